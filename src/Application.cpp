@@ -4,6 +4,7 @@
 #include "services/IDiskService.hpp"
 #include "services/IWipeService.hpp"
 #include "util/Logger.hpp"
+#include "util/StartupTrace.hpp"
 #include "viewmodels/MainViewModel.hpp"
 #include "views/MainWindow.hpp"
 
@@ -63,8 +64,13 @@ void StorageWiperApp::on_activate(GtkApplication* app, gpointer user_data) {
         // Setup MVVM pattern
         self->setup_main_window();
 
-        // Show the window
+        // Show the window with placeholder content; the helper answers later
         gtk_window_present(GTK_WINDOW(self->main_window_));
+        util::StartupTrace::instance().mark(util::StartupTrace::WINDOW_PRESENTED);
+        self->watch_first_frame();
+
+        // Connect without blocking the first frame; retries are automatic
+        self->dbus_client_->connect_async();
 
     } catch (const std::exception& e) {
         LOG_ERROR("Application", std::format("Error during application activation: {}", e.what()));
@@ -73,16 +79,9 @@ void StorageWiperApp::on_activate(GtkApplication* app, gpointer user_data) {
 }
 
 void StorageWiperApp::configure_services() {
-    // Create DBusClient and connect to the helper service
+    // Create DBusClient; it connects once the window is on screen
     dbus_client_ = std::make_shared<DBusClient>();
 
-    // Attempt to connect - if it fails, reconnection logic will retry automatically
-    if (!dbus_client_->connect()) {
-        LOG_WARNING("Application", "Initial connection to storage-wiper-helper failed. "
-                                   "Will retry automatically when service becomes available.");
-        // Don't throw - the reconnection logic will handle it
-    }
-
     // Register DBusClient as both disk and wipe service (it implements both interfaces)
     container_.register_instance<IDiskService>(
         std::static_pointer_cast<IDiskService>(dbus_client_));
@@ -102,12 +101,30 @@ void StorageWiperApp::setup_main_window() {
     // Set up connection state callback
     // Use weak_ptr to avoid preventing ViewModel destruction
     std::weak_ptr<MainViewModel> weak_vm = view_model_;
-    dbus_client_->set_connection_state_callback([weak_vm](ConnectionState state,
-                                                          const std::string& error) {
-        Glib::signal_idle().connect([weak_vm, state, error]() {
-            if (auto vm = weak_vm.lock()) {
-                bool connected = (state == ConnectionState::CONNECTED);
-                vm->set_connection_state(connected, error);
+    std::weak_ptr<DBusClient> weak_client = dbus_client_;
+    dbus_client_->set_connection_state_callback([weak_vm, weak_client](ConnectionState state,
+                                                                       const std::string& error) {
+        Glib::signal_idle().connect([weak_vm, weak_client, state, error]() {
+            auto vm = weak_vm.lock();
+            if (!vm) {
+                return false; // G_SOURCE_REMOVE
+            }
+
+            bool connected = (state == ConnectionState::CONNECTED);
+            if (connected) {
+                util::StartupTrace::instance().mark(util::StartupTrace::HELPER_CONNECTED);
+            }
+
+            // Starts the disk query
+            vm->set_connection_state(connected, error);
+
+            // Fetch algorithm metadata in parallel with the disk query
+            if (auto client = weak_client.lock(); connected && client) {
+                client->load_algorithms_async([weak_vm]() {
+                    if (auto loaded_vm = weak_vm.lock()) {
+                        loaded_vm->refresh_algorithms();
+                    }
+                });
             }
             return false; // G_SOURCE_REMOVE
         });
@@ -149,7 +166,35 @@ void StorageWiperApp::setup_main_window() {
     view_model_->initialize();
 }
 
+void StorageWiperApp::watch_first_frame() {
+    auto* frame_clock = gtk_widget_get_frame_clock(GTK_WIDGET(main_window_));
+    if (!frame_clock) {
+        return;
+    }
+
+    first_frame_clock_ = frame_clock;
+    first_frame_handler_ =
+        g_signal_connect(frame_clock, "after-paint", G_CALLBACK(on_after_paint), this);
+}
+
+void StorageWiperApp::on_after_paint(GdkFrameClock* frame_clock, gpointer user_data) {
+    auto* self = static_cast<StorageWiperApp*>(user_data);
+
+    util::StartupTrace::instance().mark(util::StartupTrace::FIRST_FRAME);
+
+    // Only the first frame is of interest
+    g_signal_handler_disconnect(frame_clock, self->first_frame_handler_);
+    self->first_frame_handler_ = 0;
+    self->first_frame_clock_ = nullptr;
+}
+
 void StorageWiperApp::cleanup() {
+    if (first_frame_handler_ != 0) {
+        g_signal_handler_disconnect(first_frame_clock_, first_frame_handler_);
+        first_frame_handler_ = 0;
+        first_frame_clock_ = nullptr;
+    }
+
     if (view_model_) {
         view_model_->cleanup();
         view_model_.reset();
@@ -50,9 +50,11 @@ public:
 private:
     static void on_activate(GtkApplication* app, gpointer user_data);
     static void on_startup(GtkApplication* app, gpointer user_data);
+    static void on_after_paint(GdkFrameClock* frame_clock, gpointer user_data);
 
     void configure_services();
     void setup_main_window();
+    void watch_first_frame();
     void cleanup();
 
     GtkApplication* app_;
@@ -65,6 +67,10 @@ private:
 
     // D-Bus client (kept for lifetime management)
     std::shared_ptr<DBusClient> dbus_client_;
+
+    // One-shot "after-paint" handler timing the first frame
+    GdkFrameClock* first_frame_clock_ = nullptr;
+    gulong first_frame_handler_ = 0;
 };
 
 #endif // STORAGE_WIPER_APPLICATION_HPP
@@ -6,15 +6,20 @@
 #include "algorithms/ATASecureEraseAlgorithm.hpp"
 
 #include "models/WipeTypes.hpp"
+#include "util/Logger.hpp"
 
 #include <fcntl.h>
 #include <linux/hdreg.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <cstring>
+#include <format>
+#include <future>
+#include <random>
 #include <thread>
 
 #include <scsi/sg.h>
@@ -49,10 +54,10 @@ bool ATASecureEraseAlgorithm::execute([[maybe_unused]] int fd, [[maybe_unused]]
     return false;
 }
 
-bool ATASecureEraseAlgorithm::execute_on_device(const std::string& device_path,
-                                                [[maybe_unused]] uint64_t size,
+bool ATASecureEraseAlgorithm::execute_on_device(const std::string& device_path, uint64_t size,
                                                 ProgressCallback callback,
                                                 const std::atomic<bool>& cancel_flag) {
+    pre_erase_samples_.clear();
     report_progress(callback, 0, "Checking ATA Security support...");
 
     // Open device
@@ -127,6 +132,9 @@ bool ATASecureEraseAlgorithm::execute_on_device(const std::string& device_path,
         }
     }
 
+    report_progress(callback, 2, "Sampling pre-erase content...");
+    sample_before_erase(device_path, size, cancel_flag);
+
     report_progress(callback, 5, "Setting temporary security password...");
 
     // Step 1: Set security password
@@ -173,7 +181,36 @@ bool ATASecureEraseAlgorithm::execute_on_device(const std::string& device_path,
     bool use_enhanced = security_info.enhanced_erase_supported;
     auto start_time = std::chrono::steady_clock::now();
 
-    if (!security_erase_unit(fd, TEMP_PASSWORD, use_enhanced, false)) {
+    // The ioctl blocks for the whole erase, for hours on large drives. It gets a thread
+    // of its own rather than an executor worker, which it would hold for that long; this
+    // thread polls so progress keeps flowing, estimated from the drive's erase time.
+    std::promise<bool> erase_result;
+    auto erase = erase_result.get_future();
+    const std::jthread eraser{[this, fd, use_enhanced, result = std::move(erase_result)]() mutable {
+        result.set_value(security_erase_unit(fd, TEMP_PASSWORD, use_enhanced, false));
+    }};
+
+    while (erase.wait_for(ERASE_POLL_INTERVAL) != std::future_status::ready) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - start_time);
+
+        // Map elapsed/estimated time onto 15%..95%; the last 5% is post-erase checks
+        double percentage = 15.0;
+        if (estimated_minutes > 0) {
+            const double fraction = std::min(
+                1.0, static_cast<double>(elapsed.count()) / (estimated_minutes * 60.0));
+            percentage = 15.0 + (fraction * 80.0);
+        }
+
+        std::string status =
+            "Secure erase in progress (" + std::to_string(elapsed.count()) + "s elapsed)";
+        if (cancel_flag.load()) {
+            status += " - cannot be interrupted once started";
+        }
+        report_progress(callback, percentage, status);
+    }
+
+    if (!erase.get()) {
         // The erase may have failed but password should be cleared on success
         // Try to disable password in case it's still set
         disable_security_password(fd, TEMP_PASSWORD, false);
@@ -219,6 +256,46 @@ bool ATASecureEraseAlgorithm::execute_on_device(const std::string& device_path,
     return true;
 }
 
+void ATASecureEraseAlgorithm::sample_before_erase(const std::string& device_path, uint64_t size,
+                                                  const std::atomic<bool>& cancel_flag) {
+    int fd = open(device_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_WARNING("ATASecureEraseAlgorithm",
+                    std::format("Cannot sample {} before erase: {}", device_path,
+                                strerror(errno)));
+        return;
+    }
+
+    const auto offsets =
+        verification::plan_sample_offsets(size, verification::SAMPLE_COUNT,
+                                          verification::SAMPLE_BYTES, std::random_device{}());
+    pre_erase_samples_ = verification::take_samples(fd, size, offsets,
+                                                    verification::SAMPLE_BYTES, cancel_flag);
+    close(fd);
+
+    if (pre_erase_samples_.empty()) {
+        LOG_WARNING("ATASecureEraseAlgorithm",
+                    "Pre-erase sampling failed; verification will only check the fill, "
+                    "and cannot confirm an erase that leaves random-looking data");
+    }
+}
+
+bool ATASecureEraseAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
+                                     const std::atomic<bool>& cancel_flag) {
+    const auto verdict = verification::verify_erase_sampled(fd, size, pre_erase_samples_,
+                                                            std::move(callback), cancel_flag);
+    if (verdict.passed) {
+        LOG_INFO("ATASecureEraseAlgorithm", std::format("Erase verified: {}", verdict.detail));
+    } else if (verdict.inconclusive) {
+        LOG_ERROR("ATASecureEraseAlgorithm",
+                  std::format("Erase could not be verified: {}", verdict.detail));
+    } else {
+        LOG_ERROR("ATASecureEraseAlgorithm",
+                  std::format("Erase verification failed: {}", verdict.detail));
+    }
+    return verdict.passed;
+}
+
 ATASecurityInfo ATASecureEraseAlgorithm::get_security_info(const std::string& device_path) {
     ATASecurityInfo info{};
 
@@ -6,9 +6,12 @@
 #pragma once
 
 #include "IWipeAlgorithm.hpp"
+#include "SampledVerification.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 /**
  * @enum ATASecurityState
@@ -55,6 +58,10 @@ struct ATASecurityInfo {
  * 4. Issue SECURITY ERASE PREPARE
  * 5. Issue SECURITY ERASE UNIT
  * 6. Wait for completion (can take minutes to hours)
+ *
+ * Before step 3 a few hundred blocks are fingerprinted, so verify() can check
+ * in seconds that the drive really replaced them with a uniform erase fill.
+ * An instance must not run two erases at once.
  */
 class ATASecureEraseAlgorithm : public IWipeAlgorithm {
 public:
@@ -86,6 +93,14 @@ public:
 
     bool is_ssd_compatible() const override { return true; }
 
+    bool supports_verification() const override { return true; }
+
+    /**
+     * @brief Sampled readback: one uniform fill everywhere, and nothing left as it was
+     */
+    bool verify(int fd, uint64_t size, ProgressCallback callback,
+                const std::atomic<bool>& cancel_flag) override;
+
     /**
      * @brief Check if a device supports ATA Secure Erase
      * @param device_path Path to the device
@@ -127,6 +142,18 @@ private:
     // Temporary password for secure erase
     static constexpr char TEMP_PASSWORD[] = "StorageWiper";
 
+    // How often progress is reported while the erase command is outstanding
+    static constexpr auto ERASE_POLL_INTERVAL = std::chrono::seconds{1};
+
+    // Pre-erase fingerprints from the last execute_on_device(); empty if sampling failed
+    std::vector<verification::Sample> pre_erase_samples_;
+
+    /**
+     * @brief Fingerprint the blocks verify() will re-read after the erase
+     */
+    void sample_before_erase(const std::string& device_path, uint64_t size,
+                             const std::atomic<bool>& cancel_flag);
+
     /**
      * @brief Send ATA command via ioctl
      */
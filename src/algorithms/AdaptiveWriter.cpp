@@ -0,0 +1,397 @@
+/**
+ * @file AdaptiveWriter.cpp
+ * @brief AIMD write controller and the parallel overwrite loop it drives
+ */
+
+#include "algorithms/AdaptiveWriter.hpp"
+
+#include "util/Executor.hpp"
+#include "util/Logger.hpp"
+#include "util/WriteHelpers.hpp"
+#include "util/WritePacer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <future>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using Clock = WriteController::Clock;
+
+// Room for two streams at full depth; more streams share it
+constexpr std::size_t WRITE_POOL_THREADS = 2 * WriteController::MAX_DEPTH;
+
+// Writes get threads of their own: streams keeping up to MAX_DEPTH requests in
+// flight each must not crowd SMART queries, scans and enumeration off the
+// shared blocking-I/O lane
+auto write_pool() -> util::Executor& {
+    static util::Executor pool{{.compute_threads = 1, .io_threads = WRITE_POOL_THREADS}};
+    return pool;
+}
+
+auto other(auto dimension) {
+    using Dimension = decltype(dimension);
+    return dimension == Dimension::DEPTH ? Dimension::REQUEST_SIZE : Dimension::DEPTH;
+}
+
+struct Completion {
+    int error = 0;  // errno of the failed write, 0 on success
+    Clock::duration latency{};
+};
+
+// One request, positioned, retried until complete
+auto write_at(int fd, const uint8_t* data, std::size_t size, off_t offset) -> int {
+    std::size_t done = 0;
+    while (done < size) {
+        const auto result =
+            ::pwrite(fd, data + done, size - done, offset + static_cast<off_t>(done));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        if (result == 0) {
+            return EIO;
+        }
+        done += static_cast<std::size_t>(result);
+    }
+    return 0;
+}
+
+void log_adjustment(const WriteController::Adjustment& adjustment, bool notable) {
+    const auto message = std::format(
+        "{}: depth {} -> {}, request {} KiB -> {} KiB ({:.0f} MB/s, {:.1f} ms per request)",
+        to_string(adjustment.reason), adjustment.from.depth, adjustment.to.depth,
+        adjustment.from.request_bytes / 1'024, adjustment.to.request_bytes / 1'024,
+        adjustment.throughput_bps / 1e6, adjustment.latency_ms);
+    if (notable) {
+        LOG_INFO("AdaptiveWriter", message);
+    } else {
+        LOG_DEBUG("AdaptiveWriter", message);
+    }
+}
+
+// Pipes and other unseekable descriptors: the plain loop the algorithms always had
+auto write_sequential(int fd, uint64_t size, const StreamFill& fill, bool constant,
+                      const std::function<void(uint64_t)>& progress,
+                      const std::atomic<bool>& cancel_flag) -> bool {
+    std::vector<uint8_t> buffer(static_cast<std::size_t>(
+        std::min<uint64_t>(WriteController::INITIAL_REQUEST_BYTES, size)));
+    if (constant) {
+        fill(0, buffer);
+    }
+
+    uint64_t written = 0;
+    while (written < size && !cancel_flag.load()) {
+        const auto to_write =
+            static_cast<std::size_t>(std::min<uint64_t>(buffer.size(), size - written));
+        if (!constant) {
+            fill(written, std::span{buffer}.first(to_write));
+        }
+        const auto result = util::write_with_retry(fd, buffer.data(), to_write);
+        if (result <= 0) {
+            return false;
+        }
+        written += static_cast<uint64_t>(result);
+        if (progress) {
+            progress(written);
+        }
+    }
+    return !cancel_flag.load();
+}
+
+}  // namespace
+
+auto to_string(WriteController::Reason reason) -> std::string {
+    switch (reason) {
+        case WriteController::Reason::PROBE:
+            return "Probing";
+        case WriteController::Reason::NO_GAIN:
+            return "No gain, reverting";
+        case WriteController::Reason::SETTLED:
+            return "Settled at the knee";
+        case WriteController::Reason::SLOWDOWN:
+            return "Drive slowed down, backing off";
+    }
+    return "Unknown";
+}
+
+WriteController::WriteController(std::size_t max_depth)
+    : max_depth_(std::clamp<std::size_t>(max_depth, 1, MAX_DEPTH)),
+      settings_{.depth = std::min(INITIAL_DEPTH, max_depth_),
+                .request_bytes = INITIAL_REQUEST_BYTES},
+      previous_(settings_) {}
+
+auto WriteController::record(std::size_t bytes, Clock::duration latency, Clock::time_point now)
+    -> std::optional<Adjustment> {
+    if (!window_start_) {
+        window_start_ = now;  // The first completion only starts the clock
+        return std::nullopt;
+    }
+    window_bytes_ += bytes;
+    ++window_completions_;
+    window_latency_ += latency;
+    if (now - *window_start_ < WINDOW || window_completions_ < settings_.depth) {
+        return std::nullopt;
+    }
+
+    const auto seconds = std::chrono::duration<double>(now - *window_start_).count();
+    const Sample sample{
+        .throughput_bps = static_cast<double>(window_bytes_) / seconds,
+        .latency_ms = std::chrono::duration<double, std::milli>(window_latency_).count() /
+                      static_cast<double>(window_completions_)};
+    window_start_ = now;
+    window_bytes_ = 0;
+    window_completions_ = 0;
+    window_latency_ = {};
+    return close_window(sample);
+}
+
+void WriteController::restart() {
+    if (phase_ == Phase::PROBE) {
+        settings_ = previous_;
+    }
+    phase_ = Phase::MEASURE;
+    failed_probes_ = 0;
+    reference_.reset();
+    window_start_.reset();
+    window_bytes_ = 0;
+    window_completions_ = 0;
+    window_latency_ = {};
+}
+
+auto WriteController::close_window(const Sample& sample) -> std::optional<Adjustment> {
+    if (reference_) {
+        // Growing latency is what a probe costs; only held settings are judged by it
+        const bool slower =
+            sample.throughput_bps < reference_->throughput_bps * (1.0 - DROP) ||
+            (phase_ == Phase::HOLD && sample.latency_ms > reference_->latency_ms * LATENCY_SPIKE);
+        if (slower) {
+            return back_off(sample);
+        }
+    }
+
+    switch (phase_) {
+        case Phase::MEASURE:
+            // First window, or the first one after a revert or back-off
+            reference_ = sample;
+            return failed_probes_ >= 2 ? settle(sample) : probe(sample);
+
+        case Phase::PROBE: {
+            if (sample.throughput_bps >= reference_->throughput_bps * (1.0 + GAIN)) {
+                reference_ = sample;
+                failed_probes_ = 0;
+                return probe(sample);
+            }
+            const Adjustment adjustment{.from = settings_,
+                                        .to = previous_,
+                                        .reason = Reason::NO_GAIN,
+                                        .throughput_bps = sample.throughput_bps,
+                                        .latency_ms = sample.latency_ms};
+            settings_ = previous_;
+            ++failed_probes_;
+            dimension_ = other(dimension_);
+            phase_ = Phase::MEASURE;
+            return adjustment;
+        }
+
+        case Phase::HOLD:
+            if (--hold_windows_ <= 0) {
+                // The drive may have sped up again (cache flushed, cooled down)
+                failed_probes_ = 0;
+                return probe(sample);
+            }
+            return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+auto WriteController::back_off(const Sample& sample) -> std::optional<Adjustment> {
+    const auto from = settings_;
+    // A probe that coincides with the slowdown is dropped along with half the rest
+    if (phase_ == Phase::PROBE) {
+        settings_ = previous_;
+    }
+    if (settings_.depth > 1) {
+        settings_.depth /= 2;
+    } else {
+        settings_.request_bytes = std::max(settings_.request_bytes / 2, MIN_REQUEST_BYTES);
+    }
+
+    failed_probes_ = 0;
+    dimension_ = Dimension::DEPTH;
+    phase_ = Phase::MEASURE;
+    reference_ = sample;
+    if (settings_ == from) {
+        return std::nullopt;  // Nothing left to give up; measure the new normal
+    }
+    return Adjustment{.from = from,
+                      .to = settings_,
+                      .reason = Reason::SLOWDOWN,
+                      .throughput_bps = sample.throughput_bps,
+                      .latency_ms = sample.latency_ms};
+}
+
+auto WriteController::probe(const Sample& sample) -> std::optional<Adjustment> {
+    if (!can_grow(dimension_)) {
+        dimension_ = other(dimension_);
+        if (!can_grow(dimension_)) {
+            return settle(sample);
+        }
+    }
+
+    previous_ = settings_;
+    if (dimension_ == Dimension::DEPTH) {
+        ++settings_.depth;
+    } else {
+        settings_.request_bytes = std::min(settings_.request_bytes * 2, MAX_REQUEST_BYTES);
+    }
+    phase_ = Phase::PROBE;
+    return Adjustment{.from = previous_,
+                      .to = settings_,
+                      .reason = Reason::PROBE,
+                      .throughput_bps = sample.throughput_bps,
+                      .latency_ms = sample.latency_ms};
+}
+
+auto WriteController::settle(const Sample& sample) -> std::optional<Adjustment> {
+    phase_ = Phase::HOLD;
+    hold_windows_ = HOLD_WINDOWS;
+    return Adjustment{.from = settings_,
+                      .to = settings_,
+                      .reason = Reason::SETTLED,
+                      .throughput_bps = sample.throughput_bps,
+                      .latency_ms = sample.latency_ms};
+}
+
+auto WriteController::can_grow(Dimension dimension) const -> bool {
+    return dimension == Dimension::DEPTH ? settings_.depth < max_depth_
+                                         : settings_.request_bytes < MAX_REQUEST_BYTES;
+}
+
+auto write_stream(int fd, uint64_t size, const StreamFill& fill, bool constant,
+                  const std::function<void(uint64_t written)>& progress,
+                  const std::atomic<bool>& cancel_flag) -> bool {
+    const auto base = ::lseek(fd, 0, SEEK_CUR);
+    if (base < 0) {
+        return write_sequential(fd, size, fill, constant, progress, cancel_flag);
+    }
+
+    struct Request {
+        std::vector<uint8_t> buffer;
+        std::size_t length = 0;
+        std::future<Completion> done;
+    };
+
+    auto& executor = write_pool();
+    WriteController controller;
+    std::optional<WriteController::Settings> settled;
+    std::deque<Request> in_flight;
+    std::vector<std::vector<uint8_t>> spare;
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    bool failed = false;
+    double multiplier = util::WritePacer::multiplier();
+    auto busy_since = Clock::now();
+
+    auto complete_oldest = [&] {
+        auto request = std::move(in_flight.front());
+        in_flight.pop_front();
+        const auto result = request.done.get();
+        if (result.error != 0) {
+            if (!failed) {
+                LOG_ERROR("AdaptiveWriter", std::format("Write failed near offset {}: {}",
+                                                        static_cast<uint64_t>(base) + completed,
+                                                        strerror(result.error)));
+            }
+            failed = true;
+        } else if (!failed) {
+            completed += request.length;
+            if (progress) {
+                progress(completed);
+            }
+            if (const auto adjustment =
+                    controller.record(request.length, result.latency, Clock::now())) {
+                // A settled state is news only when it differs from the last one
+                const bool notable = adjustment->reason == WriteController::Reason::SLOWDOWN ||
+                                     (adjustment->reason == WriteController::Reason::SETTLED &&
+                                      settled != adjustment->to);
+                if (adjustment->reason == WriteController::Reason::SETTLED) {
+                    settled = adjustment->to;
+                }
+                log_adjustment(*adjustment, notable);
+            }
+        }
+        spare.push_back(std::move(request.buffer));
+    };
+
+    while (submitted < size && !failed && !cancel_flag.load()) {
+        if (const auto current = util::WritePacer::multiplier(); current != multiplier) {
+            multiplier = current;
+            controller.restart();
+        }
+        const auto settings = controller.settings();
+        // Throttled: fewer requests in flight first, pauses for the share that leaves
+        const auto depth = std::max<std::size_t>(
+            1, static_cast<std::size_t>(
+                   std::llround(static_cast<double>(settings.depth) * multiplier)));
+        while (in_flight.size() >= depth && !failed) {
+            complete_oldest();
+        }
+        if (failed) {
+            break;
+        }
+        const double share =
+            multiplier * static_cast<double>(settings.depth) / static_cast<double>(depth);
+        if (share < 1.0) {
+            util::WritePacer::pace(Clock::now() - busy_since, share);
+            busy_since = Clock::now();
+        }
+
+        // Buffers of an earlier request size are dropped rather than resized
+        std::erase_if(spare, [&](const auto& buffer) {
+            return buffer.size() != settings.request_bytes;
+        });
+        std::vector<uint8_t> buffer;
+        if (!spare.empty()) {
+            buffer = std::move(spare.back());
+            spare.pop_back();
+        } else {
+            buffer.resize(settings.request_bytes);
+            if (constant) {
+                fill(0, buffer);
+            }
+        }
+
+        const auto length =
+            static_cast<std::size_t>(std::min<uint64_t>(settings.request_bytes, size - submitted));
+        if (!constant) {
+            fill(submitted, std::span{buffer}.first(length));
+        }
+        auto done = executor.submit(
+            [fd, data = buffer.data(), length, offset = base + static_cast<off_t>(submitted)] {
+                const auto start = Clock::now();
+                return Completion{.error = write_at(fd, data, length, offset),
+                                  .latency = Clock::now() - start};
+            },
+            util::TaskPriority::BULK, util::TaskLane::BLOCKING_IO);
+        in_flight.push_back(
+            {.buffer = std::move(buffer), .length = length, .done = std::move(done)});
+        submitted += length;
+    }
+
+    // Every buffer must outlive its write
+    while (!in_flight.empty()) {
+        complete_oldest();
+    }
+    ::lseek(fd, base + static_cast<off_t>(completed), SEEK_SET);
+    return !failed && completed == size && !cancel_flag.load();
+}
@@ -0,0 +1,148 @@
+/**
+ * @file AdaptiveWriter.hpp
+ * @brief Overwrite loop with several requests in flight, tuned while it runs
+ *
+ * A drive's best queue depth and request size change during a wipe: an SMR
+ * drive runs out of its CMR cache, a consumer SSD fills its SLC cache, a
+ * controller throttles when hot. WriteController follows the knee of the
+ * latency curve with AIMD:
+ *
+ * - probe: one more request in flight, or requests twice as large, kept only
+ *   if throughput gains more than GAIN;
+ * - at the knee (neither probe gains), hold and probe again later;
+ * - when throughput collapses, or latency spikes at the held settings, halve
+ *   the depth (then the request size) and climb again from there.
+ *
+ * write_stream() runs the requests on a pool of I/O threads reserved for
+ * wipe writes, separate from the shared executor, and logs every adjustment.
+ * While util::WritePacer throttles wipes it keeps fewer requests in flight
+ * and pauses between them for whatever share that does not cover.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+
+/**
+ * @class WriteController
+ * @brief AIMD controller for the in-flight count and request size of one write stream
+ */
+class WriteController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        std::size_t depth = 0;          ///< Requests in flight
+        std::size_t request_bytes = 0;  ///< Bytes per request
+
+        auto operator==(const Settings&) const -> bool = default;
+    };
+
+    enum class Reason : std::uint8_t {
+        PROBE,     ///< Trying one step up
+        NO_GAIN,   ///< The step up did not pay off; back to the previous settings
+        SETTLED,   ///< At the knee; holding (settings unchanged)
+        SLOWDOWN   ///< The drive slowed down at the held settings; multiplicative decrease
+    };
+
+    struct Adjustment {
+        Settings from;
+        Settings to;
+        Reason reason = Reason::PROBE;
+        double throughput_bps = 0.0;  ///< Of the window that led to the adjustment
+        double latency_ms = 0.0;      ///< Mean completion latency of that window
+    };
+
+    static constexpr std::size_t MIN_REQUEST_BYTES = 128 * 1'024;
+    static constexpr std::size_t MAX_REQUEST_BYTES = 4 * 1'024 * 1'024;
+    static constexpr std::size_t INITIAL_REQUEST_BYTES = 1'024 * 1'024;
+    static constexpr std::size_t INITIAL_DEPTH = 2;
+    static constexpr std::size_t MAX_DEPTH = 16;
+    static constexpr auto WINDOW = std::chrono::milliseconds{500};
+    static constexpr double GAIN = 0.05;           // A probe must beat the reference by 5%
+    static constexpr double DROP = 0.25;           // Throughput loss that means the drive changed
+    static constexpr double LATENCY_SPIKE = 2.0;   // Latency growth that means the same
+    static constexpr int HOLD_WINDOWS = 20;        // Windows at the knee before probing again
+
+    /**
+     * @param max_depth Upper bound on requests in flight
+     */
+    explicit WriteController(std::size_t max_depth = MAX_DEPTH);
+
+    [[nodiscard]] auto settings() const -> const Settings& { return settings_; }
+
+    /**
+     * @brief Account one completed request; closes the window when it is due
+     * @return The adjustment made at the end of a window, if any
+     */
+    auto record(std::size_t bytes, Clock::duration latency, Clock::time_point now)
+        -> std::optional<Adjustment>;
+
+    /**
+     * @brief Drop the current window and the reference throughput
+     *
+     * For when the stream is slowed down from outside (WritePacer): throughput
+     * before and after says nothing about the drive. A probe in progress is
+     * reverted; the next window measures afresh.
+     */
+    void restart();
+
+private:
+    enum class Phase : std::uint8_t { MEASURE, PROBE, HOLD };
+    enum class Dimension : std::uint8_t { DEPTH, REQUEST_SIZE };
+
+    struct Sample {
+        double throughput_bps = 0.0;
+        double latency_ms = 0.0;
+    };
+
+    auto close_window(const Sample& sample) -> std::optional<Adjustment>;
+    auto probe(const Sample& sample) -> std::optional<Adjustment>;
+    auto settle(const Sample& sample) -> std::optional<Adjustment>;
+    auto back_off(const Sample& sample) -> std::optional<Adjustment>;
+    [[nodiscard]] auto can_grow(Dimension dimension) const -> bool;
+
+    std::size_t max_depth_;
+    Settings settings_;
+    Settings previous_;
+    Phase phase_ = Phase::MEASURE;
+    Dimension dimension_ = Dimension::DEPTH;
+    int failed_probes_ = 0;
+    int hold_windows_ = 0;
+    std::optional<Sample> reference_;
+
+    std::optional<Clock::time_point> window_start_;
+    std::uint64_t window_bytes_ = 0;
+    std::size_t window_completions_ = 0;
+    Clock::duration window_latency_{};
+};
+
+[[nodiscard]] auto to_string(WriteController::Reason reason) -> std::string;
+
+/**
+ * @brief Produces the bytes for [offset, offset + out.size()) of the stream
+ */
+using StreamFill = std::function<void(uint64_t offset, std::span<uint8_t> out)>;
+
+/**
+ * @brief Write `size` bytes from the descriptor's current position
+ *
+ * On a seekable descriptor the requests are positioned writes issued in
+ * parallel, sized and counted by a WriteController; `fill` is called on the
+ * calling thread, once per request (once per buffer if `constant`). Other
+ * descriptors (pipes) get one sequential write at a time. The position ends
+ * up after the written range either way.
+ *
+ * @param progress Called on the calling thread with the bytes completed so far
+ * @return true if every byte was written and the stream was not cancelled
+ */
+auto write_stream(int fd, uint64_t size, const StreamFill& fill, bool constant,
+                  const std::function<void(uint64_t written)>& progress,
+                  const std::atomic<bool>& cancel_flag) -> bool;
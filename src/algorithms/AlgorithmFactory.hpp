@@ -0,0 +1,204 @@
+/**
+ * @file AlgorithmFactory.hpp
+ * @brief Construct wipe algorithm implementations by identifier
+ */
+
+#pragma once
+
+#include "algorithms/ATASecureEraseAlgorithm.hpp"
+#include "algorithms/DoD522022MAlgorithm.hpp"
+#include "algorithms/DoDECEAlgorithm.hpp"
+#include "algorithms/GOSTAlgorithm.hpp"
+#include "algorithms/GutmannAlgorithm.hpp"
+#include "algorithms/IWipeAlgorithm.hpp"
+#include "algorithms/LBATaggedAlgorithm.hpp"
+#include "algorithms/LBATaggedZeroAlgorithm.hpp"
+#include "algorithms/LuksCryptoShredAlgorithm.hpp"
+#include "algorithms/LuksCryptoShredOverwriteAlgorithm.hpp"
+#include "algorithms/RCMPAlgorithm.hpp"
+#include "algorithms/RandomFillAlgorithm.hpp"
+#include "algorithms/SchneierAlgorithm.hpp"
+#include "algorithms/ThinDiscardAlgorithm.hpp"
+#include "algorithms/VSITRAlgorithm.hpp"
+#include "algorithms/ZeroFillAlgorithm.hpp"
+#include "models/WipeTypes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+/**
+ * @brief Names an algorithm answers to on the command line and in station rules
+ */
+struct WipeAlgorithmEntry {
+    WipeAlgorithm algorithm;
+    std::string_view name;                      ///< Canonical name, printed back to the user
+    std::string_view summary;                   ///< One line for --help
+    std::array<std::string_view, 2> aliases{};  ///< Shorter accepted spellings
+    bool offered = true;  ///< False keeps an implemented algorithm off every front end
+};
+
+/**
+ * @brief The algorithm catalog, in the order menus and listings present it
+ *
+ * The one list every front end derives from; a new algorithm goes here and in
+ * make_wipe_algorithm() and nowhere else.
+ */
+inline constexpr std::array WIPE_ALGORITHM_CATALOG = {
+    WipeAlgorithmEntry{WipeAlgorithm::ZERO_FILL, "zero-fill", "Single pass with zeros",
+                       {"zero", "zerofill"}},
+    WipeAlgorithmEntry{WipeAlgorithm::RANDOM_FILL, "random-fill", "Single pass with random data",
+                       {"random", "randomfill"}},
+    WipeAlgorithmEntry{WipeAlgorithm::DOD_5220_22_M, "dod-5220-22-m",
+                       "DoD 5220.22-M 3-pass standard", {"dod", "dod522022m"}},
+    WipeAlgorithmEntry{WipeAlgorithm::DOD_5220_22_M_ECE, "dod-5220-22-m-ece",
+                       "DoD 5220.22-M ECE 7-pass (random/complement)", {"dod-ece"}},
+    WipeAlgorithmEntry{WipeAlgorithm::SCHNEIER, "schneier", "Bruce Schneier 7-pass method"},
+    WipeAlgorithmEntry{WipeAlgorithm::VSITR, "vsitr", "German VSITR 7-pass standard"},
+    WipeAlgorithmEntry{WipeAlgorithm::GOST_R_50739_95, "gost", "Russian GOST R 50739-95 2-pass",
+                       {"gost-r-50739-95"}},
+    WipeAlgorithmEntry{WipeAlgorithm::RCMP_TSSIT_OPS_II, "rcmp-tssit-ops-ii",
+                       "RCMP TSSIT OPS-II 7-pass", {"rcmp"}},
+    WipeAlgorithmEntry{WipeAlgorithm::GUTMANN, "gutmann", "Peter Gutmann 35-pass method"},
+    // Withheld: the SECURITY command sequence goes out through HDIO_DRIVE_CMD,
+    // which cannot carry the password block, and a partial run can leave the
+    // drive locked. Offer it once it uses SG_IO ATA PASS-THROUGH (data-out).
+    WipeAlgorithmEntry{WipeAlgorithm::ATA_SECURE_ERASE, "ata-secure-erase",
+                       "Drive's own ATA SECURITY ERASE (SATA)", {"ata"}, false},
+    WipeAlgorithmEntry{WipeAlgorithm::THIN_DISCARD, "thin-discard",
+                       "Discard + write zeroes (virtual/thin disks)", {"thin"}},
+    WipeAlgorithmEntry{WipeAlgorithm::LBA_TAGGED, "lba-tagged",
+                       "Self-describing blocks (detects fake capacity)", {"tagged"}},
+    WipeAlgorithmEntry{WipeAlgorithm::LBA_TAGGED_ZERO, "lba-tagged-zero",
+                       "LBA-tagged pass, checked, then zeros", {"tagged-zero"}},
+    WipeAlgorithmEntry{WipeAlgorithm::LUKS_CRYPTO_SHRED, "luks-crypto-shred",
+                       "Destroy LUKS headers and keyslots (seconds)", {"crypto-shred"}},
+    WipeAlgorithmEntry{WipeAlgorithm::LUKS_CRYPTO_SHRED_OVERWRITE, "luks-crypto-shred-overwrite",
+                       "Crypto-shred, then random data at idle priority",
+                       {"crypto-shred-overwrite"}},
+};
+
+/**
+ * @brief Every implemented algorithm identifier, in catalog order
+ */
+inline constexpr auto ALL_WIPE_ALGORITHMS = [] {
+    std::array<WipeAlgorithm, WIPE_ALGORITHM_CATALOG.size()> algorithms{};
+    std::ranges::transform(WIPE_ALGORITHM_CATALOG, algorithms.begin(),
+                           &WipeAlgorithmEntry::algorithm);
+    return algorithms;
+}();
+
+static_assert(
+    [] {
+        // Each enumerator exactly once: sorted, the catalog is 0, 1, ..., N-1
+        auto sorted = ALL_WIPE_ALGORITHMS;
+        std::ranges::sort(sorted);
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            if (static_cast<std::size_t>(sorted[i]) != i) {
+                return false;
+            }
+        }
+        return static_cast<std::size_t>(WipeAlgorithm::LUKS_CRYPTO_SHRED_OVERWRITE) + 1 ==
+               sorted.size();
+    }(),
+    "WIPE_ALGORITHM_CATALOG must list every WipeAlgorithm exactly once");
+
+/**
+ * @brief The algorithms the helper, GUI and CLI offer, in catalog order
+ */
+inline constexpr auto OFFERED_WIPE_ALGORITHMS = [] {
+    std::array<WipeAlgorithm, std::ranges::count(WIPE_ALGORITHM_CATALOG, true,
+                                                 &WipeAlgorithmEntry::offered)>
+        algorithms{};
+    std::size_t i = 0;
+    for (const auto& entry : WIPE_ALGORITHM_CATALOG) {
+        if (entry.offered) {
+            algorithms[i++] = entry.algorithm;
+        }
+    }
+    return algorithms;
+}();
+
+/**
+ * @brief Whether an identifier (possibly received over D-Bus) names an offered algorithm
+ */
+[[nodiscard]] constexpr auto is_offered_wipe_algorithm(WipeAlgorithm algorithm) -> bool {
+    return std::ranges::find(OFFERED_WIPE_ALGORITHMS, algorithm) !=
+           OFFERED_WIPE_ALGORITHMS.end();
+}
+
+/**
+ * @brief Canonical command-line name of an algorithm, e.g. "dod-5220-22-m"
+ */
+[[nodiscard]] constexpr auto wipe_algorithm_name(WipeAlgorithm algorithm) -> std::string_view {
+    for (const auto& entry : WIPE_ALGORITHM_CATALOG) {
+        if (entry.algorithm == algorithm) {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Look up an offered algorithm by canonical name or alias, ignoring ASCII case
+ */
+[[nodiscard]] inline auto parse_wipe_algorithm(std::string_view name)
+    -> std::optional<WipeAlgorithm> {
+    const auto matches = [name](std::string_view candidate) {
+        return !candidate.empty() &&
+               std::ranges::equal(name, candidate, [](char a, char b) {
+                   return std::tolower(static_cast<unsigned char>(a)) == b;
+               });
+    };
+    for (const auto& entry : WIPE_ALGORITHM_CATALOG) {
+        if (entry.offered && (matches(entry.name) || std::ranges::any_of(entry.aliases, matches))) {
+            return entry.algorithm;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Create a fresh instance of an algorithm
+ * @return Implementation, or nullptr for an unknown identifier
+ */
+[[nodiscard]] inline auto make_wipe_algorithm(WipeAlgorithm algorithm)
+    -> std::shared_ptr<IWipeAlgorithm> {
+    switch (algorithm) {
+        case WipeAlgorithm::ZERO_FILL:
+            return std::make_shared<ZeroFillAlgorithm>();
+        case WipeAlgorithm::RANDOM_FILL:
+            return std::make_shared<RandomFillAlgorithm>();
+        case WipeAlgorithm::DOD_5220_22_M:
+            return std::make_shared<DoD522022MAlgorithm>();
+        case WipeAlgorithm::GUTMANN:
+            return std::make_shared<GutmannAlgorithm>();
+        case WipeAlgorithm::SCHNEIER:
+            return std::make_shared<SchneierAlgorithm>();
+        case WipeAlgorithm::VSITR:
+            return std::make_shared<VSITRAlgorithm>();
+        case WipeAlgorithm::GOST_R_50739_95:
+            return std::make_shared<GOSTAlgorithm>();
+        case WipeAlgorithm::ATA_SECURE_ERASE:
+            return std::make_shared<ATASecureEraseAlgorithm>();
+        case WipeAlgorithm::THIN_DISCARD:
+            return std::make_shared<ThinDiscardAlgorithm>();
+        case WipeAlgorithm::DOD_5220_22_M_ECE:
+            return std::make_shared<DoDECEAlgorithm>();
+        case WipeAlgorithm::RCMP_TSSIT_OPS_II:
+            return std::make_shared<RCMPAlgorithm>();
+        case WipeAlgorithm::LBA_TAGGED:
+            return std::make_shared<LBATaggedAlgorithm>();
+        case WipeAlgorithm::LBA_TAGGED_ZERO:
+            return std::make_shared<LBATaggedZeroAlgorithm>();
+        case WipeAlgorithm::LUKS_CRYPTO_SHRED:
+            return std::make_shared<LuksCryptoShredAlgorithm>();
+        case WipeAlgorithm::LUKS_CRYPTO_SHRED_OVERWRITE:
+            return std::make_shared<LuksCryptoShredOverwriteAlgorithm>();
+    }
+    return nullptr;
+}
@@ -2,7 +2,7 @@
 
 #include "algorithms/VerificationHelper.hpp"
 #include "models/WipeTypes.hpp"
-#include "util/RandomBuffer.hpp"
+#include "util/RandomStream.hpp"
 #include "util/WriteHelpers.hpp"
 
 #include <unistd.h>
@@ -36,12 +36,12 @@ bool DoD522022MAlgorithm::execute(int fd, uint64_t size, ProgressCallback callba
         return false;
 
     // Pass 3: Random data
-    std::vector<uint8_t> random_buffer(BUFFER_SIZE);
+    // Next buffer is generated on the executor while the current one is written
+    util::RandomStream random{BUFFER_SIZE};
     uint64_t written = 0;
 
     while (written < size && !cancel_flag.load()) {
-        // Generate fresh random data for each buffer efficiently
-        util::RandomBufferGenerator::fill(random_buffer);
+        const auto& random_buffer = random.next();
 
         size_t to_write = std::min(static_cast<uint64_t>(BUFFER_SIZE), size - written);
         ssize_t result = util::write_with_retry(fd, random_buffer.data(), to_write);
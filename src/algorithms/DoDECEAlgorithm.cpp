@@ -0,0 +1,26 @@
+#include "algorithms/DoDECEAlgorithm.hpp"
+
+#include <array>
+
+namespace {
+
+using Kind = WipePass::Kind;
+
+constexpr std::array PASSES = {
+    // Method E
+    WipePass{.kind = Kind::RANDOM, .character = 0x00},
+    WipePass{.kind = Kind::COMPLEMENT, .character = 0x00},
+    WipePass{.kind = Kind::RANDOM, .character = 0x00},
+    // Method C
+    WipePass{.kind = Kind::CHARACTER, .character = 0x00},
+    // Method E
+    WipePass{.kind = Kind::RANDOM, .character = 0x00},
+    WipePass{.kind = Kind::COMPLEMENT, .character = 0x00},
+    WipePass{.kind = Kind::RANDOM, .character = 0x00},
+};
+
+}  // namespace
+
+auto DoDECEAlgorithm::passes() const -> std::span<const WipePass> {
+    return PASSES;
+}
@@ -0,0 +1,27 @@
+/**
+ * @file DoDECEAlgorithm.hpp
+ * @brief US Department of Defense 5220.22-M ECE 7-pass wipe algorithm
+ */
+
+#pragma once
+
+#include "PassSequenceAlgorithm.hpp"
+
+/**
+ * @class DoDECEAlgorithm
+ * @brief DoD 5220.22-M ECE: method E, then method C, then method E again
+ *
+ * Each E phase writes random data, its complement and fresh random data; the
+ * C phase writes a single character.
+ */
+class DoDECEAlgorithm : public PassSequenceAlgorithm {
+public:
+    std::string get_name() const override { return "DoD 5220.22-M ECE"; }
+
+    std::string get_description() const override {
+        return "US Department of Defense 7-pass extended standard";
+    }
+
+protected:
+    auto passes() const -> std::span<const WipePass> override;
+};
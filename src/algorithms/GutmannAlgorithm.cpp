@@ -1,7 +1,7 @@
 #include "algorithms/GutmannAlgorithm.hpp"
 
 #include "models/WipeTypes.hpp"
-#include "util/RandomBuffer.hpp"
+#include "util/RandomStream.hpp"
 #include "util/WriteHelpers.hpp"
 
 #include <unistd.h>
@@ -25,16 +25,18 @@ bool GutmannAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
     // by Peter Gutmann, 1996
 
     std::vector<uint8_t> buffer(BUFFER_SIZE);
+    // Random passes generate the next buffer on the executor while writing the current one
+    util::RandomStream random{BUFFER_SIZE};
 
     // Passes 1-4: Random data
     for (int pass = 1; pass <= 4; ++pass) {
         uint64_t written = 0;
 
         while (written < size && !cancel_flag.load()) {
-            util::RandomBufferGenerator::fill(buffer);
+            const auto& random_buffer = random.next();
 
             size_t to_write = std::min(static_cast<uint64_t>(BUFFER_SIZE), size - written);
-            ssize_t result = util::write_with_retry(fd, buffer.data(), to_write);
+            ssize_t result = util::write_with_retry(fd, random_buffer.data(), to_write);
 
             if (result <= 0) {
                 return false;
@@ -83,10 +85,10 @@ bool GutmannAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
         uint64_t written = 0;
 
         while (written < size && !cancel_flag.load()) {
-            util::RandomBufferGenerator::fill(buffer);
+            const auto& random_buffer = random.next();
 
             size_t to_write = std::min(static_cast<uint64_t>(BUFFER_SIZE), size - written);
-            ssize_t result = util::write_with_retry(fd, buffer.data(), to_write);
+            ssize_t result = util::write_with_retry(fd, random_buffer.data(), to_write);
 
             if (result <= 0) {
                 return false;
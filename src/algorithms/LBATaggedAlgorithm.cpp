@@ -0,0 +1,15 @@
+#include "algorithms/LBATaggedAlgorithm.hpp"
+
+#include <array>
+
+namespace {
+
+constexpr std::array PASSES = {
+    WipePass{.kind = WipePass::Kind::TAGGED, .character = 0x00},
+};
+
+}  // namespace
+
+auto LBATaggedAlgorithm::passes() const -> std::span<const WipePass> {
+    return PASSES;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file LBATaggedAlgorithm.hpp
+ * @brief Single pass of self-describing blocks, verified block by block
+ */
+
+#pragma once
+
+#include "PassSequenceAlgorithm.hpp"
+
+/**
+ * @class LBATaggedAlgorithm
+ * @brief Writes every block with its own address, a job id and a checksum
+ *
+ * Verification proves each block was written at its address by this wipe,
+ * which a constant pattern cannot: it catches dropped and misdirected writes
+ * and reports the real size of fake-capacity flash drives.
+ */
+class LBATaggedAlgorithm : public PassSequenceAlgorithm {
+public:
+    std::string get_name() const override { return "LBA-Tagged Pattern"; }
+
+    std::string get_description() const override {
+        return "1-pass self-describing blocks; verification detects fake capacity";
+    }
+
+    bool is_ssd_compatible() const override { return true; }
+
+protected:
+    auto passes() const -> std::span<const WipePass> override;
+};
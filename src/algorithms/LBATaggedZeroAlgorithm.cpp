@@ -0,0 +1,18 @@
+#include "algorithms/LBATaggedZeroAlgorithm.hpp"
+
+#include <array>
+
+namespace {
+
+using Kind = WipePass::Kind;
+
+constexpr std::array PASSES = {
+    WipePass{.kind = Kind::TAGGED, .character = 0x00},
+    WipePass{.kind = Kind::CHARACTER, .character = 0x00},
+};
+
+}  // namespace
+
+auto LBATaggedZeroAlgorithm::passes() const -> std::span<const WipePass> {
+    return PASSES;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file LBATaggedZeroAlgorithm.hpp
+ * @brief Self-describing blocks, checked on readback, then zeros
+ */
+
+#pragma once
+
+#include "PassSequenceAlgorithm.hpp"
+
+/**
+ * @class LBATaggedZeroAlgorithm
+ * @brief LBA-tagged pass, read back and checked, then a zero pass
+ *
+ * The tagged pass proves every address is really stored before the zero
+ * pass, whose own verification is a cheap all-zeros check, leaves the
+ * device blank.
+ */
+class LBATaggedZeroAlgorithm : public PassSequenceAlgorithm {
+public:
+    std::string get_name() const override { return "LBA-Tagged + Zero"; }
+
+    std::string get_description() const override {
+        return "2-pass: checked self-describing blocks, then zeros";
+    }
+
+protected:
+    auto passes() const -> std::span<const WipePass> override;
+};
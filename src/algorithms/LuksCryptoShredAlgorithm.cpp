@@ -0,0 +1,215 @@
+/**
+ * @file LuksCryptoShredAlgorithm.cpp
+ * @brief Header and keyslot destruction for LUKS volumes
+ */
+
+#include "algorithms/LuksCryptoShredAlgorithm.hpp"
+
+#include "util/FileDescriptor.hpp"
+#include "util/Keystream.hpp"
+#include "util/Logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <span>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+auto pwrite_all(int fd, const uint8_t* buffer, size_t length, uint64_t offset) -> bool {
+    size_t done = 0;
+    while (done < length) {
+        const auto result =
+            ::pwrite(fd, buffer + done, length - done, static_cast<off_t>(offset + done));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+auto pread_all(int fd, uint8_t* buffer, size_t length, uint64_t offset) -> bool {
+    size_t done = 0;
+    while (done < length) {
+        const auto result =
+            ::pread(fd, buffer + done, length - done, static_cast<off_t>(offset + done));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+void report(const ProgressCallback& callback, uint64_t done, uint64_t total, int total_passes,
+            const char* status) {
+    if (!callback) {
+        return;
+    }
+    WipeProgress progress{};
+    progress.bytes_written = done;
+    progress.total_bytes = total;
+    progress.current_pass = 1;
+    progress.total_passes = total_passes;
+    progress.percentage =
+        total == 0 ? 100.0 : (static_cast<double>(done) / static_cast<double>(total)) * 100.0;
+    progress.status = status;
+    callback(progress);
+}
+
+}  // namespace
+
+bool LuksCryptoShredAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
+                                       const std::atomic<bool>& cancel_flag) {
+    return shred(fd, size, callback, cancel_flag, get_pass_count());
+}
+
+bool LuksCryptoShredAlgorithm::shred(int fd, uint64_t size, const ProgressCallback& callback,
+                                     const std::atomic<bool>& cancel_flag, int total_passes) {
+    // The wipe fd is write-only; read through a second open of the same device
+    util::FileDescriptor reader(
+        open(std::format("/proc/self/fd/{}", fd).c_str(), O_RDONLY | O_CLOEXEC));
+    if (!reader) {
+        LOG_ERROR("LuksCryptoShredAlgorithm", "Cannot reopen the device to read LUKS headers");
+        return false;
+    }
+
+    // Shredding under an open mapping destroys nothing the kernel still needs
+    if (const auto mappings = luks::open_mappings(fd); !mappings.empty()) {
+        LOG_ERROR("LuksCryptoShredAlgorithm",
+                  std::format("dm-crypt mapping '{}' is open on this device; close it first "
+                              "(cryptsetup close {})",
+                              mappings.front(), mappings.front()));
+        return false;
+    }
+
+    const auto candidates = luks::candidate_offsets(fd);
+    const auto containers = luks::find_containers(reader.get(), size, candidates);
+    if (containers.empty()) {
+        LOG_ERROR("LuksCryptoShredAlgorithm",
+                  std::format("No LUKS header at any of {} candidate offsets", candidates.size()));
+        return false;
+    }
+
+    seed_ = util::Keystream::random_seed();
+    regions_.clear();
+    offsets_.clear();
+    for (const auto& container : containers) {
+        LOG_INFO("LuksCryptoShredAlgorithm",
+                 std::format("LUKS{} volume {} at offset {}: {} regions, {} bytes",
+                             container.version, container.uuid.empty() ? "?" : container.uuid,
+                             container.offset, container.regions.size(), container.bytes()));
+        offsets_.push_back(container.offset);
+        regions_.insert(regions_.end(), container.regions.begin(), container.regions.end());
+    }
+
+    uint64_t total = 0;
+    for (const auto& region : regions_) {
+        total += region.length;
+    }
+
+    const util::Keystream keystream{seed_};
+    std::vector<uint8_t> buffer(static_cast<size_t>(std::min<uint64_t>(BUFFER_SIZE, total)));
+    uint64_t written = 0;
+    report(callback, 0, total, total_passes, "Destroying LUKS headers and keyslots...");
+    for (const auto& region : regions_) {
+        for (uint64_t done = 0; done < region.length && !cancel_flag.load();) {
+            const auto length =
+                static_cast<size_t>(std::min<uint64_t>(buffer.size(), region.length - done));
+            const auto chunk = std::span{buffer}.first(length);
+            keystream.fill(region.offset + done, chunk);
+            if (!pwrite_all(fd, chunk.data(), chunk.size(), region.offset + done)) {
+                LOG_ERROR("LuksCryptoShredAlgorithm",
+                          std::format("Writing {} at offset {} failed: {}", region.what,
+                                      region.offset + done, strerror(errno)));
+                return false;
+            }
+            done += length;
+            written += length;
+            report(callback, written, total, total_passes,
+                   "Destroying LUKS headers and keyslots...");
+        }
+    }
+    if (cancel_flag.load()) {
+        return false;
+    }
+
+    if (!check_shredded(reader.get(), size, callback, cancel_flag)) {
+        return false;
+    }
+    LOG_INFO("LuksCryptoShredAlgorithm",
+             std::format("Destroyed {} bytes of key material in {} LUKS volume(s)", total,
+                         containers.size()));
+    return true;
+}
+
+bool LuksCryptoShredAlgorithm::check_shredded(int fd, uint64_t size,
+                                              const ProgressCallback& callback,
+                                              const std::atomic<bool>& cancel_flag) const {
+    // Keys still loaded in the kernel: the volume is not shredded, whatever is on disk
+    if (const auto mappings = luks::open_mappings(fd); !mappings.empty()) {
+        LOG_ERROR("LuksCryptoShredAlgorithm",
+                  std::format("dm-crypt mapping '{}' is still open", mappings.front()));
+        return false;
+    }
+
+    // Read from the media, not from pages the writes left in the cache
+    static_cast<void>(fdatasync(fd));
+    static_cast<void>(posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED));
+
+    uint64_t total = 0;
+    for (const auto& region : regions_) {
+        total += region.length;
+    }
+
+    const util::Keystream keystream{seed_};
+    std::vector<uint8_t> expected(static_cast<size_t>(std::min<uint64_t>(BUFFER_SIZE, total)));
+    std::vector<uint8_t> actual(expected.size());
+    uint64_t checked = 0;
+    for (const auto& region : regions_) {
+        for (uint64_t done = 0; done < region.length;) {
+            if (cancel_flag.load()) {
+                return false;
+            }
+            const auto length =
+                static_cast<size_t>(std::min<uint64_t>(expected.size(), region.length - done));
+            keystream.fill(region.offset + done, std::span{expected}.first(length));
+            if (!pread_all(fd, actual.data(), length, region.offset + done) ||
+                std::memcmp(expected.data(), actual.data(), length) != 0) {
+                LOG_ERROR("LuksCryptoShredAlgorithm",
+                          std::format("{} at offset {} did not read back as written",
+                                      region.what, region.offset));
+                return false;
+            }
+            done += length;
+            checked += length;
+            report(callback, checked, total, get_pass_count(), "Checking shredded regions...");
+        }
+    }
+
+    // Nothing at any volume start may still look like LUKS (e.g. a secondary header)
+    const auto offsets = offsets_.empty() ? luks::candidate_offsets(fd) : offsets_;
+    if (const auto left = luks::find_containers(fd, size, offsets); !left.empty()) {
+        LOG_ERROR("LuksCryptoShredAlgorithm",
+                  std::format("A LUKS{} header is still present at offset {}",
+                              left.front().version, left.front().offset));
+        return false;
+    }
+    return true;
+}
+
+bool LuksCryptoShredAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
+                                      const std::atomic<bool>& cancel_flag) {
+    return check_shredded(fd, size, callback, cancel_flag);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file LuksCryptoShredOverwriteAlgorithm.cpp
+ * @brief Crypto-shred, then an idle-priority random overwrite
+ */
+
+#include "algorithms/LuksCryptoShredOverwriteAlgorithm.hpp"
+
+#include "algorithms/VerificationHelper.hpp"
+#include "util/Keystream.hpp"
+#include "util/Logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <span>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+// linux/ioprio.h; glibc has no wrapper
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+constexpr int IOPRIO_CLASS_IDLE = 3;
+
+/**
+ * @brief Puts the calling thread in the idle I/O class until destroyed
+ *
+ * With who = 0, IOPRIO_WHO_PROCESS addresses the calling thread only, so
+ * the helper's other work keeps its priority.
+ */
+class IdleIoPriority {
+public:
+    IdleIoPriority() : previous_(static_cast<int>(syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0))) {
+        if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+                    IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT) != 0) {
+            LOG_WARNING("LuksCryptoShredOverwriteAlgorithm",
+                        std::format("Cannot lower I/O priority: {}", strerror(errno)));
+        }
+    }
+
+    ~IdleIoPriority() {
+        if (previous_ >= 0) {
+            static_cast<void>(syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, previous_));
+        }
+    }
+
+    IdleIoPriority(const IdleIoPriority&) = delete;
+    IdleIoPriority& operator=(const IdleIoPriority&) = delete;
+
+private:
+    int previous_;
+};
+
+}  // namespace
+
+bool LuksCryptoShredOverwriteAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
+                                                const std::atomic<bool>& cancel_flag) {
+    const auto total_passes = get_pass_count();
+    if (!shred(fd, size, callback, cancel_flag, total_passes)) {
+        return false;
+    }
+    LOG_INFO("LuksCryptoShredOverwriteAlgorithm",
+             "Keyslots destroyed; overwriting the device at idle I/O priority");
+
+    const IdleIoPriority idle;
+    overwrite_seed_ = util::Keystream::random_seed();
+    const util::Keystream keystream{overwrite_seed_};
+    std::vector<uint8_t> buffer(static_cast<size_t>(std::min<uint64_t>(BUFFER_SIZE, size)));
+
+    uint64_t written = 0;
+    while (written < size && !cancel_flag.load()) {
+        const auto chunk = std::span{buffer}.first(
+            static_cast<size_t>(std::min<uint64_t>(buffer.size(), size - written)));
+        keystream.fill(written, chunk);
+
+        const auto result = ::pwrite(fd, chunk.data(), chunk.size(), static_cast<off_t>(written));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            LOG_ERROR("LuksCryptoShredOverwriteAlgorithm",
+                      std::format("Overwrite failed at offset {}: {}", written, strerror(errno)));
+            return false;
+        }
+        written += static_cast<uint64_t>(result);
+
+        if (callback) {
+            WipeProgress progress{};
+            progress.bytes_written = written;
+            progress.total_bytes = size;
+            progress.current_pass = 2;
+            progress.total_passes = total_passes;
+            progress.percentage =
+                (static_cast<double>(written) / static_cast<double>(size)) * 100.0;
+            progress.status = "Keys destroyed; overwriting at idle priority...";
+            callback(progress);
+        }
+    }
+
+    return !cancel_flag.load();
+}
+
+bool LuksCryptoShredOverwriteAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
+                                               const std::atomic<bool>& cancel_flag) {
+    if (overwrite_seed_ == 0) {
+        // No overwrite ran in this instance; at least no header may be left
+        return LuksCryptoShredAlgorithm::verify(fd, size, std::move(callback), cancel_flag);
+    }
+    const util::Keystream keystream{overwrite_seed_};
+    return verification::verify_generated(
+        fd, size,
+        [&keystream](uint64_t offset, std::span<uint8_t> out) { keystream.fill(offset, out); },
+        std::move(callback), cancel_flag);
+}
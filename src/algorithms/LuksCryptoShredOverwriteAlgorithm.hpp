@@ -0,0 +1,44 @@
+/**
+ * @file LuksCryptoShredOverwriteAlgorithm.hpp
+ * @brief LUKS crypto-shred followed by a low-priority overwrite of the whole device
+ */
+
+#pragma once
+
+#include "LuksCryptoShredAlgorithm.hpp"
+
+/**
+ * @class LuksCryptoShredOverwriteAlgorithm
+ * @brief Crypto-shred first, then random data over everything
+ *
+ * The first pass destroys every LUKS header and keyslot and checks them, so
+ * the data is unrecoverable within seconds of starting. The second pass
+ * overwrites the whole device with a random keystream at idle I/O
+ * priority, so it only uses bandwidth that other I/O leaves free.
+ * verify() regenerates the keystream and compares it byte for byte.
+ */
+class LuksCryptoShredOverwriteAlgorithm : public LuksCryptoShredAlgorithm {
+public:
+    bool execute(int fd, uint64_t size, ProgressCallback callback,
+                 const std::atomic<bool>& cancel_flag) override;
+
+    std::string get_name() const override { return "LUKS Crypto-Shred + Overwrite"; }
+
+    std::string get_description() const override {
+        return "2-pass: destroys LUKS keyslots at once, then overwrites the device with random "
+               "data at idle I/O priority";
+    }
+
+    int get_pass_count() const override { return 2; }
+
+    // The overwrite pass wears the flash and still misses spare blocks
+    bool is_ssd_compatible() const override { return false; }
+
+    bool verify(int fd, uint64_t size, ProgressCallback callback,
+                const std::atomic<bool>& cancel_flag) override;
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1'024 * 1'024;
+
+    uint64_t overwrite_seed_ = 0;
+};
@@ -0,0 +1,402 @@
+/**
+ * @file LuksHeader.cpp
+ * @brief LUKS1/LUKS2 header decoding for crypto-shredding
+ */
+
+#include "algorithms/LuksHeader.hpp"
+
+#include "util/BlockHolders.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace luks {
+
+namespace {
+
+constexpr std::uint64_t SECTOR = 512;
+
+// LUKS1 on-disk layout (big-endian)
+constexpr std::size_t LUKS1_HEADER_SIZE = 592;
+constexpr std::size_t LUKS1_PAYLOAD_OFFSET = 104;
+constexpr std::size_t LUKS1_KEY_BYTES = 108;
+constexpr std::size_t LUKS1_KEYSLOTS = 208;
+constexpr std::size_t LUKS1_KEYSLOT_SIZE = 48;
+constexpr std::size_t LUKS1_KEYSLOT_COUNT = 8;
+constexpr std::size_t LUKS1_KEYSLOT_MATERIAL = 40;
+constexpr std::size_t LUKS1_KEYSLOT_STRIPES = 44;
+constexpr std::uint32_t LUKS1_MAX_STRIPES = 1U << 20;  // cryptsetup writes 4000
+
+// LUKS2 binary header (big-endian)
+constexpr std::size_t LUKS2_HDR_SIZE = 8;
+constexpr std::size_t LUKS2_HDR_OFFSET = 256;
+
+// Both headers share these
+constexpr std::size_t VERSION = 6;
+constexpr std::size_t UUID = 168;
+constexpr std::size_t UUID_LENGTH = 40;
+
+// Keyslot area assumed when the LUKS2 JSON cannot be read: the default
+// 16 MiB data offset less the two 16 KiB headers
+constexpr std::uint64_t LUKS2_DEFAULT_END = 16ULL << 20;
+
+template <typename T>
+auto load_be(std::span<const std::uint8_t> bytes, std::size_t at) -> T {
+    T value;
+    std::memcpy(&value, bytes.data() + at, sizeof(value));
+    if constexpr (std::endian::native == std::endian::little) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+auto has_magic(std::span<const std::uint8_t> bytes, std::span<const std::uint8_t> magic) -> bool {
+    return bytes.size() >= magic.size() && std::equal(magic.begin(), magic.end(), bytes.begin());
+}
+
+auto read_string(std::span<const std::uint8_t> bytes, std::size_t at, std::size_t length)
+    -> std::string {
+    const auto* begin = reinterpret_cast<const char*>(bytes.data() + at);
+    return {begin, strnlen(begin, length)};
+}
+
+auto round_up(std::uint64_t value, std::uint64_t to) -> std::uint64_t {
+    return (value + to - 1) / to * to;
+}
+
+auto pread_full(int fd, std::uint8_t* buffer, std::size_t length, std::uint64_t offset)
+    -> std::size_t {
+    std::size_t done = 0;
+    while (done < length) {
+        const auto result =
+            ::pread(fd, buffer + done, length - done, static_cast<off_t>(offset + done));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            break;
+        }
+        done += static_cast<std::size_t>(result);
+    }
+    return done;
+}
+
+/**
+ * @brief Unsigned value of "key" in a JSON text, from `from` on; LUKS2 writes sizes as strings
+ */
+auto json_uint(std::string_view json, std::string_view key, std::size_t from = 0)
+    -> std::optional<std::uint64_t> {
+    const auto quoted = std::format("\"{}\"", key);
+    auto pos = json.find(quoted, from);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    pos += quoted.size();
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == ':' || json[pos] == '"' ||
+                                 json[pos] == '\n' || json[pos] == '\t')) {
+        ++pos;
+    }
+    std::uint64_t value = 0;
+    const auto start = pos;
+    for (; pos < json.size() && json[pos] >= '0' && json[pos] <= '9'; ++pos) {
+        value = (value * 10) + static_cast<std::uint64_t>(json[pos] - '0');
+    }
+    return pos == start ? std::nullopt : std::optional{value};
+}
+
+/**
+ * @brief Keep the parts of container-relative regions that lie on the device
+ */
+void add_region(Container& container, std::uint64_t limit, std::uint64_t start,
+                std::uint64_t length, std::string what) {
+    if (start >= limit || length == 0) {
+        return;
+    }
+    container.regions.push_back({.offset = container.offset + start,
+                                 .length = std::min(length, limit - start),
+                                 .what = std::move(what)});
+}
+
+auto parse_luks1(std::span<const std::uint8_t> head, std::uint64_t offset, std::uint64_t limit)
+    -> std::optional<Container> {
+    if (head.size() < LUKS1_HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    Container container{
+        .version = 1, .offset = offset, .uuid = read_string(head, UUID, UUID_LENGTH)};
+    const auto payload = std::uint64_t{load_be<std::uint32_t>(head, LUKS1_PAYLOAD_OFFSET)} * SECTOR;
+    const auto key_bytes = load_be<std::uint32_t>(head, LUKS1_KEY_BYTES);
+    if (payload > 0) {
+        container.data_offset = offset + payload;
+    }
+
+    add_region(container, limit, 0, BINARY_HEADER_SIZE, "LUKS1 header");
+    for (std::size_t slot = 0; slot < LUKS1_KEYSLOT_COUNT; ++slot) {
+        const auto at = LUKS1_KEYSLOTS + (slot * LUKS1_KEYSLOT_SIZE);
+        const auto material =
+            std::uint64_t{load_be<std::uint32_t>(head, at + LUKS1_KEYSLOT_MATERIAL)} * SECTOR;
+        const auto stripes = load_be<std::uint32_t>(head, at + LUKS1_KEYSLOT_STRIPES);
+        // Disabled slots keep their layout; whatever they held goes too
+        if (material < BINARY_HEADER_SIZE || stripes == 0 || stripes > LUKS1_MAX_STRIPES) {
+            continue;
+        }
+        auto length = round_up(std::uint64_t{key_bytes} * stripes, BINARY_HEADER_SIZE);
+        if (payload > material) {
+            length = std::min(length, payload - material);
+        }
+        add_region(container, limit, material, length, std::format("keyslot {}", slot));
+    }
+    return container;
+}
+
+/**
+ * @brief Decode a LUKS2 binary header and JSON area (primary or secondary copy)
+ * @param hdr_size Size of one header copy; the primary starts at offset, the secondary after it
+ */
+auto parse_luks2(std::span<const std::uint8_t> header, std::uint64_t hdr_size,
+                 std::uint64_t offset, std::uint64_t limit) -> Container {
+    Container container{
+        .version = 2, .offset = offset, .uuid = read_string(header, UUID, UUID_LENGTH)};
+
+    add_region(container, limit, 0, hdr_size, "LUKS2 primary header");
+    add_region(container, limit, hdr_size, hdr_size, "LUKS2 secondary header");
+
+    // The JSON area follows the binary header, NUL-terminated
+    std::string_view json;
+    if (header.size() > BINARY_HEADER_SIZE) {
+        const auto area = header.subspan(BINARY_HEADER_SIZE);
+        json = {reinterpret_cast<const char*>(area.data()),
+                strnlen(reinterpret_cast<const char*>(area.data()), area.size())};
+    }
+
+    const auto keyslots_start = 2 * hdr_size;
+    std::uint64_t keyslots_end = keyslots_start;
+    if (const auto size = json_uint(json, "keyslots_size")) {
+        keyslots_end = keyslots_start + *size;
+    }
+    for (auto pos = json.find("\"area\""); pos != std::string_view::npos;
+         pos = json.find("\"area\"", pos + 1)) {
+        const auto object = json.substr(pos, json.find('}', pos) - pos);
+        const auto area_offset = json_uint(object, "offset");
+        const auto area_size = json_uint(object, "size");
+        if (area_offset && area_size) {
+            keyslots_end = std::max(keyslots_end, *area_offset + *area_size);
+        }
+    }
+
+    std::optional<std::uint64_t> data;
+    if (const auto segments = json.find("\"segments\""); segments != std::string_view::npos) {
+        data = json_uint(json, "offset", segments);
+    }
+    if (data && *data > 0) {
+        container.data_offset = offset + *data;
+    }
+
+    if (keyslots_end == keyslots_start) {
+        keyslots_end = data.value_or(LUKS2_DEFAULT_END);
+    }
+    if (data && *data > keyslots_start) {
+        keyslots_end = std::min(keyslots_end, *data);
+    }
+    if (keyslots_end > keyslots_start) {
+        add_region(container, limit, keyslots_start, keyslots_end - keyslots_start,
+                   "LUKS2 keyslots area");
+    }
+    return container;
+}
+
+auto valid_luks2_size(std::uint64_t hdr_size) -> bool {
+    return std::ranges::find(LUKS2_HEADER_SIZES, hdr_size) != LUKS2_HEADER_SIZES.end();
+}
+
+auto read_uint64(const fs::path& path) -> std::optional<std::uint64_t> {
+    std::uint64_t value = 0;
+    if (std::ifstream file{path}; file.is_open() && file >> value) {
+        return value;
+    }
+    return std::nullopt;
+}
+
+auto read_line(const fs::path& path) -> std::string {
+    std::ifstream file{path};
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// The sysfs directory of the block device behind fd
+auto sys_device_dir(int fd) -> std::optional<fs::path> {
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISBLK(st.st_mode)) {
+        return std::nullopt;
+    }
+    std::error_code ec;
+    auto dir = fs::canonical(
+        std::format("/sys/dev/block/{}:{}", major(st.st_rdev), minor(st.st_rdev)), ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return dir;
+}
+
+}  // namespace
+
+auto Container::bytes() const -> std::uint64_t {
+    std::uint64_t total = 0;
+    for (const auto& region : regions) {
+        total += region.length;
+    }
+    return total;
+}
+
+auto parse(std::span<const std::uint8_t> head, std::uint64_t offset, std::uint64_t limit)
+    -> std::optional<Container> {
+    if (!has_magic(head, MAGIC) || head.size() < VERSION + 2) {
+        return std::nullopt;
+    }
+    switch (load_be<std::uint16_t>(head, VERSION)) {
+        case 1:
+            return parse_luks1(head, offset, limit);
+        case 2: {
+            if (head.size() < BINARY_HEADER_SIZE) {
+                return std::nullopt;
+            }
+            const auto hdr_size = load_be<std::uint64_t>(head, LUKS2_HDR_SIZE);
+            if (!valid_luks2_size(hdr_size)) {
+                return std::nullopt;
+            }
+            const auto json_end = std::min<std::uint64_t>(hdr_size, head.size());
+            return parse_luks2(head.first(static_cast<std::size_t>(json_end)), hdr_size, offset,
+                               limit);
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+auto probe(int fd, std::uint64_t offset, std::uint64_t limit) -> std::optional<Container> {
+    std::vector<std::uint8_t> head(
+        static_cast<std::size_t>(std::min<std::uint64_t>(limit, BINARY_HEADER_SIZE)));
+    head.resize(pread_full(fd, head.data(), head.size(), offset));
+
+    if (has_magic(head, MAGIC)) {
+        // Read the whole LUKS2 JSON area before decoding
+        if (head.size() == BINARY_HEADER_SIZE && load_be<std::uint16_t>(head, VERSION) == 2) {
+            const auto hdr_size = load_be<std::uint64_t>(head, LUKS2_HDR_SIZE);
+            if (valid_luks2_size(hdr_size)) {
+                head.resize(static_cast<std::size_t>(std::min(hdr_size, limit)));
+                head.resize(pread_full(fd, head.data(), head.size(), offset));
+            }
+        }
+        if (auto container = parse(head, offset, limit)) {
+            return container;
+        }
+    }
+
+    // A damaged primary: the secondary copy sits right after it and names its own offset
+    std::vector<std::uint8_t> secondary;
+    for (const auto hdr_size : LUKS2_HEADER_SIZES) {
+        if (hdr_size + BINARY_HEADER_SIZE > limit) {
+            break;
+        }
+        secondary.resize(BINARY_HEADER_SIZE);
+        if (pread_full(fd, secondary.data(), secondary.size(), offset + hdr_size) !=
+                secondary.size() ||
+            !has_magic(secondary, SECONDARY_MAGIC) ||
+            load_be<std::uint16_t>(secondary, VERSION) != 2 ||
+            load_be<std::uint64_t>(secondary, LUKS2_HDR_SIZE) != hdr_size ||
+            load_be<std::uint64_t>(secondary, LUKS2_HDR_OFFSET) != hdr_size) {
+            continue;
+        }
+        secondary.resize(static_cast<std::size_t>(std::min(hdr_size, limit - hdr_size)));
+        secondary.resize(pread_full(fd, secondary.data(), secondary.size(), offset + hdr_size));
+        return parse_luks2(secondary, hdr_size, offset, limit);
+    }
+    return std::nullopt;
+}
+
+auto read_partitions(const fs::path& sys_device_dir) -> std::vector<Partition> {
+    std::vector<Partition> partitions;
+    const auto device_name = sys_device_dir.filename().string();
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator{sys_device_dir, ec}) {
+        const auto name = entry.path().filename().string();
+        if (!name.starts_with(device_name) || name == device_name) {
+            continue;
+        }
+        // sysfs counts in 512-byte sectors whatever the logical block size
+        const auto start = read_uint64(entry.path() / "start");
+        const auto size = read_uint64(entry.path() / "size");
+        if (start && size) {
+            partitions.push_back({.name = name, .start = *start * SECTOR, .size = *size * SECTOR});
+        }
+    }
+    std::ranges::sort(partitions, {}, &Partition::start);
+    return partitions;
+}
+
+auto candidate_offsets(int fd) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> offsets = {0};
+
+    const auto sys_dir = sys_device_dir(fd);
+    std::error_code ec;
+    if (!sys_dir || fs::exists(*sys_dir / "partition", ec)) {
+        return offsets;  // A partition has no partitions of its own
+    }
+    for (const auto& partition : read_partitions(*sys_dir)) {
+        offsets.push_back(partition.start);
+    }
+    return offsets;
+}
+
+auto open_mappings(const fs::path& sys_device_dir) -> std::vector<std::string> {
+    std::vector<std::string> mappings;
+    for (const auto& holder : util::dm_holders(sys_device_dir)) {
+        // cryptsetup names its mappings' uuids CRYPT-LUKS1-..., CRYPT-LUKS2-..., CRYPT-PLAIN-...
+        if (read_line(holder / "dm" / "uuid").starts_with("CRYPT-")) {
+            const auto name = read_line(holder / "dm" / "name");
+            mappings.push_back(name.empty() ? holder.filename().string() : name);
+        }
+    }
+    return mappings;
+}
+
+auto open_mappings(int fd) -> std::vector<std::string> {
+    const auto sys_dir = sys_device_dir(fd);
+    return sys_dir ? open_mappings(*sys_dir) : std::vector<std::string>{};
+}
+
+auto find_containers(int fd, std::uint64_t size, std::span<const std::uint64_t> offsets)
+    -> std::vector<Container> {
+    std::vector<Container> containers;
+    for (const auto offset : offsets) {
+        if (offset >= size) {
+            continue;
+        }
+        const bool seen = std::ranges::any_of(
+            containers, [offset](const Container& c) { return c.offset == offset; });
+        if (seen) {
+            continue;
+        }
+        if (auto container = probe(fd, offset, size - offset)) {
+            containers.push_back(std::move(*container));
+        }
+    }
+    return containers;
+}
+
+}  // namespace luks
@@ -0,0 +1,143 @@
+/**
+ * @file LuksHeader.hpp
+ * @brief Locate LUKS1/LUKS2 headers and the keyslot areas they describe
+ *
+ * Everything needed to unlock a LUKS volume lives in a few megabytes at its
+ * start: the binary header(s), the LUKS2 JSON metadata and the keyslot areas
+ * holding the volume key encrypted under each passphrase. Once those bytes
+ * are gone the payload is ciphertext under a key that no longer exists.
+ *
+ * - LUKS1: a 592-byte header (padded here to 4 KiB) and up to 8 keyslots,
+ *   each `key_bytes * stripes` of anti-forensic material at a sector offset
+ *   given in the header.
+ * - LUKS2: a primary and a secondary copy of the binary header plus JSON area
+ *   (`hdr_size` each, 16 KiB to 4 MiB), followed by the keyslots area
+ *   (`config.keyslots_size`, plus any keyslot `area` the JSON names).
+ *
+ * A LUKS2 volume whose primary header was already damaged is still found
+ * through its secondary header.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace luks {
+
+inline constexpr std::array<std::uint8_t, 6> MAGIC = {'L', 'U', 'K', 'S', 0xBA, 0xBE};
+inline constexpr std::array<std::uint8_t, 6> SECONDARY_MAGIC = {'S', 'K', 'U', 'L', 0xBA, 0xBE};
+
+// LUKS2 binary header; the LUKS1 header fits in it too
+inline constexpr std::size_t BINARY_HEADER_SIZE = 4'096;
+
+// Where a LUKS2 secondary header may start (the valid hdr_size values)
+inline constexpr std::array<std::uint64_t, 9> LUKS2_HEADER_SIZES = {
+    16ULL << 10,  32ULL << 10,  64ULL << 10, 128ULL << 10, 256ULL << 10,
+    512ULL << 10, 1ULL << 20,   2ULL << 20,  4ULL << 20};
+
+/**
+ * @brief A byte range that must be destroyed, as device offsets
+ */
+struct Region {
+    std::uint64_t offset = 0;
+    std::uint64_t length = 0;
+    std::string what;  // e.g. "LUKS2 secondary header", "keyslot 3"
+};
+
+/**
+ * @brief One LUKS volume found on the device
+ */
+struct Container {
+    int version = 0;                // 1 or 2
+    std::uint64_t offset = 0;       // Device offset of the volume's first byte
+    std::string uuid{};
+    std::vector<Region> regions{};  // Headers and keyslots, sorted by offset
+    std::uint64_t data_offset = 0;  // Device offset of the encrypted payload, 0 if unknown
+
+    [[nodiscard]] auto bytes() const -> std::uint64_t;
+};
+
+/**
+ * @brief Decode the LUKS volume whose first bytes are `head`
+ *
+ * @param head The volume's first bytes: at least BINARY_HEADER_SIZE, and for
+ *             LUKS2 ideally the whole primary header and JSON area
+ * @param offset Device offset of head[0]; regions are reported relative to the device
+ * @param limit Bytes from offset to the end of the device; regions are clipped to it
+ * @return The volume, or nullopt if head does not start with a LUKS header
+ */
+[[nodiscard]] auto parse(std::span<const std::uint8_t> head, std::uint64_t offset,
+                         std::uint64_t limit) -> std::optional<Container>;
+
+/**
+ * @brief Read and decode a LUKS volume starting at a device offset
+ *
+ * Falls back to the LUKS2 secondary header when the primary is not intact.
+ *
+ * @param fd File descriptor opened for reading
+ * @param offset Device offset to look at
+ * @param limit Bytes from offset to the end of the device
+ */
+[[nodiscard]] auto probe(int fd, std::uint64_t offset, std::uint64_t limit)
+    -> std::optional<Container>;
+
+/**
+ * @brief A partition of a whole-disk block device
+ */
+struct Partition {
+    std::string name;
+    std::uint64_t start = 0;  // Bytes
+    std::uint64_t size = 0;   // Bytes
+};
+
+/**
+ * @brief Partitions listed in a sysfs block device directory
+ *
+ * Children named after the device (sda1, nvme0n1p2) with a `start`
+ * attribute, as DiskService finds partition holders.
+ *
+ * @param sys_device_dir e.g. /sys/block/sda
+ */
+[[nodiscard]] auto read_partitions(const std::filesystem::path& sys_device_dir)
+    -> std::vector<Partition>;
+
+/**
+ * @brief Device offsets worth probing: the start of the device and of each partition
+ * @param fd The device; partitions are only listed for whole-disk block devices
+ */
+[[nodiscard]] auto candidate_offsets(int fd) -> std::vector<std::uint64_t>;
+
+/**
+ * @brief dm-crypt mappings open on a device or any of its partitions
+ *
+ * While a mapping is open the kernel holds the volume key, and the data
+ * stays readable through it however thoroughly the headers are destroyed.
+ *
+ * @param sys_device_dir e.g. /sys/block/sda
+ * @return Mapping names (dm/name), or dm-N where the name is unreadable
+ */
+[[nodiscard]] auto open_mappings(const std::filesystem::path& sys_device_dir)
+    -> std::vector<std::string>;
+
+/**
+ * @brief open_mappings() for the block device behind fd; empty for other files
+ */
+[[nodiscard]] auto open_mappings(int fd) -> std::vector<std::string>;
+
+/**
+ * @brief Every LUKS volume starting at one of `offsets`
+ * @param fd File descriptor opened for reading
+ * @param size Device size in bytes
+ */
+[[nodiscard]] auto find_containers(int fd, std::uint64_t size,
+                                   std::span<const std::uint64_t> offsets)
+    -> std::vector<Container>;
+
+}  // namespace luks
@@ -0,0 +1,166 @@
+#include "algorithms/PassSequenceAlgorithm.hpp"
+
+#include "algorithms/AdaptiveWriter.hpp"
+#include "algorithms/TaggedVerification.hpp"
+#include "algorithms/VerificationHelper.hpp"
+#include "models/WipeTypes.hpp"
+#include "util/ByteKernels.hpp"
+#include "util/FileDescriptor.hpp"
+#include "util/Keystream.hpp"
+#include "util/Logger.hpp"
+#include "util/TaggedBlock.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+
+bool PassSequenceAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
+                                    const std::atomic<bool>& cancel_flag) {
+    const auto sequence = passes();
+    if (sequence.empty() || sequence.front().kind == WipePass::Kind::COMPLEMENT) {
+        return false;
+    }
+
+    seeds_.assign(sequence.size(), 0);
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        if (sequence[i].kind == WipePass::Kind::RANDOM ||
+            sequence[i].kind == WipePass::Kind::TAGGED) {
+            seeds_[i] = util::Keystream::random_seed();
+        }
+    }
+
+    // Handle zero-size case
+    if (size == 0) {
+        return true;
+    }
+
+    for (size_t pass = 0; pass < sequence.size(); ++pass) {
+        if (pass > 0 && lseek(fd, 0, SEEK_SET) == -1) {
+            return false;
+        }
+        if (!write_pass(fd, size, pass, callback, cancel_flag)) {
+            return false;
+        }
+
+        if (sequence[pass].kind == WipePass::Kind::TAGGED && pass + 1 < sequence.size()) {
+            // The wipe fd is write-only; read through a second open of the same device
+            util::FileDescriptor reader(
+                open(std::format("/proc/self/fd/{}", fd).c_str(), O_RDONLY | O_CLOEXEC));
+            if (!reader) {
+                LOG_ERROR("PassSequenceAlgorithm",
+                          "Cannot reopen the device to read the tagged pass back");
+                return false;
+            }
+            if (!check_tagged(reader.get(), size, seeds_[pass], callback, cancel_flag)) {
+                return false;
+            }
+        }
+    }
+
+    return !cancel_flag.load();
+}
+
+void PassSequenceAlgorithm::generate(size_t pass, uint64_t offset, std::span<uint8_t> out) const {
+    const auto& spec = passes()[pass];
+    switch (spec.kind) {
+        case WipePass::Kind::CHARACTER:
+            std::memset(out.data(), spec.character, out.size());
+            return;
+        case WipePass::Kind::RANDOM:
+            util::Keystream{seeds_[pass]}.fill(offset, out);
+            return;
+        case WipePass::Kind::COMPLEMENT:
+            // execute() rejects a leading COMPLEMENT, so pass > 0 here
+            generate(pass - 1, offset, out);
+            util::complement(out);
+            return;
+        case WipePass::Kind::TAGGED:
+            util::fill_tagged(seeds_[pass], offset, out);
+            return;
+    }
+}
+
+bool PassSequenceAlgorithm::write_pass(int fd, uint64_t size, size_t pass,
+                                       const ProgressCallback& callback,
+                                       const std::atomic<bool>& cancel_flag) {
+    const auto total_passes = get_pass_count();
+    const auto pass_number = static_cast<int>(pass) + 1;
+    const bool constant = passes()[pass].kind == WipePass::Kind::CHARACTER;
+
+    auto data = [this, pass](uint64_t offset, std::span<uint8_t> out) {
+        generate(pass, offset, out);
+    };
+    auto report = [&](uint64_t written) {
+        if (callback) {
+            WipeProgress progress{};
+            progress.bytes_written = written;
+            progress.total_bytes = size;
+            progress.current_pass = pass_number;
+            progress.total_passes = total_passes;
+            progress.percentage =
+                (static_cast<double>(written) / static_cast<double>(size)) * 100.0;
+            progress.status =
+                std::format("Writing pattern (Pass {}/{})", pass_number, total_passes);
+            callback(progress);
+        }
+    };
+
+    return write_stream(fd, size, data, constant, report, cancel_flag);
+}
+
+bool PassSequenceAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
+                                   const std::atomic<bool>& cancel_flag) {
+    const auto sequence = passes();
+    if (sequence.empty()) {
+        return false;
+    }
+
+    const auto last = sequence.size() - 1;
+    const bool have_seeds = seeds_.size() == sequence.size();
+    if (sequence[last].kind == WipePass::Kind::TAGGED) {
+        return check_tagged(fd, size, have_seeds ? std::optional{seeds_[last]} : std::nullopt,
+                            std::move(callback), cancel_flag);
+    }
+
+    if (have_seeds) {
+        // Regenerate exactly what the last pass wrote
+        return verification::verify_generated(
+            fd, size,
+            [this, last](uint64_t offset, std::span<uint8_t> out) {
+                generate(last, offset, out);
+            },
+            std::move(callback), cancel_flag);
+    }
+
+    // No wipe ran on this instance: check the kind of data the last pass leaves
+    size_t source = last;
+    uint8_t inversion = 0x00;
+    while (source > 0 && sequence[source].kind == WipePass::Kind::COMPLEMENT) {
+        inversion ^= 0xFF;
+        --source;
+    }
+    if (sequence[source].kind == WipePass::Kind::CHARACTER) {
+        return verification::verify_pattern(
+            fd, size, static_cast<uint8_t>(sequence[source].character ^ inversion),
+            std::move(callback), cancel_flag);
+    }
+    return verification::verify_random(fd, size, std::move(callback), cancel_flag);
+}
+
+bool PassSequenceAlgorithm::check_tagged(int fd, uint64_t size, std::optional<uint64_t> job_id,
+                                         ProgressCallback callback,
+                                         const std::atomic<bool>& cancel_flag) const {
+    const auto verdict =
+        verification::verify_tagged(fd, size, job_id, std::move(callback), cancel_flag);
+    if (verdict.passed) {
+        LOG_INFO("PassSequenceAlgorithm",
+                 std::format("Tagged pass verified: {}", verdict.detail));
+    } else {
+        LOG_ERROR("PassSequenceAlgorithm",
+                  std::format("Tagged pass verification failed: {}", verdict.detail));
+    }
+    return verdict.passed;
+}
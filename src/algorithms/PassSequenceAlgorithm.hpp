@@ -0,0 +1,87 @@
+/**
+ * @file PassSequenceAlgorithm.hpp
+ * @brief Base for standards defined as a list of character, random, complement and tagged passes
+ */
+
+#pragma once
+
+#include "IWipeAlgorithm.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * @brief One overwrite pass
+ */
+struct WipePass {
+    enum class Kind : uint8_t {
+        CHARACTER,  ///< Every byte is `character`
+        RANDOM,     ///< Keystream from a seed drawn when the wipe starts
+        COMPLEMENT,  ///< Bitwise complement of whatever the previous pass wrote
+        TAGGED       ///< Blocks that record their address and the job (util/TaggedBlock.hpp)
+    };
+
+    Kind kind = Kind::CHARACTER;
+    uint8_t character = 0x00;  // CHARACTER only
+};
+
+/**
+ * @class PassSequenceAlgorithm
+ * @brief Runs a fixed sequence of WipePass over the whole device
+ *
+ * Random passes come from util::Keystream, which can regenerate any block
+ * from its seed. A COMPLEMENT pass therefore rebuilds the previous pass block
+ * by block and inverts it, instead of reading back or storing the device's
+ * worth of random data, and verify() compares the last pass byte for byte.
+ *
+ * A TAGGED pass is checked by reading every block back. When it is the last
+ * pass that is what verify() does; when more passes follow, execute() reads
+ * it back before overwriting it and fails if any block is bad, so a drive
+ * that drops, misdirects or wraps writes is caught before the final pass.
+ *
+ * The seeds of the most recent execute() are kept for verify(); an instance
+ * must not run two wipes at once.
+ */
+class PassSequenceAlgorithm : public IWipeAlgorithm {
+public:
+    bool execute(int fd, uint64_t size, ProgressCallback callback,
+                 const std::atomic<bool>& cancel_flag) override;
+
+    int get_pass_count() const override { return static_cast<int>(passes().size()); }
+
+    bool is_ssd_compatible() const override { return false; }
+
+    bool supports_verification() const override { return true; }
+
+    bool verify(int fd, uint64_t size, ProgressCallback callback,
+                const std::atomic<bool>& cancel_flag) override;
+
+protected:
+    /**
+     * @brief The standard's passes, in order; the first may not be COMPLEMENT
+     */
+    [[nodiscard]] virtual auto passes() const -> std::span<const WipePass> = 0;
+
+private:
+    /**
+     * @brief Data pass `pass` writes at [offset, offset + out.size())
+     */
+    void generate(size_t pass, uint64_t offset, std::span<uint8_t> out) const;
+
+    bool write_pass(int fd, uint64_t size, size_t pass, const ProgressCallback& callback,
+                    const std::atomic<bool>& cancel_flag);
+
+    /**
+     * @brief Read a TAGGED pass back and log the verdict
+     * @param job_id The pass's job id, or empty to accept the one found on disk
+     */
+    bool check_tagged(int fd, uint64_t size, std::optional<uint64_t> job_id,
+                      ProgressCallback callback, const std::atomic<bool>& cancel_flag) const;
+
+    // Per pass of the last execute(): the keystream seed of RANDOM passes and
+    // the job id of TAGGED ones
+    std::vector<uint64_t> seeds_;
+};
@@ -0,0 +1,128 @@
+/**
+ * @file PipelinedScan.hpp
+ * @brief Sequential device read with the inspection of each chunk overlapped
+ *
+ * Internal to the verification and residual-scan implementations.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Executor.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+namespace verification::detail {
+
+inline constexpr size_t VERIFY_BUFFER_SIZE = 1'024 * 1'024;  // 1MB buffer
+
+/**
+ * @brief Read with retry on EINTR
+ */
+inline auto read_with_retry(int fd, void* buf, size_t count) -> ssize_t {
+    while (true) {
+        ssize_t result = ::read(fd, buf, count);
+        if (result >= 0 || errno != EINTR) {
+            return result;
+        }
+    }
+}
+
+/**
+ * @brief Emit verification progress
+ */
+inline void emit_progress(ProgressCallback& callback, uint64_t verified, uint64_t total,
+                          const char* status = "Verifying...") {
+    if (!callback)
+        return;
+
+    WipeProgress progress{};
+    progress.verification_in_progress = true;
+    progress.verification_percentage =
+        (static_cast<double>(verified) / static_cast<double>(total)) * 100.0;
+    progress.bytes_written = verified;
+    progress.total_bytes = total;
+    progress.percentage = progress.verification_percentage;
+    progress.status = status;
+    callback(progress);
+}
+
+enum class ScanOutcome { COMPLETE, STOPPED, READ_ERROR, CANCELLED };
+
+/**
+ * @brief Read the device sequentially, inspecting each chunk on the executor
+ *
+ * While chunk N is inspected on a compute worker, chunk N+1 is read into the
+ * other buffer, so compare/histogram cost overlaps device latency. Chunks are
+ * inspected strictly in order, one at a time, so inspect() needs no locking.
+ *
+ * @param inspect bool(const uint8_t* data, size_t len, uint64_t offset);
+ *        return false to stop the scan (e.g. on mismatch)
+ * @param buffer_size Bytes per read
+ * @param status Progress status text
+ */
+template <typename Inspect>
+auto pipelined_scan(int fd, uint64_t size, ProgressCallback& callback,
+                    const std::atomic<bool>& cancel_flag, Inspect&& inspect,
+                    std::size_t buffer_size = VERIFY_BUFFER_SIZE,
+                    const char* status = "Verifying...") -> ScanOutcome {
+    auto& executor = util::Executor::shared();
+    std::array<std::vector<uint8_t>, 2> buffers{std::vector<uint8_t>(buffer_size),
+                                                std::vector<uint8_t>(buffer_size)};
+    std::future<bool> in_flight;
+    uint64_t in_flight_end = 0;
+    uint64_t read_total = 0;
+    std::size_t current = 0;
+
+    // Wait for the chunk being inspected and report it as verified
+    auto settle = [&]() -> bool {
+        if (!in_flight.valid()) {
+            return true;
+        }
+        const bool ok = in_flight.get();
+        if (ok) {
+            emit_progress(callback, in_flight_end, size, status);
+        }
+        return ok;
+    };
+
+    while (read_total < size && !cancel_flag.load()) {
+        auto& buffer = buffers[current];
+        size_t to_read = std::min(static_cast<uint64_t>(buffer.size()), size - read_total);
+        ssize_t bytes_read = read_with_retry(fd, buffer.data(), to_read);
+
+        if (bytes_read <= 0) {
+            static_cast<void>(settle());
+            return ScanOutcome::READ_ERROR;
+        }
+        if (!settle()) {
+            return ScanOutcome::STOPPED;
+        }
+
+        in_flight = executor.submit(
+            [&inspect, &buffer, length = static_cast<size_t>(bytes_read), offset = read_total] {
+                return inspect(buffer.data(), length, offset);
+            },
+            util::TaskPriority::BULK);
+        read_total += static_cast<uint64_t>(bytes_read);
+        in_flight_end = read_total;
+        current ^= 1;
+    }
+
+    if (!settle()) {
+        return ScanOutcome::STOPPED;
+    }
+    return cancel_flag.load() ? ScanOutcome::CANCELLED : ScanOutcome::COMPLETE;
+}
+
+
+}  // namespace verification::detail
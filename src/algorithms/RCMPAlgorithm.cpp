@@ -0,0 +1,23 @@
+#include "algorithms/RCMPAlgorithm.hpp"
+
+#include <array>
+
+namespace {
+
+using Kind = WipePass::Kind;
+
+constexpr std::array PASSES = {
+    WipePass{.kind = Kind::CHARACTER, .character = 0x00},
+    WipePass{.kind = Kind::COMPLEMENT, .character = 0x00},
+    WipePass{.kind = Kind::CHARACTER, .character = 0x00},
+    WipePass{.kind = Kind::COMPLEMENT, .character = 0x00},
+    WipePass{.kind = Kind::CHARACTER, .character = 0x00},
+    WipePass{.kind = Kind::COMPLEMENT, .character = 0x00},
+    WipePass{.kind = Kind::RANDOM, .character = 0x00},
+};
+
+}  // namespace
+
+auto RCMPAlgorithm::passes() const -> std::span<const WipePass> {
+    return PASSES;
+}
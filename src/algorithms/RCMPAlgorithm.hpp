@@ -0,0 +1,24 @@
+/**
+ * @file RCMPAlgorithm.hpp
+ * @brief Royal Canadian Mounted Police TSSIT OPS-II wipe algorithm
+ */
+
+#pragma once
+
+#include "PassSequenceAlgorithm.hpp"
+
+/**
+ * @class RCMPAlgorithm
+ * @brief RCMP TSSIT OPS-II: zeros and their complement three times, then random data
+ */
+class RCMPAlgorithm : public PassSequenceAlgorithm {
+public:
+    std::string get_name() const override { return "RCMP TSSIT OPS-II"; }
+
+    std::string get_description() const override {
+        return "Royal Canadian Mounted Police 7-pass standard";
+    }
+
+protected:
+    auto passes() const -> std::span<const WipePass> override;
+};
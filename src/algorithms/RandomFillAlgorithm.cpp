@@ -1,12 +1,12 @@
 #include "algorithms/RandomFillAlgorithm.hpp"
 
+#include "algorithms/AdaptiveWriter.hpp"
 #include "algorithms/VerificationHelper.hpp"
 #include "models/WipeTypes.hpp"
-#include "util/RandomBuffer.hpp"
-#include "util/WriteHelpers.hpp"
+#include "util/RandomStream.hpp"
 
 #include <algorithm>
-#include <vector>
+#include <cstring>
 
 bool RandomFillAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
                                   const std::atomic<bool>& cancel_flag) {
@@ -15,22 +15,16 @@ bool RandomFillAlgorithm::execute(int fd, uint64_t size, ProgressCallback callba
         return true;
     }
 
-    std::vector<uint8_t> buffer(BUFFER_SIZE);
-    uint64_t written = 0;
-
-    while (written < size && !cancel_flag.load()) {
-        // Generate fresh random data for each buffer efficiently
-        util::RandomBufferGenerator::fill(buffer);
-
-        size_t to_write = std::min(static_cast<uint64_t>(BUFFER_SIZE), size - written);
-        ssize_t result = util::write_with_retry(fd, buffer.data(), to_write);
-
-        if (result <= 0) {
-            return false;
+    // Next buffer is generated on the executor while the current one is copied out;
+    // a request larger than a buffer takes several
+    util::RandomStream random{BUFFER_SIZE};
+    auto random_data = [&random](uint64_t /*offset*/, std::span<uint8_t> out) {
+        for (std::size_t pos = 0; pos < out.size(); pos += BUFFER_SIZE) {
+            const auto& buffer = random.next();
+            std::memcpy(out.data() + pos, buffer.data(), std::min(BUFFER_SIZE, out.size() - pos));
         }
-
-        written += static_cast<uint64_t>(result);
-
+    };
+    auto report = [&](uint64_t written) {
         if (callback) {
             WipeProgress progress{};
             progress.bytes_written = written;
@@ -42,9 +36,9 @@ bool RandomFillAlgorithm::execute(int fd, uint64_t size, ProgressCallback callba
             progress.status = "Writing random data...";
             callback(progress);
         }
-    }
+    };
 
-    return !cancel_flag.load();
+    return write_stream(fd, size, random_data, false, report, cancel_flag);
 }
 
 bool RandomFillAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
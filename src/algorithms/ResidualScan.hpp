@@ -0,0 +1,143 @@
+/**
+ * @file ResidualScan.hpp
+ * @brief Search a device for recognisable leftovers of earlier data
+ *
+ * Used after a wipe, or before accepting a "new" drive, to find filesystem
+ * superblocks, file headers, private-key markers and caller-supplied byte
+ * strings. The device is read once, sequentially, in large chunks; a
+ * vectorised byte-pair prefilter keeps the search close to read speed.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Result.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace verification {
+
+/**
+ * @brief A byte string to look for
+ *
+ * Filesystem structures and file headers begin on sector boundaries, so
+ * anchored signatures are only tested at sector_offset within each 512-byte
+ * sector. That keeps short magics from matching by chance in random data.
+ */
+struct Signature {
+    std::string name;
+    std::vector<uint8_t> bytes;
+    bool anchored = false;
+    uint32_t sector_offset = 0;  // Anchored only; < SECTOR_SIZE
+};
+
+inline constexpr uint32_t SECTOR_SIZE = 512;
+
+/**
+ * @brief Built-in signatures: filesystem and volume headers, common file
+ *        formats, and PEM/OpenSSH/PGP private-key markers
+ */
+[[nodiscard]] auto default_signatures() -> std::vector<Signature>;
+
+/**
+ * @brief Parse a user pattern: "hex:4d5a9000" for raw bytes, anything else as text
+ * @return Unanchored signature, or an error for bad hex or fewer than two bytes
+ */
+[[nodiscard]] auto parse_signature(std::string_view spec) -> std::expected<Signature, util::Error>;
+
+/**
+ * @class SignatureSet
+ * @brief Multi-pattern matcher over a stream of chunks
+ *
+ * Unanchored signatures are found with a packed-pair prefilter: 16 bytes at
+ * a time are compared against the first two bytes of every signature, and
+ * only positions where a pair matches are checked in full. Anchored
+ * signatures are checked at their fixed position in each sector.
+ */
+class SignatureSet {
+public:
+    using MatchFn = std::function<void(uint64_t offset, std::size_t signature)>;
+
+    explicit SignatureSet(std::vector<Signature> signatures);
+
+    [[nodiscard]] auto signatures() const noexcept -> const std::vector<Signature>& {
+        return signatures_;
+    }
+
+    /**
+     * @brief Longest signature length; chunks overlap by one byte less
+     */
+    [[nodiscard]] auto max_length() const noexcept -> std::size_t { return max_length_; }
+
+    /**
+     * @brief Report every match that lies entirely inside data
+     * @param data Bytes at device offset base
+     * @param min_end Only report matches ending past this many bytes into data
+     *        (used to skip matches already found in the previous chunk)
+     */
+    void find(std::span<const uint8_t> data, uint64_t base, std::size_t min_end,
+              const MatchFn& on_match) const;
+
+private:
+    struct Pair {
+        uint8_t first;
+        uint8_t second;
+        std::vector<std::size_t> members;  // Unanchored signatures starting with this pair
+    };
+
+    void find_anchored(std::span<const uint8_t> data, uint64_t base, std::size_t min_end,
+                       const MatchFn& on_match) const;
+    void find_unanchored(std::span<const uint8_t> data, uint64_t base, std::size_t min_end,
+                         const MatchFn& on_match) const;
+    void check_position(std::span<const uint8_t> data, std::size_t pos, uint64_t base,
+                        std::size_t min_end, const MatchFn& on_match) const;
+
+    std::vector<Signature> signatures_;
+    std::vector<std::size_t> anchored_;
+    std::vector<Pair> pairs_;
+    std::size_t max_length_ = 0;
+};
+
+/**
+ * @brief One match
+ */
+struct ResidualHit {
+    uint64_t offset = 0;
+    std::size_t signature = 0;  // Index into SignatureSet::signatures()
+};
+
+/**
+ * @brief What a scan found
+ */
+struct ResidualScanReport {
+    std::vector<uint64_t> counts;   // Matches per signature
+    std::vector<ResidualHit> hits;  // The first MAX_REPORTED_HITS matches, by offset
+    uint64_t total_hits = 0;
+    uint64_t bytes_scanned = 0;
+    bool complete = false;  // False on read error or cancellation
+};
+
+inline constexpr std::size_t MAX_REPORTED_HITS = 1'000;
+
+/**
+ * @brief Read the whole device and search it
+ * @param fd File descriptor (opened for reading)
+ * @param size Device size in bytes
+ * @param signatures Signatures to look for
+ * @param callback Progress callback (verification fields are used for scan progress)
+ * @param cancel_flag Cancellation flag
+ */
+[[nodiscard]] auto scan_residual_data(int fd, uint64_t size, const SignatureSet& signatures,
+                                      ProgressCallback callback,
+                                      const std::atomic<bool>& cancel_flag)
+    -> ResidualScanReport;
+
+}  // namespace verification
@@ -0,0 +1,300 @@
+/**
+ * @file SampledVerification.cpp
+ * @brief Seconds-long readback check for hardware erases
+ */
+
+#include "algorithms/SampledVerification.hpp"
+
+#include "util/Executor.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <format>
+#include <future>
+#include <mutex>
+#include <random>
+
+namespace verification {
+
+namespace {
+
+// Shannon entropy (bits per byte) above which a block counts as random. A
+// 64 KiB block of random data scores ~7.997, a 4 KiB block ~7.95.
+constexpr double HIGH_ENTROPY_BITS = 7.5;
+
+constexpr uint64_t FNV_OFFSET = 0xCBF2'9CE4'8422'2325ULL;
+constexpr uint64_t FNV_PRIME = 0x0000'0100'0000'01B3ULL;
+
+auto digest(std::span<const uint8_t> block) -> uint64_t {
+    uint64_t hash = FNV_OFFSET;
+    for (const auto byte : block) {
+        hash = (hash ^ byte) * FNV_PRIME;
+    }
+    return hash;
+}
+
+auto read_fully(int fd, uint8_t* buffer, std::size_t length, uint64_t offset) -> bool {
+    std::size_t done = 0;
+    while (done < length) {
+        const auto result =
+            pread(fd, buffer + done, length - done, static_cast<off_t>(offset + done));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        done += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+auto is_blank(FillPattern pattern) -> bool {
+    return pattern == FillPattern::ZEROS || pattern == FillPattern::ONES;
+}
+
+}  // namespace
+
+auto fill_pattern_name(FillPattern pattern) -> std::string_view {
+    switch (pattern) {
+        case FillPattern::ZEROS:
+            return "0x00";
+        case FillPattern::ONES:
+            return "0xFF";
+        case FillPattern::HIGH_ENTROPY:
+            return "high-entropy data";
+        case FillPattern::OTHER:
+            return "unrecognised data";
+    }
+    return "unknown";
+}
+
+auto plan_sample_offsets(uint64_t size, std::size_t count, std::size_t block_bytes, uint64_t seed)
+    -> std::vector<uint64_t> {
+    std::vector<uint64_t> offsets;
+    if (size == 0 || count == 0 || block_bytes == 0) {
+        return offsets;
+    }
+
+    const uint64_t blocks = (size + block_bytes - 1) / block_bytes;
+    if (blocks <= count) {
+        offsets.reserve(static_cast<std::size_t>(blocks));
+        for (uint64_t block = 0; block < blocks; ++block) {
+            offsets.push_back(block * block_bytes);
+        }
+        return offsets;
+    }
+
+    // Both ends are where a half-done erase most often shows
+    offsets.reserve(count);
+    offsets.push_back(0);
+
+    std::mt19937_64 random{seed};
+    const std::size_t strata = count >= 2 ? count - 2 : 0;
+    const uint64_t inner = blocks - 2;
+    for (std::size_t i = 0; i < strata; ++i) {
+        const uint64_t first = 1 + (inner * i / strata);
+        const uint64_t last = 1 + (inner * (i + 1) / strata);  // Exclusive
+        std::uniform_int_distribution<uint64_t> pick{first, last - 1};
+        offsets.push_back(pick(random) * block_bytes);
+    }
+
+    if (count >= 2) {
+        offsets.push_back((blocks - 1) * block_bytes);
+    }
+    return offsets;
+}
+
+auto classify_fill(std::span<const uint8_t> block) -> FillPattern {
+    if (block.empty()) {
+        return FillPattern::OTHER;
+    }
+
+    std::array<uint32_t, 256> counts{};
+    for (const auto byte : block) {
+        ++counts[byte];
+    }
+    if (counts[0x00] == block.size()) {
+        return FillPattern::ZEROS;
+    }
+    if (counts[0xFF] == block.size()) {
+        return FillPattern::ONES;
+    }
+
+    const auto total = static_cast<double>(block.size());
+    double entropy = 0.0;
+    for (const auto count : counts) {
+        if (count != 0) {
+            const double p = count / total;
+            entropy -= p * std::log2(p);
+        }
+    }
+    return entropy >= HIGH_ENTROPY_BITS ? FillPattern::HIGH_ENTROPY : FillPattern::OTHER;
+}
+
+auto take_samples(int fd, uint64_t size, std::span<const uint64_t> offsets,
+                  std::size_t block_bytes, const std::atomic<bool>& cancel_flag,
+                  const std::function<void(std::size_t done)>& on_progress)
+    -> std::vector<Sample> {
+    if (offsets.empty() || block_bytes == 0) {
+        return {};
+    }
+
+    // Cached pages from before an erase would hide what the media now holds
+    static_cast<void>(posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED));
+
+    std::vector<Sample> samples(offsets.size());
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex progress_mutex;
+    std::size_t done = 0;
+
+    auto worker = [&] {
+        std::vector<uint8_t> buffer(block_bytes);
+        for (auto i = next.fetch_add(1); i < offsets.size(); i = next.fetch_add(1)) {
+            if (failed.load() || cancel_flag.load()) {
+                return;
+            }
+            const auto offset = offsets[i];
+            const auto length =
+                static_cast<std::size_t>(std::min<uint64_t>(block_bytes, size - offset));
+            if (offset >= size || !read_fully(fd, buffer.data(), length, offset)) {
+                failed.store(true);
+                return;
+            }
+            const auto block = std::span{buffer}.first(length);
+            samples[i] = Sample{.offset = offset,
+                                .length = static_cast<uint32_t>(length),
+                                .digest = digest(block),
+                                .pattern = classify_fill(block)};
+            if (on_progress) {
+                std::lock_guard lock{progress_mutex};
+                on_progress(++done);
+            }
+        }
+    };
+
+    // Readers on the executor's blocking-I/O lane, at most one per I/O thread; the
+    // calling thread reads too, so this completes even when the lane is busy
+    auto& executor = util::Executor::shared();
+    const auto depth =
+        std::min({SAMPLE_QUEUE_DEPTH, offsets.size(), executor.io_threads() + 1});
+    std::vector<std::future<void>> readers;
+    readers.reserve(depth - 1);
+    for (std::size_t i = 1; i < depth; ++i) {
+        readers.push_back(
+            executor.submit(worker, util::TaskPriority::BULK, util::TaskLane::BLOCKING_IO));
+    }
+    worker();
+    for (auto& reader : readers) {
+        reader.get();
+    }
+
+    if (failed.load() || cancel_flag.load()) {
+        return {};
+    }
+    return samples;
+}
+
+auto judge_erase(std::span<const Sample> before, std::span<const Sample> after)
+    -> SampledVerdict {
+    SampledVerdict verdict{};
+    verdict.samples = after.size();
+    if (after.empty()) {
+        verdict.detail = "No samples could be read back";
+        return verdict;
+    }
+
+    verdict.pattern = after.front().pattern;
+    for (const auto& sample : after) {
+        if (sample.pattern != verdict.pattern) {
+            ++verdict.inconsistent;
+        }
+    }
+
+    // Pre-erase samples only count when they cover the same blocks
+    const bool comparable =
+        before.size() == after.size() &&
+        std::ranges::equal(before, after, [](const Sample& a, const Sample& b) {
+            return a.offset == b.offset && a.length == b.length;
+        });
+    if (comparable) {
+        for (std::size_t i = 0; i < after.size(); ++i) {
+            if (is_blank(before[i].pattern)) {
+                ++verdict.blank_before;
+            } else if (before[i].digest == after[i].digest) {
+                ++verdict.unchanged;
+            }
+        }
+    }
+
+    if (verdict.pattern == FillPattern::OTHER) {
+        verdict.detail = std::format("Sampled blocks hold {}, not an erase fill",
+                                     fill_pattern_name(verdict.pattern));
+    } else if (verdict.inconsistent != 0) {
+        verdict.detail = std::format("{} of {} samples do not read back as {}",
+                                     verdict.inconsistent, verdict.samples,
+                                     fill_pattern_name(verdict.pattern));
+    } else if (verdict.unchanged != 0) {
+        verdict.detail = std::format("{} of {} samples are unchanged since before the erase",
+                                     verdict.unchanged, verdict.samples);
+    } else if (verdict.pattern == FillPattern::HIGH_ENTROPY && !comparable) {
+        // Encrypted data nobody erased looks exactly like what a crypto erase leaves
+        verdict.inconclusive = true;
+        verdict.detail = std::format(
+            "{} samples read back as {}, but without pre-erase samples a crypto erase "
+            "cannot be told from data that was never erased",
+            verdict.samples, fill_pattern_name(verdict.pattern));
+    } else {
+        verdict.passed = true;
+        verdict.detail = std::format("{} samples read back as {}", verdict.samples,
+                                     fill_pattern_name(verdict.pattern));
+        if (!comparable) {
+            verdict.detail += "; no pre-erase samples to compare";
+        } else if (verdict.blank_before != 0) {
+            verdict.detail +=
+                std::format("; {} were already blank before the erase", verdict.blank_before);
+        }
+    }
+    return verdict;
+}
+
+auto verify_erase_sampled(int fd, uint64_t size, std::span<const Sample> before,
+                          ProgressCallback callback, const std::atomic<bool>& cancel_flag)
+    -> SampledVerdict {
+    std::vector<uint64_t> offsets;
+    std::size_t block_bytes = SAMPLE_BYTES;
+    if (before.empty()) {
+        offsets = plan_sample_offsets(size, SAMPLE_COUNT, SAMPLE_BYTES, std::random_device{}());
+    } else {
+        // Full-length samples carry the block size; only the device's last block is short
+        block_bytes = std::ranges::max(before, {}, &Sample::length).length;
+        offsets.reserve(before.size());
+        for (const auto& sample : before) {
+            offsets.push_back(sample.offset);
+        }
+    }
+
+    auto on_progress = [&](std::size_t done) {
+        if (!callback) {
+            return;
+        }
+        WipeProgress progress{};
+        progress.verification_in_progress = true;
+        progress.verification_percentage =
+            (static_cast<double>(done) / static_cast<double>(offsets.size())) * 100.0;
+        progress.percentage = progress.verification_percentage;
+        progress.status = std::format("Sampling {} of {} blocks...", done, offsets.size());
+        callback(progress);
+    };
+
+    const auto after = take_samples(fd, size, offsets, block_bytes, cancel_flag, on_progress);
+    return judge_erase(before, after);
+}
+
+}  // namespace verification
@@ -0,0 +1,121 @@
+/**
+ * @file SampledVerification.hpp
+ * @brief Seconds-long readback check for hardware erases
+ *
+ * A hardware erase gives no byte-level evidence of what the drive did, and a
+ * full read of a large SSD costs as much as an overwrite. Instead a fixed
+ * number of blocks spread over the LBA range is read at high queue depth,
+ * once before the erase and once after:
+ *
+ * - After the erase every sample must hold the same kind of fill: all 0x00,
+ *   all 0xFF, or high-entropy data (what a crypto erase leaves behind).
+ * - No sample that held data before the erase may read back unchanged. A
+ *   sample that was already blank cannot show a change and is only counted.
+ * - High-entropy data without pre-erase samples does not pass: it is what a
+ *   crypto erase leaves, and also what an encrypted disk held all along.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace verification {
+
+/**
+ * @enum FillPattern
+ * @brief What a sampled block contains
+ */
+enum class FillPattern : std::uint8_t {
+    ZEROS,         ///< Every byte 0x00
+    ONES,          ///< Every byte 0xFF
+    HIGH_ENTROPY,  ///< Random-looking (crypto erase, or encrypted data)
+    OTHER          ///< Anything else: user data, a vendor test pattern
+};
+
+[[nodiscard]] auto fill_pattern_name(FillPattern pattern) -> std::string_view;
+
+/**
+ * @brief One sampled block, reduced to a fingerprint
+ */
+struct Sample {
+    uint64_t offset = 0;
+    uint32_t length = 0;  // Bytes read; short only for the device's last block
+    uint64_t digest = 0;  // FNV-1a of the block
+    FillPattern pattern = FillPattern::OTHER;
+};
+
+/**
+ * @brief Outcome of comparing post-erase samples with pre-erase ones
+ */
+struct SampledVerdict {
+    bool passed = false;
+    bool inconclusive = false;  // Not passed because nothing could prove the erase either way
+    FillPattern pattern = FillPattern::OTHER;  // Fill of the first post-erase sample
+    std::size_t samples = 0;
+    std::size_t inconsistent = 0;  // Post-erase samples whose fill differs from the first
+    std::size_t unchanged = 0;     // Samples that held data and read back identical
+    std::size_t blank_before = 0;  // Samples that were already uniform before the erase
+    std::string detail;
+};
+
+inline constexpr std::size_t SAMPLE_COUNT = 512;
+inline constexpr std::size_t SAMPLE_BYTES = 64 * 1'024;
+inline constexpr std::size_t SAMPLE_QUEUE_DEPTH = 32;
+
+/**
+ * @brief Spread count blocks over [0, size): the first and last block, and one
+ *        block at a random aligned position in each of the strata in between
+ * @return Sorted, distinct offsets aligned to block_bytes
+ */
+[[nodiscard]] auto plan_sample_offsets(uint64_t size, std::size_t count, std::size_t block_bytes,
+                                       uint64_t seed) -> std::vector<uint64_t>;
+
+/**
+ * @brief Classify a block's contents
+ */
+[[nodiscard]] auto classify_fill(std::span<const uint8_t> block) -> FillPattern;
+
+/**
+ * @brief Read and fingerprint blocks with up to SAMPLE_QUEUE_DEPTH reads in flight
+ *
+ * The reads run on the shared executor's blocking-I/O lane and the calling
+ * thread, bounded by the lane's thread count.
+ *
+ * The page cache is dropped for the device first, so the reads reach the
+ * media rather than returning what was cached before an erase.
+ *
+ * @param size Device size; each read is clipped to it
+ * @param on_progress Called with the number of samples read so far; may be empty
+ * @return Samples in offset order, or an empty vector on read error or cancellation
+ */
+[[nodiscard]] auto take_samples(int fd, uint64_t size, std::span<const uint64_t> offsets,
+                                std::size_t block_bytes, const std::atomic<bool>& cancel_flag,
+                                const std::function<void(std::size_t done)>& on_progress = {})
+    -> std::vector<Sample>;
+
+/**
+ * @brief Judge post-erase samples against pre-erase samples at the same offsets
+ * @param before Pre-erase samples; empty when none were taken (consistency check only)
+ */
+[[nodiscard]] auto judge_erase(std::span<const Sample> before, std::span<const Sample> after)
+    -> SampledVerdict;
+
+/**
+ * @brief Sample the device after a hardware erase and judge the result
+ * @param before Pre-erase samples; the same blocks are re-read. If empty, SAMPLE_COUNT blocks
+ *        of SAMPLE_BYTES at fresh offsets are read instead.
+ */
+[[nodiscard]] auto verify_erase_sampled(int fd, uint64_t size, std::span<const Sample> before,
+                                        ProgressCallback callback,
+                                        const std::atomic<bool>& cancel_flag) -> SampledVerdict;
+
+}  // namespace verification
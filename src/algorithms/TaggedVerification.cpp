@@ -0,0 +1,196 @@
+/**
+ * @file TaggedVerification.cpp
+ * @brief Readback check for a pass of LBA-tagged blocks
+ */
+
+#include "algorithms/TaggedVerification.hpp"
+
+#include "algorithms/PipelinedScan.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <vector>
+
+namespace verification {
+
+namespace {
+
+constexpr uint64_t BLOCK = util::TAGGED_BLOCK_SIZE;
+
+// Whole blocks per read, so no block straddles two chunks
+static_assert(detail::VERIFY_BUFFER_SIZE % util::TAGGED_BLOCK_SIZE == 0);
+
+}  // namespace
+
+TaggedBlockChecker::TaggedBlockChecker(uint64_t size, std::optional<uint64_t> job_id)
+    : size_(size), job_id_(job_id) {}
+
+void TaggedBlockChecker::check(std::span<const uint8_t> data, uint64_t offset) {
+    for (std::size_t pos = 0; pos < data.size(); pos += BLOCK) {
+        const auto address = (offset + pos) / BLOCK;
+        if (data.size() - pos >= BLOCK) {
+            check_block(data.subspan(pos).first<util::TAGGED_BLOCK_SIZE>(), address);
+        } else {
+            check_short_block(data.subspan(pos), address);
+        }
+    }
+    checked_end_ = std::max(checked_end_, offset + data.size());
+}
+
+void TaggedBlockChecker::mark_unreadable() {
+    if (checked_end_ >= size_) {
+        return;
+    }
+    tally_.unreadable = (size_ - checked_end_ + BLOCK - 1) / BLOCK;
+    record_bad(checked_end_ / BLOCK);
+}
+
+void TaggedBlockChecker::check_block(std::span<const uint8_t, util::TAGGED_BLOCK_SIZE> block,
+                                     uint64_t address) {
+    ++tally_.blocks;
+
+    util::BlockTag tag;
+    switch (util::read_tag(block, tag)) {
+        case util::TagStatus::FOREIGN:
+            ++tally_.foreign;
+            record_bad(address);
+            return;
+        case util::TagStatus::CORRUPT:
+            ++tally_.corrupt;
+            record_bad(address);
+            return;
+        case util::TagStatus::VALID:
+            break;
+    }
+
+    if (!job_id_) {
+        job_id_ = tag.job_id;
+    }
+    if (tag.job_id != *job_id_) {
+        ++tally_.stale;
+        record_bad(address);
+        return;
+    }
+    if (tag.address != address) {
+        ++tally_.misplaced;
+        const auto distance = tag.address > address ? tag.address - address
+                                                    : address - tag.address;
+        alias_distance_ = std::min(alias_distance_.value_or(distance), distance);
+        record_bad(address);
+        return;
+    }
+    last_good_end_ = (address + 1) * BLOCK;
+}
+
+void TaggedBlockChecker::check_short_block(std::span<const uint8_t> data, uint64_t address) {
+    ++tally_.blocks;
+
+    // Too short to hold a checksum: compare with the prefix of the block we expect
+    if (job_id_) {
+        std::vector<uint8_t> expected(data.size());
+        util::fill_tagged(*job_id_, address * BLOCK, expected);
+        if (std::ranges::equal(data, expected)) {
+            last_good_end_ = address * BLOCK + data.size();
+            return;
+        }
+    }
+
+    const auto magic = std::min(data.size(), util::TAGGED_BLOCK_MAGIC.size());
+    if (std::memcmp(data.data(), util::TAGGED_BLOCK_MAGIC.data(), magic) == 0) {
+        ++tally_.corrupt;
+    } else {
+        ++tally_.foreign;
+    }
+    record_bad(address);
+}
+
+void TaggedBlockChecker::record_bad(uint64_t address) {
+    if (!tally_.first_bad_offset) {
+        tally_.first_bad_offset = address * BLOCK;
+    }
+}
+
+auto TaggedBlockChecker::verdict() const -> TaggedVerdict {
+    auto verdict = tally_;
+    const auto expected_blocks = (size_ + BLOCK - 1) / BLOCK;
+    const auto bad = verdict.foreign + verdict.corrupt + verdict.stale + verdict.misplaced +
+                     verdict.unreadable;
+
+    // Wrapped addresses give the size directly; otherwise a drive that stops
+    // storing data shows good blocks up to its real end and only bad ones after
+    verdict.real_capacity = size_;
+    if (alias_distance_) {
+        verdict.real_capacity = std::min(size_, *alias_distance_ * BLOCK);
+    } else if (verdict.first_bad_offset && *verdict.first_bad_offset >= last_good_end_) {
+        verdict.real_capacity = last_good_end_;
+    }
+
+    if (bad == 0 && verdict.blocks == expected_blocks) {
+        verdict.passed = true;
+        verdict.detail = std::format("All {} blocks carry their own address and this job's tag",
+                                     verdict.blocks);
+        return verdict;
+    }
+
+    if (bad == 0) {
+        verdict.detail =
+            std::format("Only {} of {} blocks were checked", verdict.blocks, expected_blocks);
+        return verdict;
+    }
+
+    verdict.detail = std::format(
+        "{} of {} blocks are bad (no tag {}, corrupt {}, other job {}, wrong address {}, "
+        "unreadable {}), the first at offset {}",
+        bad, expected_blocks, verdict.foreign, verdict.corrupt, verdict.stale, verdict.misplaced,
+        verdict.unreadable, verdict.first_bad_offset.value_or(0));
+    if (verdict.real_capacity < size_) {
+        verdict.detail += std::format("; the device appears to store only {} of {} bytes",
+                                      verdict.real_capacity, size_);
+    }
+    return verdict;
+}
+
+auto verify_tagged(int fd, uint64_t size, std::optional<uint64_t> job_id,
+                   ProgressCallback callback, const std::atomic<bool>& cancel_flag)
+    -> TaggedVerdict {
+    TaggedBlockChecker checker{size, job_id};
+    if (size == 0) {
+        return checker.verdict();
+    }
+
+    // Read from the media, not from pages the write pass left in the cache
+    static_cast<void>(fdatasync(fd));
+    static_cast<void>(posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED));
+
+    // Seek to beginning
+    if (lseek(fd, 0, SEEK_SET) != 0) {
+        auto verdict = checker.verdict();
+        verdict.passed = false;
+        verdict.detail = "Could not seek to the start of the device";
+        return verdict;
+    }
+
+    const auto outcome = detail::pipelined_scan(
+        fd, size, callback, cancel_flag,
+        [&checker](const uint8_t* data, size_t length, uint64_t offset) {
+            checker.check({data, length}, offset);
+            return true;
+        },
+        detail::VERIFY_BUFFER_SIZE, "Checking tagged blocks...");
+
+    if (outcome == detail::ScanOutcome::READ_ERROR) {
+        checker.mark_unreadable();
+    }
+    auto verdict = checker.verdict();
+    if (outcome == detail::ScanOutcome::CANCELLED || outcome == detail::ScanOutcome::STOPPED) {
+        verdict.passed = false;
+        verdict.detail = "Readback was cancelled";
+    }
+    return verdict;
+}
+
+}  // namespace verification
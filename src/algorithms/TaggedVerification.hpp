@@ -0,0 +1,104 @@
+/**
+ * @file TaggedVerification.hpp
+ * @brief Readback check for a pass of LBA-tagged blocks
+ *
+ * A constant-pattern check cannot tell a block the drive wrote from one it
+ * dropped (the old data was the same pattern), nor from one it wrote to the
+ * wrong address. Tagged blocks (util/TaggedBlock.hpp) carry their address, the
+ * job id and a checksum, so each block read back is checked on its own:
+ *
+ * - FOREIGN: no tag at all, e.g. a dropped write over older data
+ * - CORRUPT: a tag whose checksum does not match
+ * - STALE: an intact tag from another job (a dropped write over an earlier run)
+ * - MISPLACED: this job's tag for a different address (a misdirected write)
+ *
+ * Counterfeit flash that reports more capacity than it has wraps addresses
+ * around, so the blocks read back carry addresses a fixed distance away;
+ * that distance is the real capacity. Drives that discard writes past their
+ * real end show good blocks up to that point and bad ones after it.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/TaggedBlock.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace verification {
+
+/**
+ * @brief Outcome of a tagged readback
+ */
+struct TaggedVerdict {
+    bool passed = false;
+    uint64_t blocks = 0;  // Checked, including a short last block
+    uint64_t foreign = 0;
+    uint64_t corrupt = 0;
+    uint64_t stale = 0;
+    uint64_t misplaced = 0;
+    uint64_t unreadable = 0;  // Blocks past a read error
+    std::optional<uint64_t> first_bad_offset;
+    uint64_t real_capacity = 0;  // Best estimate of what the device really stores, in bytes
+    std::string detail;
+};
+
+/**
+ * @class TaggedBlockChecker
+ * @brief Tallies tagged blocks read back in order from the start of the device
+ */
+class TaggedBlockChecker {
+public:
+    /**
+     * @param size Device size in bytes
+     * @param job_id Expected job id; when empty, the job id of the first intact block is used
+     */
+    TaggedBlockChecker(uint64_t size, std::optional<uint64_t> job_id);
+
+    /**
+     * @brief Check the bytes at device offset `offset`, which must be block-aligned
+     */
+    void check(std::span<const uint8_t> data, uint64_t offset);
+
+    /**
+     * @brief Count every block from the end of what was checked as bad (a read failed there)
+     */
+    void mark_unreadable();
+
+    [[nodiscard]] auto verdict() const -> TaggedVerdict;
+
+private:
+    void check_block(std::span<const uint8_t, util::TAGGED_BLOCK_SIZE> block, uint64_t address);
+    void check_short_block(std::span<const uint8_t> data, uint64_t address);
+    void record_bad(uint64_t address);
+
+    uint64_t size_;
+    std::optional<uint64_t> job_id_;
+    TaggedVerdict tally_{};
+    uint64_t checked_end_ = 0;
+    uint64_t last_good_end_ = 0;              // End of the last good block
+    std::optional<uint64_t> alias_distance_;  // Smallest address gap of a misplaced block
+};
+
+/**
+ * @brief Read the whole device back and check every tagged block
+ *
+ * Dirty pages are flushed and the device's page cache is dropped first, so
+ * the blocks come from the media rather than from memory.
+ *
+ * @param fd File descriptor (opened for reading)
+ * @param size Device size in bytes
+ * @param job_id Job id the pass was written with, or empty to accept the one found on disk
+ * @param callback Progress callback
+ * @param cancel_flag Cancellation flag
+ */
+[[nodiscard]] auto verify_tagged(int fd, uint64_t size, std::optional<uint64_t> job_id,
+                                 ProgressCallback callback, const std::atomic<bool>& cancel_flag)
+    -> TaggedVerdict;
+
+}  // namespace verification
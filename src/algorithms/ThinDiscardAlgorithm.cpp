@@ -0,0 +1,216 @@
+/**
+ * @file ThinDiscardAlgorithm.cpp
+ * @brief Discard and write-zeroes wipe using block device offload
+ */
+
+#include "algorithms/ThinDiscardAlgorithm.hpp"
+
+#include "algorithms/VerificationHelper.hpp"
+#include "util/Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <linux/falloc.h>
+#include <linux/fs.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// SCSI logical block provisioning modes that mean "thin" (sd driver names)
+constexpr std::array<std::string_view, 3> THIN_PROVISIONING_MODES = {"unmap", "writesame_16",
+                                                                     "writesame_10"};
+
+constexpr std::array<std::string_view, 5> VIRTUAL_DISK_PREFIXES = {"vd", "xvd", "dm-", "rbd",
+                                                                   "nbd"};
+
+auto read_uint64(const fs::path& path) -> uint64_t {
+    uint64_t value = 0;
+    if (std::ifstream file{path}; file.is_open()) {
+        file >> value;
+    }
+    return value;
+}
+
+/**
+ * @brief Release or zero one step of the device
+ * @return 0 on success, otherwise errno
+ */
+using RangeOperation = int (*)(int fd, uint64_t offset, uint64_t length);
+
+auto blk_discard(int fd, uint64_t offset, uint64_t length) -> int {
+    std::array<uint64_t, 2> range = {offset, length};
+    return ioctl(fd, BLKDISCARD, range.data()) == 0 ? 0 : errno;
+}
+
+auto blk_zeroout(int fd, uint64_t offset, uint64_t length) -> int {
+    std::array<uint64_t, 2> range = {offset, length};
+    return ioctl(fd, BLKZEROOUT, range.data()) == 0 ? 0 : errno;
+}
+
+// On a block device this is REQ_OP_WRITE_ZEROES with unmap allowed and no
+// fallback to writing zero pages; on a regular file it deallocates the range.
+auto punch_hole(int fd, uint64_t offset, uint64_t length) -> int {
+    return fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset),
+                     static_cast<off_t>(length)) == 0
+               ? 0
+               : errno;
+}
+
+auto is_unsupported(int error) -> bool {
+    return error == EOPNOTSUPP || error == ENOTTY || error == EINVAL;
+}
+
+}  // namespace
+
+auto ProvisioningInfo::is_thin() const -> bool {
+    if (std::ranges::find(THIN_PROVISIONING_MODES, provisioning_mode) !=
+        THIN_PROVISIONING_MODES.end()) {
+        return true;
+    }
+    return virtual_disk && supports_discard();
+}
+
+ProvisioningInfo ThinDiscardAlgorithm::read_provisioning_info(const fs::path& sys_device_dir) {
+    ProvisioningInfo info;
+
+    auto device_dir = sys_device_dir;
+    std::error_code ec;
+    if (!fs::exists(device_dir / "queue", ec) && fs::exists(device_dir / "partition", ec)) {
+        device_dir = device_dir.parent_path();
+    }
+
+    const auto queue = device_dir / "queue";
+    info.discard_max_bytes = read_uint64(queue / "discard_max_bytes");
+    info.write_zeroes_max_bytes = read_uint64(queue / "write_zeroes_max_bytes");
+    info.discard_zeroes_data = read_uint64(queue / "discard_zeroes_data") != 0;
+
+    // sd exposes the mode under device/scsi_disk/<h:c:t:l>/
+    for (const auto& entry : fs::directory_iterator{device_dir / "device" / "scsi_disk", ec}) {
+        if (std::ifstream file{entry.path() / "provisioning_mode"}; file.is_open()) {
+            file >> info.provisioning_mode;
+            break;
+        }
+    }
+
+    const auto name = device_dir.filename().string();
+    auto has_prefix = [&name](std::string_view prefix) { return name.starts_with(prefix); };
+    info.virtual_disk = std::ranges::any_of(VIRTUAL_DISK_PREFIXES, has_prefix);
+    return info;
+}
+
+std::optional<ProvisioningInfo> ThinDiscardAlgorithm::get_provisioning_info(int fd) {
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISBLK(st.st_mode)) {
+        return std::nullopt;
+    }
+
+    // /sys/dev/block/M:m links to the device (or partition) directory
+    std::error_code ec;
+    auto sys_dir = fs::canonical(
+        std::format("/sys/dev/block/{}:{}", major(st.st_rdev), minor(st.st_rdev)), ec);
+    if (ec) {
+        return ProvisioningInfo{};
+    }
+    return read_provisioning_info(sys_dir);
+}
+
+bool ThinDiscardAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
+                                   const std::atomic<bool>& cancel_flag) {
+    if (size == 0) {
+        return true;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        return false;
+    }
+    const bool block_device = S_ISBLK(st.st_mode);
+
+    if (auto info = get_provisioning_info(fd)) {
+        LOG_INFO("ThinDiscardAlgorithm",
+                 std::format("discard_max_bytes={} write_zeroes_max_bytes={} "
+                             "provisioning_mode={} thin={}",
+                             info->discard_max_bytes, info->write_zeroes_max_bytes,
+                             info->provisioning_mode.empty() ? "n/a" : info->provisioning_mode,
+                             info->is_thin()));
+    }
+
+    auto report = [&](int pass, uint64_t done, const char* status) {
+        if (callback) {
+            WipeProgress progress{};
+            progress.bytes_written = done;
+            progress.total_bytes = size;
+            progress.current_pass = pass;
+            progress.total_passes = get_pass_count();
+            progress.percentage = (static_cast<double>(done) / static_cast<double>(size)) * 100.0;
+            progress.status = status;
+            callback(progress);
+        }
+    };
+
+    // Apply an operation over the whole device in chunks. Returns 0, or the
+    // errno of the first failing chunk.
+    auto run_pass = [&](int pass, RangeOperation operation, const char* status) -> int {
+        uint64_t done = 0;
+        report(pass, 0, status);
+        while (done < size && !cancel_flag.load()) {
+            const uint64_t length = std::min(CHUNK_SIZE, size - done);
+            if (int error = operation(fd, done, length); error != 0) {
+                return error;
+            }
+            done += length;
+            report(pass, done, status);
+        }
+        return 0;
+    };
+
+    // Pass 1: hand the blocks back to the backing store. Best effort - the
+    // zeroing pass alone determines what the device reads back.
+    const auto release = block_device ? blk_discard : punch_hole;
+    if (int error = run_pass(1, release, "Discarding blocks..."); error != 0) {
+        if (!is_unsupported(error)) {
+            LOG_ERROR("ThinDiscardAlgorithm", std::format("Discard failed: {}", strerror(error)));
+            return false;
+        }
+        LOG_WARNING("ThinDiscardAlgorithm",
+                    "Device does not support discard; backing storage stays allocated");
+    }
+    if (cancel_flag.load()) {
+        return false;
+    }
+
+    // Pass 2: write zeroes, letting the device unmap instead of storing them
+    int error = run_pass(2, punch_hole, "Writing zeroes (unmap)...");
+    if (error != 0 && block_device && is_unsupported(error)) {
+        LOG_WARNING("ThinDiscardAlgorithm",
+                    "Device cannot write zeroes with unmap; falling back to BLKZEROOUT, "
+                    "which may allocate backing storage");
+        error = run_pass(2, blk_zeroout, "Writing zeroes...");
+    }
+    if (error != 0) {
+        LOG_ERROR("ThinDiscardAlgorithm", std::format("Zeroing failed: {}", strerror(error)));
+        return false;
+    }
+
+    return !cancel_flag.load();
+}
+
+bool ThinDiscardAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
+                                  const std::atomic<bool>& cancel_flag) {
+    return verification::verify_zeros(fd, size, std::move(callback), cancel_flag);
+}
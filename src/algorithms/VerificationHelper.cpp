@@ -5,49 +5,22 @@
 
 #include "algorithms/VerificationHelper.hpp"
 
+#include "algorithms/PipelinedScan.hpp"
+
 #include <unistd.h>
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <future>
 #include <numeric>
 
 namespace verification {
 
-namespace {
-constexpr size_t VERIFY_BUFFER_SIZE = 1'024 * 1'024;  // 1MB buffer
-
-/**
- * @brief Read with retry on EINTR
- */
-auto read_with_retry(int fd, void* buf, size_t count) -> ssize_t {
-    while (true) {
-        ssize_t result = ::read(fd, buf, count);
-        if (result >= 0 || errno != EINTR) {
-            return result;
-        }
-    }
-}
-
-/**
- * @brief Emit verification progress
- */
-void emit_progress(ProgressCallback& callback, uint64_t verified, uint64_t total) {
-    if (!callback)
-        return;
-
-    WipeProgress progress{};
-    progress.verification_in_progress = true;
-    progress.verification_percentage =
-        (static_cast<double>(verified) / static_cast<double>(total)) * 100.0;
-    progress.bytes_written = verified;
-    progress.total_bytes = total;
-    progress.percentage = progress.verification_percentage;
-    progress.status = "Verifying...";
-    callback(progress);
-}
-
-}  // namespace
+using detail::pipelined_scan;
+using detail::ScanOutcome;
+using detail::VERIFY_BUFFER_SIZE;
 
 auto verify_zeros(int fd, uint64_t size, ProgressCallback callback,
                   const std::atomic<bool>& cancel_flag) -> bool {
@@ -65,35 +38,15 @@ auto verify_pattern(int fd, uint64_t size, uint8_t pattern, ProgressCallback cal
         return false;
     }
 
-    std::vector<uint8_t> buffer(VERIFY_BUFFER_SIZE);
-    uint64_t verified = 0;
-    bool mismatch_found = false;
-
-    while (verified < size && !cancel_flag.load()) {
-        size_t to_read = std::min(static_cast<uint64_t>(buffer.size()), size - verified);
-        ssize_t bytes_read = read_with_retry(fd, buffer.data(), to_read);
-
-        if (bytes_read <= 0) {
-            return false;  // Read error
-        }
+    // Check all bytes match pattern
+    const auto outcome =
+        pipelined_scan(fd, size, callback, cancel_flag,
+                       [pattern](const uint8_t* data, size_t length, uint64_t /*offset*/) {
+                           return std::all_of(data, data + length,
+                                              [pattern](uint8_t byte) { return byte == pattern; });
+                       });
 
-        // Check all bytes match pattern
-        for (ssize_t i = 0; i < bytes_read; ++i) {
-            if (buffer[static_cast<size_t>(i)] != pattern) {
-                mismatch_found = true;
-                break;
-            }
-        }
-
-        if (mismatch_found) {
-            break;
-        }
-
-        verified += static_cast<uint64_t>(bytes_read);
-        emit_progress(callback, verified, size);
-    }
-
-    return !mismatch_found && !cancel_flag.load();
+    return outcome == ScanOutcome::COMPLETE;
 }
 
 auto verify_random(int fd, uint64_t size, ProgressCallback callback,
@@ -108,29 +61,19 @@ auto verify_random(int fd, uint64_t size, ProgressCallback callback,
 
     // Count byte frequencies for chi-squared test
     std::array<uint64_t, 256> byte_counts{};
-    std::vector<uint8_t> buffer(VERIFY_BUFFER_SIZE);
-    uint64_t verified = 0;
     uint64_t total_bytes = 0;
 
-    while (verified < size && !cancel_flag.load()) {
-        size_t to_read = std::min(static_cast<uint64_t>(buffer.size()), size - verified);
-        ssize_t bytes_read = read_with_retry(fd, buffer.data(), to_read);
-
-        if (bytes_read <= 0) {
-            return false;  // Read error
-        }
-
-        // Count byte frequencies
-        for (ssize_t i = 0; i < bytes_read; ++i) {
-            byte_counts[buffer[static_cast<size_t>(i)]]++;
-            total_bytes++;
-        }
-
-        verified += static_cast<uint64_t>(bytes_read);
-        emit_progress(callback, verified, size);
-    }
+    const auto outcome = pipelined_scan(
+        fd, size, callback, cancel_flag,
+        [&byte_counts, &total_bytes](const uint8_t* data, size_t length, uint64_t /*offset*/) {
+            for (size_t i = 0; i < length; ++i) {
+                byte_counts[data[i]]++;
+            }
+            total_bytes += length;
+            return true;
+        });
 
-    if (cancel_flag.load()) {
+    if (outcome != ScanOutcome::COMPLETE) {
         return false;
     }
 
@@ -169,36 +112,44 @@ auto verify_buffer_pattern(int fd, uint64_t size, const std::vector<uint8_t>& ex
         return false;
     }
 
-    std::vector<uint8_t> buffer(VERIFY_BUFFER_SIZE);
-    uint64_t verified = 0;
-    bool mismatch_found = false;
-
-    while (verified < size && !cancel_flag.load()) {
-        size_t to_read = std::min(static_cast<uint64_t>(buffer.size()), size - verified);
-        ssize_t bytes_read = read_with_retry(fd, buffer.data(), to_read);
-
-        if (bytes_read <= 0) {
-            return false;  // Read error
-        }
-
-        // Check bytes match expected pattern (repeating)
-        for (ssize_t i = 0; i < bytes_read; ++i) {
-            size_t pattern_idx = (verified + static_cast<uint64_t>(i)) % expected_pattern.size();
-            if (buffer[static_cast<size_t>(i)] != expected_pattern[pattern_idx]) {
-                mismatch_found = true;
-                break;
+    // Check bytes match expected pattern (repeating)
+    const auto outcome = pipelined_scan(
+        fd, size, callback, cancel_flag,
+        [&expected_pattern](const uint8_t* data, size_t length, uint64_t offset) {
+            for (size_t i = 0; i < length; ++i) {
+                size_t pattern_idx = (offset + i) % expected_pattern.size();
+                if (data[i] != expected_pattern[pattern_idx]) {
+                    return false;
+                }
             }
-        }
+            return true;
+        });
+
+    return outcome == ScanOutcome::COMPLETE;
+}
 
-        if (mismatch_found) {
-            break;
-        }
+auto verify_generated(int fd, uint64_t size,
+                      const std::function<void(uint64_t offset, std::span<uint8_t> out)>& generate,
+                      ProgressCallback callback, const std::atomic<bool>& cancel_flag) -> bool {
+    if (size == 0)
+        return true;
 
-        verified += static_cast<uint64_t>(bytes_read);
-        emit_progress(callback, verified, size);
+    // Seek to beginning
+    if (lseek(fd, 0, SEEK_SET) != 0) {
+        return false;
     }
 
-    return !mismatch_found && !cancel_flag.load();
+    // Chunks are inspected one at a time, so a single scratch buffer suffices
+    std::vector<uint8_t> expected(VERIFY_BUFFER_SIZE);
+    const auto outcome = pipelined_scan(
+        fd, size, callback, cancel_flag,
+        [&generate, &expected](const uint8_t* data, size_t length, uint64_t offset) {
+            auto block = std::span{expected}.first(length);
+            generate(offset, block);
+            return std::memcmp(data, block.data(), length) == 0;
+        });
+
+    return outcome == ScanOutcome::COMPLETE;
 }
 
 }  // namespace verification
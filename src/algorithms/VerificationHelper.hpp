@@ -9,6 +9,8 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
+#include <span>
 #include <vector>
 
 namespace verification {
@@ -64,4 +66,18 @@ namespace verification {
                                          ProgressCallback callback,
                                          const std::atomic<bool>& cancel_flag) -> bool;
 
+/**
+ * @brief Verify against data produced on demand, e.g. by a seekable keystream
+ * @param fd File descriptor (opened for reading)
+ * @param size Device size in bytes
+ * @param generate Writes the expected bytes for [offset, offset + out.size()) into out
+ * @param callback Progress callback
+ * @param cancel_flag Cancellation flag
+ * @return true if every byte matches
+ */
+[[nodiscard]] auto verify_generated(
+    int fd, uint64_t size,
+    const std::function<void(uint64_t offset, std::span<uint8_t> out)>& generate,
+    ProgressCallback callback, const std::atomic<bool>& cancel_flag) -> bool;
+
 }  // namespace verification
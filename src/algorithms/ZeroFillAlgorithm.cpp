@@ -1,13 +1,10 @@
 #include "algorithms/ZeroFillAlgorithm.hpp"
 
+#include "algorithms/AdaptiveWriter.hpp"
 #include "algorithms/VerificationHelper.hpp"
 #include "models/WipeTypes.hpp"
-#include "util/WriteHelpers.hpp"
 
-#include <unistd.h>
-
-#include <algorithm>
-#include <vector>
+#include <cstring>
 
 bool ZeroFillAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback,
                                 const std::atomic<bool>& cancel_flag) {
@@ -16,19 +13,10 @@ bool ZeroFillAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback
         return true;
     }
 
-    std::vector<uint8_t> buffer(BUFFER_SIZE, 0);
-    uint64_t written = 0;
-
-    while (written < size && !cancel_flag.load()) {
-        size_t to_write = std::min(static_cast<uint64_t>(BUFFER_SIZE), size - written);
-        ssize_t result = util::write_with_retry(fd, buffer.data(), to_write);
-
-        if (result <= 0) {
-            return false;
-        }
-
-        written += static_cast<uint64_t>(result);
-
+    auto zeros = [](uint64_t /*offset*/, std::span<uint8_t> out) {
+        std::memset(out.data(), 0, out.size());
+    };
+    auto report = [&](uint64_t written) {
         if (callback) {
             WipeProgress progress{};
             progress.bytes_written = written;
@@ -40,9 +28,9 @@ bool ZeroFillAlgorithm::execute(int fd, uint64_t size, ProgressCallback callback
             progress.status = "Writing zeros...";
             callback(progress);
         }
-    }
+    };
 
-    return !cancel_flag.load();
+    return write_stream(fd, size, zeros, true, report, cancel_flag);
 }
 
 bool ZeroFillAlgorithm::verify(int fd, uint64_t size, ProgressCallback callback,
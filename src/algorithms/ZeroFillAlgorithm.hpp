@@ -30,7 +30,4 @@ public:
 
     bool verify(int fd, uint64_t size, ProgressCallback callback,
                 const std::atomic<bool>& cancel_flag) override;
-
-private:
-    static constexpr size_t BUFFER_SIZE = 1'024 * 1'024;  // 1MB buffer
 };
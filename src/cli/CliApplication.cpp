@@ -5,23 +5,39 @@
 
 #include "cli/CliApplication.hpp"
 
+#include "algorithms/AlgorithmFactory.hpp"
+#include "algorithms/ResidualScan.hpp"
 #include "cli/ProgressDisplay.hpp"
 #include "config.h"
+#include "helper/services/DiskService.hpp"
+#include "helper/services/FileShredService.hpp"
+#include "helper/services/FreeSpaceWipeService.hpp"
+#include "helper/services/StationPolicy.hpp"
+#include "helper/services/WipeService.hpp"
 #include "services/DBusClient.hpp"
+#include "util/FileDescriptor.hpp"
 #include "util/Logger.hpp"
 
 #include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <csignal>
+#include <cstring>
 #include <filesystem>
 #include <format>
-#include <future>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <thread>
 
+#include <fcntl.h>
 #include <getopt.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace cli {
 
@@ -49,6 +65,14 @@ const struct option long_options[] = {
     {       "verify",       no_argument, nullptr, 'v'},
     {"force-unmount",       no_argument, nullptr, 'f'},
     {          "yes",       no_argument, nullptr, 'y'},
+    {       "direct",       no_argument, nullptr, 'd'},
+    {        "shred", required_argument, nullptr, 's'},
+    {      "discard",       no_argument, nullptr, 'D'},
+    {   "free-space", required_argument, nullptr, 'F'},
+    {      "reserve", required_argument, nullptr, 'R'},
+    {         "trim",       no_argument, nullptr, 'T'},
+    {         "scan", required_argument, nullptr, 'S'},
+    {      "pattern", required_argument, nullptr, 'P'},
     {        nullptr,                 0, nullptr,   0}
 };
 
@@ -75,12 +99,26 @@ auto CliApplication::run(int argc, char* argv[]) -> int {
         return 0;
     }
 
-    // Connect to D-Bus helper
-    if (!connect()) {
-        LOG_ERROR("CLI", "Failed to connect to storage-wiper-helper service");
-        std::cerr << "Error: Failed to connect to storage-wiper-helper service.\n"
-                  << "Make sure the helper is installed and D-Bus is running.\n";
-        return 1;
+    // Read-only and needs no service: open the device directly
+    if (!options.scan_path.empty()) {
+        return cmd_scan(options);
+    }
+
+    if (options.direct) {
+        if (auto direct = init_direct(); !direct) {
+            std::cerr << "Error: " << direct.error().message << "\n";
+            return 1;
+        }
+    } else if (!connect()) {
+        // Rescue images often have no system bus; root can still work in-process
+        if (::geteuid() != 0 || !init_direct()) {
+            LOG_ERROR("CLI", "Failed to connect to storage-wiper-helper service");
+            std::cerr << "Error: Failed to connect to storage-wiper-helper service.\n"
+                      << "Make sure the helper is installed and D-Bus is running,\n"
+                      << "or run as root with --direct.\n";
+            return 1;
+        }
+        std::cerr << "Helper unavailable; running in direct mode.\n";
     }
 
     if (options.list_disks) {
@@ -91,6 +129,14 @@ auto CliApplication::run(int argc, char* argv[]) -> int {
         return cmd_wipe(options);
     }
 
+    if (!options.shred_paths.empty()) {
+        return cmd_shred(options);
+    }
+
+    if (!options.free_space_directory.empty()) {
+        return cmd_free_space(options);
+    }
+
     // No command specified
     print_help();
     return 1;
@@ -100,7 +146,7 @@ auto CliApplication::parse_args(int argc, char* argv[]) -> CliOptions {
     CliOptions options;
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "hVljw:a:vfy", long_options, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hVljw:a:vfyds:F:", long_options, nullptr)) != -1) {
         switch (opt) {
             case 'h':
                 options.show_help = true;
@@ -116,7 +162,7 @@ auto CliApplication::parse_args(int argc, char* argv[]) -> CliOptions {
                 break;
             case 'w':
                 options.wipe = true;
-                options.device_path = optarg;
+                options.device_paths.emplace_back(optarg);
                 break;
             case 'a':
                 options.algorithm = optarg;
@@ -130,6 +176,30 @@ auto CliApplication::parse_args(int argc, char* argv[]) -> CliOptions {
             case 'y':
                 options.no_confirm = true;
                 break;
+            case 'd':
+                options.direct = true;
+                break;
+            case 's':
+                options.shred_paths.emplace_back(optarg);
+                break;
+            case 'D':
+                options.discard = true;
+                break;
+            case 'F':
+                options.free_space_directory = optarg;
+                break;
+            case 'R':
+                options.reserve = optarg;
+                break;
+            case 'T':
+                options.trim = true;
+                break;
+            case 'S':
+                options.scan_path = optarg;
+                break;
+            case 'P':
+                options.patterns.emplace_back(optarg);
+                break;
             default:
                 options.show_help = true;
                 break;
@@ -144,28 +214,46 @@ void CliApplication::print_help() {
               << "Secure disk wiping tool\n\n"
               << "Commands:\n"
               << "  -l, --list              List available disks\n"
-              << "  -w, --wipe <device>     Wipe the specified device\n\n"
+              << "  -w, --wipe <device>     Wipe the specified device (repeat with --direct\n"
+              << "                          to wipe several devices concurrently)\n"
+              << "  -s, --shred <file>      Overwrite and delete a file (repeatable; files\n"
+              << "                          are shredded in parallel)\n"
+              << "  -F, --free-space <dir>  Overwrite the free space of a mounted filesystem\n"
+              << "      --scan <device>     Search for residual data (exit 2 if any is found)\n\n"
               << "Options:\n"
               << "  -h, --help              Show this help message\n"
               << "  -V, --version           Show version information\n"
-              << "  -j, --json              Output in JSON format (with --list)\n"
+              << "  -j, --json              Output in JSON format (with --list or --scan)\n"
               << "  -a, --algorithm <name>  Wipe algorithm (default: zero-fill)\n"
               << "  -v, --verify            Verify wipe by reading back data\n"
               << "  -f, --force-unmount     Unmount device before wiping\n"
-              << "  -y, --yes               Skip confirmation prompt\n\n"
-              << "Algorithms:\n"
-              << "  zero-fill               Single pass with zeros\n"
-              << "  random-fill             Single pass with random data\n"
-              << "  dod-5220-22-m           DoD 5220.22-M 3-pass standard\n"
-              << "  schneier                Bruce Schneier 7-pass method\n"
-              << "  vsitr                   German VSITR 7-pass standard\n"
-              << "  gost                    Russian GOST R 50739-95 2-pass\n"
-              << "  gutmann                 Peter Gutmann 35-pass method\n\n"
+              << "  -y, --yes               Skip confirmation prompt\n"
+              << "  -d, --direct            Run in-process as root, without the D-Bus helper\n"
+              << "      --discard           Discard shredded blocks (with --shred)\n"
+              << "      --reserve <size>    Free space to leave, e.g. 2G (with --free-space)\n"
+              << "      --trim              Discard free blocks instead of overwriting them\n"
+              << "      --pattern <bytes>   Extra text or hex:<digits> to scan for (repeatable)\n\n"
+              << "Algorithms:\n";
+    for (const auto& entry : WIPE_ALGORITHM_CATALOG) {
+        if (!entry.offered) {
+            continue;
+        }
+        if (entry.name.size() > 22) {
+            std::cout << std::format("  {}\n  {:22}  {}\n", entry.name, "", entry.summary);
+        } else {
+            std::cout << std::format("  {:22}  {}\n", entry.name, entry.summary);
+        }
+    }
+    std::cout << "\n"
               << "Examples:\n"
               << "  " << APP_NAME << " --list\n"
               << "  " << APP_NAME << " --list --json\n"
               << "  " << APP_NAME << " --wipe /dev/sdb\n"
               << "  " << APP_NAME << " --wipe /dev/sdb --algorithm dod-5220-22-m --verify\n"
+              << "  " << APP_NAME << " --direct --yes --wipe /dev/sdb --wipe /dev/sdc\n"
+              << "  " << APP_NAME << " --shred secrets.txt --shred keys.pem --discard\n"
+              << "  " << APP_NAME << " --free-space /home --reserve 5G\n"
+              << "  " << APP_NAME << " --scan /dev/sdb --pattern ACME-CONFIDENTIAL\n"
               << std::endl;
 }
 
@@ -175,26 +263,38 @@ void CliApplication::print_version() {
 }
 
 auto CliApplication::connect() -> bool {
-    client_ = std::make_unique<DBusClient>();
-    return client_->connect();
+    client_ = std::make_shared<DBusClient>();
+    if (!client_->connect()) {
+        client_.reset();
+        return false;
+    }
+    disk_service_ = client_;
+    wipe_service_ = client_;
+    return true;
 }
 
-auto CliApplication::get_disks_blocking() -> std::expected<std::vector<DiskInfo>, util::Error> {
-    std::promise<std::expected<std::vector<DiskInfo>, util::Error>> promise;
-    auto future = promise.get_future();
+auto CliApplication::init_direct() -> std::expected<void, util::Error> {
+    if (::geteuid() != 0) {
+        return std::unexpected(util::Error{"Direct mode requires root privileges"});
+    }
 
-    client_->get_available_disks([&promise](auto result) { promise.set_value(result); });
+    auto disk_service = std::make_shared<DiskService>();
+    disk_service_ = disk_service;
+    wipe_service_ = std::make_shared<WipeService>(disk_service);
+    direct_ = true;
+    LOG_INFO("CLI", "Running in direct mode (in-process services)");
+    return {};
+}
 
-    auto* main_context = g_main_context_default();
-    while (future.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready) {
-        g_main_context_iteration(main_context, TRUE);
+auto CliApplication::make_wipe_service() -> std::shared_ptr<IWipeService> {
+    if (direct_) {
+        return std::make_shared<WipeService>(disk_service_);
     }
-
-    return future.get();
+    return wipe_service_;
 }
 
 auto CliApplication::cmd_list(bool json) -> int {
-    auto disks_res = get_disks_blocking();
+    auto disks_res = disk_service_->get_available_disks_blocking();
 
     if (!disks_res) {
         if (json) {
@@ -235,55 +335,82 @@ auto CliApplication::cmd_wipe(const CliOptions& options) -> int {
         return 1;
     }
 
-    // Validate device path
-    auto valid = client_->validate_device_path(options.device_path);
-    if (!valid) {
-        LOG_ERROR("CLI", std::format("Invalid device path {}: {}", options.device_path,
-                                     valid.error().message));
-        std::cerr << "Error: " << valid.error().message << "\n";
+    // The helper runs one wipe at a time
+    if (options.device_paths.size() > 1 && !direct_) {
+        std::cerr << "Error: Wiping several devices at once requires --direct.\n";
         return 1;
     }
 
+    // Validate device paths
+    for (const auto& path : options.device_paths) {
+        auto valid = disk_service_->validate_device_path(path);
+        if (!valid) {
+            LOG_ERROR("CLI",
+                      std::format("Invalid device path {}: {}", path, valid.error().message));
+            std::cerr << "Error: " << path << ": " << valid.error().message << "\n";
+            return 1;
+        }
+    }
+
     // Get disk info
-    auto disks_res = get_disks_blocking();
+    auto disks_res = disk_service_->get_available_disks_blocking();
     if (!disks_res) {
         std::cerr << "Error getting disk info: " << disks_res.error().message << "\n";
         return 1;
     }
     const auto& disks = *disks_res;
 
-    auto disk_it = std::find_if(disks.begin(), disks.end(),
-                                [&](const DiskInfo& d) { return d.path == options.device_path; });
+    std::vector<DiskInfo> targets;
+    for (const auto& path : options.device_paths) {
+        auto disk_it = std::find_if(disks.begin(), disks.end(),
+                                    [&](const DiskInfo& d) { return d.path == path; });
 
-    if (disk_it == disks.end()) {
-        LOG_ERROR("CLI", std::format("Device not found: {}", options.device_path));
-        std::cerr << "Error: Device not found: " << options.device_path << "\n";
-        return 1;
+        if (disk_it == disks.end()) {
+            LOG_ERROR("CLI", std::format("Device not found: {}", path));
+            std::cerr << "Error: Device not found: " << path << "\n";
+            return 1;
+        }
+        targets.push_back(*disk_it);
     }
 
-    const auto& disk = *disk_it;
-
     // Check if mounted
-    if (disk.is_mounted) {
-        if (options.force_unmount) {
-            std::cout << "Unmounting " << options.device_path << "...\n";
-            auto unmount_result = client_->unmount_disk(options.device_path);
-            if (!unmount_result) {
-                LOG_ERROR("CLI", std::format("Failed to unmount {}: {}", options.device_path,
-                                             unmount_result.error().message));
-                std::cerr << "Error: Failed to unmount: " << unmount_result.error().message << "\n";
-                return 1;
-            }
-        } else {
-            std::cerr << "Error: Device is mounted at " << disk.mount_point << "\n"
+    for (const auto& disk : targets) {
+        if (!disk.is_mounted) {
+            continue;
+        }
+        if (!options.force_unmount) {
+            std::cerr << "Error: " << disk.path << " is mounted at " << disk.mount_point << "\n"
                       << "Use --force-unmount to unmount before wiping.\n";
             return 1;
         }
+        std::cout << "Unmounting " << disk.path << "...\n";
+        auto unmount_result = disk_service_->unmount_disk(disk.path);
+        if (!unmount_result) {
+            LOG_ERROR("CLI", std::format("Failed to unmount {}: {}", disk.path,
+                                         unmount_result.error().message));
+            std::cerr << "Error: Failed to unmount: " << unmount_result.error().message << "\n";
+            return 1;
+        }
+    }
+
+    // Overwriting a thin disk inflates its backing pool to full size
+    if (*algo != WipeAlgorithm::THIN_DISCARD) {
+        for (const auto& disk : targets) {
+            if (disk.is_thin_provisioned) {
+                std::cerr << "Note: " << disk.path << " is thin-provisioned; "
+                          << "--algorithm thin-discard releases its backing storage in seconds "
+                          << "instead of allocating it.\n";
+            }
+        }
     }
 
     // Confirm
     if (!options.no_confirm) {
-        if (!confirm_wipe(options.device_path, options.algorithm)) {
+        std::string device_list;
+        for (const auto& disk : targets) {
+            device_list += (device_list.empty() ? "" : ", ") + disk.path;
+        }
+        if (!confirm_wipe(device_list, options.algorithm)) {
             std::cout << "Aborted.\n";
             return 1;
         }
@@ -293,104 +420,423 @@ auto CliApplication::cmd_wipe(const CliOptions& options) -> int {
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
 
-    // Create progress display
-    ProgressDisplay progress(options.device_path, disk.model, disk.size_bytes,
-                             client_->get_algorithm_name(*algo), client_->get_pass_count(*algo));
+    // Per-device job. In direct mode callbacks arrive on each job's wipe thread,
+    // so completion state is atomic and output is serialized.
+    struct WipeJob {
+        std::string path;
+        std::shared_ptr<IWipeService> service;
+        std::unique_ptr<ProgressDisplay> progress;
+        std::atomic<bool> complete{false};
+        std::atomic<bool> success{false};
+        std::string final_message;
+    };
+
+    std::mutex output_mutex;
+    std::vector<std::unique_ptr<WipeJob>> jobs;
+    const bool multi_device = targets.size() > 1;
+
+    for (const auto& disk : targets) {
+        auto job = std::make_unique<WipeJob>();
+        job->path = disk.path;
+        job->service = make_wipe_service();
+        job->progress = std::make_unique<ProgressDisplay>(
+            disk.path, disk.model, disk.size_bytes, wipe_service_->get_algorithm_name(*algo),
+            wipe_service_->get_pass_count(*algo));
+        job->progress->set_multi_device(multi_device);
+
+        // Progress callback
+        auto callback = [&output_mutex, job = job.get()](const WipeProgress& p) {
+            std::lock_guard lock{output_mutex};
+            if (p.is_complete) {
+                job->final_message = p.status;
+                if (p.has_error && !p.error_message.empty()) {
+                    job->final_message = p.error_message;
+                }
+                if (p.io) {
+                    job->final_message += std::format(
+                        " (disk I/O: {} written, {} read, {} discarded)",
+                        ProgressDisplay::format_bytes(p.io->write_bytes),
+                        ProgressDisplay::format_bytes(p.io->read_bytes),
+                        ProgressDisplay::format_bytes(p.io->discard_bytes));
+                }
+                job->success.store(!p.has_error);
+                job->complete.store(true);
+            } else {
+                job->progress->update(p);
+            }
+        };
+
+        // Start wipe
+        if (!job->service->wipe_disk(disk.path, *algo, callback, options.verify)) {
+            LOG_ERROR("CLI", std::format("Failed to start wipe operation for {}", disk.path));
+            std::lock_guard lock{output_mutex};
+            std::cerr << "Error: Failed to start wipe operation for " << disk.path << ".\n";
+            if (!job->complete.load()) {
+                job->final_message = "Failed to start wipe operation";
+                job->complete.store(true);
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    // Wait for completion, checking for cancellation
+    auto main_context = g_main_context_default();
+    auto all_complete = [&jobs] {
+        return std::all_of(jobs.begin(), jobs.end(),
+                           [](const auto& job) { return job->complete.load(); });
+    };
+    while (!all_complete()) {
+        // Process GLib events for D-Bus signals (no-op in direct mode)
+        g_main_context_iteration(main_context, FALSE);
+
+        if (g_cancel_requested.load()) {
+            for (const auto& job : jobs) {
+                job->service->cancel_current_operation();
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    }
+
+    bool all_succeeded = true;
+    std::lock_guard lock{output_mutex};
+    for (const auto& job : jobs) {
+        job->progress->complete(job->success.load(), job->final_message);
+        all_succeeded = all_succeeded && job->success.load();
+    }
+
+    return all_succeeded ? 0 : 1;
+}
+
+auto CliApplication::cmd_shred(const CliOptions& options) -> int {
+    auto algo = parse_algorithm(options.algorithm);
+    if (!algo) {
+        LOG_ERROR("CLI", std::format("Unknown algorithm: {}", options.algorithm));
+        std::cerr << "Error: Unknown algorithm '" << options.algorithm << "'\n"
+                  << "Run with --help to see available algorithms.\n";
+        return 1;
+    }
+
+    // The helper only accepts absolute paths; duplicates would race each other
+    std::vector<std::string> paths;
+    for (const auto& file : options.shred_paths) {
+        std::error_code ec;
+        auto absolute = std::filesystem::absolute(file, ec);
+        if (ec) {
+            std::cerr << "Error: " << file << ": " << ec.message() << "\n";
+            return 1;
+        }
+        auto normalized = absolute.lexically_normal().string();
+        if (std::find(paths.begin(), paths.end(), normalized) == paths.end()) {
+            paths.push_back(std::move(normalized));
+        }
+    }
+
+    if (!options.no_confirm) {
+        std::string file_list;
+        for (const auto& path : paths) {
+            file_list += (file_list.empty() ? "" : ", ") + path;
+        }
+        if (!confirm_wipe(file_list, options.algorithm)) {
+            std::cout << "Aborted.\n";
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    // Per-file state, keyed by path. Updates arrive concurrently from shred workers
+    // (direct mode) or from the main loop (helper mode).
+    struct ShredJob {
+        std::unique_ptr<ProgressDisplay> progress;
+        bool complete = false;
+        bool success = false;
+        std::string final_message;
+        std::vector<std::string> warnings;
+    };
+
+    std::mutex output_mutex;
+    std::map<std::string, ShredJob> jobs;
+    std::size_t completed = 0;
+    for (const auto& path : paths) {
+        auto& job = jobs[path];
+        job.progress = std::make_unique<ProgressDisplay>(path, "", 0,
+                                                         wipe_service_->get_algorithm_name(*algo),
+                                                         wipe_service_->get_pass_count(*algo));
+        job.progress->set_multi_device(paths.size() > 1);
+    }
+
+    auto callback = [&](const ShredProgress& update) {
+        std::lock_guard lock{output_mutex};
+        auto it = jobs.find(update.path);
+        if (it == jobs.end() || it->second.complete) {
+            return;
+        }
+        auto& job = it->second;
+        if (update.progress.is_complete) {
+            job.final_message =
+                update.progress.has_error ? update.progress.error_message : update.progress.status;
+            job.success = !update.progress.has_error;
+            job.warnings = update.warnings;
+            job.complete = true;
+            ++completed;
+        } else {
+            job.progress->update(update.progress);
+        }
+    };
+
+    if (direct_) {
+        ShredOptions shred_options;
+        shred_options.algorithm = *algo;
+        shred_options.discard = options.discard;
+        FileShredService service;
+        static_cast<void>(service.shred_all(paths, shred_options, callback, g_cancel_requested));
+    } else {
+        if (auto started = client_->shred_files(paths, *algo, options.discard, callback);
+            !started) {
+            LOG_ERROR("CLI", std::format("Failed to start shredding: {}", started.error().message));
+            std::cerr << "Error: " << started.error().message << "\n";
+            return 1;
+        }
+
+        auto main_context = g_main_context_default();
+        bool cancel_sent = false;
+        auto all_complete = [&] {
+            std::lock_guard lock{output_mutex};
+            return completed == jobs.size();
+        };
+        while (!all_complete()) {
+            g_main_context_iteration(main_context, FALSE);
+            if (g_cancel_requested.load() && !cancel_sent) {
+                cancel_sent = client_->cancel_current_operation();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
+    }
+
+    bool all_succeeded = true;
+    std::lock_guard lock{output_mutex};
+    for (const auto& path : paths) {
+        const auto& job = jobs.at(path);
+        job.progress->complete(job.success, job.final_message);
+        for (const auto& warning : job.warnings) {
+            std::cerr << "Warning: " << path << ": " << warning << "\n";
+        }
+        all_succeeded = all_succeeded && job.success;
+    }
+
+    return all_succeeded ? 0 : 1;
+}
+
+auto CliApplication::cmd_free_space(const CliOptions& options) -> int {
+    auto algo = parse_algorithm(options.algorithm);
+    if (!algo) {
+        LOG_ERROR("CLI", std::format("Unknown algorithm: {}", options.algorithm));
+        std::cerr << "Error: Unknown algorithm '" << options.algorithm << "'\n"
+                  << "Run with --help to see available algorithms.\n";
+        return 1;
+    }
+
+    uint64_t reserve = 0;
+    if (!options.reserve.empty()) {
+        auto parsed = parse_size(options.reserve);
+        if (!parsed) {
+            std::cerr << "Error: Invalid reserve size '" << options.reserve << "'\n";
+            return 1;
+        }
+        reserve = *parsed;
+    }
+
+    std::error_code ec;
+    const auto directory =
+        std::filesystem::absolute(options.free_space_directory, ec).lexically_normal().string();
+    if (ec || !std::filesystem::is_directory(directory, ec)) {
+        std::cerr << "Error: " << options.free_space_directory << " is not a directory\n";
+        return 1;
+    }
+
+    const std::string method_name =
+        options.trim ? "FITRIM discard" : wipe_service_->get_algorithm_name(*algo);
+
+    if (!options.no_confirm) {
+        std::cout << "\nThe free space of " << directory << " will be "
+                  << (options.trim ? "discarded" : "filled and overwritten")
+                  << ". Existing files are not touched.\n"
+                  << "Method: " << method_name << "\n\n"
+                  << "Type 'yes' to confirm: ";
+        std::cout.flush();
+        std::string input;
+        std::getline(std::cin, input);
+        if (input != "yes") {
+            std::cout << "Aborted.\n";
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
 
-    // Track completion
+    ProgressDisplay progress{directory, "", 0, method_name,
+                             options.trim ? 1 : wipe_service_->get_pass_count(*algo)};
     std::atomic<bool> complete{false};
     std::atomic<bool> success{false};
     std::string final_message;
+    std::mutex output_mutex;
 
-    // Progress callback
     auto callback = [&](const WipeProgress& p) {
+        std::lock_guard lock{output_mutex};
         if (p.is_complete) {
-            complete.store(true);
+            final_message = p.has_error && !p.error_message.empty() ? p.error_message : p.status;
             success.store(!p.has_error);
-            final_message = p.status;
-            if (p.has_error && !p.error_message.empty()) {
-                final_message = p.error_message;
-            }
+            complete.store(true);
         } else {
             progress.update(p);
         }
     };
 
-    // Start wipe
-    if (!client_->wipe_disk(options.device_path, *algo, callback, options.verify)) {
-        LOG_ERROR("CLI", std::format("Failed to start wipe operation for {}", options.device_path));
-        std::cerr << "Error: Failed to start wipe operation.\n";
-        return 1;
-    }
-
-    // Wait for completion, checking for cancellation
-    auto main_context = g_main_context_default();
-    while (!complete.load()) {
-        // Process GLib events for D-Bus signals
-        g_main_context_iteration(main_context, FALSE);
-
-        if (g_cancel_requested.load()) {
-            client_->cancel_current_operation();
+    if (direct_) {
+        FreeSpaceOptions free_space_options;
+        free_space_options.method = options.trim ? FreeSpaceMethod::TRIM
+                                                 : FreeSpaceMethod::OVERWRITE;
+        free_space_options.algorithm = *algo;
+        if (reserve > 0) {
+            free_space_options.reserve_bytes = reserve;
+        }
+        FreeSpaceWipeService service;
+        static_cast<void>(
+            service.wipe(directory, free_space_options, callback, g_cancel_requested));
+    } else {
+        if (auto started = client_->wipe_free_space(directory, *algo, reserve, options.trim,
+                                                    callback);
+            !started) {
+            LOG_ERROR("CLI",
+                      std::format("Failed to start free-space wipe: {}", started.error().message));
+            std::cerr << "Error: " << started.error().message << "\n";
+            return 1;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        auto main_context = g_main_context_default();
+        bool cancel_sent = false;
+        while (!complete.load()) {
+            g_main_context_iteration(main_context, FALSE);
+            if (g_cancel_requested.load() && !cancel_sent) {
+                cancel_sent = client_->cancel_current_operation();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
     }
 
+    std::lock_guard lock{output_mutex};
     progress.complete(success.load(), final_message);
-
     return success.load() ? 0 : 1;
 }
 
-auto CliApplication::parse_algorithm(const std::string& name) -> std::optional<WipeAlgorithm> {
-    // Convert to lowercase for comparison
-    std::string lower = name;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-
-    if (lower == "zero-fill" || lower == "zero" || lower == "zerofill") {
-        return WipeAlgorithm::ZERO_FILL;
+auto CliApplication::cmd_scan(const CliOptions& options) -> int {
+    auto signatures = verification::default_signatures();
+    for (const auto& spec : options.patterns) {
+        auto signature = verification::parse_signature(spec);
+        if (!signature) {
+            std::cerr << "Error: " << signature.error().message << "\n";
+            return 1;
+        }
+        signatures.push_back(std::move(*signature));
     }
-    if (lower == "random-fill" || lower == "random" || lower == "randomfill") {
-        return WipeAlgorithm::RANDOM_FILL;
+    const verification::SignatureSet signature_set{std::move(signatures)};
+
+    const util::FileDescriptor fd{::open(options.scan_path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (!fd) {
+        std::cerr << "Error: Cannot open " << options.scan_path << ": " << std::strerror(errno)
+                  << (errno == EACCES ? " (run as root)" : "") << "\n";
+        return 1;
     }
-    if (lower == "dod-5220-22-m" || lower == "dod" || lower == "dod522022m") {
-        return WipeAlgorithm::DOD_5220_22_M;
+
+    // Disk images are scanned like devices
+    struct stat st{};
+    if (::fstat(fd.get(), &st) != 0) {
+        std::cerr << "Error: Cannot stat " << options.scan_path << "\n";
+        return 1;
     }
-    if (lower == "schneier") {
-        return WipeAlgorithm::SCHNEIER;
+    auto size = static_cast<uint64_t>(st.st_size);
+    if (S_ISBLK(st.st_mode) && ::ioctl(fd.get(), BLKGETSIZE64, &size) != 0) {
+        std::cerr << "Error: Cannot determine the size of " << options.scan_path << "\n";
+        return 1;
     }
-    if (lower == "vsitr") {
-        return WipeAlgorithm::VSITR;
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    std::unique_ptr<ProgressDisplay> progress;
+    ProgressCallback callback;
+    if (!options.json_output) {
+        progress =
+            std::make_unique<ProgressDisplay>(options.scan_path, "", size, "Residual data scan", 1);
+        callback = [&progress](const WipeProgress& p) { progress->update(p); };
     }
-    if (lower == "gost" || lower == "gost-r-50739-95") {
-        return WipeAlgorithm::GOST_R_50739_95;
+
+    const auto report = verification::scan_residual_data(fd.get(), size, signature_set, callback,
+                                                         g_cancel_requested);
+    const auto& names = signature_set.signatures();
+
+    if (options.json_output) {
+        std::cout << "{\n"
+                  << "  \"device\": \"" << options.scan_path << "\",\n"
+                  << "  \"bytes_scanned\": " << report.bytes_scanned << ",\n"
+                  << "  \"complete\": " << (report.complete ? "true" : "false") << ",\n"
+                  << "  \"total_hits\": " << report.total_hits << ",\n"
+                  << "  \"signatures\": [";
+        bool first = true;
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (report.counts[i] == 0) {
+                continue;
+            }
+            std::cout << (first ? "\n" : ",\n") << "    {\"name\": \"" << names[i].name
+                      << "\", \"count\": " << report.counts[i] << "}";
+            first = false;
+        }
+        std::cout << (first ? "" : "\n  ") << "],\n  \"hits\": [";
+        for (std::size_t i = 0; i < report.hits.size(); ++i) {
+            const auto& hit = report.hits[i];
+            std::cout << (i == 0 ? "\n" : ",\n") << "    {\"offset\": " << hit.offset
+                      << ", \"signature\": \"" << names[hit.signature].name << "\"}";
+        }
+        std::cout << (report.hits.empty() ? "" : "\n  ") << "]\n}\n";
+    } else {
+        progress->complete(report.complete,
+                           report.complete ? std::format("Scanned {} bytes", report.bytes_scanned)
+                                           : std::string{"Scan did not complete"});
+        if (report.total_hits == 0) {
+            std::cout << "No residual data found.\n";
+        } else {
+            std::cout << "Residual data found (" << report.total_hits << " matches):\n";
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                if (report.counts[i] != 0) {
+                    std::cout << "  " << std::left << std::setw(40) << names[i].name
+                              << report.counts[i] << "\n";
+                }
+            }
+            constexpr std::size_t SHOWN_HITS = 20;
+            std::cout << "First matches:\n";
+            for (std::size_t i = 0; i < std::min(SHOWN_HITS, report.hits.size()); ++i) {
+                const auto& hit = report.hits[i];
+                std::cout << std::format("  0x{:012x}  {}\n", hit.offset,
+                                         names[hit.signature].name);
+            }
+        }
     }
-    if (lower == "gutmann") {
-        return WipeAlgorithm::GUTMANN;
+
+    if (!report.complete) {
+        return 1;
     }
+    return report.total_hits == 0 ? 0 : 2;
+}
 
-    return std::nullopt;
+auto CliApplication::parse_algorithm(const std::string& name) -> std::optional<WipeAlgorithm> {
+    return parse_wipe_algorithm(name);
 }
 
 auto CliApplication::algorithm_to_string(WipeAlgorithm algo) -> std::string {
-    switch (algo) {
-        case WipeAlgorithm::ZERO_FILL:
-            return "zero-fill";
-        case WipeAlgorithm::RANDOM_FILL:
-            return "random-fill";
-        case WipeAlgorithm::DOD_5220_22_M:
-            return "dod-5220-22-m";
-        case WipeAlgorithm::SCHNEIER:
-            return "schneier";
-        case WipeAlgorithm::VSITR:
-            return "vsitr";
-        case WipeAlgorithm::GOST_R_50739_95:
-            return "gost";
-        case WipeAlgorithm::GUTMANN:
-            return "gutmann";
-        case WipeAlgorithm::ATA_SECURE_ERASE:
-            return "ata-secure-erase";
-    }
-    return "unknown";
+    return std::string{wipe_algorithm_name(algo)};
 }
 
 auto CliApplication::confirm_wipe(const std::string& device_path, const std::string& algorithm)
@@ -418,6 +864,8 @@ void CliApplication::print_disks_json(const std::vector<DiskInfo>& disks) {
         std::cout << "    \"model\": \"" << disk.model << "\",\n";
         std::cout << "    \"size_bytes\": " << disk.size_bytes << ",\n";
         std::cout << "    \"is_ssd\": " << (disk.is_ssd ? "true" : "false") << ",\n";
+        std::cout << "    \"is_thin_provisioned\": "
+                  << (disk.is_thin_provisioned ? "true" : "false") << ",\n";
         std::cout << "    \"is_removable\": " << (disk.is_removable ? "true" : "false") << ",\n";
         std::cout << "    \"is_mounted\": " << (disk.is_mounted ? "true" : "false") << ",\n";
         std::cout << "    \"mount_point\": \"" << disk.mount_point << "\",\n";
@@ -463,6 +911,8 @@ void CliApplication::print_disks_table(const std::vector<DiskInfo>& disks) {
         std::string type = disk.is_ssd ? "SSD" : "HDD";
         if (disk.is_removable) {
             type = "Removable";
+        } else if (disk.is_thin_provisioned) {
+            type = "Thin";
         }
 
         std::string status = disk.is_mounted ? "Mounted" : "Available";
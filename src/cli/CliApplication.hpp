@@ -7,6 +7,8 @@
 
 #include "models/DiskInfo.hpp"
 #include "models/WipeTypes.hpp"
+#include "services/IDiskService.hpp"
+#include "services/IWipeService.hpp"
 #include "util/Result.hpp"
 
 #include <expected>
@@ -29,11 +31,19 @@ struct CliOptions {
     bool list_disks = false;
     bool json_output = false;
     bool wipe = false;
-    std::string device_path;
+    std::vector<std::string> device_paths;  // --wipe may be repeated (direct mode)
     std::string algorithm = "zero-fill";
     bool verify = false;
     bool force_unmount = false;
     bool no_confirm = false;
+    bool direct = false;
+    std::vector<std::string> shred_paths;  // --shred may be repeated
+    bool discard = false;
+    std::string free_space_directory;
+    std::string reserve;  // Size with optional K/M/G/T suffix; empty = default
+    bool trim = false;
+    std::string scan_path;              // Device or image to search for residual data
+    std::vector<std::string> patterns;  // --pattern may be repeated (with --scan)
 };
 
 /**
@@ -44,6 +54,15 @@ struct CliOptions {
  * - Listing available disks
  * - Wiping disks with various algorithms
  * - Optional verification after wipe
+ * - Shredding individual files
+ * - Wiping the free space of a mounted filesystem
+ * - Scanning a device for residual data (read-only, always in-process)
+ *
+ * Normally every operation goes through the privileged helper over D-Bus. In
+ * direct mode (--direct, or automatically when running as root and the helper
+ * is unreachable) DiskService and WipeService run in-process instead, for
+ * rescue/PXE images without a system bus or polkit. Direct mode can wipe
+ * several devices concurrently, one WipeService per device.
  */
 class CliApplication {
 public:
@@ -87,6 +106,20 @@ private:
      */
     [[nodiscard]] auto connect() -> bool;
 
+    /**
+     * @brief Use in-process disk and wipe services instead of the helper
+     * @return Error if not running as root
+     */
+    [[nodiscard]] auto init_direct() -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Wipe service for one job
+     *
+     * Direct mode creates a fresh WipeService per device so jobs run in
+     * parallel; helper mode always returns the D-Bus client.
+     */
+    [[nodiscard]] auto make_wipe_service() -> std::shared_ptr<IWipeService>;
+
     /**
      * @brief List available disks
      * @param json Output as JSON if true
@@ -101,6 +134,27 @@ private:
      */
     auto cmd_wipe(const CliOptions& options) -> int;
 
+    /**
+     * @brief Overwrite and delete files
+     * @param options Shred options (paths, algorithm, discard)
+     * @return Exit code
+     */
+    auto cmd_shred(const CliOptions& options) -> int;
+
+    /**
+     * @brief Overwrite (or discard) the free space of a mounted filesystem
+     * @param options Free-space options (directory, algorithm, reserve, trim)
+     * @return Exit code
+     */
+    auto cmd_free_space(const CliOptions& options) -> int;
+
+    /**
+     * @brief Search a device for file headers, filesystem and key markers
+     * @param options Scan options (device, extra patterns, JSON output)
+     * @return 0 if nothing was found, 2 if residual data was found, 1 on error
+     */
+    auto cmd_scan(const CliOptions& options) -> int;
+
     /**
      * @brief Convert algorithm string to enum
      * @param name Algorithm name (e.g., "zero-fill", "dod-5220-22-m")
@@ -133,13 +187,10 @@ private:
      */
     void print_disks_table(const std::vector<DiskInfo>& disks);
 
-    /**
-     * @brief Helper to get disks synchronously by pumping the main loop
-     */
-    [[nodiscard]] auto get_disks_blocking()
-        -> std::expected<std::vector<DiskInfo>, util::Error>;
-
-    std::unique_ptr<DBusClient> client_;
+    std::shared_ptr<DBusClient> client_;  // Helper mode only
+    std::shared_ptr<IDiskService> disk_service_;
+    std::shared_ptr<IWipeService> wipe_service_;  // Algorithm metadata, helper-mode wipes
+    bool direct_ = false;
 };
 
 }  // namespace cli
@@ -41,6 +41,10 @@ void ProgressDisplay::set_color_enabled(bool enable) {
     color_enabled_ = enable;
 }
 
+void ProgressDisplay::set_multi_device(bool enable) {
+    multi_device_ = enable;
+}
+
 void ProgressDisplay::update(const WipeProgress& progress) {
     // Print header on first update
     if (!header_printed_) {
@@ -62,6 +66,15 @@ void ProgressDisplay::update(const WipeProgress& progress) {
         header_printed_ = true;
     }
 
+    if (multi_device_) {
+        auto now = std::chrono::steady_clock::now();
+        if (last_line_time_ != std::chrono::steady_clock::time_point{} &&
+            now - last_line_time_ < MULTI_DEVICE_INTERVAL) {
+            return;
+        }
+        last_line_time_ = now;
+    }
+
     // Generate progress bar
     std::string bar = generate_progress_bar(progress.percentage);
 
@@ -87,26 +100,41 @@ void ProgressDisplay::update(const WipeProgress& progress) {
         status_line += "  |  ETA: " + format_duration(progress.estimated_seconds_remaining);
     }
 
+    // Backed off for other workloads (host I/O or memory pressure)
+    if (progress.rate_multiplier < 1.0) {
+        status_line += std::format("  |  throttled to {:.0f}%", progress.rate_multiplier * 100.0);
+    }
+
+    if (multi_device_) {
+        std::cout << device_path_ << ": " << status_line << std::endl;
+        return;
+    }
+
     // Clear line and print
     clear_line();
     std::cout << status_line << std::flush;
 }
 
 void ProgressDisplay::complete(bool success, const std::string& message) {
-    clear_line();
-    std::cout << "\n";
+    if (!multi_device_) {
+        clear_line();
+        std::cout << "\n";
+    }
 
     if (color_enabled_) {
         std::cout << (success ? GREEN : RED) << BOLD;
     }
 
+    if (multi_device_) {
+        std::cout << device_path_ << ": ";
+    }
     std::cout << (success ? "[OK] " : "[FAILED] ") << message;
 
     if (color_enabled_) {
         std::cout << RESET;
     }
 
-    std::cout << "\n" << std::endl;
+    std::cout << (multi_device_ ? "" : "\n") << std::endl;
 }
 
 auto ProgressDisplay::format_bytes(uint64_t bytes) -> std::string {
@@ -52,18 +52,27 @@ public:
      */
     void set_color_enabled(bool enable);
 
+    /**
+     * @brief Print one throttled line per update, prefixed with the device path
+     *
+     * Used when several devices are wiped at once and a single rewritten
+     * status line would interleave. Callers serialize output across displays.
+     * @param enable Whether to use multi-device output
+     */
+    void set_multi_device(bool enable);
+
     /**
      * @brief Check if terminal supports ANSI codes
      * @return true if terminal supports ANSI
      */
     [[nodiscard]] static auto is_terminal() -> bool;
 
-private:
     /**
      * @brief Format bytes as human-readable string (e.g., "245 MB/s")
      */
     [[nodiscard]] static auto format_bytes(uint64_t bytes) -> std::string;
 
+private:
     /**
      * @brief Format speed as human-readable string
      */
@@ -91,9 +100,12 @@ private:
     int total_passes_;
     bool color_enabled_ = true;
     bool header_printed_ = false;
+    bool multi_device_ = false;
     std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point last_line_time_;
 
     static constexpr int BAR_WIDTH = 30;
+    static constexpr auto MULTI_DEVICE_INTERVAL = std::chrono::seconds{5};
 };
 
 }  // namespace cli
@@ -8,11 +8,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace mvvm {
@@ -210,4 +213,92 @@ private:
     mutable std::mutex mutex_;
 };
 
+/**
+ * @class SnapshotObservable
+ * @brief Observable for large values, published as immutable snapshots
+ *
+ * Observable<T> copies the value on every set() and again for every
+ * notification. For lists of hundreds of disks that is several deep copies
+ * per refresh. SnapshotObservable instead keeps a std::shared_ptr<const T>
+ * that is swapped atomically: readers and subscribers share the published
+ * snapshot and may keep it as long as they like, and set() moves the new
+ * value in without copying.
+ *
+ * The subscriber list is copy-on-write as well, so notification iterates a
+ * snapshot of it without copying any std::function or holding a lock.
+ *
+ * @tparam T Value type; must be equality comparable
+ */
+template <typename T>
+class SnapshotObservable {
+public:
+    using Snapshot = std::shared_ptr<const T>;
+    using SnapshotChangedCallback = std::function<void(const Snapshot&)>;
+
+    explicit SnapshotObservable(T initial_value = T{})
+        : value_(std::make_shared<const T>(std::move(initial_value))),
+          subscribers_(std::make_shared<const SubscriberList>()) {}
+
+    /**
+     * @brief Current snapshot; never null, safe to keep after later set() calls
+     */
+    [[nodiscard]] auto get() const -> Snapshot { return value_.load(); }
+
+    /**
+     * @brief Publish a new value and notify subscribers if it differs
+     * @param new_value Value to take ownership of
+     * @return true if value changed, false if same
+     */
+    auto set(T new_value) -> bool {
+        Snapshot snapshot;
+        {
+            std::lock_guard lock(write_mutex_);
+            if (*value_.load() == new_value) {
+                return false;
+            }
+            snapshot = std::make_shared<const T>(std::move(new_value));
+            value_.store(snapshot);
+        }
+        const auto subscribers = subscribers_.load();
+        for (const auto& [id, callback] : *subscribers) {
+            callback(snapshot);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Subscribe to value changes
+     * @param callback Function called with the new snapshot when changed
+     * @return Subscription ID
+     */
+    auto subscribe(SnapshotChangedCallback callback) -> size_t {
+        std::lock_guard lock(write_mutex_);
+        auto id = next_id_++;
+        auto updated = std::make_shared<SubscriberList>(*subscribers_.load());
+        updated->emplace_back(id, std::move(callback));
+        subscribers_.store(std::move(updated));
+        return id;
+    }
+
+    /**
+     * @brief Unsubscribe from value changes
+     * @param id Subscription ID returned from subscribe()
+     * @note A notification already in progress may still call the callback once
+     */
+    void unsubscribe(size_t id) {
+        std::lock_guard lock(write_mutex_);
+        auto updated = std::make_shared<SubscriberList>(*subscribers_.load());
+        std::erase_if(*updated, [id](const auto& entry) { return entry.first == id; });
+        subscribers_.store(std::move(updated));
+    }
+
+private:
+    using SubscriberList = std::vector<std::pair<size_t, SnapshotChangedCallback>>;
+
+    std::atomic<Snapshot> value_;
+    std::atomic<std::shared_ptr<const SubscriberList>> subscribers_;
+    size_t next_id_ = 0;
+    std::mutex write_mutex_;  // Serializes writers; readers never lock
+};
+
 }  // namespace mvvm
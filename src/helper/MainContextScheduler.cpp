@@ -0,0 +1,45 @@
+/**
+ * @file MainContextScheduler.cpp
+ * @brief GLib main context implementation of util::Scheduler
+ */
+
+#include "helper/MainContextScheduler.hpp"
+
+#include <utility>
+
+namespace {
+
+auto dispatch(gpointer data) -> gboolean {
+    auto* callback = static_cast<util::Scheduler::Callback*>(data);
+    (*callback)();
+    return G_SOURCE_REMOVE;
+}
+
+void destroy(gpointer data) {
+    delete static_cast<util::Scheduler::Callback*>(data);
+}
+
+}  // namespace
+
+MainContextScheduler::MainContextScheduler(GMainContext* context)
+    : context_(g_main_context_ref(context ? context : g_main_context_default())) {}
+
+MainContextScheduler::~MainContextScheduler() {
+    g_main_context_unref(context_);
+}
+
+void MainContextScheduler::post(Callback callback) {
+    attach(g_idle_source_new(), std::move(callback));
+}
+
+void MainContextScheduler::post_after(std::chrono::milliseconds delay, Callback callback) {
+    attach(g_timeout_source_new(static_cast<guint>(delay.count())), std::move(callback));
+}
+
+void MainContextScheduler::attach(GSource* source, Callback callback) {
+    // Default priority so resumptions are not starved by idle-priority work
+    g_source_set_priority(source, G_PRIORITY_DEFAULT);
+    g_source_set_callback(source, dispatch, new Callback(std::move(callback)), destroy);
+    g_source_attach(source, context_);
+    g_source_unref(source);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file MainContextScheduler.hpp
+ * @brief util::Scheduler that resumes coroutines on a GLib main context
+ */
+
+#pragma once
+
+#include "util/Coroutine.hpp"
+
+#include <glib.h>
+
+#include <chrono>
+
+/**
+ * @class MainContextScheduler
+ * @brief Posts callbacks as idle/timeout sources on a GMainContext
+ *
+ * Safe to call from any thread: g_source_attach() wakes the owning context.
+ * Callbacks still pending when the context is destroyed are freed unrun.
+ */
+class MainContextScheduler final : public util::Scheduler {
+public:
+    /**
+     * @brief Bind to a main context
+     * @param context Context to dispatch on (nullptr = global default context)
+     */
+    explicit MainContextScheduler(GMainContext* context = nullptr);
+    ~MainContextScheduler() override;
+
+    MainContextScheduler(const MainContextScheduler&) = delete;
+    MainContextScheduler& operator=(const MainContextScheduler&) = delete;
+    MainContextScheduler(MainContextScheduler&&) = delete;
+    MainContextScheduler& operator=(MainContextScheduler&&) = delete;
+
+    void post(Callback callback) override;
+    void post_after(std::chrono::milliseconds delay, Callback callback) override;
+
+private:
+    void attach(GSource* source, Callback callback);
+
+    GMainContext* context_;
+};
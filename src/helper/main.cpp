@@ -5,25 +5,56 @@
  * This privileged helper runs as root and provides D-Bus methods for:
  * - Listing available disks
  * - Performing wipe operations
+ * - Shredding individual files
+ * - Wiping the free space of mounted filesystems
+ * - Read-only surface scans that grade a drive before reuse
+ * - Per-disk I/O limits for wipes (cgroup v2 io controller)
+ * - Backing wipes off while other workloads stall on I/O or memory (PSI)
  * - Progress reporting via D-Bus signals
  *
- * Authorization is handled via polkit.
+ * Authorization is handled via polkit. The helper is D-Bus activated and exits
+ * after an idle period without jobs or clients (see IdlePolicy).
  */
 
+#include "algorithms/AlgorithmFactory.hpp"
+#include "helper/MainContextScheduler.hpp"
 #include "helper/services/DiskService.hpp"
+#include "helper/services/FileShredService.hpp"
+#include "helper/services/FreeSpaceWipeService.hpp"
+#include "helper/services/HotplugMonitor.hpp"
+#include "helper/services/IdlePolicy.hpp"
+#include "helper/services/IoCgroup.hpp"
+#include "helper/services/PressureMonitor.hpp"
+#include "helper/services/StationService.hpp"
+#include "helper/services/SurfaceScanService.hpp"
+#include "helper/services/QueueTuner.hpp"
 #include "helper/services/WipeService.hpp"
 #include "services/DevicePolicy.hpp"
+#include "util/Coroutine.hpp"
 #include "util/Logger.hpp"
+#include "util/WritePacer.hpp"
 
 #include <gio/gio.h>
+#include <glib-unix.h>
 
 #include <algorithm>
-#include <array>
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <expected>
+#include <filesystem>
 #include <format>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <malloc.h>
 #include <polkit/polkit.h>
 
 namespace {
@@ -36,25 +67,82 @@ constexpr auto DBUS_INTERFACE = "su.kidoz.storage_wiper.Helper";
 // Polkit action IDs
 constexpr auto POLKIT_ACTION_LIST_DISKS = "su.kidoz.storage_wiper.list-disks";
 constexpr auto POLKIT_ACTION_WIPE_DISK = "su.kidoz.storage_wiper.wipe-disk";
+constexpr auto POLKIT_ACTION_SCAN_DISK = "su.kidoz.storage_wiper.scan-disk";
+
+// Unmount retry policy (busy filesystems usually settle within a few seconds)
+constexpr int UNMOUNT_MAX_ATTEMPTS = 5;
+constexpr auto UNMOUNT_INITIAL_RETRY_DELAY = std::chrono::milliseconds{250};
 
 // Global state
 GDBusConnection* g_connection = nullptr;
 GMainLoop* g_main_loop = nullptr;
+std::unique_ptr<MainContextScheduler> g_scheduler;
 std::shared_ptr<DiskService> g_disk_service;
 std::unique_ptr<WipeService> g_wipe_service;
+std::shared_ptr<QueueTuner> g_queue_tuner;  // Shared by every wipe, station jobs included
+std::shared_ptr<IoCgroup> g_io_cgroup;      // Null without a delegated io controller
+std::unique_ptr<PressureMonitor> g_pressure_monitor;  // Null without PSI
+std::vector<guint> g_pressure_source_ids;
+std::unique_ptr<HotplugMonitor> g_hotplug_monitor;  // Station mode only
+std::unique_ptr<StationService> g_station;
+guint g_uevent_source_id = 0;
 std::string g_current_wipe_device;
 std::atomic<bool> g_wipe_in_progress{false};
+std::unique_ptr<FileShredService> g_shred_service;
+std::atomic<bool> g_shred_cancel{false};
+std::size_t g_shreds_remaining = 0;    // Main thread only
+std::deque<std::string> g_shred_queue;  // Files no shred worker has picked up; main thread only
+std::unique_ptr<FreeSpaceWipeService> g_free_space_service;
+std::thread g_free_space_thread;
+std::atomic<bool> g_free_space_cancel{false};
+std::unique_ptr<SurfaceScanService> g_surface_scan_service;
+std::optional<IdlePolicy> g_idle_policy;
+guint g_idle_check_id = 0;
+std::unordered_map<std::string, guint> g_client_watches;  // Unique bus name -> watch id
+
+// Upper bound on files per ShredFiles call
+constexpr std::size_t MAX_SHRED_FILES = 4'096;
+
+// Files shredded at once; the others wait in g_shred_queue
+constexpr std::size_t SHRED_PARALLELISM = 4;
+
+// Smallest free-space reserve a caller may request
+constexpr uint64_t MIN_FREE_RESERVE = 64ULL << 20;
+
+// How often the idle policy is consulted
+constexpr guint IDLE_CHECK_INTERVAL_S = 5;
+
+// How often pressure is sampled without a PSI trigger firing (lets the write rate recover)
+constexpr guint PRESSURE_CHECK_INTERVAL_S = 2;
 
 // D-Bus introspection XML
-// GetDisks return type: a(sssxbbsbsu)
+// GetDisks return type: a(sssxbbsbsub)
 //   s=path, s=model, s=serial, x=size_bytes, b=is_removable, b=is_ssd,
 //   s=filesystem, b=is_mounted, s=mount_point, u=smart_status
-//   (0=unknown,1=good,2=warning,3=critical)
+//   (0=unknown,1=good,2=warning,3=critical), b=is_thin_provisioned
+// GetInventory return type: (as a(uuuuuutyy))
+//   as=string table (index 0 is ""), then per disk: u=device_id, u=path, u=model,
+//   u=serial, u=filesystem, u=mount_point (string table indexes), t=size_bytes,
+//   y=DiskInventory flags, y=smart_status
+// GetSurfaceScanReport return type: (bbssatadada(tuu)at)
+//   b=available, b=complete, s=grade, s=summary, at=latency histogram (<10, <50, <150,
+//   <500, >=500 ms), ad=mean and ad=worst read per region in ms, a(tuu)=slow reads
+//   (offset, length, latency us), at=unreadable sector byte offsets
+// SetIoLimits arguments: s=device, t=read_bps, t=write_bps, t=read_iops, t=write_iops,
+//   u=weight (1-10000), t=latency_target_us; 0 leaves a setting at the kernel default
+// GetIoStat return type: (btttttt) b=available, then bytes and requests read, written,
+//   discarded on the device's disk by the helper (wipes, scans, shreds) since it started
+// WipeProgress ends in (bttt): b=io_accounted, then bytes read, written and discarded by
+//   the job, from io.stat; set on the completion update only
 const char* introspection_xml = R"XML(
 <node>
   <interface name="su.kidoz.storage_wiper.Helper">
     <method name="GetDisks">
-      <arg name="disks" type="a(sssxbbsbsu)" direction="out"/>
+      <arg name="disks" type="a(sssxbbsbsub)" direction="out"/>
+    </method>
+    <method name="GetInventory">
+      <arg name="strings" type="as" direction="out"/>
+      <arg name="disks" type="a(uuuuuutyy)" direction="out"/>
     </method>
     <method name="GetDiskSMART">
       <arg name="path" type="s" direction="in"/>
@@ -94,6 +182,63 @@ const char* introspection_xml = R"XML(
     <method name="CancelWipe">
       <arg name="cancelled" type="b" direction="out"/>
     </method>
+    <method name="ShredFiles">
+      <arg name="paths" type="as" direction="in"/>
+      <arg name="algorithm_id" type="u" direction="in"/>
+      <arg name="discard" type="b" direction="in"/>
+      <arg name="started" type="b" direction="out"/>
+      <arg name="error_message" type="s" direction="out"/>
+    </method>
+    <method name="WipeFreeSpace">
+      <arg name="directory" type="s" direction="in"/>
+      <arg name="algorithm_id" type="u" direction="in"/>
+      <arg name="reserve_bytes" type="t" direction="in"/>
+      <arg name="trim" type="b" direction="in"/>
+      <arg name="started" type="b" direction="out"/>
+      <arg name="error_message" type="s" direction="out"/>
+    </method>
+    <method name="StartSurfaceScan">
+      <arg name="device_path" type="s" direction="in"/>
+      <arg name="started" type="b" direction="out"/>
+      <arg name="error_message" type="s" direction="out"/>
+    </method>
+    <method name="CancelSurfaceScan">
+      <arg name="device_path" type="s" direction="in"/>
+      <arg name="cancelled" type="b" direction="out"/>
+    </method>
+    <method name="GetSurfaceScanReport">
+      <arg name="device_path" type="s" direction="in"/>
+      <arg name="available" type="b" direction="out"/>
+      <arg name="complete" type="b" direction="out"/>
+      <arg name="grade" type="s" direction="out"/>
+      <arg name="summary" type="s" direction="out"/>
+      <arg name="histogram" type="at" direction="out"/>
+      <arg name="region_mean_ms" type="ad" direction="out"/>
+      <arg name="region_max_ms" type="ad" direction="out"/>
+      <arg name="slow_reads" type="a(tuu)" direction="out"/>
+      <arg name="failed_sectors" type="at" direction="out"/>
+    </method>
+    <method name="SetIoLimits">
+      <arg name="device_path" type="s" direction="in"/>
+      <arg name="read_bps" type="t" direction="in"/>
+      <arg name="write_bps" type="t" direction="in"/>
+      <arg name="read_iops" type="t" direction="in"/>
+      <arg name="write_iops" type="t" direction="in"/>
+      <arg name="weight" type="u" direction="in"/>
+      <arg name="latency_target_us" type="t" direction="in"/>
+      <arg name="success" type="b" direction="out"/>
+      <arg name="error_message" type="s" direction="out"/>
+    </method>
+    <method name="GetIoStat">
+      <arg name="device_path" type="s" direction="in"/>
+      <arg name="available" type="b" direction="out"/>
+      <arg name="read_bytes" type="t" direction="out"/>
+      <arg name="write_bytes" type="t" direction="out"/>
+      <arg name="read_ios" type="t" direction="out"/>
+      <arg name="write_ios" type="t" direction="out"/>
+      <arg name="discard_bytes" type="t" direction="out"/>
+      <arg name="discard_ios" type="t" direction="out"/>
+    </method>
     <signal name="WipeProgress">
       <arg name="device_path" type="s"/>
       <arg name="percentage" type="d"/>
@@ -111,19 +256,80 @@ const char* introspection_xml = R"XML(
       <arg name="verification_in_progress" type="b"/>
       <arg name="verification_passed" type="b"/>
       <arg name="verification_percentage" type="d"/>
+      <arg name="rate_multiplier" type="d"/>
+      <arg name="io_accounted" type="b"/>
+      <arg name="io_read_bytes" type="t"/>
+      <arg name="io_write_bytes" type="t"/>
+      <arg name="io_discard_bytes" type="t"/>
+    </signal>
+    <signal name="SurfaceScanProgress">
+      <arg name="device_path" type="s"/>
+      <arg name="percentage" type="d"/>
+      <arg name="status" type="s"/>
+      <arg name="is_complete" type="b"/>
+      <arg name="has_error" type="b"/>
+      <arg name="error_message" type="s"/>
+      <arg name="bytes_read" type="t"/>
+      <arg name="total_bytes" type="t"/>
+      <arg name="speed_bytes_per_sec" type="t"/>
+      <arg name="estimated_seconds_remaining" type="x"/>
+    </signal>
+    <signal name="ShredProgress">
+      <arg name="path" type="s"/>
+      <arg name="percentage" type="d"/>
+      <arg name="current_pass" type="i"/>
+      <arg name="total_passes" type="i"/>
+      <arg name="status" type="s"/>
+      <arg name="is_complete" type="b"/>
+      <arg name="has_error" type="b"/>
+      <arg name="error_message" type="s"/>
+      <arg name="bytes_written" type="t"/>
+      <arg name="total_bytes" type="t"/>
+      <arg name="warnings" type="as"/>
+    </signal>
+    <signal name="StationWipeQueued">
+      <arg name="device_path" type="s"/>
+      <arg name="port_path" type="s"/>
+      <arg name="rule" type="s"/>
+      <arg name="estimate" type="s"/>
+    </signal>
+    <signal name="StationWipeStarted">
+      <arg name="device_path" type="s"/>
+      <arg name="port_path" type="s"/>
+      <arg name="rule" type="s"/>
+      <arg name="details" type="s"/>
+    </signal>
+    <signal name="StationWipeFinished">
+      <arg name="device_path" type="s"/>
+      <arg name="port_path" type="s"/>
+      <arg name="rule" type="s"/>
+      <arg name="success" type="b"/>
+      <arg name="message" type="s"/>
     </signal>
   </interface>
 </node>
 )XML";
 
 auto is_supported_algorithm(WipeAlgorithm algorithm) -> bool {
-    constexpr std::array supported_algorithms = {
-        WipeAlgorithm::ZERO_FILL, WipeAlgorithm::RANDOM_FILL, WipeAlgorithm::DOD_5220_22_M,
-        WipeAlgorithm::SCHNEIER,  WipeAlgorithm::VSITR,       WipeAlgorithm::GOST_R_50739_95,
-        WipeAlgorithm::GUTMANN};
+    return is_offered_wipe_algorithm(algorithm);
+}
+
+/**
+ * Whether two device paths lead to the same disk: /dev/sdb, /dev/sdb1 and a
+ * /dev/disk/by-id link to either are all one drive
+ */
+auto same_disk(const std::string& a, const std::string& b) -> bool {
+    if (a == b) {
+        return true;
+    }
+    const auto disk = disk_number(a);
+    return disk.has_value() && disk == disk_number(b);
+}
 
-    return std::find(supported_algorithms.begin(), supported_algorithms.end(), algorithm) !=
-           supported_algorithms.end();
+auto is_scanning_disk(const std::string& device) -> bool {
+    return std::ranges::any_of(
+        g_surface_scan_service->active_devices(),
+        [&device](const std::string& scanned) { return same_disk(scanned, device); });
 }
 
 /**
@@ -186,17 +392,22 @@ auto check_authorization(GDBusMethodInvocation* invocation, const char* action_i
 
 /**
  * Emit WipeProgress signal on D-Bus
+ *
+ * The completion update carries the job's io.stat delta when the helper has
+ * an io cgroup (io_accounted).
  */
-void emit_wipe_progress(const WipeProgress& progress) {
+void emit_wipe_progress(const std::string& device_path, const WipeProgress& progress) {
     if (!g_connection)
         return;
 
+    const auto io = progress.io.value_or(IoStat{});
+
     GError* error = nullptr;
     g_dbus_connection_emit_signal(
         g_connection,
         nullptr,  // broadcast to all
         DBUS_PATH, DBUS_INTERFACE, "WipeProgress",
-        g_variant_new("(sdiisbbstttxbbbd)", g_current_wipe_device.c_str(), progress.percentage,
+        g_variant_new("(sdiisbbstttxbbbddbttt)", device_path.c_str(), progress.percentage,
                       progress.current_pass, progress.total_passes, progress.status.c_str(),
                       progress.is_complete ? TRUE : FALSE, progress.has_error ? TRUE : FALSE,
                       progress.error_message.c_str(), static_cast<guint64>(progress.bytes_written),
@@ -206,7 +417,10 @@ void emit_wipe_progress(const WipeProgress& progress) {
                       progress.verification_enabled ? TRUE : FALSE,
                       progress.verification_in_progress ? TRUE : FALSE,
                       progress.verification_passed ? TRUE : FALSE,
-                      progress.verification_percentage),
+                      progress.verification_percentage, progress.rate_multiplier,
+                      progress.io ? TRUE : FALSE, static_cast<guint64>(io.read_bytes),
+                      static_cast<guint64>(io.write_bytes),
+                      static_cast<guint64>(io.discard_bytes)),
         &error);
 
     if (error) {
@@ -215,44 +429,253 @@ void emit_wipe_progress(const WipeProgress& progress) {
     }
 }
 
+void emit_wipe_progress(const WipeProgress& progress) {
+    emit_wipe_progress(g_current_wipe_device, progress);
+}
+
 /**
- * Handle GetDisks method call
+ * Emit SurfaceScanProgress signal on D-Bus
+ *
+ * A signal of its own, so clients following a wipe through WipeProgress never
+ * mistake a concurrent scan of another drive for it.
  */
-void handle_get_disks(GDBusMethodInvocation* invocation) {
-    if (!check_authorization(invocation, POLKIT_ACTION_LIST_DISKS)) {
+void emit_surface_scan_progress(const std::string& device_path, const WipeProgress& progress) {
+    if (!g_connection)
         return;
+
+    GError* error = nullptr;
+    g_dbus_connection_emit_signal(
+        g_connection, nullptr, DBUS_PATH, DBUS_INTERFACE, "SurfaceScanProgress",
+        g_variant_new("(sdsbbstttx)", device_path.c_str(), progress.percentage,
+                      progress.status.c_str(), progress.is_complete ? TRUE : FALSE,
+                      progress.has_error ? TRUE : FALSE, progress.error_message.c_str(),
+                      static_cast<guint64>(progress.bytes_written),
+                      static_cast<guint64>(progress.total_bytes),
+                      static_cast<guint64>(progress.speed_bytes_per_sec),
+                      static_cast<gint64>(progress.estimated_seconds_remaining)),
+        &error);
+
+    if (error) {
+        LOG_ERROR("Helper", std::format("Failed to emit signal: {}", error->message));
+        g_error_free(error);
     }
+}
+
+/**
+ * Emit ShredProgress signal on D-Bus
+ */
+void emit_shred_progress(const ShredProgress& update) {
+    if (!g_connection)
+        return;
+
+    GVariantBuilder warnings;
+    g_variant_builder_init(&warnings, G_VARIANT_TYPE("as"));
+    for (const auto& warning : update.warnings) {
+        g_variant_builder_add(&warnings, "s", warning.c_str());
+    }
+
+    const auto& progress = update.progress;
+    GError* error = nullptr;
+    g_dbus_connection_emit_signal(
+        g_connection, nullptr, DBUS_PATH, DBUS_INTERFACE, "ShredProgress",
+        g_variant_new("(sdiisbbsttas)", update.path.c_str(), progress.percentage,
+                      progress.current_pass, progress.total_passes, progress.status.c_str(),
+                      progress.is_complete ? TRUE : FALSE, progress.has_error ? TRUE : FALSE,
+                      progress.error_message.c_str(), static_cast<guint64>(progress.bytes_written),
+                      static_cast<guint64>(progress.total_bytes), &warnings),
+        &error);
 
-    auto disks = g_disk_service->get_available_disks_sync();
+    if (error) {
+        LOG_ERROR("Helper", std::format("Failed to emit ShredProgress: {}", error->message));
+        g_error_free(error);
+    }
+}
+
+/**
+ * Unix user id of the D-Bus caller
+ */
+auto get_caller_uid(GDBusMethodInvocation* invocation) -> std::optional<uid_t> {
+    GError* error = nullptr;
+    GVariant* result = g_dbus_connection_call_sync(
+        g_dbus_method_invocation_get_connection(invocation), "org.freedesktop.DBus",
+        "/org/freedesktop/DBus", "org.freedesktop.DBus", "GetConnectionUnixUser",
+        g_variant_new("(s)", g_dbus_method_invocation_get_sender(invocation)),
+        G_VARIANT_TYPE("(u)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+
+    if (!result) {
+        LOG_ERROR("Helper", std::format("GetConnectionUnixUser failed: {}",
+                                        error ? error->message : "unknown"));
+        g_clear_error(&error);
+        return std::nullopt;
+    }
+
+    guint32 uid = 0;
+    g_variant_get(result, "(u)", &uid);
+    g_variant_unref(result);
+    return static_cast<uid_t>(uid);
+}
+
+/**
+ * Emit StationWipeQueued/StationWipeStarted/StationWipeFinished signals on D-Bus
+ */
+void emit_station_event(const StationEvent& event) {
+    if (!g_connection || event.kind == StationEvent::Kind::IGNORED) {
+        return;
+    }
+
+    GVariant* parameters = nullptr;
+    const char* signal_name = nullptr;
+    if (event.kind == StationEvent::Kind::QUEUED || event.kind == StationEvent::Kind::STARTED) {
+        signal_name = event.kind == StationEvent::Kind::QUEUED ? "StationWipeQueued"
+                                                               : "StationWipeStarted";
+        parameters = g_variant_new("(ssss)", event.device_path.c_str(), event.port_path.c_str(),
+                                   event.rule.c_str(), event.message.c_str());
+    } else {
+        signal_name = "StationWipeFinished";
+        parameters = g_variant_new("(sssbs)", event.device_path.c_str(), event.port_path.c_str(),
+                                   event.rule.c_str(), event.success ? TRUE : FALSE,
+                                   event.message.c_str());
+    }
+
+    GError* error = nullptr;
+    g_dbus_connection_emit_signal(g_connection, nullptr, DBUS_PATH, DBUS_INTERFACE, signal_name,
+                                  parameters, &error);
+    if (error) {
+        LOG_ERROR("Helper", std::format("Failed to emit {}: {}", signal_name, error->message));
+        g_error_free(error);
+    }
+}
+
+/**
+ * Drain hotplug uevents into the station service
+ */
+auto on_uevent_readable(gint /*fd*/, GIOCondition /*condition*/, gpointer /*user_data*/)
+    -> gboolean {
+    for (const auto& event : g_hotplug_monitor->read_events()) {
+        g_station->on_uevent(event);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * Enable hotplug auto-wipe if the station config turns it on
+ */
+void start_station_mode() {
+    auto config = StationConfig::load();
+    if (!config) {
+        LOG_ERROR("Helper", std::format("Station mode disabled: {}", config.error().message));
+        return;
+    }
+    if (!config->enabled) {
+        return;
+    }
+
+    auto monitor = std::make_unique<HotplugMonitor>();
+    if (auto opened = monitor->open(); !opened) {
+        LOG_ERROR("Helper", std::format("Station mode disabled: {}", opened.error().message));
+        return;
+    }
+
+    g_hotplug_monitor = std::move(monitor);
+    // Hot-plugged disks already under a manual wipe or surface scan are left alone
+    auto busy_elsewhere = [](const std::string& device) -> std::optional<std::string> {
+        if (g_wipe_in_progress.load() && same_disk(g_current_wipe_device, device)) {
+            return "device is being wiped";
+        }
+        if (is_scanning_disk(device)) {
+            return "device is being surface scanned";
+        }
+        return std::nullopt;
+    };
+    g_station = std::make_unique<StationService>(
+        std::move(*config), g_disk_service,
+        [] { return std::make_shared<WipeService>(g_disk_service, g_queue_tuner, g_io_cgroup); },
+        *g_scheduler, emit_station_event, std::chrono::steady_clock::now, same_disk,
+        busy_elsewhere);
+    g_uevent_source_id =
+        g_unix_fd_add(g_hotplug_monitor->fd(), G_IO_IN, on_uevent_readable, nullptr);
+}
+
+/**
+ * Enumerate disks off the main loop and reply when done
+ */
+auto get_disks_task(GDBusMethodInvocation* invocation) -> util::Task<> {
+    auto disks = co_await util::run_blocking(
+        *g_scheduler, [] { return g_disk_service->get_available_disks_sync(); });
 
     GVariantBuilder builder;
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(sssxbbsbsu)"));
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(sssxbbsbsub)"));
 
     for (const auto& disk : disks) {
         // Convert SmartData::HealthStatus to uint32
         auto smart_status = static_cast<guint32>(disk.smart.status);
-        g_variant_builder_add(&builder, "(sssxbbsbsu)", disk.path.c_str(), disk.model.c_str(),
+        g_variant_builder_add(&builder, "(sssxbbsbsub)", disk.path.c_str(), disk.model.c_str(),
                               disk.serial.c_str(), static_cast<gint64>(disk.size_bytes),
                               disk.is_removable ? TRUE : FALSE, disk.is_ssd ? TRUE : FALSE,
                               disk.filesystem.c_str(), disk.is_mounted ? TRUE : FALSE,
-                              disk.mount_point.c_str(), smart_status);
+                              disk.mount_point.c_str(), smart_status,
+                              disk.is_thin_provisioned ? TRUE : FALSE);
     }
 
-    g_dbus_method_invocation_return_value(invocation, g_variant_new("(a(sssxbbsbsu))", &builder));
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(a(sssxbbsbsub))", &builder));
 }
 
 /**
- * Handle GetDiskSMART method call
+ * Handle GetDisks method call
  */
-void handle_get_disk_smart(GDBusMethodInvocation* invocation, GVariant* parameters) {
+void handle_get_disks(GDBusMethodInvocation* invocation) {
     if (!check_authorization(invocation, POLKIT_ACTION_LIST_DISKS)) {
         return;
     }
 
-    const char* path = nullptr;
-    g_variant_get(parameters, "(&s)", &path);
+    util::spawn(get_disks_task(invocation));
+}
+
+/**
+ * Reply with the cached inventory snapshot: strings once, rows as integers
+ */
+auto get_inventory_task(GDBusMethodInvocation* invocation) -> util::Task<> {
+    auto inventory = co_await util::run_blocking(
+        *g_scheduler, [] { return g_disk_service->get_inventory(); });
+
+    GVariantBuilder strings;
+    g_variant_builder_init(&strings, G_VARIANT_TYPE("as"));
+    for (DiskInventory::StringId id = 0; id < inventory->string_count(); ++id) {
+        const std::string value{inventory->string(id)};
+        g_variant_builder_add(&strings, "s", value.c_str());
+    }
+
+    GVariantBuilder rows;
+    g_variant_builder_init(&rows, G_VARIANT_TYPE("a(uuuuuutyy)"));
+    for (std::size_t i = 0; i < inventory->size(); ++i) {
+        const auto row = inventory->row(i);
+        g_variant_builder_add(&rows, "(uuuuuutyy)", row.id, row.path, row.model, row.serial,
+                              row.filesystem, row.mount_point,
+                              static_cast<guint64>(row.size_bytes), row.flags,
+                              static_cast<guchar>(row.smart.status));
+    }
+
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(asa(uuuuuutyy))", &strings, &rows));
+}
+
+/**
+ * Handle GetInventory method call
+ */
+void handle_get_inventory(GDBusMethodInvocation* invocation) {
+    if (!check_authorization(invocation, POLKIT_ACTION_LIST_DISKS)) {
+        return;
+    }
 
-    auto smart = g_disk_service->get_smart_data(path ? path : "");
+    util::spawn(get_inventory_task(invocation));
+}
+
+/**
+ * Query SMART on the blocking I/O lane and reply when done
+ */
+auto get_disk_smart_task(GDBusMethodInvocation* invocation, std::string path) -> util::Task<> {
+    auto smart = co_await util::run_blocking(
+        *g_scheduler, [&path] { return g_disk_service->get_smart_data(path); });
 
     g_dbus_method_invocation_return_value(
         invocation,
@@ -262,6 +685,20 @@ void handle_get_disk_smart(GDBusMethodInvocation* invocation, GVariant* paramete
                       static_cast<guint32>(smart.status)));
 }
 
+/**
+ * Handle GetDiskSMART method call
+ */
+void handle_get_disk_smart(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_LIST_DISKS)) {
+        return;
+    }
+
+    const char* path = nullptr;
+    g_variant_get(parameters, "(&s)", &path);
+
+    util::spawn(get_disk_smart_task(invocation, path ? path : ""));
+}
+
 /**
  * Handle ValidateDevicePath method call
  */
@@ -293,6 +730,32 @@ void handle_is_device_writable(GDBusMethodInvocation* invocation, GVariant* para
                                           g_variant_new("(b)", writable ? TRUE : FALSE));
 }
 
+/**
+ * Unmount with exponential-backoff retries, suspended (not blocking) between attempts
+ */
+auto unmount_device_task(GDBusMethodInvocation* invocation, std::string path) -> util::Task<> {
+    std::expected<void, util::Error> result;
+    auto delay = UNMOUNT_INITIAL_RETRY_DELAY;
+
+    for (int attempt = 1; attempt <= UNMOUNT_MAX_ATTEMPTS; ++attempt) {
+        result = co_await util::run_blocking(
+            *g_scheduler, [&path] { return g_disk_service->unmount_disk(path); });
+        if (result || attempt == UNMOUNT_MAX_ATTEMPTS) {
+            break;
+        }
+
+        LOG_INFO("Helper", std::format("Unmount of {} failed (attempt {}/{}): {}; retrying",
+                                       path, attempt, UNMOUNT_MAX_ATTEMPTS,
+                                       result.error().message));
+        co_await util::sleep_for(*g_scheduler, delay);
+        delay *= 2;
+    }
+
+    g_dbus_method_invocation_return_value(
+        invocation, g_variant_new("(bs)", result.has_value() ? TRUE : FALSE,
+                                  result.has_value() ? "" : result.error().message.c_str()));
+}
+
 /**
  * Handle UnmountDevice method call
  */
@@ -304,12 +767,16 @@ void handle_unmount_device(GDBusMethodInvocation* invocation, GVariant* paramete
 
     const char* path = nullptr;
     g_variant_get(parameters, "(&s)", &path);
+    std::string device{path ? path : ""};
 
-    auto result = g_disk_service->unmount_disk(path ? path : "");
+    // Path validation failures are permanent; only retry real unmount failures
+    if (auto valid = g_disk_service->validate_device_path(device); !valid) {
+        g_dbus_method_invocation_return_value(
+            invocation, g_variant_new("(bs)", FALSE, valid.error().message.c_str()));
+        return;
+    }
 
-    g_dbus_method_invocation_return_value(
-        invocation, g_variant_new("(bs)", result.has_value() ? TRUE : FALSE,
-                                  result.has_value() ? "" : result.error().message.c_str()));
+    util::spawn(unmount_device_task(invocation, std::move(device)));
 }
 
 /**
@@ -319,12 +786,7 @@ void handle_get_algorithms(GDBusMethodInvocation* invocation) {
     GVariantBuilder builder;
     g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ussi)"));
 
-    constexpr std::array algorithms = {WipeAlgorithm::ZERO_FILL,     WipeAlgorithm::RANDOM_FILL,
-                                       WipeAlgorithm::DOD_5220_22_M, WipeAlgorithm::SCHNEIER,
-                                       WipeAlgorithm::VSITR,         WipeAlgorithm::GOST_R_50739_95,
-                                       WipeAlgorithm::GUTMANN};
-
-    for (auto algo : algorithms) {
+    for (auto algo : OFFERED_WIPE_ALGORITHMS) {
         g_variant_builder_add(&builder, "(ussi)", static_cast<guint32>(algo),
                               g_wipe_service->get_algorithm_name(algo).c_str(),
                               g_wipe_service->get_algorithm_description(algo).c_str(),
@@ -355,6 +817,17 @@ void handle_start_wipe(GDBusMethodInvocation* invocation, GVariant* parameters)
 
     const std::string device{device_path ? device_path : ""};
 
+    if (g_station && g_station->is_busy(device)) {
+        g_dbus_method_invocation_return_value(
+            invocation, g_variant_new("(bs)", FALSE, "Device is being wiped by station mode"));
+        return;
+    }
+    if (is_scanning_disk(device)) {
+        g_dbus_method_invocation_return_value(
+            invocation, g_variant_new("(bs)", FALSE, "Device is being surface scanned"));
+        return;
+    }
+
     // Validate algorithm
     auto algorithm = static_cast<WipeAlgorithm>(algorithm_id);
     if (!is_supported_algorithm(algorithm)) {
@@ -400,6 +873,380 @@ void handle_start_wipe(GDBusMethodInvocation* invocation, GVariant* parameters)
     g_dbus_method_invocation_return_value(invocation, g_variant_new("(bs)", TRUE, ""));
 }
 
+/**
+ * Shreds get threads of their own, so a call naming thousands of files cannot
+ * crowd SMART queries, enumeration and scans off the shared blocking-I/O lane
+ */
+auto shred_pool() -> util::Executor& {
+    static util::Executor pool{{.compute_threads = 1, .io_threads = SHRED_PARALLELISM}};
+    return pool;
+}
+
+/**
+ * Shred queued files one at a time; the last file to finish frees the helper
+ */
+auto shred_worker(ShredOptions options) -> util::Task<> {
+    auto on_progress = [](const ShredProgress& update) {
+        g_scheduler->post([update] { emit_shred_progress(update); });
+    };
+    while (!g_shred_queue.empty()) {
+        auto path = std::move(g_shred_queue.front());
+        g_shred_queue.pop_front();
+
+        auto shred = [&path, &options, &on_progress] {
+            return g_shred_service->shred(path, options, on_progress, g_shred_cancel);
+        };
+        static_cast<void>(co_await util::run_blocking(*g_scheduler, shred,
+                                                      util::TaskLane::BLOCKING_IO, shred_pool(),
+                                                      util::TaskPriority::BULK));
+
+        if (--g_shreds_remaining == 0) {
+            g_wipe_in_progress.store(false);
+        }
+    }
+}
+
+/**
+ * Handle ShredFiles method call
+ */
+void handle_shred_files(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_WIPE_DISK)) {
+        return;
+    }
+
+    GVariantIter* path_iter = nullptr;
+    guint32 algorithm_id = 0;
+    gboolean discard = FALSE;
+    g_variant_get(parameters, "(asub)", &path_iter, &algorithm_id, &discard);
+
+    std::vector<std::string> paths;
+    const gchar* path = nullptr;
+    while (g_variant_iter_next(path_iter, "&s", &path)) {
+        paths.emplace_back(path);
+    }
+    g_variant_iter_free(path_iter);
+
+    auto reject = [invocation](const char* message) {
+        g_dbus_method_invocation_return_value(invocation, g_variant_new("(bs)", FALSE, message));
+    };
+
+    if (g_wipe_in_progress.load()) {
+        reject("A wipe operation is already in progress");
+        return;
+    }
+    if (paths.empty() || paths.size() > MAX_SHRED_FILES) {
+        reject("Invalid number of files");
+        return;
+    }
+    if (std::ranges::any_of(paths, [](const std::string& p) { return !p.starts_with('/'); })) {
+        reject("File paths must be absolute");
+        return;
+    }
+
+    auto algorithm = static_cast<WipeAlgorithm>(algorithm_id);
+    if (!is_supported_algorithm(algorithm)) {
+        reject("Unsupported wipe algorithm");
+        return;
+    }
+
+    // The helper runs as root; only let callers destroy files they own
+    auto uid = get_caller_uid(invocation);
+    if (!uid) {
+        reject("Could not determine caller");
+        return;
+    }
+
+    ShredOptions options;
+    options.algorithm = algorithm;
+    options.discard = discard != FALSE;
+    options.required_owner = *uid;
+
+    g_shred_cancel.store(false);
+    g_wipe_in_progress.store(true);
+    g_shreds_remaining = paths.size();
+    g_shred_queue.assign(std::make_move_iterator(paths.begin()),
+                         std::make_move_iterator(paths.end()));
+    for (std::size_t i = 0; i < std::min(SHRED_PARALLELISM, g_shreds_remaining); ++i) {
+        util::spawn(shred_worker(options));
+    }
+
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(bs)", TRUE, ""));
+}
+
+/**
+ * Handle WipeFreeSpace method call
+ *
+ * Progress is reported through WipeProgress with the directory as device path.
+ */
+void handle_wipe_free_space(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_WIPE_DISK)) {
+        return;
+    }
+
+    const char* directory_arg = nullptr;
+    guint32 algorithm_id = 0;
+    guint64 reserve_bytes = 0;
+    gboolean trim = FALSE;
+    g_variant_get(parameters, "(&sutb)", &directory_arg, &algorithm_id, &reserve_bytes, &trim);
+    const std::string requested{directory_arg ? directory_arg : ""};
+
+    auto reject = [invocation](const std::string& message) {
+        g_dbus_method_invocation_return_value(invocation,
+                                              g_variant_new("(bs)", FALSE, message.c_str()));
+    };
+
+    if (g_wipe_in_progress.load()) {
+        reject("A wipe operation is already in progress");
+        return;
+    }
+    std::error_code ec;
+    const auto canonical = std::filesystem::canonical(requested, ec);
+    if (!requested.starts_with('/') || ec) {
+        reject("Not an absolute path to a directory");
+        return;
+    }
+    const std::string directory = canonical.string();
+
+    auto algorithm = static_cast<WipeAlgorithm>(algorithm_id);
+    if (!is_supported_algorithm(algorithm)) {
+        reject("Unsupported wipe algorithm");
+        return;
+    }
+
+    // The helper runs as root; only fill directories the caller could fill itself
+    auto uid = get_caller_uid(invocation);
+    if (!uid) {
+        reject("Could not determine caller");
+        return;
+    }
+    if (auto checked = FreeSpaceWipeService::check_directory(directory, *uid); !checked) {
+        reject(checked.error().message);
+        return;
+    }
+
+    FreeSpaceOptions options;
+    options.method = trim != FALSE ? FreeSpaceMethod::TRIM : FreeSpaceMethod::OVERWRITE;
+    options.algorithm = algorithm;
+    options.required_owner = *uid;
+    options.reserve_bytes = std::max<uint64_t>(reserve_bytes, MIN_FREE_RESERVE);
+    if (reserve_bytes == 0) {
+        options.reserve_bytes = FreeSpaceOptions::DEFAULT_RESERVE;
+    }
+
+    // The previous job has reported completion; reap its thread
+    if (g_free_space_thread.joinable()) {
+        g_free_space_thread.join();
+    }
+
+    g_current_wipe_device = directory;
+    g_free_space_cancel.store(false);
+    g_wipe_in_progress.store(true);
+    g_free_space_thread = std::thread([directory, options] {
+        auto on_progress = [](const WipeProgress& progress) {
+            g_scheduler->post([progress] {
+                emit_wipe_progress(progress);
+                if (progress.is_complete) {
+                    g_wipe_in_progress.store(false);
+                }
+            });
+        };
+        static_cast<void>(
+            g_free_space_service->wipe(directory, options, on_progress, g_free_space_cancel));
+    });
+
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(bs)", TRUE, ""));
+}
+
+/**
+ * Handle StartSurfaceScan method call
+ *
+ * Progress is reported through SurfaceScanProgress with the device path; the
+ * last update carries the grade in its status.
+ */
+void handle_start_surface_scan(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_SCAN_DISK)) {
+        return;
+    }
+
+    const char* device_arg = nullptr;
+    g_variant_get(parameters, "(&s)", &device_arg);
+    const std::string device{device_arg ? device_arg : ""};
+
+    auto reject = [invocation](const std::string& message) {
+        g_dbus_method_invocation_return_value(invocation,
+                                              g_variant_new("(bs)", FALSE, message.c_str()));
+    };
+
+    // Scans run alongside wipes of other drives, but never on the drive being wiped
+    if (g_wipe_in_progress.load() && same_disk(g_current_wipe_device, device)) {
+        reject("Device is being wiped");
+        return;
+    }
+    if (!g_surface_scan_service->is_scanning(device) && is_scanning_disk(device)) {
+        reject("Another partition of this drive is being surface scanned");
+        return;
+    }
+    if (g_station && g_station->is_busy(device)) {
+        reject("Device is being wiped by station mode");
+        return;
+    }
+    if (auto valid = g_disk_service->validate_device_path(device); !valid) {
+        reject(valid.error().message);
+        return;
+    }
+
+    auto on_progress = [device](const WipeProgress& progress) {
+        g_scheduler->post([device, progress] { emit_surface_scan_progress(device, progress); });
+    };
+    if (auto started = g_surface_scan_service->start(device, on_progress); !started) {
+        reject(started.error().message);
+        return;
+    }
+
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(bs)", TRUE, ""));
+}
+
+/**
+ * Handle CancelSurfaceScan method call
+ */
+void handle_cancel_surface_scan(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_SCAN_DISK)) {
+        return;
+    }
+
+    const char* device = nullptr;
+    g_variant_get(parameters, "(&s)", &device);
+    const bool cancelled = g_surface_scan_service->cancel(device ? device : "");
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(b)", cancelled ? TRUE : FALSE));
+}
+
+/**
+ * Handle GetSurfaceScanReport method call
+ */
+void handle_get_surface_scan_report(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_SCAN_DISK)) {
+        return;
+    }
+
+    const char* device = nullptr;
+    g_variant_get(parameters, "(&s)", &device);
+    const auto report = g_surface_scan_service->report(device ? device : "");
+
+    GVariantBuilder histogram;
+    GVariantBuilder region_mean;
+    GVariantBuilder region_max;
+    GVariantBuilder slow_reads;
+    GVariantBuilder failed_sectors;
+    g_variant_builder_init(&histogram, G_VARIANT_TYPE("at"));
+    g_variant_builder_init(&region_mean, G_VARIANT_TYPE("ad"));
+    g_variant_builder_init(&region_max, G_VARIANT_TYPE("ad"));
+    g_variant_builder_init(&slow_reads, G_VARIANT_TYPE("a(tuu)"));
+    g_variant_builder_init(&failed_sectors, G_VARIANT_TYPE("at"));
+
+    std::string grade;
+    if (report) {
+        grade = std::string(1, report->grade);
+        for (const auto count : report->histogram) {
+            g_variant_builder_add(&histogram, "t", static_cast<guint64>(count));
+        }
+        for (const auto& region : report->regions) {
+            g_variant_builder_add(&region_mean, "d", region.mean_us() / 1'000.0);
+            g_variant_builder_add(&region_max, "d", region.max_us / 1'000.0);
+        }
+        for (const auto& slow : report->slow_reads) {
+            g_variant_builder_add(&slow_reads, "(tuu)", static_cast<guint64>(slow.offset),
+                                  slow.length, slow.latency_us);
+        }
+        for (const auto offset : report->failed_sectors) {
+            g_variant_builder_add(&failed_sectors, "t", static_cast<guint64>(offset));
+        }
+    }
+
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(bbssatadada(tuu)at)", report ? TRUE : FALSE,
+                      report && report->complete ? TRUE : FALSE, grade.c_str(),
+                      report ? report->summary.c_str() : "", &histogram, &region_mean,
+                      &region_max, &slow_reads, &failed_sectors));
+}
+
+/**
+ * Handle SetIoLimits method call
+ *
+ * Limits apply to the device's whole disk at once, including a wipe already
+ * running on it, and stay until changed or the helper exits.
+ */
+void handle_set_io_limits(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_WIPE_DISK)) {
+        return;
+    }
+
+    const char* device_arg = nullptr;
+    guint64 read_bps = 0;
+    guint64 write_bps = 0;
+    guint64 read_iops = 0;
+    guint64 write_iops = 0;
+    guint32 weight = 0;
+    guint64 latency_target_us = 0;
+    g_variant_get(parameters, "(&sttttut)", &device_arg, &read_bps, &write_bps, &read_iops,
+                  &write_iops, &weight, &latency_target_us);
+    const std::string device{device_arg ? device_arg : ""};
+
+    auto reply = [invocation](bool success, const std::string& message) {
+        g_dbus_method_invocation_return_value(
+            invocation, g_variant_new("(bs)", success ? TRUE : FALSE, message.c_str()));
+    };
+
+    if (!g_io_cgroup) {
+        reply(false, "I/O limits need the cgroup v2 io controller delegated to the helper");
+        return;
+    }
+    if (auto valid = g_disk_service->validate_device_path(device); !valid) {
+        reply(false, valid.error().message);
+        return;
+    }
+    const auto disk = disk_number(device);
+    if (!disk) {
+        reply(false, "Cannot resolve the device's disk");
+        return;
+    }
+
+    const IoLimits limits{.read_bps = read_bps,
+                          .write_bps = write_bps,
+                          .read_iops = read_iops,
+                          .write_iops = write_iops,
+                          .weight = weight,
+                          .latency_target_us = latency_target_us};
+    if (auto applied = g_io_cgroup->set_limits(*disk, limits); !applied) {
+        reply(false, applied.error().message);
+        return;
+    }
+    reply(true, "");
+}
+
+/**
+ * Handle GetIoStat method call
+ */
+void handle_get_io_stat(GDBusMethodInvocation* invocation, GVariant* parameters) {
+    if (!check_authorization(invocation, POLKIT_ACTION_LIST_DISKS)) {
+        return;
+    }
+
+    const char* device = nullptr;
+    g_variant_get(parameters, "(&s)", &device);
+    const auto disk = g_io_cgroup ? disk_number(device ? device : "") : std::nullopt;
+    const auto stat = disk ? g_io_cgroup->stat(*disk) : std::nullopt;
+    const auto io = stat.value_or(IoStat{});
+
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(btttttt)", stat ? TRUE : FALSE, static_cast<guint64>(io.read_bytes),
+                      static_cast<guint64>(io.write_bytes), static_cast<guint64>(io.read_ios),
+                      static_cast<guint64>(io.write_ios), static_cast<guint64>(io.discard_bytes),
+                      static_cast<guint64>(io.discard_ios)));
+}
+
 /**
  * Handle CancelWipe method call
  */
@@ -409,20 +1256,143 @@ void handle_cancel_wipe(GDBusMethodInvocation* invocation) {
     }
 
     bool cancelled = g_wipe_service->cancel_current_operation();
+    if (g_shreds_remaining > 0) {
+        g_shred_cancel.store(true);
+        cancelled = true;
+    }
+    if (g_free_space_thread.joinable() && g_wipe_in_progress.load()) {
+        g_free_space_cancel.store(true);
+        cancelled = true;
+    }
 
     g_dbus_method_invocation_return_value(invocation,
                                           g_variant_new("(b)", cancelled ? TRUE : FALSE));
 }
 
+/**
+ * Sample host pressure and pass the resulting multiplier to every wipe
+ */
+auto on_pressure_check(gpointer /*user_data*/) -> gboolean {
+    util::WritePacer::set_multiplier(g_pressure_monitor->sample());
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * A PSI trigger fired: back off now rather than at the next periodic check
+ */
+auto on_pressure_trigger(gint /*fd*/, GIOCondition /*condition*/, gpointer /*user_data*/)
+    -> gboolean {
+    return on_pressure_check(nullptr);
+}
+
+/**
+ * Install the PSI triggers and the periodic check; wipes run at full rate without PSI
+ * or without the helper's own cgroup, which is needed to tell other workloads apart
+ */
+void start_pressure_monitor() {
+    if (!g_io_cgroup) {
+        LOG_INFO("Helper", "No pressure backoff: the helper has no cgroup of its own");
+        return;
+    }
+    // The service cgroup, so that neither the wipes in wipe-io nor the helper count
+    auto monitor = std::make_unique<PressureMonitor>(g_io_cgroup->path().parent_path());
+    if (auto opened = monitor->open(); !opened) {
+        LOG_INFO("Helper", std::format("No pressure backoff: {}", opened.error().message));
+        return;
+    }
+
+    g_pressure_monitor = std::move(monitor);
+    for (const int fd : g_pressure_monitor->fds()) {
+        g_pressure_source_ids.push_back(
+            g_unix_fd_add(fd, G_IO_PRI, on_pressure_trigger, nullptr));
+    }
+    g_pressure_source_ids.push_back(
+        g_timeout_add_seconds(PRESSURE_CHECK_INTERVAL_S, on_pressure_check, nullptr));
+}
+
+/**
+ * Forget a client once its bus connection goes away
+ */
+void on_client_vanished(GDBusConnection* /*connection*/, const gchar* name,
+                        gpointer /*user_data*/) {
+    if (auto it = g_client_watches.find(name); it != g_client_watches.end()) {
+        g_bus_unwatch_name(it->second);
+        g_client_watches.erase(it);
+    }
+    g_idle_policy->note_activity(IdlePolicy::Clock::now());
+}
+
+/**
+ * Count a request as activity and keep the helper up while its sender is connected
+ */
+void track_client(GDBusConnection* connection, const gchar* sender) {
+    g_idle_policy->note_activity(IdlePolicy::Clock::now());
+    if (!sender || g_client_watches.contains(sender)) {
+        return;
+    }
+    const guint watch_id =
+        g_bus_watch_name_on_connection(connection, sender, G_BUS_NAME_WATCHER_FLAGS_NONE, nullptr,
+                                       on_client_vanished, nullptr, nullptr);
+    g_client_watches.emplace(sender, watch_id);
+}
+
+/**
+ * Save the warm cache, drop the disk list and return free heap pages to the kernel
+ */
+void release_idle_memory() {
+    if (auto saved = g_disk_service->save_warm_cache(); !saved) {
+        LOG_WARNING("Helper", std::format("Warm cache not saved: {}", saved.error().message));
+    }
+    g_disk_service->invalidate_cache();
+    malloc_trim(0);
+    LOG_INFO("Helper", "Idle: released caches and free memory");
+}
+
+/**
+ * Periodic idle check; quits the main loop when the helper is no longer needed
+ */
+auto on_idle_check(gpointer /*user_data*/) -> gboolean {
+    const bool station_busy =
+        g_station && (g_station->active_jobs() > 0 || g_station->queued_jobs() > 0);
+    const bool scanning = g_surface_scan_service->active_count() > 0;
+    const IdlePolicy::Activity activity{
+        .busy = g_wipe_in_progress.load() || g_shreds_remaining > 0 || station_busy || scanning,
+        .clients = g_client_watches.size(),
+        .may_exit = !g_station};  // Station mode must be present when disks are inserted
+
+    switch (g_idle_policy->poll(IdlePolicy::Clock::now(), activity)) {
+        case IdleAction::NONE:
+            break;
+        case IdleAction::TRIM:
+            release_idle_memory();
+            break;
+        case IdleAction::EXIT:
+            LOG_INFO("Helper", std::format("No jobs or clients for {}s; exiting until re-activated",
+                                           g_idle_policy->settings().exit_after.count()));
+            if (auto saved = g_disk_service->save_warm_cache(); !saved) {
+                LOG_WARNING("Helper",
+                            std::format("Warm cache not saved: {}", saved.error().message));
+            }
+            g_idle_check_id = 0;
+            g_main_loop_quit(g_main_loop);
+            return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
 /**
  * D-Bus method call handler
  */
-void handle_method_call(GDBusConnection* /*connection*/, const gchar* /*sender*/,
+void handle_method_call(GDBusConnection* connection, const gchar* sender,
                         const gchar* /*object_path*/, const gchar* /*interface_name*/,
                         const gchar* method_name, GVariant* parameters,
                         GDBusMethodInvocation* invocation, gpointer /*user_data*/) {
+    track_client(connection, sender);
+
     if (g_strcmp0(method_name, "GetDisks") == 0) {
         handle_get_disks(invocation);
+    } else if (g_strcmp0(method_name, "GetInventory") == 0) {
+        handle_get_inventory(invocation);
     } else if (g_strcmp0(method_name, "GetDiskSMART") == 0) {
         handle_get_disk_smart(invocation, parameters);
     } else if (g_strcmp0(method_name, "ValidateDevicePath") == 0) {
@@ -437,6 +1407,20 @@ void handle_method_call(GDBusConnection* /*connection*/, const gchar* /*sender*/
         handle_start_wipe(invocation, parameters);
     } else if (g_strcmp0(method_name, "CancelWipe") == 0) {
         handle_cancel_wipe(invocation);
+    } else if (g_strcmp0(method_name, "ShredFiles") == 0) {
+        handle_shred_files(invocation, parameters);
+    } else if (g_strcmp0(method_name, "WipeFreeSpace") == 0) {
+        handle_wipe_free_space(invocation, parameters);
+    } else if (g_strcmp0(method_name, "StartSurfaceScan") == 0) {
+        handle_start_surface_scan(invocation, parameters);
+    } else if (g_strcmp0(method_name, "CancelSurfaceScan") == 0) {
+        handle_cancel_surface_scan(invocation, parameters);
+    } else if (g_strcmp0(method_name, "GetSurfaceScanReport") == 0) {
+        handle_get_surface_scan_report(invocation, parameters);
+    } else if (g_strcmp0(method_name, "SetIoLimits") == 0) {
+        handle_set_io_limits(invocation, parameters);
+    } else if (g_strcmp0(method_name, "GetIoStat") == 0) {
+        handle_get_io_stat(invocation, parameters);
     } else {
         g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD,
                                               "Unknown method: %s", method_name);
@@ -508,7 +1492,7 @@ void on_bus_acquired(GDBusConnection* /*connection*/, const gchar* /*name*/,
 
 }  // namespace
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
+int main(int argc, char* argv[]) {
     // Initialize logger for helper daemon
     util::Logger::instance().initialize("/var/log/storage-wiper", "storage-wiper-helper");
 
@@ -520,12 +1504,40 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 
     LOG_INFO("Helper", "Storage Wiper Helper starting...");
 
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    auto idle_settings = IdleSettings::parse_arguments(args);
+    if (!idle_settings) {
+        LOG_ERROR("Helper", idle_settings.error().message);
+        return 1;
+    }
+
     // Initialize services
     g_disk_service = std::make_shared<DiskService>();
-    g_wipe_service = std::make_unique<WipeService>(g_disk_service);
+    g_queue_tuner = std::make_shared<QueueTuner>();
+    // A crash mid-wipe leaves queues tuned; put them back before anything else runs
+    if (const auto restored = g_queue_tuner->restore_pending(); restored > 0) {
+        LOG_WARNING("Helper", std::format("Restored {} block queue(s) after a crash", restored));
+    }
+    g_io_cgroup = std::make_shared<IoCgroup>();
+    if (auto opened = g_io_cgroup->open(); !opened) {
+        LOG_INFO("Helper", std::format("Wipes run without I/O limits: {}", opened.error().message));
+        g_io_cgroup.reset();
+    }
+    g_wipe_service = std::make_unique<WipeService>(g_disk_service, g_queue_tuner, g_io_cgroup);
+    g_shred_service = std::make_unique<FileShredService>();
+    g_free_space_service = std::make_unique<FreeSpaceWipeService>();
+    g_surface_scan_service = std::make_unique<SurfaceScanService>();
+    if (auto loaded = g_disk_service->load_warm_cache(); !loaded) {
+        LOG_INFO("Helper", std::format("Starting cold: {}", loaded.error().message));
+    }
 
-    // Create main loop
+    // Create main loop; coroutine-based handlers resume on its context
     g_main_loop = g_main_loop_new(nullptr, FALSE);
+    g_scheduler = std::make_unique<MainContextScheduler>();
+    start_station_mode();
+    start_pressure_monitor();
+    g_idle_policy.emplace(*idle_settings, IdlePolicy::Clock::now());
+    g_idle_check_id = g_timeout_add_seconds(IDLE_CHECK_INTERVAL_S, on_idle_check, nullptr);
 
     // Request D-Bus name
     guint owner_id = g_bus_own_name(G_BUS_TYPE_SYSTEM, DBUS_NAME, G_BUS_NAME_OWNER_FLAGS_NONE,
@@ -539,8 +1551,38 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 
     // Cleanup
     g_bus_unown_name(owner_id);
+    if (g_uevent_source_id != 0) {
+        g_source_remove(g_uevent_source_id);
+    }
+    if (g_idle_check_id != 0) {
+        g_source_remove(g_idle_check_id);
+    }
+    for (const auto source_id : g_pressure_source_ids) {
+        g_source_remove(source_id);
+    }
+    g_pressure_monitor.reset();
+    for (const auto& [name, watch_id] : g_client_watches) {
+        g_bus_unwatch_name(watch_id);
+    }
+    g_client_watches.clear();
+    g_station.reset();  // Cancels and joins station wipes
+    g_shred_cancel.store(true);
+    while (g_shreds_remaining > 0) {
+        g_main_context_iteration(nullptr, TRUE);
+    }
+    g_shred_service.reset();
+    g_free_space_cancel.store(true);
+    if (g_free_space_thread.joinable()) {
+        g_free_space_thread.join();  // Removes its filler files before returning
+    }
+    g_free_space_service.reset();
+    g_surface_scan_service.reset();  // Cancels and joins running scans
+    g_hotplug_monitor.reset();
+    g_scheduler.reset();
     g_main_loop_unref(g_main_loop);
     g_wipe_service.reset();
+    g_queue_tuner.reset();  // After every wipe, whose leases refer to it
+    g_io_cgroup.reset();
     g_disk_service.reset();
 
     LOG_INFO("Helper", "Storage Wiper Helper stopped");
@@ -1,6 +1,9 @@
 #include "helper/services/DiskService.hpp"
 
+#include "algorithms/ThinDiscardAlgorithm.hpp"
 #include "helper/services/SmartService.hpp"
+#include "util/BlockHolders.hpp"
+#include "util/Executor.hpp"
 #include "util/FileDescriptor.hpp"
 #include "util/Logger.hpp"
 
@@ -9,15 +12,18 @@
 #include <array>
 #include <cctype>
 #include <cerrno>
+#include <charconv>
 #include <cstring>
 #include <expected>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <future>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <sstream>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -39,6 +45,11 @@ namespace rng = std::ranges;
 
 namespace {
 constexpr auto BYTES_PER_SECTOR = uint64_t{512};
+constexpr std::string_view DEV_PREFIX{"/dev/"};
+
+// Projection for the sorted (device, index) mount index
+constexpr auto device_key = [](const std::pair<std::string, std::size_t>& item) noexcept
+    -> const std::string& { return item.first; };
 
 auto is_partition_suffix(std::string_view suffix) noexcept -> bool {
     if (suffix.empty()) {
@@ -56,47 +67,132 @@ auto is_virtual_device(std::string_view name) noexcept -> bool {
                        [name](const char* pattern) { return name.contains(pattern); });
 }
 
+// Identity of a physical device; a different serial at the same path is a swapped disk
+auto identity_key(std::string_view path, std::string_view serial) -> std::string {
+    std::string key{path};
+    key.push_back('\0');
+    key.append(serial);
+    return key;
+}
+
+// Warm cache file: a header line, then tab-separated records
+constexpr std::string_view WARM_CACHE_HEADER = "storage-wiper-inventory 1";
+
+auto split_fields(std::string_view line) -> std::vector<std::string_view> {
+    std::vector<std::string_view> fields;
+    for (auto field : line | std::views::split('\t')) {
+        fields.emplace_back(field.begin(), field.end());
+    }
+    return fields;
+}
+
+template <typename T>
+auto parse_field(std::string_view text) -> std::optional<T> {
+    T value{};
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+auto is_storable(std::string_view value) noexcept -> bool {
+    return !value.contains('\t') && !value.contains('\n');
+}
+
+auto trim_whitespace(std::string_view text) -> std::string {
+    const auto first = text.find_first_not_of(" \n\r\t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return std::string{text.substr(first, text.find_last_not_of(" \n\r\t") - first + 1)};
+}
+
+// Serial number from sysfs: NVMe and some SCSI drivers expose device/serial,
+// SCSI/SATA disks the unit serial number VPD page (0x80)
+auto read_serial(const fs::path& sys_path) -> std::string {
+    if (std::ifstream file{sys_path / "device" / "serial"}) {
+        std::string serial;
+        std::getline(file, serial);
+        return trim_whitespace(serial);
+    }
+    if (std::ifstream file{sys_path / "device" / "vpd_pg80", std::ios::binary}) {
+        const std::string page{std::istreambuf_iterator<char>{file}, {}};
+        constexpr std::size_t HEADER = 4;  // Qualifier, page code, 16-bit length
+        if (page.size() > HEADER && static_cast<unsigned char>(page[1]) == 0x80) {
+            const auto high = static_cast<unsigned char>(page[2]);
+            const auto low = static_cast<unsigned char>(page[3]);
+            const auto length = (static_cast<std::size_t>(high) << 8U) | low;
+            return trim_whitespace(std::string_view{page}.substr(HEADER, length));
+        }
+    }
+    return {};
+}
+
 }  // namespace
 
 // ============================================================================
 // MountCache implementation
 // ============================================================================
 
+void MountCache::build_index(const fs::path& dev_root) {
+    by_device_.clear();
+    mapper_by_dm_.clear();
+    by_device_.reserve(entries.size());
+
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto& device = entries[i].device;
+        by_device_.emplace_back(device, i);
+
+        // Resolve /dev/mapper/* once here instead of once per disk during lookup
+        if (device.starts_with("/dev/mapper/")) {
+            const auto link = dev_root / std::string_view{device}.substr(DEV_PREFIX.size());
+            std::error_code ec;
+            const auto real_path = fs::read_symlink(link, ec);
+            if (!ec) {
+                mapper_by_dm_.try_emplace(real_path.filename().string(), i);
+            }
+        }
+    }
+
+    rng::sort(by_device_);
+}
+
 auto MountCache::find_mount_for_device(const std::string& device_path,
                                        const std::vector<std::string>& dm_holders) const
     -> std::optional<MountEntry> {
-    // First, check direct mount of device or its partitions
-    for (const auto& entry : entries) {
-        if (entry.device == device_path ||
-            (entry.device.starts_with(device_path) &&
-             is_partition_suffix(std::string_view{entry.device}.substr(device_path.size())))) {
-            return entry;
+    auto matches_device = [&device_path](std::string_view device) {
+        return device == device_path ||
+               (device.starts_with(device_path) &&
+                is_partition_suffix(device.substr(device_path.size())));
+    };
+
+    // First, check direct mount of device or its partitions. Every candidate shares the
+    // device path as a prefix, so it lives in one contiguous sorted range. Keep the
+    // earliest mount table entry to match /proc/mounts ordering.
+    std::optional<std::size_t> best;
+    for (auto it = rng::lower_bound(by_device_, device_path, {}, device_key);
+         it != by_device_.end() && it->first.starts_with(device_path); ++it) {
+        if (matches_device(it->first) && (!best || it->second < *best)) {
+            best = it->second;
         }
     }
+    if (best) {
+        return entries[*best];
+    }
 
-    // Check if any dm-* holder is mounted
+    // Check if any dm-* holder is mounted, directly or through /dev/mapper
     for (const auto& dm_name : dm_holders) {
         const auto dm_path = std::format("/dev/{}", dm_name);
-        for (const auto& entry : entries) {
-            if (entry.device == dm_path) {
-                return entry;
-            }
+        auto it = rng::lower_bound(by_device_, dm_path, {}, device_key);
+        if (it != by_device_.end() && it->first == dm_path) {
+            return entries[it->second];
         }
     }
-
-    // Check /dev/mapper/* entries by resolving symlinks
-    if (!dm_holders.empty()) {
-        for (const auto& entry : entries) {
-            if (entry.device.starts_with("/dev/mapper/")) {
-                std::error_code ec;
-                const auto real_path = fs::read_symlink(entry.device, ec);
-                if (!ec) {
-                    const auto resolved_dm_name = real_path.filename().string();
-                    if (rng::find(dm_holders, resolved_dm_name) != dm_holders.end()) {
-                        return entry;
-                    }
-                }
-            }
+    for (const auto& dm_name : dm_holders) {
+        if (auto it = mapper_by_dm_.find(dm_name); it != mapper_by_dm_.end()) {
+            return entries[it->second];
         }
     }
 
@@ -107,7 +203,17 @@ auto MountCache::find_mount_for_device(const std::string& device_path,
 // DiskService implementation
 // ============================================================================
 
-DiskService::DiskService() : smart_service_(std::make_unique<SmartService>()) {}
+DiskService::DiskService() : DiskService(SystemPaths{}, std::make_unique<SmartService>()) {}
+
+DiskService::DiskService(SystemPaths paths, std::unique_ptr<SmartService> smart_service)
+    : paths_(std::move(paths)), smart_service_(std::move(smart_service)) {}
+
+auto DiskService::resolve_dev_path(const std::string& device_path) const -> std::string {
+    if (paths_.dev == "/dev" || !device_path.starts_with(DEV_PREFIX)) {
+        return device_path;
+    }
+    return (paths_.dev / std::string_view{device_path}.substr(DEV_PREFIX.size())).string();
+}
 
 auto DiskService::get_smart_data(const std::string& device_path) -> SmartData {
     if (!smart_service_) {
@@ -118,21 +224,47 @@ auto DiskService::get_smart_data(const std::string& device_path) -> SmartData {
 
 void DiskService::invalidate_cache() {
     std::lock_guard lock{cache_mutex_};
-    cached_disks_.clear();
+    cached_inventory_.reset();
     cache_timestamp_ = {};
 }
 
 auto DiskService::get_available_disks_sync() -> std::vector<DiskInfo> {
+    return get_inventory()->to_disk_infos();
+}
+
+auto DiskService::get_inventory() -> std::shared_ptr<const DiskInventory> {
     // Check cache first (with TTL)
     {
         std::lock_guard lock{cache_mutex_};
         const auto now = std::chrono::steady_clock::now();
-        if (!cached_disks_.empty() && (now - cache_timestamp_) < CACHE_TTL) {
-            return cached_disks_;
+        if (cached_inventory_ && !cached_inventory_->empty() &&
+            (now - cache_timestamp_) < CACHE_TTL) {
+            return cached_inventory_;
         }
     }
 
-    const fs::path block_dir{"/sys/block"};
+    const auto disks = enumerate_disks();
+
+    std::lock_guard lock{cache_mutex_};
+    DiskInventory::Builder builder{disks.size()};
+    for (const auto& disk : disks) {
+        builder.add(device_id_for(disk), disk);
+    }
+    cached_inventory_ = std::make_shared<const DiskInventory>(std::move(builder).build());
+    cache_timestamp_ = std::chrono::steady_clock::now();
+    return cached_inventory_;
+}
+
+auto DiskService::device_id_for(const DiskInfo& disk) -> DiskInventory::DeviceId {
+    auto [it, inserted] = device_ids_.try_emplace(identity_key(disk.path, disk.serial), 0);
+    if (inserted) {
+        it->second = next_device_id_++;
+    }
+    return it->second;
+}
+
+auto DiskService::enumerate_disks() -> std::vector<DiskInfo> {
+    const auto& block_dir = paths_.sys_block;
 
     if (!fs::exists(block_dir)) {
         return {};
@@ -142,34 +274,60 @@ auto DiskService::get_available_disks_sync() -> std::vector<DiskInfo> {
     const auto mount_cache = parse_mount_table();
 
     // OPTIMIZATION 2: First pass - collect basic disk info (fast, no SMART)
-    std::vector<DiskInfo> disks;
-    std::vector<std::string> smart_eligible_paths;
-
+    std::vector<std::string> candidate_paths;
     for (const auto& entry : fs::directory_iterator{block_dir}) {
         const auto device_name = entry.path().filename().string();
 
         if (is_virtual_device(device_name)) {
             continue;
         }
+        candidate_paths.push_back(std::format("/dev/{}", device_name));
+    }
 
-        const auto device_path = std::format("/dev/{}", device_name);
-
+    // sysfs parsing is independent per disk, so fan it out across the compute lane
+    auto& executor = util::Executor::shared();
+    std::vector<std::optional<DiskInfo>> parsed(candidate_paths.size());
+    executor.parallel_for(candidate_paths.size(), [&](std::size_t i) {
+        const auto& device_path = candidate_paths[i];
         if (auto valid = validate_device_path(device_path); !valid) {
-            continue;
+            return;
         }
-
         if (auto info = parse_disk_info(device_path, mount_cache); info.size_bytes > 0) {
-            // Track paths that need SMART data
-            if (smart_service_ && SmartService::is_smart_supported(device_path)) {
-                smart_eligible_paths.push_back(device_path);
+            parsed[i] = std::move(info);
+        }
+    });
+
+    std::vector<DiskInfo> disks;
+    std::vector<std::string> smart_eligible_paths;
+    disks.reserve(parsed.size());
+
+    // Readings restored from the warm cache apply to this enumeration only
+    std::unordered_map<std::string, SmartData> warm_smart;
+    {
+        std::lock_guard lock{cache_mutex_};
+        warm_smart = std::exchange(warm_smart_, {});
+    }
+
+    for (auto& info : parsed) {
+        if (!info) {
+            continue;
+        }
+        // Track paths that need SMART data
+        if (smart_service_ && SmartService::is_smart_supported(info->path)) {
+            auto warm = info->serial.empty()
+                            ? warm_smart.end()
+                            : warm_smart.find(identity_key(info->path, info->serial));
+            if (warm != warm_smart.end()) {
+                info->smart = warm->second;
+            } else {
+                smart_eligible_paths.push_back(info->path);
             }
-            disks.emplace_back(std::move(info));
         }
+        disks.emplace_back(std::move(*info));
     }
 
-    // OPTIMIZATION 3: Parallel SMART collection using std::async
+    // OPTIMIZATION 3: Parallel SMART collection on the executor's blocking I/O lane
     if (!smart_eligible_paths.empty() && smart_service_) {
-        // Launch async SMART queries
         // Capture raw pointer to SmartService since:
         // 1. SmartService lifetime is tied to DiskService lifetime (owned by unique_ptr)
         // 2. DiskService waits for all futures before returning from this method
@@ -179,9 +337,11 @@ auto DiskService::get_available_disks_sync() -> std::vector<DiskInfo> {
 
         SmartService* smart_service_ptr = smart_service_.get();
         for (const auto& path : smart_eligible_paths) {
-            smart_futures.push_back(std::async(std::launch::async, [smart_service_ptr, path]() {
-                return std::make_pair(path, smart_service_ptr->get_smart_data(path));
-            }));
+            smart_futures.push_back(executor.submit(
+                [smart_service_ptr, path]() {
+                    return std::make_pair(path, smart_service_ptr->get_smart_data(path));
+                },
+                util::TaskPriority::NORMAL, util::TaskLane::BLOCKING_IO));
         }
 
         // Collect results and merge into disk info
@@ -215,14 +375,123 @@ auto DiskService::get_available_disks_sync() -> std::vector<DiskInfo> {
         }
     }
 
-    // Update cache
+    return disks;
+}
+
+auto DiskService::save_warm_cache(const fs::path& path) const -> std::expected<void, util::Error> {
+    std::ostringstream out;
+    out << WARM_CACHE_HEADER << '\n';
     {
         std::lock_guard lock{cache_mutex_};
-        cached_disks_ = disks;
-        cache_timestamp_ = std::chrono::steady_clock::now();
+        // Nothing was listed since the last save; keep that file
+        if (!cached_inventory_) {
+            return {};
+        }
+        out << "next-id\t" << next_device_id_ << '\n';
+        for (const auto& [key, id] : device_ids_) {
+            const auto separator = key.find('\0');
+            const auto device_path = std::string_view{key}.substr(0, separator);
+            const auto serial = std::string_view{key}.substr(separator + 1);
+            if (is_storable(device_path) && is_storable(serial)) {
+                out << "device\t" << id << '\t' << device_path << '\t' << serial << '\n';
+            }
+        }
+
+        // Stamp readings with when the snapshot was taken, not when it is saved
+        const auto taken = std::chrono::system_clock::now() -
+                           std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                               std::chrono::steady_clock::now() - cache_timestamp_);
+        const auto taken_s =
+            std::chrono::duration_cast<std::chrono::seconds>(taken.time_since_epoch()).count();
+        for (const auto disk : cached_inventory_->rows()) {
+            const auto* smart = disk.smart();
+            if (!smart || !smart->available || disk.serial().empty() ||
+                !is_storable(disk.path()) || !is_storable(disk.serial())) {
+                continue;
+            }
+            out << std::format("smart\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\n", disk.path(),
+                               disk.serial(), taken_s, smart->healthy ? 1 : 0,
+                               smart->power_on_hours, smart->reallocated_sectors,
+                               smart->pending_sectors, smart->temperature_celsius,
+                               smart->uncorrectable_errors, static_cast<int>(smart->status));
+        }
     }
 
-    return disks;
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file{temp_path, std::ios::trunc};
+        if (!file) {
+            return std::unexpected(
+                util::Error{std::format("Cannot write {}", temp_path.string()), errno});
+        }
+        fs::permissions(temp_path, fs::perms::owner_read | fs::perms::owner_write,
+                        fs::perm_options::replace, ec);
+        file << out.str();
+        if (!file.flush()) {
+            return std::unexpected(
+                util::Error{std::format("Cannot write {}", temp_path.string()), errno});
+        }
+    }
+    fs::rename(temp_path, path, ec);
+    if (ec) {
+        fs::remove(temp_path, ec);
+        return std::unexpected(util::Error{std::format("Cannot replace {}", path.string())});
+    }
+    return {};
+}
+
+auto DiskService::load_warm_cache(const fs::path& path) -> std::expected<void, util::Error> {
+    std::ifstream file{path};
+    if (!file) {
+        return std::unexpected(util::Error{std::format("Cannot read {}", path.string()), errno});
+    }
+    std::string line;
+    if (!std::getline(file, line) || line != WARM_CACHE_HEADER) {
+        return std::unexpected(util::Error{std::format("Unrecognized {}", path.string())});
+    }
+
+    const auto now_s = std::chrono::duration_cast<std::chrono::seconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    const auto max_age_s = std::chrono::seconds{WARM_SMART_MAX_AGE}.count();
+
+    std::lock_guard lock{cache_mutex_};
+    while (std::getline(file, line)) {
+        const auto fields = split_fields(line);
+        if (fields.size() == 2 && fields[0] == "next-id") {
+            if (auto next = parse_field<DiskInventory::DeviceId>(fields[1])) {
+                next_device_id_ = std::max(next_device_id_, *next);
+            }
+        } else if (fields.size() == 4 && fields[0] == "device") {
+            if (auto id = parse_field<DiskInventory::DeviceId>(fields[1]); id && *id != 0) {
+                device_ids_.try_emplace(identity_key(fields[2], fields[3]), *id);
+                next_device_id_ = std::max(next_device_id_, *id + 1);
+            }
+        } else if (fields.size() == 11 && fields[0] == "smart") {
+            auto taken = parse_field<int64_t>(fields[3]);
+            if (!taken || now_s - *taken > max_age_s || *taken > now_s) {
+                continue;
+            }
+            SmartData smart;
+            smart.available = true;
+            smart.healthy = fields[4] == "1";
+            smart.power_on_hours = parse_field<int64_t>(fields[5]).value_or(-1);
+            smart.reallocated_sectors = parse_field<int>(fields[6]).value_or(-1);
+            smart.pending_sectors = parse_field<int>(fields[7]).value_or(-1);
+            smart.temperature_celsius = parse_field<int>(fields[8]).value_or(-1);
+            smart.uncorrectable_errors = parse_field<int>(fields[9]).value_or(-1);
+            const auto status = parse_field<int>(fields[10]).value_or(0);
+            constexpr auto max_status = static_cast<int>(SmartData::HealthStatus::CRITICAL);
+            smart.status = status >= 0 && status <= max_status
+                               ? static_cast<SmartData::HealthStatus>(status)
+                               : SmartData::HealthStatus::UNKNOWN;
+            warm_smart_[identity_key(fields[1], fields[2])] = smart;
+        }
+    }
+    return {};
 }
 
 auto DiskService::get_available_disks_blocking()
@@ -237,7 +506,7 @@ void DiskService::get_available_disks(
     }
 }
 
-auto DiskService::parse_mount_table() -> MountCache {
+auto DiskService::parse_mount_table() const -> MountCache {
     MountCache cache;
 
     auto mtab_deleter = [](FILE* f) {
@@ -245,8 +514,8 @@ auto DiskService::parse_mount_table() -> MountCache {
             ::endmntent(f);
     };
 
-    std::unique_ptr<FILE, decltype(mtab_deleter)> mtab{::setmntent("/proc/mounts", "r"),
-                                                       mtab_deleter};
+    std::unique_ptr<FILE, decltype(mtab_deleter)> mtab{
+        ::setmntent(paths_.proc_mounts.c_str(), "r"), mtab_deleter};
     if (!mtab) {
         return cache;
     }
@@ -259,42 +528,15 @@ auto DiskService::parse_mount_table() -> MountCache {
         });
     }
 
+    cache.build_index(paths_.dev);
     return cache;
 }
 
-auto DiskService::collect_dm_holders(const std::string& sys_path, const std::string& device_name)
-    -> std::vector<std::string> {
+auto DiskService::collect_dm_holders(const std::string& sys_path) -> std::vector<std::string> {
     std::vector<std::string> dm_holders;
-
-    auto collect_from_path = [&dm_holders](const fs::path& holders_path) {
-        if (!fs::exists(holders_path)) {
-            return;
-        }
-        std::error_code ec;
-        for (const auto& holder : fs::directory_iterator{holders_path, ec}) {
-            if (ec)
-                break;
-            const auto holder_name = holder.path().filename().string();
-            if (holder_name.starts_with("dm-")) {
-                dm_holders.push_back(holder_name);
-            }
-        }
-    };
-
-    // Check holders of the device itself
-    collect_from_path(sys_path + "/holders");
-
-    // Also check holders of partitions (e.g., /dev/nvme0n1p1 -> dm-0)
-    std::error_code ec;
-    for (const auto& entry : fs::directory_iterator{sys_path, ec}) {
-        if (ec)
-            break;
-        const auto part_name = entry.path().filename().string();
-        if (part_name.starts_with(device_name) && part_name != device_name) {
-            collect_from_path(entry.path() / "holders");
-        }
+    for (const auto& holder : util::dm_holders(sys_path)) {
+        dm_holders.push_back(holder.filename().string());
     }
-
     return dm_holders;
 }
 
@@ -311,8 +553,8 @@ auto DiskService::unmount_disk(const std::string& path) -> std::expected<void, u
                 if (f)
                     ::endmntent(f);
             };
-        std::unique_ptr<FILE, decltype(mtab_deleter)> mtab{::setmntent("/proc/mounts", "r"),
-                                                           mtab_deleter}) {
+        std::unique_ptr<FILE, decltype(mtab_deleter)> mtab{
+            ::setmntent(paths_.proc_mounts.c_str(), "r"), mtab_deleter}) {
         while (auto* entry = ::getmntent(mtab.get())) {
             const std::string_view mount_device{entry->mnt_fsname};
 
@@ -353,8 +595,8 @@ auto DiskService::unmount_disk(const std::string& path) -> std::expected<void, u
                 if (f)
                     ::endmntent(f);
             };
-        std::unique_ptr<FILE, decltype(mtab_deleter)> mtab{::setmntent("/proc/mounts", "r"),
-                                                           mtab_deleter}) {
+        std::unique_ptr<FILE, decltype(mtab_deleter)> mtab{
+            ::setmntent(paths_.proc_mounts.c_str(), "r"), mtab_deleter}) {
         while (auto* entry = ::getmntent(mtab.get())) {
             const std::string_view mount_device{entry->mnt_fsname};
 
@@ -381,7 +623,7 @@ auto DiskService::is_disk_writable(const std::string& path) -> bool {
         return false;
     }
 
-    const util::FileDescriptor fd{::open(path.c_str(), O_RDWR)};
+    const util::FileDescriptor fd{::open(resolve_dev_path(path).c_str(), O_RDWR)};
     return fd.is_valid();
 }
 
@@ -390,7 +632,7 @@ auto DiskService::get_disk_size(const std::string& path) -> std::expected<uint64
         return std::unexpected(valid.error());
     }
 
-    const util::FileDescriptor fd{::open(path.c_str(), O_RDONLY)};
+    const util::FileDescriptor fd{::open(resolve_dev_path(path).c_str(), O_RDONLY)};
     if (!fd) {
         return std::unexpected(
             util::Error{std::format("Failed to open device: {}", std::strerror(errno)), errno});
@@ -404,6 +646,10 @@ auto DiskService::get_disk_size(const std::string& path) -> std::expected<uint64
     return size;
 }
 
+auto DiskService::is_device_node(mode_t mode) const -> bool {
+    return S_ISBLK(mode);
+}
+
 auto DiskService::validate_device_path(const std::string& path)
     -> std::expected<void, util::Error> {
     // Whitelist of allowed device prefixes (physical disks only)
@@ -429,11 +675,11 @@ auto DiskService::validate_device_path(const std::string& path)
 
     // Verify it's actually a block device
     struct stat st{};
-    if (::stat(path.c_str(), &st) != 0) {
+    if (::stat(resolve_dev_path(path).c_str(), &st) != 0) {
         return std::unexpected(util::Error{
             std::format("Failed to stat device path: {}", std::strerror(errno)), errno});
     }
-    if (!S_ISBLK(st.st_mode)) {
+    if (!is_device_node(st.st_mode)) {
         return std::unexpected(util::Error{"Device path is not a block device"});
     }
     return {};
@@ -451,10 +697,11 @@ auto DiskService::parse_disk_info(const std::string& device_path, const MountCac
                          .is_mounted = false,
                          .mount_point = {},
                          .is_lvm_pv = false,
-                         .smart = {}};
+                         .smart = {},
+                         .is_thin_provisioned = false};
 
     const auto device_name = fs::path{device_path}.filename().string();
-    const auto sys_path = std::format("/sys/block/{}", device_name);
+    const auto sys_path = (paths_.sys_block / device_name).string();
 
     // Helper lambdas for reading different types from sysfs
     auto read_uint64 = [](const fs::path& path) -> std::optional<uint64_t> {
@@ -493,15 +740,18 @@ auto DiskService::parse_disk_info(const std::string& device_path, const MountCac
             std::string_view{info.model}.substr(0, info.model.find_last_not_of(" \n\r\t") + 1)};
     }
 
+    info.serial = read_serial(sys_path);
+
     // Check if removable
     if (const auto removable = read_int(sys_path + "/removable")) {
         info.is_removable = (*removable == 1);
     }
 
     info.is_ssd = check_if_ssd(device_path);
+    info.is_thin_provisioned = ThinDiscardAlgorithm::read_provisioning_info(sys_path).is_thin();
 
     // Collect device-mapper (dm-*) holders for this device and its partitions
-    auto dm_holders = collect_dm_holders(sys_path, device_name);
+    auto dm_holders = collect_dm_holders(sys_path);
     info.is_lvm_pv = !dm_holders.empty();
 
     // OPTIMIZATION: Use pre-parsed mount cache instead of re-reading /proc/mounts
@@ -519,7 +769,7 @@ auto DiskService::parse_disk_info(const std::string& device_path, const MountCac
 
 auto DiskService::check_if_ssd(const std::string& device_path) -> bool {
     const auto device_name = fs::path{device_path}.filename().string();
-    const auto rotational_path = std::format("/sys/block/{}/queue/rotational", device_name);
+    const auto rotational_path = paths_.sys_block / device_name / "queue" / "rotational";
 
     // Check the rotational flag for this device
     // For physical disks (sd*, nvme*, etc.), this directly indicates SSD vs HDD
@@ -1,17 +1,24 @@
 #pragma once
 
 #include "helper/services/SmartService.hpp"
+#include "models/DiskInventory.hpp"
 #include "services/IDiskService.hpp"
 
 #include <chrono>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <sys/types.h>
+
 /**
  * @brief Cached mount information for a single mount point
  */
@@ -23,19 +30,53 @@ struct MountEntry {
 
 /**
  * @brief Cached mount table parsed from /proc/mounts
+ *
+ * Lookups are indexed so that enumerating N disks against M mounts costs
+ * O(N log M) rather than O(N * M); call build_index() after filling entries.
  */
 struct MountCache {
     std::vector<MountEntry> entries;
 
+    /**
+     * @brief Build lookup indexes over entries
+     * @param dev_root Directory standing in for /dev when resolving /dev/mapper symlinks
+     */
+    void build_index(const std::filesystem::path& dev_root = "/dev");
+
     // Quick lookup by device path prefix
     [[nodiscard]] auto find_mount_for_device(const std::string& device_path,
                                              const std::vector<std::string>& dm_holders) const
         -> std::optional<MountEntry>;
+
+private:
+    // (device, entry index) sorted by device for prefix range scans
+    std::vector<std::pair<std::string, std::size_t>> by_device_;
+    // dm-N name -> entry index for /dev/mapper/* symlinks resolved once at build time
+    std::unordered_map<std::string, std::size_t> mapper_by_dm_;
+};
+
+/**
+ * @brief Filesystem roots DiskService reads from
+ *
+ * Defaults to the live system. Tests and benchmarks point these at a synthetic
+ * tree; reported device paths always stay in the "/dev/<name>" namespace.
+ */
+struct SystemPaths {
+    std::filesystem::path sys_block = "/sys/block";
+    std::filesystem::path proc_mounts = "/proc/mounts";
+    std::filesystem::path dev = "/dev";
 };
 
 class DiskService : public IDiskService {
 public:
     DiskService();
+
+    /**
+     * @brief Construct with explicit system roots
+     * @param paths Roots for sysfs, the mount table and device nodes
+     * @param smart_service SMART reader, or nullptr to skip SMART collection
+     */
+    DiskService(SystemPaths paths, std::unique_ptr<SmartService> smart_service);
     ~DiskService() override = default;
 
     // Non-copyable and non-movable due to mutex member
@@ -52,6 +93,16 @@ public:
 
     // Helper method for synchronous access within the daemon process (not part of IDiskService)
     [[nodiscard]] auto get_available_disks_sync() -> std::vector<DiskInfo>;
+
+    /**
+     * @brief Current disk list as a shared, immutable snapshot
+     *
+     * Served from the TTL cache without copying. Device ids stay the same for
+     * a given path and serial for the lifetime of this service.
+     * @return Snapshot (never null; empty when no disks were found)
+     */
+    [[nodiscard]] auto get_inventory() -> std::shared_ptr<const DiskInventory>;
+
     auto unmount_disk(const std::string& path) -> std::expected<void, util::Error> override;
     [[nodiscard]] auto is_disk_writable(const std::string& path) -> bool override;
     [[nodiscard]] auto get_disk_size(const std::string& path)
@@ -71,6 +122,47 @@ public:
      */
     void invalidate_cache();
 
+    /// Where the helper keeps its warm cache between activations
+    static constexpr auto WARM_CACHE_PATH = "/var/cache/storage-wiper/inventory.cache";
+
+    /// Persisted SMART readings older than this are read again
+    static constexpr auto WARM_SMART_MAX_AGE = std::chrono::minutes{10};
+
+    /**
+     * @brief Save device ids and the latest SMART readings
+     *
+     * Written before the helper exits idle so the next activation keeps the
+     * same device ids and can skip the SMART queries of the first listing.
+     * The file is replaced atomically and readable by root only. Does nothing
+     * if no listing is cached, so an earlier save survives invalidate_cache().
+     */
+    [[nodiscard]] auto save_warm_cache(const std::filesystem::path& path = WARM_CACHE_PATH) const
+        -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Load a cache written by save_warm_cache()
+     *
+     * Device ids are restored. SMART readings are used once, by the next
+     * enumeration, for devices whose path and serial still match; devices
+     * without a serial are always queried.
+     */
+    [[nodiscard]] auto load_warm_cache(const std::filesystem::path& path = WARM_CACHE_PATH)
+        -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Roots this service enumerates from
+     */
+    [[nodiscard]] auto paths() const noexcept -> const SystemPaths& { return paths_; }
+
+protected:
+    /**
+     * @brief Whether a stat()ed device path is a node validate_device_path accepts
+     *
+     * Block devices only. Tests over a synthetic tree, which cannot hold real
+     * device nodes, override this in a fixture subclass.
+     */
+    [[nodiscard]] virtual auto is_device_node(mode_t mode) const -> bool;
+
 private:
     /**
      * @brief Parse disk info without SMART data (fast path)
@@ -83,27 +175,48 @@ private:
 
     [[nodiscard]] auto check_if_ssd(const std::string& device_path) -> bool;
 
+    /**
+     * @brief Enumerate disks from sysfs and collect SMART data (uncached)
+     */
+    [[nodiscard]] auto enumerate_disks() -> std::vector<DiskInfo>;
+
+    /**
+     * @brief Stable id for a device, assigned on first sight (cache_mutex_ held)
+     */
+    [[nodiscard]] auto device_id_for(const DiskInfo& disk) -> DiskInventory::DeviceId;
+
     /**
      * @brief Parse /proc/mounts once into a cache structure
-     * @return Parsed mount entries
+     * @return Parsed and indexed mount entries
      */
-    [[nodiscard]] static auto parse_mount_table() -> MountCache;
+    [[nodiscard]] auto parse_mount_table() const -> MountCache;
+
+    /**
+     * @brief Map a "/dev/<name>" path onto the configured device root
+     */
+    [[nodiscard]] auto resolve_dev_path(const std::string& device_path) const -> std::string;
 
     /**
      * @brief Collect dm-* holders for a device and its partitions
      * @param sys_path Path in /sys/block/
-     * @param device_name Device name (e.g., "sda")
      * @return List of dm-* device names
      */
-    [[nodiscard]] static auto collect_dm_holders(const std::string& sys_path,
-                                                 const std::string& device_name)
+    [[nodiscard]] static auto collect_dm_holders(const std::string& sys_path)
         -> std::vector<std::string>;
 
+    SystemPaths paths_;
     std::unique_ptr<SmartService> smart_service_;
 
     // Result cache with TTL
     mutable std::mutex cache_mutex_;
-    std::vector<DiskInfo> cached_disks_;
+    std::shared_ptr<const DiskInventory> cached_inventory_;
     std::chrono::steady_clock::time_point cache_timestamp_;
+
+    // Device ids keyed by path and serial; never reused while the service lives
+    std::unordered_map<std::string, DiskInventory::DeviceId> device_ids_;
+    DiskInventory::DeviceId next_device_id_ = 1;
+
+    // SMART readings from the warm cache, consumed by the next enumeration
+    std::unordered_map<std::string, SmartData> warm_smart_;
     static constexpr auto CACHE_TTL = std::chrono::milliseconds{500};
 };
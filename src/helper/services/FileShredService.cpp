@@ -0,0 +1,338 @@
+/**
+ * @file FileShredService.cpp
+ * @brief Secure deletion of individual files
+ */
+
+#include "helper/services/FileShredService.hpp"
+
+#include "algorithms/AlgorithmFactory.hpp"
+#include "util/FileDescriptor.hpp"
+#include "util/FilesystemKind.hpp"
+#include "util/Logger.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <future>
+#include <utility>
+
+// System headers
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+// Linux-specific headers
+#include <linux/falloc.h>
+#include <linux/fiemap.h>
+#include <linux/fs.h>
+
+namespace {
+
+auto round_up(uint64_t value, uint64_t multiple) -> uint64_t {
+    if (multiple == 0) {
+        return value;
+    }
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+auto physical_layout_changed(const std::vector<FileExtent>& before,
+                             const std::vector<FileExtent>& after) -> bool {
+    if (before.size() != after.size()) {
+        return true;
+    }
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        if (before[i].physical_offset != after[i].physical_offset ||
+            before[i].length != after[i].length) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Open the directory that holds @p path, for the *at() calls on its name
+ */
+auto open_parent_directory(const std::filesystem::path& path) -> util::FileDescriptor {
+    auto parent = path.parent_path();
+    if (parent.empty()) {
+        parent = ".";
+    }
+    return util::FileDescriptor{::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+}
+
+}  // namespace
+
+FileShredService::FileShredService(util::Executor& executor) : executor_(executor) {}
+
+auto FileShredService::map_extents(int fd) -> std::expected<std::vector<FileExtent>, util::Error> {
+    // uint64_t storage keeps struct fiemap suitably aligned
+    constexpr std::size_t bytes = sizeof(fiemap) + FIEMAP_BATCH * sizeof(fiemap_extent);
+    std::vector<uint64_t> storage((bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    auto* map = reinterpret_cast<fiemap*>(storage.data());
+
+    std::vector<FileExtent> extents;
+    uint64_t start = 0;
+    while (true) {
+        std::fill(storage.begin(), storage.end(), 0);
+        map->fm_start = start;
+        map->fm_length = FIEMAP_MAX_OFFSET - start;
+        map->fm_flags = FIEMAP_FLAG_SYNC;
+        map->fm_extent_count = FIEMAP_BATCH;
+
+        if (ioctl(fd, FS_IOC_FIEMAP, map) != 0) {
+            return std::unexpected(
+                util::Error{std::format("FIEMAP failed: {}", strerror(errno)), errno});
+        }
+        if (map->fm_mapped_extents == 0) {
+            break;
+        }
+
+        bool last = false;
+        for (uint32_t i = 0; i < map->fm_mapped_extents; ++i) {
+            const auto& raw = map->fm_extents[i];
+            auto& extent = extents.emplace_back();
+            extent.logical_offset = raw.fe_logical;
+            extent.physical_offset = raw.fe_physical;
+            extent.length = raw.fe_length;
+            extent.flags = raw.fe_flags;
+            last = (raw.fe_flags & FIEMAP_EXTENT_LAST) != 0;
+        }
+        if (last) {
+            break;
+        }
+        const auto& tail = extents.back();
+        start = tail.logical_offset + tail.length;
+    }
+    return extents;
+}
+
+auto FileShredService::in_place_warnings(int fd, const std::vector<FileExtent>& extents)
+    -> std::vector<std::string> {
+    std::vector<std::string> warnings;
+
+    struct statfs fs{};
+    if (fstatfs(fd, &fs) == 0) {
+        if (const char* name = util::lookup_filesystem(static_cast<long>(fs.f_type),
+                                                       util::OUT_OF_PLACE_FILESYSTEMS)) {
+            warnings.push_back(std::format(
+                "{} writes new data to fresh blocks; the original contents may remain on disk "
+                "until that space is reused. Wipe free space or the whole device for assurance",
+                name));
+        }
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == 0 && st.st_nlink > 1) {
+        warnings.push_back(std::format(
+            "File has {} hard links; the other names will see the overwritten data", st.st_nlink));
+    }
+
+    uint32_t flags = 0;
+    for (const auto& extent : extents) {
+        flags |= extent.flags;
+    }
+    if ((flags & FIEMAP_EXTENT_SHARED) != 0) {
+        warnings.emplace_back(
+            "File shares extents with reflinked copies or snapshots; those copies keep the data");
+    }
+    if ((flags & (FIEMAP_EXTENT_ENCODED | FIEMAP_EXTENT_DATA_ENCRYPTED)) != 0) {
+        warnings.emplace_back(
+            "File has compressed or encrypted extents; the stored bytes cannot be overwritten "
+            "in place");
+    }
+    if ((flags & (FIEMAP_EXTENT_DATA_INLINE | FIEMAP_EXTENT_NOT_ALIGNED)) != 0) {
+        warnings.emplace_back("Part of the file is stored inline with filesystem metadata");
+    }
+    return warnings;
+}
+
+auto FileShredService::shred(const std::string& path, const ShredOptions& options,
+                             const ShredCallback& callback, const std::atomic<bool>& cancel_flag)
+    -> ShredResult {
+    ShredResult result;
+    result.path = path;
+
+    auto finish = [&](bool success, std::string message) -> ShredResult {
+        result.success = success;
+        result.message = std::move(message);
+        if (success) {
+            LOG_INFO("FileShredService", std::format("{}: {}", path, result.message));
+        } else {
+            LOG_ERROR("FileShredService", std::format("{}: {}", path, result.message));
+        }
+        if (callback) {
+            ShredProgress update;
+            update.path = path;
+            update.progress.is_complete = true;
+            update.progress.has_error = !success;
+            update.progress.percentage = success ? 100.0 : 0.0;
+            update.progress.bytes_written = result.bytes_overwritten;
+            update.progress.total_bytes = result.bytes_overwritten;
+            update.progress.status = success ? result.message : "Shred failed";
+            update.progress.error_message = success ? "" : result.message;
+            update.warnings = result.warnings;
+            callback(update);
+        }
+        return std::move(result);
+    };
+
+    // Thin Discard only deallocates a file's blocks, it never overwrites them
+    auto algorithm = make_wipe_algorithm(options.algorithm);
+    if (!algorithm || algorithm->requires_device_access() ||
+        options.algorithm == WipeAlgorithm::THIN_DISCARD) {
+        return finish(false, "Algorithm cannot be applied to individual files");
+    }
+
+    // Every step goes through the parent directory opened here, so the name that
+    // is finally unlinked is looked up in the same directory the file was opened in
+    const std::filesystem::path file_path{path};
+    const auto name = file_path.filename();
+    const auto dir = open_parent_directory(file_path);
+    if (!dir) {
+        return finish(false, std::format("Cannot open directory: {}", strerror(errno)));
+    }
+
+    struct stat link_st{};
+    if (name.empty() || fstatat(dir.get(), name.c_str(), &link_st, AT_SYMLINK_NOFOLLOW) != 0) {
+        return finish(false, std::format("Cannot stat file: {}", strerror(errno)));
+    }
+    if (!S_ISREG(link_st.st_mode)) {
+        return finish(false, "Not a regular file");
+    }
+    if (options.required_owner && *options.required_owner != 0 &&
+        link_st.st_uid != *options.required_owner) {
+        return finish(false, "File is not owned by the requesting user");
+    }
+
+    // O_SYNC mirrors the device wipe path: every pass reaches stable storage
+    // before the next one starts, so later passes cannot coalesce in the page cache
+    util::FileDescriptor fd{
+        ::openat(dir.get(), name.c_str(), O_WRONLY | O_SYNC | O_NOFOLLOW | O_CLOEXEC)};
+    if (!fd) {
+        return finish(false, std::format("Failed to open file: {}", strerror(errno)));
+    }
+
+    struct stat st{};
+    if (fstat(fd.get(), &st) != 0 || st.st_ino != link_st.st_ino || st.st_dev != link_st.st_dev) {
+        return finish(false, "File changed while opening");
+    }
+
+    struct statfs fs{};
+    if (fstatfs(fd.get(), &fs) == 0) {
+        const char* name =
+            util::lookup_filesystem(static_cast<long>(fs.f_type), util::PSEUDO_FILESYSTEMS);
+        if (name) {
+            return finish(false, std::format("Refusing to shred a file on {}", name));
+        }
+    }
+
+    auto extents = map_extents(fd.get());
+    if (extents) {
+        result.warnings = in_place_warnings(fd.get(), *extents);
+    } else {
+        result.warnings = in_place_warnings(fd.get(), {});
+        result.warnings.push_back(
+            std::format("Could not verify the on-disk layout ({})", extents.error().message));
+    }
+
+    // Cover the whole last block: its tail past EOF may hold older data
+    const auto overwrite_size =
+        round_up(static_cast<uint64_t>(st.st_size), static_cast<uint64_t>(st.st_blksize));
+
+    if (overwrite_size > 0) {
+        auto forward = [&](const WipeProgress& progress) {
+            if (!callback) {
+                return;
+            }
+            ShredProgress update;
+            update.path = path;
+            update.progress = progress;
+            update.progress.is_complete = false;
+            callback(update);
+        };
+
+        if (!algorithm->execute(fd.get(), overwrite_size, forward, cancel_flag)) {
+            return finish(false, cancel_flag.load() ? "Operation was cancelled by user"
+                                                    : "Overwrite failed");
+        }
+        if (fdatasync(fd.get()) != 0) {
+            return finish(false, std::format("fdatasync failed: {}", strerror(errno)));
+        }
+        result.bytes_overwritten = overwrite_size;
+
+        if (extents && !extents->empty()) {
+            auto after = map_extents(fd.get());
+            if (after && physical_layout_changed(*extents, *after)) {
+                result.warnings.emplace_back(
+                    "Filesystem moved the data while overwriting; the original blocks were not "
+                    "overwritten");
+            }
+        }
+    }
+
+    if (options.discard && overwrite_size > 0) {
+        if (fallocate(fd.get(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, 0,
+                      static_cast<off_t>(overwrite_size)) != 0) {
+            result.warnings.push_back(
+                std::format("Discard not supported by the filesystem: {}", strerror(errno)));
+        }
+    }
+
+    if (!options.remove) {
+        if (ftruncate(fd.get(), st.st_size) != 0 || fsync(fd.get()) != 0) {
+            return finish(false, std::format("Failed to restore file size: {}", strerror(errno)));
+        }
+        return finish(true, std::format("Overwrote {} bytes", overwrite_size));
+    }
+
+    // Drop the size before unlinking so no name ever points at a sized inode
+    if (ftruncate(fd.get(), 0) != 0 || fsync(fd.get()) != 0) {
+        return finish(false, std::format("Failed to truncate file: {}", strerror(errno)));
+    }
+
+    // The name may have been renamed over while the passes ran; never unlink a
+    // file that was not the one overwritten
+    struct stat named{};
+    if (fstatat(dir.get(), name.c_str(), &named, AT_SYMLINK_NOFOLLOW) != 0 ||
+        named.st_ino != st.st_ino || named.st_dev != st.st_dev) {
+        return finish(false, "File was replaced while shredding; the new file was kept");
+    }
+    if (unlinkat(dir.get(), name.c_str(), 0) != 0) {
+        return finish(false, std::format("Failed to remove file: {}", strerror(errno)));
+    }
+    fd = util::FileDescriptor{-1};
+
+    // Make the unlink durable
+    if (fsync(dir.get()) != 0) {
+        LOG_WARNING("FileShredService", std::format("fsync of the directory of {} failed: {}",
+                                                    path, strerror(errno)));
+    }
+
+    return finish(true, std::format("Shredded {} bytes", overwrite_size));
+}
+
+auto FileShredService::shred_all(const std::vector<std::string>& paths,
+                                 const ShredOptions& options, const ShredCallback& callback,
+                                 const std::atomic<bool>& cancel_flag) -> std::vector<ShredResult> {
+    std::vector<std::future<ShredResult>> pending;
+    pending.reserve(paths.size());
+    for (const auto& path : paths) {
+        pending.push_back(executor_.submit(
+            [this, &path, &options, &callback, &cancel_flag] {
+                return shred(path, options, callback, cancel_flag);
+            },
+            util::TaskPriority::BULK, util::TaskLane::BLOCKING_IO));
+    }
+
+    std::vector<ShredResult> results;
+    results.reserve(paths.size());
+    for (auto& future : pending) {
+        results.push_back(future.get());
+    }
+    return results;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file FileShredService.hpp
+ * @brief Secure deletion of individual files
+ *
+ * Overwrites a regular file in place with one of the disk wipe algorithms,
+ * optionally releases the blocks to the device, then truncates and unlinks it.
+ * The file's extents are mapped with FIEMAP before and after the overwrite so
+ * the caller learns when the filesystem did not write in place (copy-on-write,
+ * reflinks, compression, inline data) and the original data may survive.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Executor.hpp"
+#include "util/Result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+/**
+ * @brief One physical extent of a file as reported by FS_IOC_FIEMAP
+ */
+struct FileExtent {
+    uint64_t logical_offset = 0;
+    uint64_t physical_offset = 0;
+    uint64_t length = 0;
+    uint32_t flags = 0;  ///< FIEMAP_EXTENT_* flags
+
+    auto operator==(const FileExtent&) const -> bool = default;
+};
+
+/**
+ * @brief Options for a shred operation
+ */
+struct ShredOptions {
+    WipeAlgorithm algorithm = WipeAlgorithm::ZERO_FILL;
+    bool discard = false;  ///< Punch out the overwritten range so the device can discard it
+    bool remove = true;    ///< Truncate and unlink after overwriting
+    /// Refuse files not owned by this user (set by the helper to the D-Bus caller)
+    std::optional<uid_t> required_owner;
+};
+
+/**
+ * @brief Outcome for one file
+ */
+struct ShredResult {
+    std::string path;
+    bool success = false;
+    std::string message;
+    std::vector<std::string> warnings;
+    uint64_t bytes_overwritten = 0;
+};
+
+/**
+ * @class FileShredService
+ * @brief Overwrites and removes files, several at a time
+ *
+ * Stateless apart from the executor reference; shred() and shred_all() may be
+ * called from any thread. Progress callbacks run on the worker threads.
+ */
+class FileShredService {
+public:
+    explicit FileShredService(util::Executor& executor = util::Executor::shared());
+
+    /**
+     * @brief Map the physical extents of an open file
+     * @return Extents in logical order, or an error when FIEMAP is unsupported
+     */
+    [[nodiscard]] static auto map_extents(int fd)
+        -> std::expected<std::vector<FileExtent>, util::Error>;
+
+    /**
+     * @brief Reasons an in-place overwrite of this file may leave data behind
+     * @param fd Open file
+     * @param extents Extent map from map_extents()
+     */
+    [[nodiscard]] static auto in_place_warnings(int fd, const std::vector<FileExtent>& extents)
+        -> std::vector<std::string>;
+
+    /**
+     * @brief Shred one file, blocking until done
+     */
+    [[nodiscard]] auto shred(const std::string& path, const ShredOptions& options,
+                             const ShredCallback& callback, const std::atomic<bool>& cancel_flag)
+        -> ShredResult;
+
+    /**
+     * @brief Shred several files in parallel on the executor's blocking I/O lane
+     * @return Results in the order of @p paths
+     *
+     * The callback is invoked concurrently from several workers.
+     * Blocks the calling thread; do not call from an executor worker.
+     */
+    [[nodiscard]] auto shred_all(const std::vector<std::string>& paths, const ShredOptions& options,
+                                 const ShredCallback& callback,
+                                 const std::atomic<bool>& cancel_flag) -> std::vector<ShredResult>;
+
+private:
+    static constexpr std::size_t FIEMAP_BATCH = 256;
+
+    util::Executor& executor_;
+};
@@ -0,0 +1,395 @@
+/**
+ * @file FreeSpaceWipeService.cpp
+ * @brief Sanitize the free space of a mounted filesystem
+ */
+
+#include "helper/services/FreeSpaceWipeService.hpp"
+
+#include "algorithms/AlgorithmFactory.hpp"
+#include "util/FileDescriptor.hpp"
+#include "util/FilesystemKind.hpp"
+#include "util/Logger.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// System headers
+#include <fcntl.h>
+#include <grp.h>
+#include <pwd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+// Linux-specific headers
+#include <linux/fs.h>
+
+namespace {
+
+constexpr auto FILL_DIR_TEMPLATE = ".storage-wiper-free-XXXXXX";
+
+/**
+ * @brief Shared bookkeeping of one overwrite job
+ *
+ * Allocation decisions, progress aggregation and the back-off check are
+ * serialized by the mutex, so the callback never runs concurrently.
+ */
+struct FillState {
+    std::mutex mutex;
+    std::atomic<bool> stop{false};
+    bool cancelled = false;
+    bool backed_off = false;
+    std::string error;
+
+    uint64_t target = 0;              // Headroom when the job started
+    uint64_t completed = 0;           // Bytes in fully overwritten filler files
+    uint64_t unreserved = 0;          // Claimed but not preallocated (no fallocate support)
+    std::vector<uint64_t> in_flight;  // Per-writer bytes of the current file
+    std::size_t next_file = 0;
+    std::chrono::steady_clock::time_point last_probe{};
+};
+
+auto headroom(uint64_t available, uint64_t reserve) -> uint64_t {
+    return available > reserve ? available - reserve : 0;
+}
+
+// Primary or supplementary group membership of a user, from the user database
+auto user_in_group(uid_t uid, gid_t gid) -> bool {
+    long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+    std::vector<char> buffer(size > 0 ? static_cast<std::size_t>(size) : 16384);
+    struct passwd pw{};
+    struct passwd* found = nullptr;
+    if (getpwuid_r(uid, &pw, buffer.data(), buffer.size(), &found) != 0 || found == nullptr) {
+        return false;
+    }
+    if (pw.pw_gid == gid) {
+        return true;
+    }
+
+    int count = 32;
+    std::vector<gid_t> groups(static_cast<std::size_t>(count));
+    while (getgrouplist(pw.pw_name, pw.pw_gid, groups.data(), &count) < 0) {
+        groups.resize(static_cast<std::size_t>(count));
+    }
+    groups.resize(static_cast<std::size_t>(count));
+    return std::ranges::find(groups, gid) != groups.end();
+}
+
+// Owner, or write and search permission through the group or other bits
+auto user_may_write(const struct stat& st, uid_t uid) -> bool {
+    if (st.st_uid == uid) {
+        return true;
+    }
+    constexpr mode_t OTHER_WX = S_IWOTH | S_IXOTH;
+    constexpr mode_t GROUP_WX = S_IWGRP | S_IXGRP;
+    if ((st.st_mode & OTHER_WX) == OTHER_WX) {
+        return true;
+    }
+    return (st.st_mode & GROUP_WX) == GROUP_WX && user_in_group(uid, st.st_gid);
+}
+
+}  // namespace
+
+FreeSpaceWipeService::FreeSpaceWipeService(util::Executor& executor, FreeSpaceProbe probe)
+    : executor_(executor), probe_(std::move(probe)) {}
+
+auto FreeSpaceWipeService::statvfs_probe(const std::string& directory)
+    -> std::expected<uint64_t, util::Error> {
+    struct statvfs vfs{};
+    if (statvfs(directory.c_str(), &vfs) != 0) {
+        return std::unexpected(
+            util::Error{std::format("statvfs failed: {}", strerror(errno)), errno});
+    }
+    return static_cast<uint64_t>(vfs.f_bavail) * static_cast<uint64_t>(vfs.f_frsize);
+}
+
+auto FreeSpaceWipeService::check_directory(const std::string& directory,
+                                           std::optional<uid_t> required_owner)
+    -> std::expected<void, util::Error> {
+    util::FileDescriptor fd{::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+    if (!fd) {
+        return std::unexpected(util::Error{"Not a directory: " + directory, errno});
+    }
+
+    struct statfs fs{};
+    if (fstatfs(fd.get(), &fs) == 0) {
+        if (const char* name = util::lookup_filesystem(static_cast<long>(fs.f_type),
+                                                       util::PSEUDO_FILESYSTEMS)) {
+            return std::unexpected(util::Error{std::format("Refusing to fill {}", name)});
+        }
+    }
+
+    struct stat st{};
+    if (fstat(fd.get(), &st) != 0) {
+        return std::unexpected(
+            util::Error{std::format("Cannot stat {}: {}", directory, strerror(errno)), errno});
+    }
+    if (required_owner && *required_owner != 0 && !user_may_write(st, *required_owner)) {
+        return std::unexpected(
+            util::Error{"Directory is not owned by or writable for the requesting user"});
+    }
+    return {};
+}
+
+auto FreeSpaceWipeService::trim(const std::string& directory)
+    -> std::expected<uint64_t, util::Error> {
+    util::FileDescriptor fd{::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+    if (!fd) {
+        return std::unexpected(
+            util::Error{std::format("Cannot open {}: {}", directory, strerror(errno)), errno});
+    }
+
+    fstrim_range range{};
+    range.start = 0;
+    range.len = ULLONG_MAX;
+    range.minlen = 0;
+    if (ioctl(fd.get(), FITRIM, &range) != 0) {
+        return std::unexpected(
+            util::Error{std::format("FITRIM failed: {}", strerror(errno)), errno});
+    }
+    return static_cast<uint64_t>(range.len);
+}
+
+auto FreeSpaceWipeService::wipe(const std::string& directory, const FreeSpaceOptions& options,
+                                const ProgressCallback& callback,
+                                const std::atomic<bool>& cancel_flag) -> FreeSpaceResult {
+    FreeSpaceResult result;
+
+    auto report = [&](double percentage, const std::string& status, bool complete,
+                      uint64_t written, uint64_t total) {
+        if (!callback) {
+            return;
+        }
+        WipeProgress progress{};
+        progress.percentage = percentage;
+        progress.status = status;
+        progress.is_complete = complete;
+        progress.has_error = complete && !result.success;
+        progress.error_message = progress.has_error ? result.message : "";
+        progress.bytes_written = written;
+        progress.total_bytes = total;
+        callback(progress);
+    };
+
+    if (auto checked = check_directory(directory, options.required_owner); !checked) {
+        result.message = checked.error().message;
+        report(0.0, "Free-space wipe failed", true, 0, 0);
+        return result;
+    }
+
+    if (options.method == FreeSpaceMethod::TRIM) {
+        report(0.0, "Discarding free blocks...", false, 0, 0);
+        if (auto trimmed = trim(directory); trimmed) {
+            result.success = true;
+            result.bytes_trimmed = *trimmed;
+            result.message = std::format("Discarded {} bytes of free space", *trimmed);
+        } else {
+            result.message = trimmed.error().message;
+        }
+        LOG_INFO("FreeSpaceWipeService", std::format("{}: {}", directory, result.message));
+        report(result.success ? 100.0 : 0.0, result.message, true, result.bytes_trimmed,
+               result.bytes_trimmed);
+        return result;
+    }
+
+    // Filler files must hold real data; discarding them is what TRIM is for
+    auto algorithm = make_wipe_algorithm(options.algorithm);
+    if (!algorithm || algorithm->requires_device_access() ||
+        options.algorithm == WipeAlgorithm::THIN_DISCARD) {
+        result.message = "Algorithm cannot be used to fill free space";
+        report(0.0, "Free-space wipe failed", true, 0, 0);
+        return result;
+    }
+
+    auto probe = probe_(directory);
+    if (!probe) {
+        result.message = probe.error().message;
+        report(0.0, "Free-space wipe failed", true, 0, 0);
+        return result;
+    }
+
+    std::string fill_dir = (std::filesystem::path{directory} / FILL_DIR_TEMPLATE).string();
+    if (mkdtemp(fill_dir.data()) == nullptr) {
+        result.message = std::format("Cannot create filler directory: {}", strerror(errno));
+        report(0.0, "Free-space wipe failed", true, 0, 0);
+        return result;
+    }
+
+    const auto writers = std::max<std::size_t>(1, options.writers);
+    // Multi-pass patterns must reach the disk each pass, not coalesce in the page cache
+    const int passes = std::max(1, algorithm->get_pass_count());
+    const int sync_flag = passes > 1 ? O_SYNC : 0;
+
+    FillState state;
+    state.target = headroom(*probe, options.reserve_bytes);
+    state.in_flight.assign(writers, 0);
+    LOG_INFO("FreeSpaceWipeService",
+             std::format("{}: filling {} bytes with {} writers, reserve {}", directory,
+                         state.target, writers, options.reserve_bytes));
+
+    // Caller must hold state.mutex
+    auto publish = [&](const std::string& status) {
+        uint64_t written = state.completed;
+        for (auto bytes : state.in_flight) {
+            written += bytes;
+        }
+        const double percentage =
+            state.target > 0 ? std::min(100.0, 100.0 * static_cast<double>(written) /
+                                                   static_cast<double>(state.target))
+                             : 100.0;
+        report(percentage, status, false, written, state.target);
+    };
+
+    // Caller must hold state.mutex. Stops every writer when the user cancels or
+    // when someone else is eating into the reserve.
+    auto check_back_off = [&](bool force_probe) {
+        if (cancel_flag.load()) {
+            state.cancelled = true;
+            state.stop.store(true);
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (!force_probe && now - state.last_probe < PROBE_INTERVAL) {
+            return;
+        }
+        state.last_probe = now;
+        auto available = probe_(directory);
+        if (!available) {
+            state.error = available.error().message;
+            state.stop.store(true);
+        } else if (*available < options.reserve_bytes / 2) {
+            state.backed_off = true;
+            state.stop.store(true);
+        }
+    };
+
+    auto writer = [&](std::size_t index) {
+        auto algorithm = make_wipe_algorithm(options.algorithm);
+        while (!state.stop.load()) {
+            util::FileDescriptor fd{-1};
+            uint64_t size = 0;
+            bool preallocated = true;
+            {
+                std::lock_guard lock(state.mutex);
+                auto available = probe_(directory);
+                if (!available) {
+                    state.error = available.error().message;
+                    state.stop.store(true);
+                    return;
+                }
+                const auto room = headroom(*available, options.reserve_bytes + state.unreserved);
+                size = std::min(options.file_size, room);
+                if (size < MIN_FILE_SIZE) {
+                    return;  // Filesystem is as full as we are allowed to make it
+                }
+
+                auto path = std::format("{}/fill-{}", fill_dir, state.next_file++);
+                fd = util::FileDescriptor{::open(
+                    path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | sync_flag, 0600)};
+                if (!fd) {
+                    state.error = std::format("Cannot create filler file: {}", strerror(errno));
+                    state.stop.store(true);
+                    return;
+                }
+
+                // Claim the space now so concurrent writers and probes see it gone
+                if (fallocate(fd.get(), 0, 0, static_cast<off_t>(size)) != 0) {
+                    if (errno == ENOSPC) {
+                        return;
+                    }
+                    preallocated = false;
+                    state.unreserved += size;
+                }
+            }
+
+            auto on_progress = [&](const WipeProgress& progress) {
+                const double pass_fraction =
+                    (std::max(progress.current_pass, 1) - 1 + progress.percentage / 100.0) /
+                    std::max(progress.total_passes, 1);
+                std::lock_guard lock(state.mutex);
+                state.in_flight[index] =
+                    static_cast<uint64_t>(pass_fraction * static_cast<double>(size));
+                check_back_off(false);
+                publish(std::format("Filling free space ({} writers)", writers));
+            };
+
+            const bool written = algorithm->execute(fd.get(), size, on_progress, state.stop);
+            const bool synced = written && fdatasync(fd.get()) == 0;
+            if (synced) {
+                posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+            }
+
+            std::lock_guard lock(state.mutex);
+            state.in_flight[index] = 0;
+            if (!preallocated) {
+                state.unreserved -= size;
+            }
+            if (synced) {
+                state.completed += size;
+            } else if (!state.stop.load()) {
+                state.error = written ? std::format("fdatasync failed: {}", strerror(errno))
+                                      : "Writing filler file failed";
+                state.stop.store(true);
+            }
+            check_back_off(true);
+        }
+    };
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(writers);
+    for (std::size_t i = 0; i < writers; ++i) {
+        pending.push_back(executor_.submit([&writer, i] { writer(i); }, util::TaskPriority::BULK,
+                                           util::TaskLane::BLOCKING_IO));
+    }
+    for (auto& future : pending) {
+        future.get();
+    }
+
+    {
+        std::lock_guard lock(state.mutex);
+        publish("Removing filler files...");
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(fill_dir, ec);
+    if (ec) {
+        LOG_ERROR("FreeSpaceWipeService",
+                  std::format("Failed to remove {}: {}", fill_dir, ec.message()));
+    }
+    util::FileDescriptor dir{::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+    if (dir) {
+        fsync(dir.get());
+    }
+
+    result.bytes_filled = state.completed;
+    result.backed_off = state.backed_off;
+    if (state.cancelled) {
+        result.message = "Operation was cancelled by user";
+    } else if (!state.error.empty()) {
+        result.message = state.error;
+    } else if (state.backed_off) {
+        result.message = "Stopped early: free space fell below half the reserve";
+    } else {
+        result.success = true;
+        result.message = std::format("Overwrote {} bytes of free space", state.completed);
+    }
+
+    if (result.success) {
+        LOG_INFO("FreeSpaceWipeService", std::format("{}: {}", directory, result.message));
+    } else {
+        LOG_WARNING("FreeSpaceWipeService", std::format("{}: {}", directory, result.message));
+    }
+    const std::string status = result.success ? result.message : "Free-space wipe stopped";
+    report(result.success ? 100.0 : 0.0, status, true, state.completed, state.target);
+    return result;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file FreeSpaceWipeService.hpp
+ * @brief Sanitize the free space of a mounted filesystem
+ *
+ * For disks that cannot be taken offline: deleted data lives on in blocks the
+ * filesystem now reports as free. OVERWRITE fills that space with
+ * preallocated filler files, writes the chosen algorithm's passes into them
+ * with several writers in parallel and removes them again. TRIM asks the
+ * filesystem to discard all free blocks (FITRIM), which is much faster on
+ * SSDs and thin-provisioned storage that honour discards.
+ *
+ * A safety reserve is always left free. Free space is re-checked while
+ * filling; if other users push it below half the reserve the job backs off,
+ * deleting its filler files immediately.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Executor.hpp"
+#include "util/Result.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <sys/types.h>
+
+/**
+ * @enum FreeSpaceMethod
+ * @brief How free space is sanitized
+ */
+enum class FreeSpaceMethod {
+    OVERWRITE,  ///< Fill with filler files and overwrite them
+    TRIM        ///< Discard free blocks with FITRIM
+};
+
+/**
+ * @brief Options for a free-space job
+ */
+struct FreeSpaceOptions {
+    static constexpr uint64_t DEFAULT_RESERVE = 1ULL << 30;    // 1 GiB
+    static constexpr uint64_t DEFAULT_FILE_SIZE = 1ULL << 30;  // 1 GiB per filler file
+    static constexpr std::size_t DEFAULT_WRITERS = 4;
+
+    FreeSpaceMethod method = FreeSpaceMethod::OVERWRITE;
+    WipeAlgorithm algorithm = WipeAlgorithm::ZERO_FILL;
+    uint64_t reserve_bytes = DEFAULT_RESERVE;  ///< Never fill beyond this much free space
+    uint64_t file_size = DEFAULT_FILE_SIZE;    ///< Upper bound per filler file
+    std::size_t writers = DEFAULT_WRITERS;     ///< Filler files written concurrently
+    /// Refuse directories this user neither owns nor may write to (set by the
+    /// helper to the D-Bus caller)
+    std::optional<uid_t> required_owner;
+};
+
+/**
+ * @brief Outcome of a free-space job
+ */
+struct FreeSpaceResult {
+    bool success = false;
+    bool backed_off = false;     ///< Stopped early because free space ran low
+    uint64_t bytes_filled = 0;   ///< Free space covered by completed filler files
+    uint64_t bytes_trimmed = 0;  ///< Reported by FITRIM
+    std::string message;
+};
+
+/**
+ * @class FreeSpaceWipeService
+ * @brief Runs free-space jobs; wipe() blocks the calling thread
+ */
+class FreeSpaceWipeService {
+public:
+    /// Bytes currently available to unprivileged users on the filesystem of a directory
+    using FreeSpaceProbe = std::function<std::expected<uint64_t, util::Error>(const std::string&)>;
+
+    explicit FreeSpaceWipeService(util::Executor& executor = util::Executor::shared(),
+                                  FreeSpaceProbe probe = statvfs_probe);
+
+    /**
+     * @brief Sanitize the free space of the filesystem containing @p directory
+     * @param directory Mount point (or any writable directory) on the filesystem
+     * @param options Method, algorithm, reserve and parallelism
+     * @param callback Aggregate progress; may be invoked from writer threads
+     * @param cancel_flag Set to abort; filler files are always removed
+     */
+    [[nodiscard]] auto wipe(const std::string& directory, const FreeSpaceOptions& options,
+                            const ProgressCallback& callback, const std::atomic<bool>& cancel_flag)
+        -> FreeSpaceResult;
+
+    /**
+     * @brief Whether a directory may be filled on behalf of a user
+     *
+     * Refuses anything but a directory, pseudo filesystems such as procfs, and
+     * (for a non-root @p required_owner) directories that user neither owns
+     * nor has write and search permission on.
+     */
+    [[nodiscard]] static auto check_directory(const std::string& directory,
+                                              std::optional<uid_t> required_owner)
+        -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Discard all free blocks of a mounted filesystem
+     * @return Bytes trimmed as reported by the filesystem
+     */
+    [[nodiscard]] static auto trim(const std::string& directory)
+        -> std::expected<uint64_t, util::Error>;
+
+    /**
+     * @brief Default probe: statvfs() f_bavail * f_frsize
+     */
+    [[nodiscard]] static auto statvfs_probe(const std::string& directory)
+        -> std::expected<uint64_t, util::Error>;
+
+private:
+    static constexpr uint64_t MIN_FILE_SIZE = 1ULL << 20;  // Not worth a filler file below 1 MiB
+    static constexpr auto PROBE_INTERVAL = std::chrono::milliseconds{500};
+
+    util::Executor& executor_;
+    FreeSpaceProbe probe_;
+};
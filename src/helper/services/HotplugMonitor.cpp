@@ -0,0 +1,136 @@
+/**
+ * @file HotplugMonitor.cpp
+ * @brief Kernel uevent listener implementation
+ */
+
+#include "helper/services/HotplugMonitor.hpp"
+
+#include "util/Logger.hpp"
+
+// Standard library
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+// System headers
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Linux-specific headers
+#include <linux/netlink.h>
+
+namespace {
+
+// Kernel multicast group for uevents (group 2 carries udev's rebroadcasts)
+constexpr unsigned KERNEL_UEVENT_GROUP = 1;
+
+constexpr std::string_view BLOCK_SEGMENT = "/block/";
+
+}  // namespace
+
+auto UeventMessage::port_path() const -> std::string {
+    const auto pos = devpath.rfind(BLOCK_SEGMENT);
+    return pos == std::string::npos ? devpath : devpath.substr(0, pos);
+}
+
+auto parse_uevent(std::string_view datagram) -> std::optional<UeventMessage> {
+    // Header is "action@devpath"; udev's own packets start with "libudev"
+    const auto header_end = datagram.find('\0');
+    const auto header = datagram.substr(0, header_end);
+    if (header.find('@') == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    UeventMessage message;
+    auto rest = header_end == std::string_view::npos ? std::string_view{}
+                                                     : datagram.substr(header_end + 1);
+    while (!rest.empty()) {
+        const auto end = rest.find('\0');
+        const auto field = rest.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + 1);
+
+        const auto eq = field.find('=');
+        if (eq == std::string_view::npos) {
+            continue;
+        }
+        const auto key = field.substr(0, eq);
+        const auto value = std::string{field.substr(eq + 1)};
+
+        if (key == "ACTION") {
+            message.action = value;
+        } else if (key == "SUBSYSTEM") {
+            message.subsystem = value;
+        } else if (key == "DEVTYPE") {
+            message.devtype = value;
+        } else if (key == "DEVNAME") {
+            message.devname = value;
+        } else if (key == "DEVPATH") {
+            message.devpath = value;
+        }
+    }
+
+    if (message.action.empty() || message.devpath.empty()) {
+        return std::nullopt;
+    }
+    return message;
+}
+
+auto HotplugMonitor::is_disk_hotplug(const UeventMessage& message) -> bool {
+    return message.subsystem == "block" && message.devtype == "disk" &&
+           !message.devname.empty() && (message.action == "add" || message.action == "remove");
+}
+
+auto HotplugMonitor::open() -> std::expected<void, util::Error> {
+    util::FileDescriptor sock{
+        ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT)};
+    if (!sock) {
+        return std::unexpected(
+            util::Error{std::format("Failed to create uevent socket: {}", std::strerror(errno)),
+                        errno});
+    }
+
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_pid = 0;  // Let the kernel assign a port id
+    address.nl_groups = KERNEL_UEVENT_GROUP;
+    if (::bind(sock.get(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        return std::unexpected(util::Error{
+            std::format("Failed to bind uevent socket: {}", std::strerror(errno)), errno});
+    }
+
+    socket_ = std::move(sock);
+    LOG_INFO("HotplugMonitor", "Listening for block device uevents");
+    return {};
+}
+
+auto HotplugMonitor::read_events() -> std::vector<UeventMessage> {
+    std::vector<UeventMessage> events;
+    if (!socket_) {
+        return events;
+    }
+
+    std::array<char, RECEIVE_BUFFER_SIZE> buffer{};
+    while (true) {
+        const auto received = ::recv(socket_.get(), buffer.data(), buffer.size(), 0);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                LOG_WARNING("HotplugMonitor",
+                            std::format("uevent receive failed: {}", std::strerror(errno)));
+            }
+            break;
+        }
+        if (received == 0) {
+            break;
+        }
+
+        auto message = parse_uevent({buffer.data(), static_cast<std::size_t>(received)});
+        if (message && is_disk_hotplug(*message)) {
+            events.push_back(std::move(*message));
+        }
+    }
+    return events;
+}
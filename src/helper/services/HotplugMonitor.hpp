@@ -0,0 +1,85 @@
+/**
+ * @file HotplugMonitor.hpp
+ * @brief Kernel uevent listener for block device hotplug
+ *
+ * Listens on a NETLINK_KOBJECT_UEVENT socket for add/remove events of whole
+ * block devices. The socket is non-blocking so the helper can watch fd() from
+ * its main loop and drain events with read_events().
+ */
+
+#pragma once
+
+#include "util/FileDescriptor.hpp"
+#include "util/Result.hpp"
+
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief One kernel uevent for a block device
+ */
+struct UeventMessage {
+    std::string action;     // "add", "remove", "change", ...
+    std::string subsystem;  // "block"
+    std::string devtype;    // "disk" or "partition"
+    std::string devname;    // e.g., "sdb"
+    std::string devpath;    // sysfs path without /sys, e.g., "/devices/pci0000:00/.../block/sdb"
+
+    auto operator==(const UeventMessage&) const -> bool = default;
+
+    /**
+     * @brief Device node path (e.g., /dev/sdb)
+     */
+    [[nodiscard]] auto device_path() const -> std::string { return "/dev/" + devname; }
+
+    /**
+     * @brief Physical port the device hangs off: devpath minus the trailing /block/<name>
+     *
+     * Stable for a given bay/controller port across insertions, so station
+     * rules can match on it.
+     */
+    [[nodiscard]] auto port_path() const -> std::string;
+};
+
+/**
+ * @brief Parse a raw kernel uevent datagram ("action@devpath\0KEY=VALUE\0...")
+ * @return Message, or nullopt for malformed datagrams and udev-rebroadcast ("libudev") packets
+ */
+[[nodiscard]] auto parse_uevent(std::string_view datagram) -> std::optional<UeventMessage>;
+
+/**
+ * @class HotplugMonitor
+ * @brief Non-blocking netlink listener yielding whole-disk add/remove events
+ */
+class HotplugMonitor {
+public:
+    HotplugMonitor() = default;
+
+    /**
+     * @brief Open and bind the netlink socket
+     */
+    [[nodiscard]] auto open() -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Socket descriptor to poll for readability (-1 before open())
+     */
+    [[nodiscard]] auto fd() const noexcept -> int { return socket_.get(); }
+
+    /**
+     * @brief Drain pending datagrams, keeping only whole-disk add/remove events
+     */
+    [[nodiscard]] auto read_events() -> std::vector<UeventMessage>;
+
+    /**
+     * @brief Whether a message is a whole-disk add or remove
+     */
+    [[nodiscard]] static auto is_disk_hotplug(const UeventMessage& message) -> bool;
+
+private:
+    static constexpr std::size_t RECEIVE_BUFFER_SIZE = 8'192;
+
+    util::FileDescriptor socket_{-1};
+};
@@ -0,0 +1,82 @@
+/**
+ * @file IdlePolicy.cpp
+ * @brief When the helper gives memory back, and when it exits
+ */
+
+#include "helper/services/IdlePolicy.hpp"
+
+#include "helper/services/StationPolicy.hpp"
+
+// Standard library
+#include <format>
+#include <optional>
+
+namespace {
+
+constexpr std::string_view IDLE_TIMEOUT_OPTION = "--idle-timeout=";
+constexpr std::string_view TRIM_AFTER_OPTION = "--trim-after=";
+
+auto parse_option(std::string_view arg, std::string_view option)
+    -> std::optional<std::expected<std::chrono::seconds, util::Error>> {
+    if (!arg.starts_with(option)) {
+        return std::nullopt;
+    }
+    auto value = parse_duration(arg.substr(option.size()));
+    if (!value) {
+        return std::unexpected(util::Error{std::format("Invalid duration in '{}'", arg)});
+    }
+    return *value;
+}
+
+}  // namespace
+
+auto IdleSettings::parse_arguments(std::span<const std::string_view> args)
+    -> std::expected<IdleSettings, util::Error> {
+    IdleSettings settings;
+    for (const auto arg : args) {
+        if (auto timeout = parse_option(arg, IDLE_TIMEOUT_OPTION)) {
+            if (!*timeout) {
+                return std::unexpected(timeout->error());
+            }
+            settings.exit_after = **timeout;
+        } else if (auto trim = parse_option(arg, TRIM_AFTER_OPTION)) {
+            if (!*trim) {
+                return std::unexpected(trim->error());
+            }
+            settings.trim_after = **trim;
+        } else {
+            return std::unexpected(util::Error{std::format("Unknown argument '{}'", arg)});
+        }
+    }
+    return settings;
+}
+
+IdlePolicy::IdlePolicy(IdleSettings settings, Clock::time_point now)
+    : settings_(settings), last_activity_(now) {}
+
+void IdlePolicy::note_activity(Clock::time_point now) {
+    last_activity_ = now;
+    trimmed_ = false;  // New work may have grown the heap again
+}
+
+auto IdlePolicy::idle_for(Clock::time_point now) const -> Clock::duration {
+    return now - last_activity_;
+}
+
+auto IdlePolicy::poll(Clock::time_point now, const Activity& activity) -> IdleAction {
+    if (activity.busy) {
+        note_activity(now);
+        return IdleAction::NONE;
+    }
+
+    const auto idle = idle_for(now);
+    if (activity.may_exit && activity.clients == 0 && settings_.exit_after.count() > 0 &&
+        idle >= settings_.exit_after) {
+        return IdleAction::EXIT;
+    }
+    if (!trimmed_ && settings_.trim_after.count() > 0 && idle >= settings_.trim_after) {
+        trimmed_ = true;
+        return IdleAction::TRIM;
+    }
+    return IdleAction::NONE;
+}
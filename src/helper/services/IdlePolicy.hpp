@@ -0,0 +1,100 @@
+/**
+ * @file IdlePolicy.hpp
+ * @brief When the helper gives memory back, and when it exits
+ *
+ * The helper is D-Bus activated, so it does not need to stay resident once
+ * nobody is using it. IdlePolicy turns periodic observations (is a job
+ * running, how many clients are connected) into one of two actions:
+ *
+ * - TRIM: no job has run for trim_after. Caches are dropped and freed heap
+ *   pages are returned to the kernel, once per idle period.
+ * - EXIT: additionally no client has been connected for exit_after. The
+ *   helper saves its warm cache and exits; the next call re-activates it.
+ *
+ * Both are set on the helper command line, e.g. "--idle-timeout=10m
+ * --trim-after=30s"; "--idle-timeout=0" keeps the helper resident. Station
+ * mode never exits, since it has to be present when disks are inserted.
+ *
+ * Not thread-safe; the helper calls it from its main loop.
+ */
+
+#pragma once
+
+#include "util/Result.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+
+/**
+ * @brief Idle thresholds
+ */
+struct IdleSettings {
+    std::chrono::seconds trim_after{30};   // Without jobs; 0 = never trim
+    std::chrono::seconds exit_after{300};  // Without jobs or clients; 0 = stay resident
+
+    /**
+     * @brief Read --idle-timeout=DURATION and --trim-after=DURATION
+     * @param args Command-line arguments without the program name
+     * @return Settings (defaults for absent options), or an error naming the bad argument
+     */
+    [[nodiscard]] static auto parse_arguments(std::span<const std::string_view> args)
+        -> std::expected<IdleSettings, util::Error>;
+};
+
+/**
+ * @enum IdleAction
+ * @brief What the helper should do after an idle check
+ */
+enum class IdleAction : std::uint8_t {
+    NONE,  ///< Keep running
+    TRIM,  ///< Release caches and free heap pages
+    EXIT   ///< Save the warm cache and quit
+};
+
+/**
+ * @brief Tracks time since the helper last did anything
+ */
+class IdlePolicy {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief What the helper looks like at one check
+     */
+    struct Activity {
+        bool busy = false;        // A wipe, shred or station job is queued or running
+        std::size_t clients = 0;  // Peers that have called the helper and are still connected
+        bool may_exit = true;     // False while something needs the helper resident
+    };
+
+    IdlePolicy(IdleSettings settings, Clock::time_point now);
+
+    /**
+     * @brief Restart the idle period (a request arrived or a client left)
+     */
+    void note_activity(Clock::time_point now);
+
+    /**
+     * @brief Decide what to do now
+     *
+     * TRIM is returned at most once per idle period; EXIT is returned on
+     * every check once it applies.
+     */
+    [[nodiscard]] auto poll(Clock::time_point now, const Activity& activity) -> IdleAction;
+
+    /**
+     * @brief Time since the last activity
+     */
+    [[nodiscard]] auto idle_for(Clock::time_point now) const -> Clock::duration;
+
+    [[nodiscard]] auto settings() const noexcept -> const IdleSettings& { return settings_; }
+
+private:
+    IdleSettings settings_;
+    Clock::time_point last_activity_;
+    bool trimmed_ = false;
+};
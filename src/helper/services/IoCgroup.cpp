@@ -0,0 +1,287 @@
+/**
+ * @file IoCgroup.cpp
+ * @brief cgroup v2 io controller setup, limits and io.stat parsing
+ */
+
+#include "helper/services/IoCgroup.hpp"
+
+#include "util/FileDescriptor.hpp"
+#include "util/Logger.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+auto read_file(const fs::path& path) -> std::optional<std::string> {
+    std::ifstream file{path};
+    if (!file) {
+        return std::nullopt;
+    }
+    return std::string{std::istreambuf_iterator<char>{file}, {}};
+}
+
+auto write_file(const fs::path& path, std::string_view value) -> std::expected<void, util::Error> {
+    util::FileDescriptor fd(::open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC));
+    // cgroupfs parses each write on its own, so the line goes in one call
+    if (!fd ||
+        ::write(fd.get(), value.data(), value.size()) != static_cast<ssize_t>(value.size())) {
+        return std::unexpected(util::Error{
+            std::format("Cannot write \"{}\" to {}: {}", value, path.string(), strerror(errno)),
+            errno});
+    }
+    return {};
+}
+
+template <typename T>
+auto parse_number(std::string_view text) -> std::optional<T> {
+    T value{};
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+auto words(std::string_view text) -> std::vector<std::string_view> {
+    std::vector<std::string_view> result;
+    for (auto word : text | std::views::split(' ')) {
+        if (!word.empty()) {
+            result.emplace_back(word.begin(), word.end());
+        }
+    }
+    return result;
+}
+
+auto has_word(std::string_view text, std::string_view word) -> bool {
+    for (auto line : text | std::views::split('\n')) {
+        for (const auto entry : words({line.begin(), line.end()})) {
+            if (entry == word) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+auto limit_value(uint64_t value) -> std::string {
+    return value == 0 ? "max" : std::to_string(value);
+}
+
+auto parse_device_number(std::string_view text) -> std::optional<DeviceNumber> {
+    const auto colon = text.find(':');
+    if (colon == std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto major = parse_number<unsigned>(text.substr(0, colon));
+    const auto minor = parse_number<unsigned>(text.substr(colon + 1));
+    if (!major || !minor) {
+        return std::nullopt;
+    }
+    return DeviceNumber{.major = *major, .minor = *minor};
+}
+
+}  // namespace
+
+auto disk_number(const std::string& device_path) -> std::optional<DeviceNumber> {
+    struct stat st{};
+    if (stat(device_path.c_str(), &st) != 0 || !S_ISBLK(st.st_mode)) {
+        return std::nullopt;
+    }
+    DeviceNumber device{.major = major(st.st_rdev), .minor = minor(st.st_rdev)};
+
+    // The io controller only takes whole disks; a partition's disk is its sysfs parent
+    std::error_code ec;
+    const auto sys_dir = fs::canonical(
+        std::format("/sys/dev/block/{}:{}", device.major, device.minor), ec);
+    if (!ec && fs::exists(sys_dir / "partition", ec)) {
+        const auto parent = read_file(sys_dir.parent_path() / "dev");
+        if (!parent) {
+            return std::nullopt;
+        }
+        return parse_device_number(std::string_view{*parent}.substr(0, parent->find('\n')));
+    }
+    return device;
+}
+
+auto format_io_max(DeviceNumber device, const IoLimits& limits) -> std::string {
+    return std::format("{}:{} rbps={} wbps={} riops={} wiops={}", device.major, device.minor,
+                       limit_value(limits.read_bps), limit_value(limits.write_bps),
+                       limit_value(limits.read_iops), limit_value(limits.write_iops));
+}
+
+auto parse_io_stat(std::string_view text, DeviceNumber device) -> std::optional<IoStat> {
+    const auto key = std::format("{}:{}", device.major, device.minor);
+    for (auto range : text | std::views::split('\n')) {
+        const auto fields = words({range.begin(), range.end()});
+        if (fields.empty() || fields.front() != key) {
+            continue;
+        }
+        IoStat stat;
+        for (const auto field : fields | std::views::drop(1)) {
+            const auto equals = field.find('=');
+            if (equals == std::string_view::npos) {
+                continue;
+            }
+            const auto name = field.substr(0, equals);
+            const auto value = parse_number<uint64_t>(field.substr(equals + 1)).value_or(0);
+            if (name == "rbytes") {
+                stat.read_bytes = value;
+            } else if (name == "wbytes") {
+                stat.write_bytes = value;
+            } else if (name == "rios") {
+                stat.read_ios = value;
+            } else if (name == "wios") {
+                stat.write_ios = value;
+            } else if (name == "dbytes") {
+                stat.discard_bytes = value;
+            } else if (name == "dios") {
+                stat.discard_ios = value;
+            }
+        }
+        return stat;
+    }
+    return std::nullopt;
+}
+
+auto parse_own_cgroup(std::string_view proc_self_cgroup) -> std::optional<std::string> {
+    // cgroup v2 is the hierarchy with id 0 and no controller list
+    for (auto range : proc_self_cgroup | std::views::split('\n')) {
+        const std::string_view line{range.begin(), range.end()};
+        if (line.starts_with("0::/")) {
+            return std::string{line.substr(3)};
+        }
+    }
+    return std::nullopt;
+}
+
+IoCgroup::IoCgroup(fs::path root, fs::path self) : root_(std::move(root)), self_(std::move(self)) {}
+
+auto IoCgroup::open() -> std::expected<void, util::Error> {
+    const auto membership = read_file(self_);
+    const auto own = membership ? parse_own_cgroup(*membership) : std::nullopt;
+    if (!own) {
+        return std::unexpected(util::Error{"Not running in a cgroup v2 hierarchy"});
+    }
+
+    auto service = root_ / fs::path{*own}.relative_path();
+    // Already moved, e.g. open() called twice
+    if (service.filename() == WORKER_GROUP) {
+        service = service.parent_path();
+    }
+    const auto controllers = read_file(service / "cgroup.controllers");
+    if (!controllers || !has_word(*controllers, "io")) {
+        return std::unexpected(
+            util::Error{std::format("io controller is not delegated to {}", service.string())});
+    }
+
+    const auto worker = service / WORKER_GROUP;
+    std::error_code ec;
+    fs::create_directory(worker, ec);
+    if (ec) {
+        return std::unexpected(util::Error{
+            std::format("Cannot create {}: {}", worker.string(), ec.message()), ec.value()});
+    }
+    if (auto moved = write_file(worker / "cgroup.procs", std::to_string(::getpid())); !moved) {
+        return std::unexpected(moved.error());
+    }
+    if (const auto enabled = read_file(service / "cgroup.subtree_control");
+        !enabled || !has_word(*enabled, "io")) {
+        if (auto enable = write_file(service / "cgroup.subtree_control", "+io"); !enable) {
+            return std::unexpected(enable.error());
+        }
+    }
+
+    std::lock_guard lock{mutex_};
+    service_ = service;
+    path_ = worker;
+    LOG_INFO("IoCgroup", std::format("Wipe I/O runs in {}", path_.string()));
+    return {};
+}
+
+auto IoCgroup::set_limits(DeviceNumber device, const IoLimits& limits)
+    -> std::expected<void, util::Error> {
+    std::lock_guard lock{mutex_};
+    if (path_.empty()) {
+        return std::unexpected(util::Error{"I/O cgroup is not available"});
+    }
+    if (limits.weight > 10'000) {
+        return std::unexpected(util::Error{"io.weight must be between 1 and 10000"});
+    }
+
+    if (auto written = write_file(path_ / "io.max", format_io_max(device, limits)); !written) {
+        return written;
+    }
+
+    const auto key = std::format("{}:{}", device.major, device.minor);
+    // io.weight needs the iocost or bfq policy, io.latency the iolatency one
+    std::error_code ec;
+    if (fs::exists(service_ / "io.weight", ec)) {
+        const auto weight = limits.weight == 0 ? std::string{"default"}
+                                               : std::to_string(limits.weight);
+        if (auto written = write_file(service_ / "io.weight", std::format("{} {}", key, weight));
+            !written) {
+            return written;
+        }
+    } else if (limits.weight != 0) {
+        LOG_WARNING("IoCgroup", "io.weight is not available; the weight is ignored");
+    }
+    if (fs::exists(service_ / "io.latency", ec)) {
+        if (auto written = write_file(service_ / "io.latency",
+                                      std::format("{} target={}", key,
+                                                  limit_value(limits.latency_target_us)));
+            !written) {
+            return written;
+        }
+    } else if (limits.latency_target_us != 0) {
+        LOG_WARNING("IoCgroup", "io.latency is not available; the latency target is ignored");
+    }
+
+    if (limits == IoLimits{}) {
+        limits_.erase(device);
+    } else {
+        limits_[device] = limits;
+    }
+    LOG_INFO("IoCgroup", std::format("{}: {}, weight {}, latency target {} us",
+                                     key, format_io_max(device, limits), limits.weight,
+                                     limits.latency_target_us));
+    return {};
+}
+
+auto IoCgroup::limits(DeviceNumber device) const -> IoLimits {
+    std::lock_guard lock{mutex_};
+    const auto it = limits_.find(device);
+    return it == limits_.end() ? IoLimits{} : it->second;
+}
+
+auto IoCgroup::stat(DeviceNumber device) const -> std::optional<IoStat> {
+    fs::path path;
+    {
+        std::lock_guard lock{mutex_};
+        path = path_;
+    }
+    if (path.empty()) {
+        return std::nullopt;
+    }
+    const auto text = read_file(path / "io.stat");
+    if (!text) {
+        return std::nullopt;
+    }
+    // No line yet means no I/O to the device so far
+    return parse_io_stat(*text, device).value_or(IoStat{});
+}
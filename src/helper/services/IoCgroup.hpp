@@ -0,0 +1,145 @@
+/**
+ * @file IoCgroup.hpp
+ * @brief cgroup v2 I/O control and accounting for wipe workers
+ *
+ * A rate limit in the wipe loop only spaces out submissions; once requests
+ * are queued in the kernel, a wipe can still starve other tenants of the
+ * same disk. The cgroup v2 io controller acts inside the block layer:
+ *
+ * - io.max caps bytes and requests per second per device;
+ * - io.weight sets the share of a contended device relative to sibling
+ *   cgroups (the other services of the slice);
+ * - io.latency sets the helper's own latency target; when a sibling with a
+ *   tighter target misses it, the group with the looser target is throttled.
+ *
+ * The helper runs in a delegated child of its own service cgroup (the io
+ * controller cannot be applied to single threads). io.max and io.stat live on
+ * that child; io.weight and io.latency compare siblings, so they go on the
+ * service cgroup, which has the other services as siblings. Every setting and
+ * every io.stat line is keyed by the target disk, and a disk is wiped by one
+ * job at a time, so limits and accounting are per job.
+ *
+ * The whole helper process lives in the worker cgroup, because the io
+ * controller cannot split one process. A disk's limits and io.stat line
+ * therefore also cover the helper's other I/O on that disk: verification
+ * reads, surface scans, file shreds and free-space wipes on its filesystems.
+ * A scan or a file shred never overlaps a wipe of the same disk, so a wipe's
+ * io.stat delta is its own I/O plus a few kilobytes of SMART and sysfs reads.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Result.hpp"
+
+#include <compare>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Block device number (MAJ:MIN) of a whole disk
+ */
+struct DeviceNumber {
+    unsigned major = 0;
+    unsigned minor = 0;
+
+    auto operator<=>(const DeviceNumber&) const = default;
+};
+
+/**
+ * @brief io controller settings for one device; 0 leaves a setting at its default
+ */
+struct IoLimits {
+    uint64_t read_bps = 0;
+    uint64_t write_bps = 0;
+    uint64_t read_iops = 0;
+    uint64_t write_iops = 0;
+    uint32_t weight = 0;             ///< 1-10000; the default is 100
+    uint64_t latency_target_us = 0;  ///< io.latency target
+
+    auto operator==(const IoLimits&) const -> bool = default;
+};
+
+/**
+ * @brief Whole-disk device number of a device node; partitions resolve to their disk
+ */
+[[nodiscard]] auto disk_number(const std::string& device_path) -> std::optional<DeviceNumber>;
+
+/**
+ * @brief io.max line for a device, e.g. "8:16 rbps=max wbps=104857600 riops=max wiops=max"
+ */
+[[nodiscard]] auto format_io_max(DeviceNumber device, const IoLimits& limits) -> std::string;
+
+/**
+ * @brief The device's line of an io.stat file
+ */
+[[nodiscard]] auto parse_io_stat(std::string_view text, DeviceNumber device)
+    -> std::optional<IoStat>;
+
+/**
+ * @brief cgroup v2 path from /proc/self/cgroup ("0::/system.slice/x.service")
+ */
+[[nodiscard]] auto parse_own_cgroup(std::string_view proc_self_cgroup)
+    -> std::optional<std::string>;
+
+/**
+ * @class IoCgroup
+ * @brief The helper's I/O cgroup: per-device limits, live changes and io.stat
+ *
+ * Thread-safe. Without a delegated io controller open() fails and wipes run
+ * without kernel-side isolation.
+ */
+class IoCgroup {
+public:
+    static constexpr auto DEFAULT_ROOT = "/sys/fs/cgroup";
+    static constexpr auto DEFAULT_SELF = "/proc/self/cgroup";
+    static constexpr auto WORKER_GROUP = "wipe-io";
+
+    explicit IoCgroup(std::filesystem::path root = DEFAULT_ROOT,
+                      std::filesystem::path self = DEFAULT_SELF);
+
+    /**
+     * @brief Create the worker cgroup, move the helper into it and enable io
+     *
+     * cgroup v2 allows controllers only on groups without processes of their
+     * own, so the helper leaves its service cgroup for a child before the
+     * service cgroup can pass io down.
+     */
+    [[nodiscard]] auto open() -> std::expected<void, util::Error>;
+
+    /**
+     * @brief The worker cgroup directory (empty before open())
+     */
+    [[nodiscard]] auto path() const -> const std::filesystem::path& { return path_; }
+
+    /**
+     * @brief Apply limits to a device now, including to a wipe already running
+     */
+    [[nodiscard]] auto set_limits(DeviceNumber device, const IoLimits& limits)
+        -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Limits last set for a device
+     */
+    [[nodiscard]] auto limits(DeviceNumber device) const -> IoLimits;
+
+    /**
+     * @brief The cgroup's I/O on a device so far
+     */
+    [[nodiscard]] auto stat(DeviceNumber device) const -> std::optional<IoStat>;
+
+private:
+    std::filesystem::path root_;
+    std::filesystem::path self_;
+    std::filesystem::path service_;
+    std::filesystem::path path_;
+
+    mutable std::mutex mutex_;
+    std::map<DeviceNumber, IoLimits> limits_;
+};
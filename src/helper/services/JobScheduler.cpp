@@ -0,0 +1,368 @@
+/**
+ * @file JobScheduler.cpp
+ * @brief Priority- and deadline-aware ordering of queued wipe jobs
+ */
+
+#include "helper/services/JobScheduler.hpp"
+
+#include "algorithms/AlgorithmFactory.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <format>
+#include <functional>
+#include <queue>
+#include <set>
+#include <utility>
+
+namespace {
+
+using std::chrono::milliseconds;
+
+auto describe_duration(milliseconds duration) -> std::string {
+    const auto total_minutes = std::chrono::duration_cast<std::chrono::minutes>(duration).count();
+    if (total_minutes < 1) {
+        return std::format("{}s",
+                           std::chrono::duration_cast<std::chrono::seconds>(duration).count());
+    }
+    if (total_minutes < 60) {
+        return std::format("{}m", total_minutes);
+    }
+    return std::format("{}h {:02d}m", total_minutes / 60, total_minutes % 60);
+}
+
+auto describe_bytes(double bytes) -> std::string {
+    constexpr std::array units = {"B", "KB", "MB", "GB", "TB", "PB"};
+    std::size_t unit = 0;
+    while (bytes >= 1'024.0 && unit + 1 < units.size()) {
+        bytes /= 1'024.0;
+        ++unit;
+    }
+    return std::format("{:.1f} {}", bytes, units[unit]);
+}
+
+// Discard and ATA erase run inside the device and use no host bandwidth
+auto host_bandwidth(const ThroughputEstimator& estimator, const JobSpec& spec) -> double {
+    if (spec.algorithm == WipeAlgorithm::THIN_DISCARD ||
+        spec.algorithm == WipeAlgorithm::ATA_SECURE_ERASE) {
+        return 0.0;
+    }
+    return estimator.rate(spec);
+}
+
+auto history_key(const JobSpec& spec) -> const std::string& {
+    return spec.device_key.empty() ? spec.device_path : spec.device_key;
+}
+
+}  // namespace
+
+auto parse_job_priority(std::string_view name) -> std::optional<JobPriority> {
+    std::string lower{name};
+    std::ranges::transform(lower, lower.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "low") {
+        return JobPriority::LOW;
+    }
+    if (lower == "normal") {
+        return JobPriority::NORMAL;
+    }
+    if (lower == "high") {
+        return JobPriority::HIGH;
+    }
+    if (lower == "urgent") {
+        return JobPriority::URGENT;
+    }
+    return std::nullopt;
+}
+
+// ============================================================================
+// ThroughputEstimator
+// ============================================================================
+
+void ThroughputEstimator::record(const std::string& device_key, uint64_t bytes,
+                                 milliseconds elapsed) {
+    if (bytes == 0 || elapsed.count() <= 0) {
+        return;
+    }
+    const double observed =
+        static_cast<double>(bytes) / (static_cast<double>(elapsed.count()) / 1'000.0);
+    auto [it, inserted] = rates_.try_emplace(device_key, observed);
+    if (!inserted) {
+        it->second = SMOOTHING * observed + (1.0 - SMOOTHING) * it->second;
+    }
+}
+
+auto ThroughputEstimator::rate(const JobSpec& spec) const -> double {
+    if (auto it = rates_.find(history_key(spec)); it != rates_.end()) {
+        return it->second;
+    }
+    return spec.is_ssd ? DEFAULT_SSD_RATE : DEFAULT_HDD_RATE;
+}
+
+auto ThroughputEstimator::bytes_to_process(const JobSpec& spec) -> uint64_t {
+    auto algorithm = make_wipe_algorithm(spec.algorithm);
+    const int passes = algorithm ? std::max(1, algorithm->get_pass_count()) : 1;
+    return spec.size_bytes * static_cast<uint64_t>(passes) + (spec.verify ? spec.size_bytes : 0);
+}
+
+auto ThroughputEstimator::estimate(const JobSpec& spec) const -> milliseconds {
+    const double device_rate = rate(spec);
+    const auto size = static_cast<double>(spec.size_bytes);
+
+    double seconds = 0.0;
+    if (spec.algorithm == WipeAlgorithm::THIN_DISCARD) {
+        seconds = size / OFFLOAD_RATE + (spec.verify ? size / device_rate : 0.0);
+    } else {
+        seconds = static_cast<double>(bytes_to_process(spec)) / device_rate;
+    }
+    return milliseconds{static_cast<int64_t>(seconds * 1'000.0)};
+}
+
+// ============================================================================
+// JobScheduler
+// ============================================================================
+
+JobScheduler::JobScheduler(SchedulerLimits limits) : limits_(limits) {}
+
+auto JobScheduler::submit(JobSpec spec, TimePoint now)
+    -> std::expected<JobAdmission, util::Error> {
+    if (spec.size_bytes == 0) {
+        return std::unexpected(util::Error{"Device size is unknown"});
+    }
+    auto algorithm = make_wipe_algorithm(spec.algorithm);
+    if (!algorithm) {
+        return std::unexpected(util::Error{"Unknown algorithm"});
+    }
+
+    JobAdmission admission;
+    admission.estimated_duration = estimator_.estimate(spec);
+
+    if (spec.deadline && now + admission.estimated_duration > *spec.deadline) {
+        const auto available = std::max(milliseconds{0}, std::chrono::duration_cast<milliseconds>(
+                                                             *spec.deadline - now));
+        auto reason = std::format(
+            "Deadline cannot be met: {} on {} needs about {} at {}/s, but only {} remain",
+            algorithm->get_name(), describe_bytes(static_cast<double>(spec.size_bytes)),
+            describe_duration(admission.estimated_duration),
+            describe_bytes(estimator_.rate(spec)), describe_duration(available));
+        if (limits_.reject_infeasible) {
+            return std::unexpected(util::Error{std::move(reason)});
+        }
+        admission.deadline_at_risk = true;
+        admission.warning = std::move(reason);
+    }
+
+    admission.id = next_id_++;
+    jobs_.emplace(admission.id,
+                  Entry{.spec = std::move(spec),
+                        .estimate = admission.estimated_duration,
+                        .running = false,
+                        .started = {},
+                        .expected_finish = std::nullopt});
+
+    for (const auto& planned : plan(now)) {
+        if (planned.id != admission.id) {
+            continue;
+        }
+        admission.estimated_finish = planned.finish;
+        if (!planned.on_time && !admission.deadline_at_risk) {
+            const auto& deadline = *jobs_.at(admission.id).spec.deadline;
+            admission.deadline_at_risk = true;
+            admission.warning = std::format(
+                "Deadline at risk: queued behind other jobs, expected to finish {} late",
+                describe_duration(
+                    std::chrono::duration_cast<milliseconds>(planned.finish - deadline)));
+        }
+    }
+    return admission;
+}
+
+auto JobScheduler::simulate(const std::vector<uint64_t>& order, TimePoint now) const
+    -> std::vector<PlannedJob> {
+    const bool unlimited = limits_.max_active == 0;
+
+    // Times at which each bay becomes free, earliest first
+    std::priority_queue<TimePoint, std::vector<TimePoint>, std::greater<>> free_at;
+    std::size_t busy = 0;
+    for (const auto& [id, entry] : jobs_) {
+        if (entry.running) {
+            const auto finish = entry.expected_finish.value_or(entry.started + entry.estimate);
+            free_at.push(std::max(now, finish));
+            ++busy;
+        }
+    }
+    for (std::size_t bay = busy; !unlimited && bay < limits_.max_active; ++bay) {
+        free_at.push(now);
+    }
+
+    std::vector<PlannedJob> planned;
+    planned.reserve(order.size());
+    for (auto id : order) {
+        const auto& entry = jobs_.at(id);
+        TimePoint start = now;
+        if (!unlimited) {
+            start = free_at.top();
+            free_at.pop();
+        }
+        const auto finish = start + entry.estimate;
+        if (!unlimited) {
+            free_at.push(finish);
+        }
+        planned.push_back(PlannedJob{.id = id,
+                                     .start = start,
+                                     .finish = finish,
+                                     .on_time = !entry.spec.deadline ||
+                                                finish <= *entry.spec.deadline});
+    }
+    return planned;
+}
+
+auto JobScheduler::plan(TimePoint now) const -> std::vector<PlannedJob> {
+    std::vector<uint64_t> with_deadline;
+    std::vector<uint64_t> others;
+    for (const auto& [id, entry] : jobs_) {
+        if (!entry.running) {
+            (entry.spec.deadline ? with_deadline : others).push_back(id);
+        }
+    }
+
+    auto priority_of = [this](uint64_t id) { return jobs_.at(id).spec.priority; };
+
+    std::ranges::stable_sort(with_deadline, [&](uint64_t a, uint64_t b) {
+        const auto& lhs = jobs_.at(a).spec;
+        const auto& rhs = jobs_.at(b).spec;
+        if (*lhs.deadline != *rhs.deadline) {
+            return *lhs.deadline < *rhs.deadline;
+        }
+        return lhs.priority > rhs.priority;
+    });
+
+    // Moore-Hodgson: build the EDF sequence, and whenever it makes a job late
+    // give up on the least important (then longest) job in it
+    std::vector<uint64_t> order;
+    for (auto id : with_deadline) {
+        order.push_back(id);
+        while (!std::ranges::all_of(simulate(order, now), &PlannedJob::on_time)) {
+            auto victim = std::ranges::min_element(order, [&](uint64_t a, uint64_t b) {
+                if (priority_of(a) != priority_of(b)) {
+                    return priority_of(a) < priority_of(b);
+                }
+                return jobs_.at(a).estimate > jobs_.at(b).estimate;
+            });
+            others.push_back(*victim);
+            order.erase(victim);
+        }
+    }
+    const std::set<uint64_t> must_meet(order.begin(), order.end());
+
+    // Everything else by priority, then submission order
+    std::ranges::sort(others, [&](uint64_t a, uint64_t b) {
+        if (priority_of(a) != priority_of(b)) {
+            return priority_of(a) > priority_of(b);
+        }
+        return a < b;
+    });
+
+    auto keeps_deadlines = [&](const std::vector<PlannedJob>& planned) {
+        return std::ranges::all_of(planned, [&](const PlannedJob& job) {
+            return job.on_time || !must_meet.contains(job.id);
+        });
+    };
+
+    // Slot each one in as early as the deadline jobs allow, never ahead of a
+    // more important job placed before it
+    std::size_t floor = 0;
+    for (auto id : others) {
+        std::size_t position = floor;
+        for (; position < order.size(); ++position) {
+            auto candidate = order;
+            candidate.insert(candidate.begin() + static_cast<std::ptrdiff_t>(position), id);
+            if (keeps_deadlines(simulate(candidate, now))) {
+                break;
+            }
+        }
+        order.insert(order.begin() + static_cast<std::ptrdiff_t>(position), id);
+        floor = position + 1;
+    }
+
+    return simulate(order, now);
+}
+
+auto JobScheduler::start_ready(TimePoint now) -> std::vector<uint64_t> {
+    std::size_t running = 0;
+    double bandwidth = 0.0;
+    for (const auto& [id, entry] : jobs_) {
+        if (entry.running) {
+            ++running;
+            bandwidth += host_bandwidth(estimator_, entry.spec);
+        }
+    }
+
+    std::vector<uint64_t> started;
+    for (const auto& planned : plan(now)) {
+        if (limits_.max_active != 0 && running >= limits_.max_active) {
+            break;
+        }
+        auto& entry = jobs_.at(planned.id);
+        const double needed = host_bandwidth(estimator_, entry.spec);
+        // Strict plan order: a job that does not fit holds back the ones after it
+        if (limits_.bandwidth_limit != 0 && running > 0 &&
+            bandwidth + needed > static_cast<double>(limits_.bandwidth_limit)) {
+            break;
+        }
+        entry.running = true;
+        entry.started = now;
+        ++running;
+        bandwidth += needed;
+        started.push_back(planned.id);
+    }
+    return started;
+}
+
+void JobScheduler::update_progress(uint64_t id, double fraction, TimePoint now) {
+    auto it = jobs_.find(id);
+    // Too early to extrapolate from below 1%
+    if (it == jobs_.end() || !it->second.running || fraction < 0.01) {
+        return;
+    }
+    auto& entry = it->second;
+    const auto elapsed = std::chrono::duration_cast<milliseconds>(now - entry.started);
+    const auto total = milliseconds{
+        static_cast<int64_t>(static_cast<double>(elapsed.count()) / std::min(fraction, 1.0))};
+    entry.expected_finish = entry.started + total;
+}
+
+void JobScheduler::complete(uint64_t id, bool success, TimePoint now) {
+    auto it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return;
+    }
+    const auto& entry = it->second;
+    // Offloaded erases say nothing about the device's sequential write rate
+    if (success && entry.running && host_bandwidth(estimator_, entry.spec) > 0.0) {
+        estimator_.record(history_key(entry.spec),
+                          ThroughputEstimator::bytes_to_process(entry.spec),
+                          std::chrono::duration_cast<milliseconds>(now - entry.started));
+    }
+    jobs_.erase(it);
+}
+
+auto JobScheduler::cancel(uint64_t id) -> bool {
+    return jobs_.erase(id) > 0;
+}
+
+auto JobScheduler::spec(uint64_t id) const -> const JobSpec* {
+    auto it = jobs_.find(id);
+    return it != jobs_.end() ? &it->second.spec : nullptr;
+}
+
+auto JobScheduler::queued_count() const -> std::size_t {
+    return static_cast<std::size_t>(
+        std::ranges::count_if(jobs_, [](const auto& item) { return !item.second.running; }));
+}
+
+auto JobScheduler::running_count() const -> std::size_t {
+    return jobs_.size() - queued_count();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file JobScheduler.hpp
+ * @brief Priority- and deadline-aware ordering of queued wipe jobs
+ *
+ * When more disks are queued than there are bays (or bandwidth) to wipe them
+ * at once, FIFO order lets a long low-priority job push everything with a
+ * maintenance window past its deadline. JobScheduler estimates every job's
+ * duration from per-device throughput history and orders the queue so that as
+ * many deadlines as possible are met:
+ *
+ * 1. Jobs with deadlines are ordered earliest-deadline-first. Whenever the
+ *    simulated schedule makes one late, the lowest-priority (then longest) of
+ *    them is moved out of the deadline set (Moore-Hodgson), since it would
+ *    only make the others late too.
+ * 2. The remaining jobs, in priority then submission order, are slotted in at
+ *    the earliest position that keeps every deadline job on time.
+ *
+ * Throughput is learned per device (serial, falling back to model) from
+ * completed jobs; unknown devices start from a media-class default.
+ *
+ * Not thread-safe; the owner serializes calls (StationService uses its
+ * scheduler thread).
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Result.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @enum JobPriority
+ * @brief Operator-assigned importance of a job
+ */
+enum class JobPriority {
+    LOW,     ///< Fill idle bays
+    NORMAL,  ///< Default
+    HIGH,    ///< Ahead of normal work
+    URGENT   ///< Ahead of everything without a deadline
+};
+
+/**
+ * @brief Parse "low", "normal", "high" or "urgent"
+ */
+[[nodiscard]] auto parse_job_priority(std::string_view name) -> std::optional<JobPriority>;
+
+/**
+ * @brief What to wipe, and by when
+ */
+struct JobSpec {
+    std::string device_path;
+    std::string device_key;  ///< Throughput history key (serial or model); path if empty
+    uint64_t size_bytes = 0;
+    WipeAlgorithm algorithm = WipeAlgorithm::ZERO_FILL;
+    bool verify = false;
+    bool is_ssd = false;
+    JobPriority priority = JobPriority::NORMAL;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+};
+
+/**
+ * @class ThroughputEstimator
+ * @brief Per-device wipe throughput learned from finished jobs
+ */
+class ThroughputEstimator {
+public:
+    // Starting points for devices without history, bytes per second
+    static constexpr double DEFAULT_HDD_RATE = 150.0 * 1'000'000;
+    static constexpr double DEFAULT_SSD_RATE = 400.0 * 1'000'000;
+    // Discard and write-zeroes are offloaded to the device
+    static constexpr double OFFLOAD_RATE = 20.0 * 1'000'000'000;
+
+    /**
+     * @brief Fold an observed run into the device's estimate
+     * @param device_key Device identity
+     * @param bytes Bytes processed (all passes plus verification)
+     * @param elapsed Wall time taken
+     */
+    void record(const std::string& device_key, uint64_t bytes, std::chrono::milliseconds elapsed);
+
+    /**
+     * @brief Expected sequential write rate for a job's device, bytes per second
+     */
+    [[nodiscard]] auto rate(const JobSpec& spec) const -> double;
+
+    /**
+     * @brief Expected wall time of a job run alone
+     */
+    [[nodiscard]] auto estimate(const JobSpec& spec) const -> std::chrono::milliseconds;
+
+    /**
+     * @brief Bytes a job moves: size times passes, plus one read pass to verify
+     */
+    [[nodiscard]] static auto bytes_to_process(const JobSpec& spec) -> uint64_t;
+
+private:
+    static constexpr double SMOOTHING = 0.3;  // Weight of the newest observation
+
+    std::unordered_map<std::string, double> rates_;
+};
+
+/**
+ * @brief Capacity the scheduler may use at once
+ */
+struct SchedulerLimits {
+    std::size_t max_active = 0;      ///< Concurrent jobs (bays); 0 = unlimited
+    uint64_t bandwidth_limit = 0;    ///< Cap on running jobs' summed rates, bytes/s; 0 = none
+    bool reject_infeasible = false;  ///< Refuse jobs whose deadline cannot be met even alone
+};
+
+/**
+ * @brief Result of a successful submit()
+ */
+struct JobAdmission {
+    uint64_t id = 0;
+    std::chrono::milliseconds estimated_duration{0};
+    std::chrono::steady_clock::time_point estimated_finish;
+    bool deadline_at_risk = false;  ///< Deadline will be missed under the current plan
+    std::string warning;            ///< Human-readable reason when at risk
+};
+
+/**
+ * @brief One queued job's place in the current plan
+ */
+struct PlannedJob {
+    uint64_t id = 0;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point finish;
+    bool on_time = true;  ///< Always true for jobs without a deadline
+};
+
+/**
+ * @class JobScheduler
+ * @brief Orders and throttles queued jobs against deadlines and capacity
+ */
+class JobScheduler {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    explicit JobScheduler(SchedulerLimits limits = {});
+
+    /**
+     * @brief Queue a job
+     * @return Admission with estimates and any deadline warning, or an error
+     *         when the job is invalid or (with reject_infeasible) cannot meet
+     *         its deadline even if started immediately
+     */
+    [[nodiscard]] auto submit(JobSpec spec, TimePoint now)
+        -> std::expected<JobAdmission, util::Error>;
+
+    /**
+     * @brief Pick the queued jobs to start now and mark them running
+     *
+     * Jobs start in plan order while a bay is free and, with a bandwidth
+     * limit, while the running jobs leave room for the next one's rate.
+     */
+    [[nodiscard]] auto start_ready(TimePoint now) -> std::vector<uint64_t>;
+
+    /**
+     * @brief Refine a running job's remaining time from its progress
+     * @param fraction Completed share of the whole job, 0..1
+     */
+    void update_progress(uint64_t id, double fraction, TimePoint now);
+
+    /**
+     * @brief Remove a finished job; successful runs feed the throughput history
+     */
+    void complete(uint64_t id, bool success, TimePoint now);
+
+    /**
+     * @brief Drop a queued or running job without recording throughput
+     * @return true if the job was known
+     */
+    auto cancel(uint64_t id) -> bool;
+
+    /**
+     * @brief Projected start and finish of every queued job, in start order
+     */
+    [[nodiscard]] auto plan(TimePoint now) const -> std::vector<PlannedJob>;
+
+    [[nodiscard]] auto spec(uint64_t id) const -> const JobSpec*;
+    [[nodiscard]] auto queued_count() const -> std::size_t;
+    [[nodiscard]] auto running_count() const -> std::size_t;
+
+    [[nodiscard]] auto estimator() -> ThroughputEstimator& { return estimator_; }
+
+private:
+    struct Entry {
+        JobSpec spec;
+        std::chrono::milliseconds estimate{0};
+        bool running = false;
+        TimePoint started;
+        std::optional<TimePoint> expected_finish;  // Refined by update_progress()
+    };
+
+    // Start/finish of queued jobs run in the given order after the running ones
+    [[nodiscard]] auto simulate(const std::vector<uint64_t>& order, TimePoint now) const
+        -> std::vector<PlannedJob>;
+
+    SchedulerLimits limits_;
+    ThroughputEstimator estimator_;
+    std::map<uint64_t, Entry> jobs_;  // Ordered by id, i.e. submission order
+    uint64_t next_id_ = 1;
+};
@@ -0,0 +1,176 @@
+/**
+ * @file PressureMonitor.cpp
+ * @brief PSI parsing, triggers and the pressure backoff controller
+ */
+
+#include "helper/services/PressureMonitor.hpp"
+
+#include "util/Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::array RESOURCES{"io", "memory"};
+
+auto read_file(const fs::path& path) -> std::optional<std::string> {
+    std::ifstream file{path};
+    if (!file) {
+        return std::nullopt;
+    }
+    return std::string{std::istreambuf_iterator<char>{file}, {}};
+}
+
+// avg10 of one "some ..." or "full ..." line
+auto parse_avg10(std::string_view line) -> std::optional<double> {
+    constexpr std::string_view key = "avg10=";
+    const auto start = line.find(key);
+    if (start == std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto* first = line.data() + start + key.size();
+    double value = 0.0;
+    auto [ptr, ec] = std::from_chars(first, line.data() + line.size(), value);
+    if (ec != std::errc{}) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Whether cgroup is a proper descendant of root, so that it has siblings to compare against
+auto below_root(const fs::path& cgroup, const fs::path& root) -> bool {
+    const auto relative = cgroup.lexically_relative(root);
+    return !cgroup.empty() && !relative.empty() && *relative.begin() != "." &&
+           *relative.begin() != "..";
+}
+
+}  // namespace
+
+auto parse_pressure(std::string_view text) -> std::optional<PressureStall> {
+    std::optional<PressureStall> result;
+    for (auto range : text | std::views::split('\n')) {
+        const std::string_view line{range.begin(), range.end()};
+        const bool some = line.starts_with("some ");
+        if (!some && !line.starts_with("full ")) {
+            continue;
+        }
+        const auto avg10 = parse_avg10(line);
+        if (!avg10) {
+            return std::nullopt;
+        }
+        if (!result) {
+            result.emplace();
+        }
+        (some ? result->some : result->full) = *avg10;
+    }
+    return result;
+}
+
+auto PressureBackoff::update(double stall_percent, Clock::time_point now) -> bool {
+    const auto since_change = last_change_ ? now - *last_change_ : Clock::duration::max();
+    double next = multiplier_;
+    if (stall_percent >= HIGH_STALL_PERCENT && since_change >= DECREASE_HOLD) {
+        next = std::max(multiplier_ * DECREASE_FACTOR, MIN_MULTIPLIER);
+    } else if (stall_percent <= LOW_STALL_PERCENT && since_change >= INCREASE_HOLD) {
+        next = std::min(multiplier_ + INCREASE_STEP, 1.0);
+    }
+    if (next == multiplier_) {
+        return false;
+    }
+    multiplier_ = next;
+    last_change_ = now;
+    return true;
+}
+
+PressureMonitor::PressureMonitor(fs::path own_cgroup, fs::path cgroup_root, fs::path proc_dir)
+    : own_cgroup_(std::move(own_cgroup)),
+      cgroup_root_(std::move(cgroup_root)),
+      proc_dir_(std::move(proc_dir)) {}
+
+auto PressureMonitor::open() -> std::expected<void, util::Error> {
+    if (!below_root(own_cgroup_, cgroup_root_)) {
+        return std::unexpected(util::Error{std::format(
+            "{} is not a cgroup below {}; other workloads' stalls cannot be told apart",
+            own_cgroup_.string(), cgroup_root_.string())});
+    }
+
+    std::vector<util::FileDescriptor> triggers;
+    for (const auto* resource : RESOURCES) {
+        const auto path = proc_dir_ / resource;
+        util::FileDescriptor fd(::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC));
+        // One write with the terminating NUL; the trigger stays armed until the fd is closed
+        const std::string_view trigger{TRIGGER};
+        if (!fd || ::write(fd.get(), trigger.data(), trigger.size() + 1) < 0) {
+            return std::unexpected(util::Error{
+                std::format("Cannot set a PSI trigger on {}: {}", path.string(), strerror(errno)),
+                errno});
+        }
+        triggers.push_back(std::move(fd));
+    }
+    triggers_ = std::move(triggers);
+    return {};
+}
+
+auto PressureMonitor::fds() const -> std::vector<int> {
+    std::vector<int> result;
+    for (const auto& trigger : triggers_) {
+        result.push_back(trigger.get());
+    }
+    return result;
+}
+
+auto PressureMonitor::others_stall(std::string_view resource) const -> double {
+    if (!below_root(own_cgroup_, cgroup_root_)) {
+        return 0.0;
+    }
+    const auto file = std::format("{}.pressure", resource);
+    const auto levels = own_cgroup_.lexically_relative(cgroup_root_);
+    double worst = 0.0;
+    // Siblings at every level from the helper's cgroup up to the root; tasks in
+    // the root cgroup itself (mostly kernel threads) have no pressure file
+    auto own = own_cgroup_;
+    for (auto level = levels.begin(); level != levels.end(); ++level, own = own.parent_path()) {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator{own.parent_path(), ec}) {
+            if (entry.path() == own || !entry.is_directory(ec)) {
+                continue;
+            }
+            const auto text = read_file(entry.path() / file);
+            if (const auto stall = text ? parse_pressure(*text) : std::nullopt) {
+                worst = std::max(worst, stall->some);
+            }
+        }
+    }
+    return worst;
+}
+
+auto PressureMonitor::sample(PressureBackoff::Clock::time_point now) -> double {
+    stall_percent_ = 0.0;
+    for (const auto* resource : RESOURCES) {
+        stall_percent_ = std::max(stall_percent_, others_stall(resource));
+    }
+
+    const auto previous = backoff_.multiplier();
+    if (backoff_.update(stall_percent_, now)) {
+        LOG_INFO("PressureMonitor",
+                 std::format("Another workload stalled {:.1f}% of the time: "
+                             "write rate {:.0f}% -> {:.0f}%",
+                             stall_percent_, previous * 100.0, backoff_.multiplier() * 100.0));
+    }
+    return backoff_.multiplier();
+}
@@ -0,0 +1,138 @@
+/**
+ * @file PressureMonitor.hpp
+ * @brief Backs wipes off while the host is under I/O or memory pressure
+ *
+ * Pressure stall information (PSI) tells what share of the last 10 seconds
+ * tasks spent waiting on I/O or memory. A wipe stalls on its own writes all
+ * the time, and PSI "some" shares overlap rather than add up, so the host
+ * figure minus the helper's own says nothing about anyone else. Instead the
+ * monitor reads the cgroups beside the helper's: the other services of its
+ * slice, the other slices (user.slice, machine.slice, ...) and so on up to
+ * the root. The most stalled of them is fed to PressureBackoff, which halves
+ * the write rate multiplier (util::WritePacer) while others stall and adds
+ * back a step at a time once they stop. Without the helper's own cgroup
+ * there is nothing to tell the two apart and the monitor does not run.
+ *
+ * PSI triggers on /proc/pressure wake the helper as soon as stalls on the
+ * host exceed the threshold; the wake-up only causes a sample, so the
+ * helper's own stalls firing it are harmless. The helper also samples on a
+ * timer so the rate recovers when no trigger fires.
+ */
+
+#pragma once
+
+#include "util/FileDescriptor.hpp"
+#include "util/Result.hpp"
+#include "util/WritePacer.hpp"
+
+#include <chrono>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief avg10 of a PSI file: % of time some / all non-idle tasks stalled
+ */
+struct PressureStall {
+    double some = 0.0;
+    double full = 0.0;
+
+    auto operator==(const PressureStall&) const -> bool = default;
+};
+
+/**
+ * @brief Parse a PSI file ("some avg10=1.23 avg60=... total=...\nfull avg10=...")
+ */
+[[nodiscard]] auto parse_pressure(std::string_view text) -> std::optional<PressureStall>;
+
+/**
+ * @class PressureBackoff
+ * @brief AIMD controller from others' stall share to a write rate multiplier
+ */
+class PressureBackoff {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double HIGH_STALL_PERCENT = 10.0;  // Back off above this
+    static constexpr double LOW_STALL_PERCENT = 2.0;    // Recover below this
+    static constexpr double DECREASE_FACTOR = 0.5;
+    static constexpr double INCREASE_STEP = 0.1;
+    static constexpr double MIN_MULTIPLIER = util::WritePacer::MIN_MULTIPLIER;
+    // avg10 trails a change for seconds; waiting between steps keeps one
+    // episode from driving the rate straight to the floor
+    static constexpr auto DECREASE_HOLD = std::chrono::seconds{2};
+    static constexpr auto INCREASE_HOLD = std::chrono::seconds{5};
+
+    /**
+     * @brief Feed the current stall share of other workloads
+     * @return true if the multiplier changed
+     */
+    auto update(double stall_percent, Clock::time_point now) -> bool;
+
+    [[nodiscard]] auto multiplier() const -> double { return multiplier_; }
+
+private:
+    double multiplier_ = 1.0;
+    std::optional<Clock::time_point> last_change_;
+};
+
+/**
+ * @class PressureMonitor
+ * @brief Reads the PSI of the cgroups beside the helper's and keeps a PressureBackoff up to date
+ *
+ * Not thread-safe; the helper drives it from its main loop.
+ */
+class PressureMonitor {
+public:
+    static constexpr auto DEFAULT_PROC_DIR = "/proc/pressure";
+    static constexpr auto DEFAULT_CGROUP_ROOT = "/sys/fs/cgroup";
+    // Wake up when tasks stall for 100 ms within a 1 s window (HIGH_STALL_PERCENT)
+    static constexpr auto TRIGGER = "some 100000 1000000";
+
+    /**
+     * @param own_cgroup The helper's cgroup directory under cgroup_root; it and
+     *                   everything below it are not counted
+     * @param cgroup_root Mount point of the cgroup v2 hierarchy
+     * @param proc_dir Host PSI files (io, memory) for the triggers
+     */
+    explicit PressureMonitor(std::filesystem::path own_cgroup,
+                             std::filesystem::path cgroup_root = DEFAULT_CGROUP_ROOT,
+                             std::filesystem::path proc_dir = DEFAULT_PROC_DIR);
+
+    /**
+     * @brief Install the PSI triggers
+     *
+     * Fails when own_cgroup does not lie below cgroup_root.
+     */
+    [[nodiscard]] auto open() -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Trigger descriptors to watch for POLLPRI
+     */
+    [[nodiscard]] auto fds() const -> std::vector<int>;
+
+    /**
+     * @brief Read pressure now and update the multiplier
+     * @return The multiplier
+     */
+    auto sample(PressureBackoff::Clock::time_point now = PressureBackoff::Clock::now()) -> double;
+
+    /**
+     * @brief Stall share of the most stalled other cgroup at the last sample, in %
+     */
+    [[nodiscard]] auto stall_percent() const -> double { return stall_percent_; }
+
+    [[nodiscard]] auto multiplier() const -> double { return backoff_.multiplier(); }
+
+private:
+    [[nodiscard]] auto others_stall(std::string_view resource) const -> double;
+
+    std::filesystem::path own_cgroup_;
+    std::filesystem::path cgroup_root_;
+    std::filesystem::path proc_dir_;
+    std::vector<util::FileDescriptor> triggers_;
+    PressureBackoff backoff_;
+    double stall_percent_ = 0.0;
+};
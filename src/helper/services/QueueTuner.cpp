@@ -0,0 +1,370 @@
+/**
+ * @file QueueTuner.cpp
+ * @brief Block queue snapshot, retune and restore
+ */
+
+#include "helper/services/QueueTuner.hpp"
+
+#include "util/FileDescriptor.hpp"
+#include "util/Logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <ranges>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// State file: a header line, then one "queue dir, attribute, original value" per line
+constexpr std::string_view STATE_HEADER = "storage-wiper-queue-tuning 1";
+
+auto trim_whitespace(std::string_view text) -> std::string {
+    const auto first = text.find_first_not_of(" \n\r\t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return std::string{text.substr(first, text.find_last_not_of(" \n\r\t") - first + 1)};
+}
+
+auto read_attribute(const fs::path& path) -> std::optional<std::string> {
+    std::ifstream file{path};
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return std::nullopt;
+    }
+    return trim_whitespace(line);
+}
+
+// Root may write any file, so look at the mode bits: read-only attributes are 0444
+auto is_writable(const fs::path& path) -> bool {
+    std::error_code ec;
+    const auto status = fs::status(path, ec);
+    return !ec && fs::is_regular_file(status) &&
+           (status.permissions() & fs::perms::owner_write) != fs::perms::none;
+}
+
+auto write_attribute(const fs::path& path, std::string_view value) -> std::expected<void, int> {
+    util::FileDescriptor fd(::open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC));
+    if (!fd) {
+        return std::unexpected(errno);
+    }
+    // sysfs takes the whole value in one write and rejects invalid ones there
+    if (::write(fd.get(), value.data(), value.size()) != static_cast<ssize_t>(value.size())) {
+        return std::unexpected(errno);
+    }
+    return {};
+}
+
+auto parse_number(std::string_view text) -> std::optional<std::uint64_t> {
+    std::uint64_t value = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/**
+ * @brief Active entry of a scheduler list such as "[mq-deadline] kyber none"
+ */
+auto active_scheduler(std::string_view list) -> std::string {
+    const auto open = list.find('[');
+    const auto close = list.find(']', open);
+    if (open == std::string_view::npos || close == std::string_view::npos) {
+        return trim_whitespace(list);
+    }
+    return std::string{list.substr(open + 1, close - open - 1)};
+}
+
+auto offers_scheduler(std::string_view list, std::string_view name) -> bool {
+    return std::ranges::any_of(list | std::views::split(' '), [name](auto token) {
+        std::string_view entry{token.begin(), token.end()};
+        if (entry.starts_with('[') && entry.ends_with(']')) {
+            entry = entry.substr(1, entry.size() - 2);
+        }
+        return entry == name;
+    });
+}
+
+// The value to write back later; for the scheduler, the active entry only
+auto current_value(const fs::path& queue_dir, const std::string& attribute)
+    -> std::optional<std::string> {
+    auto value = read_attribute(queue_dir / attribute);
+    if (value && attribute == "scheduler") {
+        return active_scheduler(*value);
+    }
+    return value;
+}
+
+}  // namespace
+
+auto queue_dir_for_device(const std::string& device_path) -> std::optional<fs::path> {
+    struct stat st{};
+    if (stat(device_path.c_str(), &st) != 0 || !S_ISBLK(st.st_mode)) {
+        return std::nullopt;
+    }
+    std::error_code ec;
+    auto sys_dir = fs::canonical(
+        std::format("/sys/dev/block/{}:{}", major(st.st_rdev), minor(st.st_rdev)), ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    // Partitions share their disk's queue
+    if (fs::exists(sys_dir / "partition", ec)) {
+        sys_dir = sys_dir.parent_path();
+    }
+    auto queue_dir = sys_dir / "queue";
+    if (!fs::is_directory(queue_dir, ec)) {
+        return std::nullopt;
+    }
+    return queue_dir;
+}
+
+auto plan_queue_tuning(const fs::path& queue_dir) -> std::vector<QueueSetting> {
+    std::vector<QueueSetting> plan;
+    const auto disk = queue_dir.parent_path().filename().string();
+
+    // The scheduler goes first: switching it resets nr_requests
+    if (disk.starts_with("nvme") && is_writable(queue_dir / "scheduler")) {
+        if (const auto list = read_attribute(queue_dir / "scheduler");
+            list && active_scheduler(*list) != "none" && offers_scheduler(*list, "none")) {
+            plan.push_back({.attribute = "scheduler", .value = "none"});
+        }
+    }
+
+    if (is_writable(queue_dir / "max_sectors_kb")) {
+        const auto current = read_attribute(queue_dir / "max_sectors_kb").and_then(parse_number);
+        const auto hw = read_attribute(queue_dir / "max_hw_sectors_kb").and_then(parse_number);
+        if (current && hw && *hw > *current) {
+            plan.push_back({.attribute = "max_sectors_kb", .value = std::to_string(*hw)});
+        }
+    }
+
+    if (is_writable(queue_dir / "nr_requests")) {
+        const auto current = read_attribute(queue_dir / "nr_requests").and_then(parse_number);
+        if (current && *current < QueueTuner::TARGET_NR_REQUESTS) {
+            plan.push_back({.attribute = "nr_requests",
+                            .value = std::to_string(QueueTuner::TARGET_NR_REQUESTS)});
+        }
+    }
+
+    if (is_writable(queue_dir / "wbt_lat_usec")) {
+        if (const auto current = read_attribute(queue_dir / "wbt_lat_usec");
+            current && *current != "0") {
+            plan.push_back({.attribute = "wbt_lat_usec", .value = "0"});
+        }
+    }
+    return plan;
+}
+
+QueueTuner::Lease::Lease(QueueTuner* tuner, fs::path queue_dir, std::vector<QueueSetting> applied)
+    : tuner_(tuner), queue_dir_(std::move(queue_dir)), applied_(std::move(applied)) {}
+
+QueueTuner::Lease::Lease(Lease&& other) noexcept
+    : tuner_(std::exchange(other.tuner_, nullptr)), queue_dir_(std::move(other.queue_dir_)),
+      applied_(std::move(other.applied_)) {}
+
+QueueTuner::Lease& QueueTuner::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (tuner_) {
+            tuner_->restore(queue_dir_);
+        }
+        tuner_ = std::exchange(other.tuner_, nullptr);
+        queue_dir_ = std::move(other.queue_dir_);
+        applied_ = std::move(other.applied_);
+    }
+    return *this;
+}
+
+QueueTuner::Lease::~Lease() {
+    if (tuner_) {
+        tuner_->restore(queue_dir_);
+    }
+}
+
+QueueTuner::QueueTuner(fs::path state_path) : state_path_(std::move(state_path)) {}
+
+auto QueueTuner::tune(const std::string& device_path) -> std::expected<Lease, util::Error> {
+    const auto queue_dir = queue_dir_for_device(device_path);
+    if (!queue_dir) {
+        return std::unexpected(
+            util::Error{std::format("{} has no block queue to tune", device_path)});
+    }
+    return tune_queue(*queue_dir);
+}
+
+auto QueueTuner::tune_queue(const fs::path& queue_dir) -> std::expected<Lease, util::Error> {
+    std::lock_guard lock{mutex_};
+
+    // Another wipe on the same disk (e.g. a second partition) already tuned it
+    if (auto it = tuned_.find(queue_dir); it != tuned_.end()) {
+        ++it->second.holders;
+        return Lease{this, queue_dir, {}};
+    }
+
+    const auto plan = plan_queue_tuning(queue_dir);
+    if (plan.empty()) {
+        return Lease{nullptr, queue_dir, {}};
+    }
+
+    // Persist the originals before touching anything, so a crash can be undone
+    TunedQueue tuned{.originals = {}, .holders = 1};
+    for (const auto& setting : plan) {
+        tuned.originals.push_back(
+            {.attribute = setting.attribute,
+             .value = current_value(queue_dir, setting.attribute).value_or("")});
+    }
+    tuned_[queue_dir] = tuned;
+    if (auto saved = save_locked(); !saved) {
+        tuned_.erase(queue_dir);
+        return std::unexpected(saved.error());
+    }
+
+    std::vector<QueueSetting> applied;
+    std::vector<QueueSetting> originals;
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        if (auto written = write_attribute(queue_dir / plan[i].attribute, plan[i].value);
+            !written) {
+            LOG_WARNING("QueueTuner", std::format("Cannot set {} to {}: {}",
+                                                  (queue_dir / plan[i].attribute).string(),
+                                                  plan[i].value, strerror(written.error())));
+            continue;
+        }
+        applied.push_back(plan[i]);
+        originals.push_back(tuned.originals[i]);
+    }
+
+    if (applied.empty()) {
+        tuned_.erase(queue_dir);
+        static_cast<void>(save_locked());
+        return Lease{nullptr, queue_dir, {}};
+    }
+    tuned_[queue_dir].originals = std::move(originals);
+    if (auto saved = save_locked(); !saved) {
+        LOG_WARNING("QueueTuner", saved.error().message);
+    }
+
+    std::string summary;
+    for (const auto& setting : applied) {
+        summary += std::format(" {}={}", setting.attribute, setting.value);
+    }
+    LOG_INFO("QueueTuner", std::format("Tuned {}:{}", queue_dir.string(), summary));
+    return Lease{this, queue_dir, std::move(applied)};
+}
+
+void QueueTuner::restore(const fs::path& queue_dir) {
+    std::lock_guard lock{mutex_};
+    auto it = tuned_.find(queue_dir);
+    if (it == tuned_.end() || --it->second.holders > 0) {
+        return;
+    }
+    write_back(queue_dir, it->second.originals);
+    tuned_.erase(it);
+    if (auto saved = save_locked(); !saved) {
+        LOG_WARNING("QueueTuner", saved.error().message);
+    }
+}
+
+void QueueTuner::write_back(const fs::path& queue_dir, const std::vector<QueueSetting>& originals) {
+    // In the order they were changed: the scheduler first, as switching it resets the others
+    for (const auto& setting : originals) {
+        if (auto written = write_attribute(queue_dir / setting.attribute, setting.value);
+            !written) {
+            // The disk may be gone; there is nothing left to restore then
+            LOG_WARNING("QueueTuner", std::format("Cannot restore {} to {}: {}",
+                                                  (queue_dir / setting.attribute).string(),
+                                                  setting.value, strerror(written.error())));
+        }
+    }
+    LOG_INFO("QueueTuner", std::format("Restored {}", queue_dir.string()));
+}
+
+auto QueueTuner::restore_pending() -> std::size_t {
+    std::ifstream file{state_path_};
+    std::string line;
+    if (!file || !std::getline(file, line) || line != STATE_HEADER) {
+        return 0;
+    }
+
+    std::vector<std::pair<fs::path, std::vector<QueueSetting>>> pending;
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        for (auto field : line | std::views::split('\t')) {
+            fields.emplace_back(field.begin(), field.end());
+        }
+        if (fields.size() != 3) {
+            continue;
+        }
+        if (pending.empty() || pending.back().first != fields[0]) {
+            pending.emplace_back(fields[0], std::vector<QueueSetting>{});
+        }
+        pending.back().second.push_back({.attribute = fields[1], .value = fields[2]});
+    }
+    file.close();
+
+    std::lock_guard lock{mutex_};
+    for (const auto& [queue_dir, originals] : pending) {
+        LOG_WARNING("QueueTuner", std::format("Restoring {}, left tuned by an interrupted wipe",
+                                              queue_dir.string()));
+        write_back(queue_dir, originals);
+    }
+    if (auto saved = save_locked(); !saved) {
+        LOG_WARNING("QueueTuner", saved.error().message);
+    }
+    return pending.size();
+}
+
+auto QueueTuner::save_locked() const -> std::expected<void, util::Error> {
+    std::error_code ec;
+    if (tuned_.empty()) {
+        fs::remove(state_path_, ec);
+        return {};
+    }
+
+    std::ostringstream out;
+    out << STATE_HEADER << '\n';
+    for (const auto& [queue_dir, tuned] : tuned_) {
+        for (const auto& setting : tuned.originals) {
+            out << queue_dir.string() << '\t' << setting.attribute << '\t' << setting.value
+                << '\n';
+        }
+    }
+
+    fs::create_directories(state_path_.parent_path(), ec);
+    auto temp_path = state_path_;
+    temp_path += ".tmp";
+    {
+        std::ofstream file{temp_path, std::ios::trunc};
+        if (!file) {
+            return std::unexpected(
+                util::Error{std::format("Cannot write {}", temp_path.string()), errno});
+        }
+        file << out.str();
+        if (!file.flush()) {
+            return std::unexpected(
+                util::Error{std::format("Cannot write {}", temp_path.string()), errno});
+        }
+    }
+    fs::rename(temp_path, state_path_, ec);
+    if (ec) {
+        fs::remove(temp_path, ec);
+        return std::unexpected(
+            util::Error{std::format("Cannot replace {}", state_path_.string())});
+    }
+    return {};
+}
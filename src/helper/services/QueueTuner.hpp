@@ -0,0 +1,129 @@
+/**
+ * @file QueueTuner.hpp
+ * @brief Retune a device's block queue for the duration of a wipe
+ *
+ * The default queue settings suit mixed desktop I/O. A wipe is one long
+ * sequential write stream, which runs faster with:
+ *
+ * - `scheduler` = none on NVMe (the device reorders on its own);
+ * - `max_sectors_kb` raised to `max_hw_sectors_kb`, so fewer, larger requests;
+ * - a deeper `nr_requests`;
+ * - writeback throttling off (`wbt_lat_usec` = 0).
+ *
+ * The previous values are written to a state file before anything changes.
+ * They are restored when the Lease returned by tune() is destroyed: on
+ * completion, cancellation or error. If the helper dies mid-wipe,
+ * restore_pending() at the next start puts them back.
+ */
+
+#pragma once
+
+#include "util/Result.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One queue attribute and the value to write to it
+ */
+struct QueueSetting {
+    std::string attribute;  ///< File name under queue/, e.g. "nr_requests"
+    std::string value;
+};
+
+/**
+ * @brief The queue/ directory in sysfs of the disk holding a device node
+ * @return e.g. /sys/devices/.../block/sdb/queue; nullopt for anything but a block device.
+ *         A partition resolves to its whole disk's queue.
+ */
+[[nodiscard]] auto queue_dir_for_device(const std::string& device_path)
+    -> std::optional<std::filesystem::path>;
+
+/**
+ * @brief Settings to apply to a queue for a wipe, in the order they must be written
+ *
+ * Attributes that are missing, read-only or already tuned are left out.
+ * NVMe is recognised by the disk name (the directory above queue/).
+ */
+[[nodiscard]] auto plan_queue_tuning(const std::filesystem::path& queue_dir)
+    -> std::vector<QueueSetting>;
+
+/**
+ * @class QueueTuner
+ * @brief Applies plan_queue_tuning() and guarantees the original values come back
+ *
+ * Thread-safe; wipes of different disks hold their own leases. Wipes of two
+ * partitions of one disk share its queue: the second lease changes nothing,
+ * and the originals come back when the last lease is released.
+ */
+class QueueTuner {
+public:
+    static constexpr auto DEFAULT_STATE_PATH = "/var/lib/storage-wiper/queue-tuning.state";
+    static constexpr std::size_t TARGET_NR_REQUESTS = 1'024;
+
+    /**
+     * @class Lease
+     * @brief Restores a queue's original settings when destroyed
+     */
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        /// Settings this lease wrote; empty if the queue needed no change or was already tuned
+        [[nodiscard]] auto applied() const -> const std::vector<QueueSetting>& { return applied_; }
+
+    private:
+        friend class QueueTuner;
+        Lease(QueueTuner* tuner, std::filesystem::path queue_dir,
+              std::vector<QueueSetting> applied);
+
+        QueueTuner* tuner_;
+        std::filesystem::path queue_dir_;
+        std::vector<QueueSetting> applied_;
+    };
+
+    explicit QueueTuner(std::filesystem::path state_path = DEFAULT_STATE_PATH);
+
+    /**
+     * @brief Tune the queue of the disk holding `device_path`
+     * @return A lease, or an error if the device has no queue to tune
+     */
+    [[nodiscard]] auto tune(const std::string& device_path) -> std::expected<Lease, util::Error>;
+
+    /**
+     * @brief Tune a queue directory directly
+     */
+    [[nodiscard]] auto tune_queue(const std::filesystem::path& queue_dir)
+        -> std::expected<Lease, util::Error>;
+
+    /**
+     * @brief Restore every queue listed in the state file, e.g. after a crash
+     * @return Number of queues restored
+     */
+    auto restore_pending() -> std::size_t;
+
+private:
+    struct TunedQueue {
+        std::vector<QueueSetting> originals;  // In the order to write them back
+        int holders = 0;                      // Leases still using the tuning
+    };
+
+    void restore(const std::filesystem::path& queue_dir);
+    static void write_back(const std::filesystem::path& queue_dir,
+                           const std::vector<QueueSetting>& originals);
+    [[nodiscard]] auto save_locked() const -> std::expected<void, util::Error>;
+
+    std::filesystem::path state_path_;
+    mutable std::mutex mutex_;
+    std::map<std::filesystem::path, TunedQueue> tuned_;
+};
@@ -0,0 +1,285 @@
+/**
+ * @file StationPolicy.cpp
+ * @brief Station mode configuration parsing and rule matching
+ */
+
+#include "helper/services/StationPolicy.hpp"
+
+#include "algorithms/AlgorithmFactory.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <utility>
+
+// System headers
+#include <fnmatch.h>
+
+namespace {
+
+constexpr std::string_view RULE_SECTION_PREFIX = "rule ";
+
+auto trim(std::string_view text) -> std::string_view {
+    const auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const auto last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+auto to_lower(std::string_view text) -> std::string {
+    std::string lower{text};
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+auto parse_bool(std::string_view text) -> std::optional<bool> {
+    const auto lower = to_lower(text);
+    if (lower == "true" || lower == "yes" || lower == "1") {
+        return true;
+    }
+    if (lower == "false" || lower == "no" || lower == "0") {
+        return false;
+    }
+    return std::nullopt;
+}
+
+auto glob_matches(const std::string& pattern, std::string_view text) -> bool {
+    return ::fnmatch(pattern.c_str(), std::string{text}.c_str(), 0) == 0;
+}
+
+auto line_error(int line_number, std::string_view what) -> util::Error {
+    return util::Error{std::format("station config line {}: {}", line_number, what)};
+}
+
+}  // namespace
+
+auto parse_size(std::string_view text) -> std::optional<uint64_t> {
+    text = trim(text);
+    uint64_t value = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || ptr == text.data()) {
+        return std::nullopt;
+    }
+
+    const auto suffix = to_lower(trim({ptr, static_cast<std::size_t>(end - ptr)}));
+    int shift = 0;
+    if (suffix.empty() || suffix == "b") {
+        shift = 0;
+    } else if (suffix == "k" || suffix == "kb") {
+        shift = 10;
+    } else if (suffix == "m" || suffix == "mb") {
+        shift = 20;
+    } else if (suffix == "g" || suffix == "gb") {
+        shift = 30;
+    } else if (suffix == "t" || suffix == "tb") {
+        shift = 40;
+    } else {
+        return std::nullopt;
+    }
+
+    if (shift > 0 && value > (UINT64_MAX >> shift)) {
+        return std::nullopt;
+    }
+    return value << shift;
+}
+
+auto parse_duration(std::string_view text) -> std::optional<std::chrono::seconds> {
+    text = trim(text);
+    uint64_t value = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || ptr == text.data()) {
+        return std::nullopt;
+    }
+
+    const auto suffix = to_lower(trim({ptr, static_cast<std::size_t>(end - ptr)}));
+    uint64_t scale = 0;
+    if (suffix.empty() || suffix == "s") {
+        scale = 1;
+    } else if (suffix == "m") {
+        scale = 60;
+    } else if (suffix == "h") {
+        scale = 3'600;
+    } else if (suffix == "d") {
+        scale = 86'400;
+    } else {
+        return std::nullopt;
+    }
+
+    if (value > static_cast<uint64_t>(INT32_MAX) / scale) {
+        return std::nullopt;
+    }
+    return std::chrono::seconds{static_cast<int64_t>(value * scale)};
+}
+
+auto parse_algorithm_name(std::string_view name) -> std::optional<WipeAlgorithm> {
+    return parse_wipe_algorithm(trim(name));
+}
+
+auto StationConfig::parse(std::istream& input) -> std::expected<StationConfig, util::Error> {
+    StationConfig config;
+    StationRule* rule = nullptr;
+    bool in_station_section = false;
+
+    std::string raw_line;
+    int line_number = 0;
+    while (std::getline(input, raw_line)) {
+        ++line_number;
+        const auto line = trim(raw_line);
+        if (line.empty() || line.front() == '#' || line.front() == ';') {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                return std::unexpected(line_error(line_number, "unterminated section header"));
+            }
+            const auto section = trim(line.substr(1, line.size() - 2));
+            in_station_section = section == "station";
+            rule = nullptr;
+            if (section.starts_with(RULE_SECTION_PREFIX)) {
+                rule = &config.rules.emplace_back();
+                rule->name = std::string{trim(section.substr(RULE_SECTION_PREFIX.size()))};
+            } else if (!in_station_section) {
+                return std::unexpected(
+                    line_error(line_number, std::format("unknown section '{}'", section)));
+            }
+            continue;
+        }
+
+        const auto eq = line.find('=');
+        if (eq == std::string_view::npos) {
+            return std::unexpected(line_error(line_number, "expected key = value"));
+        }
+        const auto key = to_lower(trim(line.substr(0, eq)));
+        const auto value = trim(line.substr(eq + 1));
+
+        if (in_station_section) {
+            if (key == "enabled") {
+                auto enabled = parse_bool(value);
+                if (!enabled) {
+                    return std::unexpected(line_error(line_number, "enabled must be a boolean"));
+                }
+                config.enabled = *enabled;
+            } else if (key == "settle_delay_ms") {
+                auto delay = parse_size(value);
+                if (!delay) {
+                    return std::unexpected(line_error(line_number, "invalid settle_delay_ms"));
+                }
+                config.settle_delay = std::chrono::milliseconds{*delay};
+            } else if (key == "max_active_jobs") {
+                auto jobs = parse_size(value);
+                if (!jobs) {
+                    return std::unexpected(line_error(line_number, "invalid max_active_jobs"));
+                }
+                config.limits.max_active = static_cast<std::size_t>(*jobs);
+            } else if (key == "bandwidth_limit") {
+                auto limit = parse_size(value);
+                if (!limit) {
+                    return std::unexpected(line_error(line_number, "invalid bandwidth_limit"));
+                }
+                config.limits.bandwidth_limit = *limit;
+            } else if (key == "reject_infeasible") {
+                auto reject = parse_bool(value);
+                if (!reject) {
+                    return std::unexpected(
+                        line_error(line_number, "reject_infeasible must be a boolean"));
+                }
+                config.limits.reject_infeasible = *reject;
+            } else {
+                return std::unexpected(
+                    line_error(line_number, std::format("unknown key '{}'", key)));
+            }
+            continue;
+        }
+
+        if (!rule) {
+            return std::unexpected(line_error(line_number, "key outside of a section"));
+        }
+
+        if (key == "port") {
+            rule->port_pattern = std::string{value};
+        } else if (key == "model") {
+            rule->model_pattern = std::string{value};
+        } else if (key == "min_size" || key == "max_size") {
+            auto size = parse_size(value);
+            if (!size) {
+                return std::unexpected(line_error(line_number, std::format("invalid {}", key)));
+            }
+            (key == "min_size" ? rule->min_size_bytes : rule->max_size_bytes) = *size;
+        } else if (key == "algorithm") {
+            auto algorithm = parse_algorithm_name(value);
+            if (!algorithm) {
+                return std::unexpected(
+                    line_error(line_number, std::format("unknown algorithm '{}'", value)));
+            }
+            rule->algorithm = *algorithm;
+        } else if (key == "verify") {
+            auto verify = parse_bool(value);
+            if (!verify) {
+                return std::unexpected(line_error(line_number, "verify must be a boolean"));
+            }
+            rule->verify = *verify;
+        } else if (key == "priority") {
+            auto priority = parse_job_priority(value);
+            if (!priority) {
+                return std::unexpected(
+                    line_error(line_number, std::format("unknown priority '{}'", value)));
+            }
+            rule->priority = *priority;
+        } else if (key == "deadline") {
+            auto deadline = parse_duration(value);
+            if (!deadline) {
+                return std::unexpected(line_error(line_number, "invalid deadline"));
+            }
+            rule->deadline = *deadline;
+        } else {
+            return std::unexpected(line_error(line_number, std::format("unknown key '{}'", key)));
+        }
+    }
+
+    if (config.enabled && config.rules.empty()) {
+        return std::unexpected(util::Error{"station mode enabled without any [rule ...] section"});
+    }
+    return config;
+}
+
+auto StationConfig::load(const std::filesystem::path& path)
+    -> std::expected<StationConfig, util::Error> {
+    std::ifstream file{path};
+    if (!file) {
+        return StationConfig{};  // No file: station mode stays off
+    }
+    return parse(file);
+}
+
+auto StationConfig::match(const DiskInfo& disk, std::string_view port_path) const
+    -> std::expected<const StationRule*, util::Error> {
+    // Hard safety checks come before any rule: never touch a disk in use
+    if (disk.is_mounted) {
+        return std::unexpected(util::Error{std::format("mounted at {}", disk.mount_point)});
+    }
+    if (disk.is_lvm_pv) {
+        return std::unexpected(util::Error{"in use by LVM/device-mapper"});
+    }
+
+    for (const auto& rule : rules) {
+        if (!glob_matches(rule.port_pattern, port_path) ||
+            !glob_matches(rule.model_pattern, disk.model)) {
+            continue;
+        }
+        if (disk.size_bytes < rule.min_size_bytes ||
+            (rule.max_size_bytes != 0 && disk.size_bytes > rule.max_size_bytes)) {
+            continue;
+        }
+        return &rule;
+    }
+    return std::unexpected(util::Error{"no matching rule"});
+}
@@ -0,0 +1,111 @@
+/**
+ * @file StationPolicy.hpp
+ * @brief Rules deciding which hot-plugged disks a wipe station wipes automatically
+ *
+ * Configuration is an INI-style file (default /etc/storage-wiper/station.conf):
+ *
+ * @code
+ * [station]
+ * enabled = true
+ * settle_delay_ms = 2000
+ * max_active_jobs = 4        ; bays wiped at once, 0 = unlimited
+ * bandwidth_limit = 1G       ; summed write rate of running jobs, per second
+ * reject_infeasible = false  ; refuse jobs that cannot meet their deadline
+ *
+ * [rule front-bays]
+ * port = /devices/pci0000:00/0000:00:17.0/ata*
+ * model = *
+ * min_size = 64G
+ * max_size = 20T
+ * algorithm = zero-fill
+ * verify = true
+ * priority = high            ; low, normal, high or urgent
+ * deadline = 8h              ; from insertion; s, m, h or d suffix
+ * @endcode
+ *
+ * Rules are tried in file order; the first match wins. Mounted disks and
+ * disks with LVM/device-mapper holders are never matched. Matched disks are
+ * queued with JobScheduler, which decides when each one starts.
+ */
+
+#pragma once
+
+#include "helper/services/JobScheduler.hpp"
+#include "models/DiskInfo.hpp"
+#include "models/WipeTypes.hpp"
+#include "util/Result.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief One auto-wipe rule
+ */
+struct StationRule {
+    std::string name;
+    std::string port_pattern = "*";   // Glob over the port path (sysfs devpath of the bay)
+    std::string model_pattern = "*";  // Glob over the model string
+    uint64_t min_size_bytes = 0;
+    uint64_t max_size_bytes = 0;  // 0 = no upper bound
+    WipeAlgorithm algorithm = WipeAlgorithm::ZERO_FILL;
+    bool verify = false;
+    JobPriority priority = JobPriority::NORMAL;
+    std::chrono::seconds deadline{0};  // Time allowed from insertion; 0 = none
+};
+
+/**
+ * @brief Station mode configuration
+ */
+struct StationConfig {
+    static constexpr auto DEFAULT_PATH = "/etc/storage-wiper/station.conf";
+
+    bool enabled = false;
+    std::chrono::milliseconds settle_delay{2'000};  // Wait for udev to create the device node
+    SchedulerLimits limits;
+    std::vector<StationRule> rules;
+
+    /**
+     * @brief Parse configuration text
+     * @return Config, or an error naming the offending line
+     */
+    [[nodiscard]] static auto parse(std::istream& input)
+        -> std::expected<StationConfig, util::Error>;
+
+    /**
+     * @brief Load configuration from a file
+     * @return Config (disabled if the file does not exist), or a parse error
+     */
+    [[nodiscard]] static auto load(const std::filesystem::path& path = DEFAULT_PATH)
+        -> std::expected<StationConfig, util::Error>;
+
+    /**
+     * @brief Find the rule that applies to a freshly inserted disk
+     * @param disk Disk information from DiskService
+     * @param port_path Port the disk was inserted into
+     * @return Matching rule, or an error explaining why the disk is left alone
+     */
+    [[nodiscard]] auto match(const DiskInfo& disk, std::string_view port_path) const
+        -> std::expected<const StationRule*, util::Error>;
+};
+
+/**
+ * @brief Parse a size with optional K/M/G/T (binary) suffix, e.g. "512G"
+ */
+[[nodiscard]] auto parse_size(std::string_view text) -> std::optional<uint64_t>;
+
+/**
+ * @brief Parse a duration with optional s/m/h/d suffix, e.g. "90m"; bare numbers are seconds
+ */
+[[nodiscard]] auto parse_duration(std::string_view text) -> std::optional<std::chrono::seconds>;
+
+/**
+ * @brief Parse an algorithm name as accepted by the CLI (e.g. "dod-5220-22-m")
+ */
+[[nodiscard]] auto parse_algorithm_name(std::string_view name) -> std::optional<WipeAlgorithm>;
@@ -0,0 +1,354 @@
+/**
+ * @file StationService.cpp
+ * @brief Hotplug auto-wipe station mode implementation
+ */
+
+#include "helper/services/StationService.hpp"
+
+#include "util/Logger.hpp"
+
+// Standard library
+#include <algorithm>
+#include <format>
+#include <optional>
+#include <utility>
+
+namespace {
+
+// Share of the whole job done, counting each pass and the verification read equally
+auto job_fraction(const WipeProgress& progress, bool verify) -> double {
+    const int passes = std::max(progress.total_passes, 1);
+    const double steps = passes + (verify ? 1 : 0);
+    if (progress.verification_in_progress) {
+        return (passes + progress.verification_percentage / 100.0) / steps;
+    }
+    const double done = std::max(progress.current_pass - 1, 0) + progress.percentage / 100.0;
+    return std::clamp(done / steps, 0.0, 1.0);
+}
+
+auto describe_minutes(std::chrono::milliseconds duration) -> std::string {
+    const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration).count();
+    return minutes < 60 ? std::format("{}m", minutes)
+                        : std::format("{}h {:02d}m", minutes / 60, minutes % 60);
+}
+
+}  // namespace
+
+StationService::StationService(StationConfig config, std::shared_ptr<IDiskService> disk_service,
+                               WipeServiceFactory make_wipe_service, util::Scheduler& scheduler,
+                               EventCallback on_event, Clock clock, DiskMatcher same_disk,
+                               BusyProbe busy_elsewhere)
+    : config_(std::move(config)), disk_service_(std::move(disk_service)),
+      make_wipe_service_(std::move(make_wipe_service)), scheduler_(scheduler),
+      on_event_(std::move(on_event)), clock_(std::move(clock)), same_disk_(std::move(same_disk)),
+      busy_elsewhere_(std::move(busy_elsewhere)), job_scheduler_(config_.limits) {
+    LOG_INFO("StationService",
+             std::format("Station mode active with {} rule(s), {} bay(s) at once",
+                         config_.rules.size(),
+                         config_.limits.max_active == 0
+                             ? std::string{"unlimited"}
+                             : std::to_string(config_.limits.max_active)));
+}
+
+StationService::~StationService() {
+    alive_.reset();
+    for (auto& [path, job] : jobs_) {
+        if (job.started) {
+            job.service->cancel_current_operation();
+        }
+    }
+    jobs_.clear();  // Joins the wipe threads
+}
+
+auto StationService::is_busy(const std::string& device_path) const -> bool {
+    auto owns = [this, &device_path](const auto& item) {
+        return same_disk_(item.first, device_path);
+    };
+    return std::ranges::any_of(jobs_, owns) || std::ranges::any_of(pending_, owns);
+}
+
+auto StationService::active_jobs() const -> std::size_t {
+    return static_cast<std::size_t>(
+        std::ranges::count_if(jobs_, [](const auto& item) { return item.second.started; }));
+}
+
+auto StationService::queued_jobs() const -> std::size_t {
+    return jobs_.size() - active_jobs();
+}
+
+void StationService::on_uevent(const UeventMessage& message) {
+    if (!HotplugMonitor::is_disk_hotplug(message)) {
+        return;
+    }
+    const auto path = message.device_path();
+
+    if (message.action == "remove") {
+        pending_.erase(path);
+        auto it = jobs_.find(path);
+        if (it == jobs_.end()) {
+            return;
+        }
+        if (it->second.started) {
+            LOG_WARNING("StationService",
+                        std::format("{} removed during station wipe; cancelling", path));
+            it->second.service->cancel_current_operation();
+            return;
+        }
+        auto job = std::move(it->second);
+        jobs_.erase(it);
+        job_scheduler_.cancel(job.id);
+        emit({.kind = StationEvent::Kind::FINISHED,
+              .device_path = path,
+              .port_path = job.port_path,
+              .rule = job.rule,
+              .success = false,
+              .message = "removed before its wipe started"});
+        return;
+    }
+
+    if (is_busy(path)) {
+        return;
+    }
+    pending_[path] = ++next_generation_;
+    util::spawn(handle_added(message));
+}
+
+auto StationService::handle_added(UeventMessage message) -> util::Task<> {
+    const auto path = message.device_path();
+    const auto port = message.port_path();
+    const auto generation = pending_.at(path);
+    const std::weak_ptr<bool> alive = alive_;
+
+    // A removal (or our destruction) while suspended abandons this attempt
+    auto still_wanted = [&] {
+        if (alive.expired()) {
+            return false;
+        }
+        auto it = pending_.find(path);
+        return it != pending_.end() && it->second == generation;
+    };
+
+    // Device node present and listed by DiskService, or nullopt while udev is still settling
+    auto lookup = [service = disk_service_, path]() -> std::optional<DiskInfo> {
+        if (!service->validate_device_path(path)) {
+            return std::nullopt;
+        }
+        auto disks = service->get_available_disks_blocking();
+        if (!disks) {
+            return std::nullopt;
+        }
+        for (auto& candidate : *disks) {
+            if (candidate.path == path) {
+                return std::move(candidate);
+            }
+        }
+        return std::nullopt;
+    };
+
+    std::optional<DiskInfo> disk;
+    for (int attempt = 0; attempt < SETTLE_ATTEMPTS && !disk; ++attempt) {
+        co_await util::sleep_for(scheduler_, config_.settle_delay);
+        if (!still_wanted()) {
+            co_return;
+        }
+
+        disk = co_await util::run_blocking(scheduler_, lookup);
+        if (!still_wanted()) {
+            co_return;
+        }
+    }
+    pending_.erase(path);
+
+    if (!disk) {
+        emit({.kind = StationEvent::Kind::IGNORED,
+              .device_path = path,
+              .port_path = port,
+              .rule = "",
+              .success = false,
+              .message = "device did not become available"});
+        co_return;
+    }
+
+    if (auto reason = busy_elsewhere_ ? busy_elsewhere_(path) : std::nullopt) {
+        emit({.kind = StationEvent::Kind::IGNORED,
+              .device_path = path,
+              .port_path = port,
+              .rule = "",
+              .success = false,
+              .message = std::move(*reason)});
+        co_return;
+    }
+
+    auto rule = config_.match(*disk, port);
+    if (!rule) {
+        emit({.kind = StationEvent::Kind::IGNORED,
+              .device_path = path,
+              .port_path = port,
+              .rule = "",
+              .success = false,
+              .message = rule.error().message});
+        co_return;
+    }
+
+    queue(path, port, *disk, **rule);
+}
+
+void StationService::queue(const std::string& device_path, const std::string& port_path,
+                           const DiskInfo& disk, const StationRule& rule) {
+    const auto now = clock_();
+    JobSpec spec{.device_path = device_path,
+                 .device_key = disk.serial.empty() ? disk.model : disk.serial,
+                 .size_bytes = disk.size_bytes,
+                 .algorithm = rule.algorithm,
+                 .verify = rule.verify,
+                 .is_ssd = disk.is_ssd,
+                 .priority = rule.priority,
+                 .deadline = std::nullopt};
+    if (rule.deadline.count() > 0) {
+        spec.deadline = now + rule.deadline;
+    }
+
+    auto admission = job_scheduler_.submit(std::move(spec), now);
+    if (!admission) {
+        emit({.kind = StationEvent::Kind::IGNORED,
+              .device_path = device_path,
+              .port_path = port_path,
+              .rule = rule.name,
+              .success = false,
+              .message = admission.error().message});
+        return;
+    }
+
+    jobs_.emplace(device_path, Job{.id = admission->id,
+                                   .port_path = port_path,
+                                   .rule = rule.name,
+                                   .model = disk.model,
+                                   .algorithm = rule.algorithm,
+                                   .verify = rule.verify,
+                                   .service = nullptr,
+                                   .started = false});
+
+    auto message = std::format(
+        "estimated {}, done in about {}", describe_minutes(admission->estimated_duration),
+        describe_minutes(std::chrono::duration_cast<std::chrono::milliseconds>(
+            admission->estimated_finish - now)));
+    if (admission->deadline_at_risk) {
+        LOG_WARNING("StationService", std::format("{}: {}", device_path, admission->warning));
+        message += "; " + admission->warning;
+    }
+    emit({.kind = StationEvent::Kind::QUEUED,
+          .device_path = device_path,
+          .port_path = port_path,
+          .rule = rule.name,
+          .success = !admission->deadline_at_risk,
+          .message = std::move(message)});
+
+    dispatch();
+}
+
+void StationService::dispatch() {
+    bool bay_freed = false;
+    for (auto id : job_scheduler_.start_ready(clock_())) {
+        auto it = std::ranges::find_if(jobs_,
+                                       [id](const auto& item) { return item.second.id == id; });
+        if (it == jobs_.end()) {
+            job_scheduler_.cancel(id);
+            continue;
+        }
+        const auto path = it->first;
+        auto& job = it->second;
+        job.service = make_wipe_service_();
+        job.started = true;
+
+        // Called on the wipe thread; estimates and completion hop back to the scheduler
+        auto callback = [this, alive = std::weak_ptr<bool>{alive_}, path, id, verify = job.verify,
+                         last_step = -1](const WipeProgress& progress) mutable {
+            if (progress.is_complete) {
+                scheduler_.post([this, alive, path, progress] {
+                    if (!alive.expired()) {
+                        finish(path, progress);
+                    }
+                });
+                return;
+            }
+            const double fraction = job_fraction(progress, verify);
+            const int step = static_cast<int>(fraction * 100.0);
+            if (step > last_step) {
+                last_step = step;
+                scheduler_.post([this, alive, id, fraction] {
+                    if (!alive.expired()) {
+                        job_scheduler_.update_progress(id, fraction, clock_());
+                    }
+                });
+            }
+        };
+
+        if (!job.service->wipe_disk(path, job.algorithm, callback, job.verify)) {
+            auto failed = std::move(job);
+            jobs_.erase(it);
+            job_scheduler_.complete(id, false, clock_());
+            bay_freed = true;
+            emit({.kind = StationEvent::Kind::FINISHED,
+                  .device_path = path,
+                  .port_path = failed.port_path,
+                  .rule = failed.rule,
+                  .success = false,
+                  .message = "failed to start wipe"});
+            continue;
+        }
+
+        emit({.kind = StationEvent::Kind::STARTED,
+              .device_path = path,
+              .port_path = job.port_path,
+              .rule = job.rule,
+              .success = true,
+              .message = std::format("{} ({})", job.service->get_algorithm_name(job.algorithm),
+                                     job.model)});
+    }
+    if (bay_freed) {
+        dispatch();
+    }
+}
+
+void StationService::finish(const std::string& device_path, const WipeProgress& progress) {
+    auto it = jobs_.find(device_path);
+    if (it == jobs_.end()) {
+        return;  // Already reported as failed to start
+    }
+    auto job = std::move(it->second);
+    jobs_.erase(it);
+    job_scheduler_.complete(job.id, !progress.has_error, clock_());
+
+    emit({.kind = StationEvent::Kind::FINISHED,
+          .device_path = device_path,
+          .port_path = job.port_path,
+          .rule = job.rule,
+          .success = !progress.has_error,
+          .message = progress.has_error && !progress.error_message.empty()
+                         ? progress.error_message
+                         : progress.status});
+    dispatch();
+    // job.service goes out of scope here, joining its finished wipe thread
+}
+
+void StationService::emit(StationEvent event) const {
+    constexpr auto kind_name = [](StationEvent::Kind kind) {
+        switch (kind) {
+            case StationEvent::Kind::QUEUED:
+                return "queued";
+            case StationEvent::Kind::STARTED:
+                return "started";
+            case StationEvent::Kind::FINISHED:
+                return "finished";
+            case StationEvent::Kind::IGNORED:
+                return "ignored";
+        }
+        return "unknown";
+    };
+    LOG_INFO("StationService", std::format("{} {} (port {}, rule '{}'): {}", event.device_path,
+                                           kind_name(event.kind), event.port_path, event.rule,
+                                           event.message));
+    if (on_event_) {
+        on_event_(event);
+    }
+}
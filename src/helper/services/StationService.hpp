@@ -0,0 +1,138 @@
+/**
+ * @file StationService.hpp
+ * @brief Hotplug auto-wipe station mode
+ *
+ * Reacts to whole-disk add/remove uevents: after a settle delay (udev needs
+ * time to create the device node) the inserted disk is looked up, matched
+ * against the StationConfig rules and, on a match, queued with JobScheduler.
+ * Queued jobs start when the scheduler says so (bays, bandwidth, deadlines),
+ * each with its own WipeService so every bay runs independently. Removal of a
+ * disk drops or cancels its job. Queueing, start and completion are reported
+ * through the event callback.
+ */
+
+#pragma once
+
+#include "helper/services/HotplugMonitor.hpp"
+#include "helper/services/JobScheduler.hpp"
+#include "helper/services/StationPolicy.hpp"
+#include "services/IDiskService.hpp"
+#include "services/IWipeService.hpp"
+#include "util/Coroutine.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * @brief Station job lifecycle notification
+ */
+struct StationEvent {
+    enum class Kind {
+        QUEUED,    ///< Rule matched; the job waits for the scheduler (message has the estimate)
+        STARTED,   ///< The wipe was started
+        FINISHED,  ///< Wipe completed, failed or was cancelled
+        IGNORED    ///< Disk inserted but left alone (message says why)
+    };
+
+    Kind kind = Kind::IGNORED;
+    std::string device_path;
+    std::string port_path;
+    std::string rule;
+    bool success = false;
+    std::string message;
+};
+
+/**
+ * @class StationService
+ * @brief Starts configured wipes for hot-plugged disks without user interaction
+ *
+ * All public methods must be called on the scheduler's thread. Wipe progress
+ * arrives on wipe threads and is marshalled back through the scheduler.
+ */
+class StationService {
+public:
+    using EventCallback = std::function<void(const StationEvent&)>;
+    using WipeServiceFactory = std::function<std::shared_ptr<IWipeService>()>;
+    using Clock = std::function<std::chrono::steady_clock::time_point()>;
+    /// Whether two device paths (partitions, /dev/disk/by-* links) name the same disk
+    using DiskMatcher = std::function<bool(const std::string&, const std::string&)>;
+    /// Why a disk is in use outside station mode (manual wipe, surface scan), or nullopt
+    using BusyProbe = std::function<std::optional<std::string>(const std::string&)>;
+
+    StationService(StationConfig config, std::shared_ptr<IDiskService> disk_service,
+                   WipeServiceFactory make_wipe_service, util::Scheduler& scheduler,
+                   EventCallback on_event, Clock clock = std::chrono::steady_clock::now,
+                   DiskMatcher same_disk = std::equal_to<>{}, BusyProbe busy_elsewhere = {});
+    ~StationService();
+
+    StationService(const StationService&) = delete;
+    StationService& operator=(const StationService&) = delete;
+    StationService(StationService&&) = delete;
+    StationService& operator=(StationService&&) = delete;
+
+    /**
+     * @brief Handle a whole-disk add/remove uevent
+     */
+    void on_uevent(const UeventMessage& message);
+
+    /**
+     * @brief Whether a station job currently owns this device's disk
+     */
+    [[nodiscard]] auto is_busy(const std::string& device_path) const -> bool;
+
+    /**
+     * @brief Number of running station jobs
+     */
+    [[nodiscard]] auto active_jobs() const -> std::size_t;
+
+    /**
+     * @brief Number of matched disks waiting for a free bay
+     */
+    [[nodiscard]] auto queued_jobs() const -> std::size_t;
+
+private:
+    // Attempts at SETTLE interval before giving up on a device node appearing
+    static constexpr int SETTLE_ATTEMPTS = 5;
+
+    struct Job {
+        uint64_t id = 0;  // JobScheduler id
+        std::string port_path;
+        std::string rule;
+        std::string model;
+        WipeAlgorithm algorithm = WipeAlgorithm::ZERO_FILL;
+        bool verify = false;
+        std::shared_ptr<IWipeService> service;
+        bool started = false;
+    };
+
+    auto handle_added(UeventMessage message) -> util::Task<>;
+    void queue(const std::string& device_path, const std::string& port_path,
+               const DiskInfo& disk, const StationRule& rule);
+    void dispatch();
+    void finish(const std::string& device_path, const WipeProgress& progress);
+    void emit(StationEvent event) const;
+
+    StationConfig config_;
+    std::shared_ptr<IDiskService> disk_service_;
+    WipeServiceFactory make_wipe_service_;
+    util::Scheduler& scheduler_;
+    EventCallback on_event_;
+    Clock clock_;
+    DiskMatcher same_disk_;
+    BusyProbe busy_elsewhere_;
+    JobScheduler job_scheduler_;
+
+    // Suspended handle_added() coroutines check this before touching members again
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+
+    // Scheduler thread only, keyed by device path
+    std::map<std::string, Job> jobs_;
+    std::map<std::string, uint64_t> pending_;  // Between uevent and job start -> generation
+    uint64_t next_generation_ = 0;
+};
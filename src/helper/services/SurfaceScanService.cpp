@@ -0,0 +1,551 @@
+/**
+ * @file SurfaceScanService.cpp
+ * @brief Read-only full-surface scan that grades a drive before reuse
+ */
+
+#include "helper/services/SurfaceScanService.hpp"
+
+#include "util/Executor.hpp"
+#include "util/FileDescriptor.hpp"
+#include "util/Logger.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <future>
+#include <utility>
+
+// System headers
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Linux-specific headers
+#include <linux/fs.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto PROGRESS_INTERVAL = std::chrono::milliseconds{250};
+
+// A failed read is retried in pieces of this size, then sector by sector
+constexpr std::size_t PROBE_SIZE = 64 * 1'024;
+
+// O_DIRECT buffers must be aligned to the logical block size
+constexpr std::size_t BUFFER_ALIGNMENT = 4'096;
+
+// Grade thresholds, see grade_surface()
+constexpr uint64_t MAX_FAILED_FOR_D = 16;
+constexpr uint64_t SLOW_PER_MILLE = 1;
+constexpr uint64_t OVER_50MS_PERCENT = 1;
+
+struct FreeDeleter {
+    void operator()(uint8_t* buffer) const noexcept { std::free(buffer); }
+};
+using AlignedBuffer = std::unique_ptr<uint8_t[], FreeDeleter>;
+
+auto make_buffer(std::size_t size) -> AlignedBuffer {
+    const auto rounded = (size + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+    return AlignedBuffer{static_cast<uint8_t*>(std::aligned_alloc(BUFFER_ALIGNMENT, rounded))};
+}
+
+auto read_all(const SurfaceReader& reader, uint8_t* buffer, std::size_t length, uint64_t offset)
+    -> bool {
+    std::size_t done = 0;
+    while (done < length) {
+        const auto result = reader(buffer + done, length - done, offset + done);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        done += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+auto to_us(Clock::duration duration) -> uint32_t {
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    return static_cast<uint32_t>(std::clamp<int64_t>(us, 0, UINT32_MAX));
+}
+
+auto describe_bytes(double bytes) -> std::string {
+    constexpr std::array units = {"B", "KB", "MB", "GB", "TB", "PB"};
+    std::size_t unit = 0;
+    while (bytes >= 1'024.0 && unit + 1 < units.size()) {
+        bytes /= 1'024.0;
+        ++unit;
+    }
+    return std::format("{:.1f} {}", bytes, units[unit]);
+}
+
+/**
+ * @brief What one chain of reads measured, and the buffer it reads into
+ */
+struct ReaderStats {
+    AlignedBuffer buffer;
+    std::array<uint64_t, LATENCY_BUCKETS> histogram{};
+    std::vector<SurfaceRegion> regions{};
+    std::vector<SlowRead> slow_reads{};
+    std::vector<uint64_t> failed_sectors{};
+};
+
+/**
+ * @brief State shared by the read chains of one scan
+ */
+struct ScanState {
+    SurfaceReader reader;
+    uint64_t size;
+    uint32_t sector_size;
+    std::size_t read_size;
+    uint64_t region_bytes;
+    std::size_t region_count;
+    ProgressCallback callback;
+    const std::atomic<bool>& cancel_flag;
+    SurfaceScanDone on_done;
+    Clock::time_point started;
+
+    std::vector<ReaderStats> chains{};
+    std::atomic<std::size_t> running{0};  // Chains that have not finished yet
+    std::atomic<uint64_t> next_chunk{0};
+    std::atomic<Clock::rep> last_completion{0};
+    std::atomic<uint64_t> bytes_done{0};
+    std::atomic<uint64_t> slow_total{0};
+    std::atomic<uint64_t> failed_total{0};
+
+    std::mutex progress_mutex{};
+    Clock::time_point last_progress{};
+
+    [[nodiscard]] auto chunk_count() const -> uint64_t {
+        return (size + read_size - 1) / read_size;
+    }
+
+    [[nodiscard]] auto region_of(uint64_t offset) const -> std::size_t {
+        return std::min(static_cast<std::size_t>(offset / region_bytes), region_count - 1);
+    }
+};
+
+void report_progress(ScanState& state, bool force) {
+    if (!state.callback) {
+        return;
+    }
+    std::unique_lock lock{state.progress_mutex, std::try_to_lock};
+    if (!lock.owns_lock()) {
+        return;  // Another reader is reporting
+    }
+    const auto now = Clock::now();
+    if (!force && now - state.last_progress < PROGRESS_INTERVAL) {
+        return;
+    }
+    state.last_progress = now;
+
+    const auto done = state.bytes_done.load();
+    const auto seconds = std::chrono::duration<double>(now - state.started).count();
+    WipeProgress progress{};
+    progress.bytes_written = done;
+    progress.total_bytes = state.size;
+    progress.current_pass = 1;
+    progress.total_passes = 1;
+    progress.percentage = static_cast<double>(done) / static_cast<double>(state.size) * 100.0;
+    if (seconds > 0.0 && done > 0) {
+        const auto rate = static_cast<double>(done) / seconds;
+        progress.speed_bytes_per_sec = static_cast<uint64_t>(rate);
+        progress.estimated_seconds_remaining =
+            static_cast<int64_t>(static_cast<double>(state.size - done) / rate);
+    }
+    progress.status = std::format("Scanning surface... ({} slow reads, {} unreadable sectors)",
+                                  state.slow_total.load(), state.failed_total.load());
+    state.callback(progress);
+}
+
+// Narrow a failed read down to the sectors that cannot be read
+void probe_failed_read(ScanState& state, ReaderStats& stats, uint64_t offset,
+                       std::size_t length) {
+    for (std::size_t piece = 0; piece < length; piece += PROBE_SIZE) {
+        const auto piece_length = std::min(PROBE_SIZE, length - piece);
+        if (read_all(state.reader, stats.buffer.get(), piece_length, offset + piece)) {
+            continue;
+        }
+        for (std::size_t sector = 0; sector < piece_length; sector += state.sector_size) {
+            const auto at = offset + piece + sector;
+            const auto sector_length = std::min<std::size_t>(state.sector_size,
+                                                             piece_length - sector);
+            if (state.cancel_flag.load()) {
+                return;
+            }
+            if (!read_all(state.reader, stats.buffer.get(), sector_length, at)) {
+                stats.failed_sectors.push_back(at);
+                ++stats.regions[state.region_of(at)].failed_sectors;
+                state.failed_total.fetch_add(1);
+            }
+        }
+    }
+}
+
+// Read one chunk and account for it; false once there is nothing left to read
+auto read_one_chunk(ScanState& state, ReaderStats& stats) -> bool {
+    const auto chunk = state.next_chunk.fetch_add(1);
+    if (chunk >= state.chunk_count() || state.cancel_flag.load()) {
+        return false;
+    }
+    const auto offset = chunk * state.read_size;
+    const auto length =
+        static_cast<std::size_t>(std::min<uint64_t>(state.read_size, state.size - offset));
+
+    const auto start = Clock::now();
+    const bool ok = read_all(state.reader, stats.buffer.get(), length, offset);
+    const auto finish = Clock::now();
+
+    // The device worked on this read since it last completed one
+    const auto previous = Clock::time_point{
+        Clock::duration{state.last_completion.exchange(finish.time_since_epoch().count())}};
+    const auto service = to_us(finish - std::max(start, previous));
+
+    if (ok) {
+        ++stats.histogram[static_cast<std::size_t>(
+            latency_bucket(std::chrono::microseconds{service}))];
+        auto& region = stats.regions[state.region_of(offset)];
+        ++region.reads;
+        region.total_us += service;
+        region.max_us = std::max(region.max_us, service);
+        if (std::chrono::microseconds{service} >= SLOW_READ) {
+            stats.slow_reads.push_back({.offset = offset,
+                                        .length = static_cast<uint32_t>(length),
+                                        .latency_us = service});
+            state.slow_total.fetch_add(1);
+        }
+    } else {
+        probe_failed_read(state, stats, offset, length);
+    }
+
+    state.bytes_done.fetch_add(length);
+    report_progress(state, false);
+    return true;
+}
+
+template <typename T, typename Key>
+void sort_and_cap(std::vector<T>& items, Key key) {
+    std::ranges::sort(items, {}, key);
+    if (items.size() > MAX_LISTED) {
+        items.resize(MAX_LISTED);
+    }
+}
+
+// Merge what the chains measured, grade it and hand it over; run by the last chain
+void finish_scan(ScanState& state) {
+    SurfaceScanReport report{};
+    report.size_bytes = state.size;
+    report.sector_size = state.sector_size;
+    report.regions.resize(state.region_count);
+    for (const auto& chain : state.chains) {
+        for (std::size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+            report.histogram[i] += chain.histogram[i];
+        }
+        for (std::size_t i = 0; i < chain.regions.size(); ++i) {
+            auto& region = report.regions[i];
+            const auto& part = chain.regions[i];
+            region.reads += part.reads;
+            region.total_us += part.total_us;
+            region.max_us = std::max(region.max_us, part.max_us);
+            region.failed_sectors += part.failed_sectors;
+        }
+        report.slow_reads.insert(report.slow_reads.end(), chain.slow_reads.begin(),
+                                 chain.slow_reads.end());
+        report.failed_sectors.insert(report.failed_sectors.end(), chain.failed_sectors.begin(),
+                                     chain.failed_sectors.end());
+    }
+    report.bytes_read = state.bytes_done.load();
+    report.slow_read_count = report.slow_reads.size();
+    report.failed_sector_count = report.failed_sectors.size();
+    sort_and_cap(report.slow_reads, &SlowRead::offset);
+    sort_and_cap(report.failed_sectors, std::identity{});
+    if (state.size > 0) {
+        report_progress(state, true);
+    }
+
+    report.elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - state.started);
+    report.complete = !state.cancel_flag.load() && report.bytes_read == state.size;
+    grade_surface(report);
+    state.on_done(std::move(report));
+}
+
+// One read per task: a chain queues its next read behind whatever else the lane
+// holds, so a scan never keeps an I/O worker for longer than a single read
+void queue_read(std::shared_ptr<ScanState> state, std::size_t chain) {
+    util::Executor::shared().post(
+        [state = std::move(state), chain]() mutable {
+            if (read_one_chunk(*state, state->chains[chain])) {
+                queue_read(std::move(state), chain);
+            } else if (state->running.fetch_sub(1) == 1) {
+                finish_scan(*state);
+            }
+        },
+        util::TaskPriority::BULK, util::TaskLane::BLOCKING_IO);
+}
+
+}  // namespace
+
+auto latency_bucket(std::chrono::microseconds latency) -> LatencyBucket {
+    using std::chrono::milliseconds;
+    if (latency < milliseconds{10}) {
+        return LatencyBucket::UNDER_10MS;
+    }
+    if (latency < milliseconds{50}) {
+        return LatencyBucket::UNDER_50MS;
+    }
+    if (latency < SLOW_READ) {
+        return LatencyBucket::UNDER_150MS;
+    }
+    if (latency < VERY_SLOW_READ) {
+        return LatencyBucket::UNDER_500MS;
+    }
+    return LatencyBucket::OVER_500MS;
+}
+
+void grade_surface(SurfaceScanReport& report) {
+    const auto& h = report.histogram;
+    const auto bucket = [&h](LatencyBucket b) { return h[static_cast<std::size_t>(b)]; };
+
+    uint64_t reads = 0;
+    for (const auto count : h) {
+        reads += count;
+    }
+    const auto very_slow = bucket(LatencyBucket::OVER_500MS);
+    const auto slow = bucket(LatencyBucket::UNDER_500MS) + very_slow;
+    const auto over_50ms = bucket(LatencyBucket::UNDER_150MS) + slow;
+    const auto failed = report.failed_sector_count;
+    const auto above_per_mille = [reads](uint64_t count) {
+        return count * 1'000 > reads * SLOW_PER_MILLE;
+    };
+
+    if (!report.complete) {
+        report.grade = '?';
+    } else if (failed > MAX_FAILED_FOR_D) {
+        report.grade = 'F';
+    } else if (failed > 0 || above_per_mille(very_slow)) {
+        report.grade = 'D';
+    } else if (very_slow > 0 || above_per_mille(slow)) {
+        report.grade = 'C';
+    } else if (slow > 0 || over_50ms * 100 > reads * OVER_50MS_PERCENT) {
+        report.grade = 'B';
+    } else {
+        report.grade = 'A';
+    }
+
+    const auto seconds = std::max(std::chrono::duration<double>(report.elapsed).count(), 1e-3);
+    const auto read = std::format("{} in {:.1f}s ({}/s)", describe_bytes(report.bytes_read),
+                                  seconds,
+                                  describe_bytes(static_cast<double>(report.bytes_read) / seconds));
+    const auto findings = std::format("{} slow reads ({} over {} ms), {} unreadable sectors", slow,
+                                      very_slow, VERY_SLOW_READ.count(), failed);
+    if (report.complete) {
+        report.summary = std::format("Grade {}: {}; {}", report.grade, findings, read);
+    } else {
+        report.summary = std::format("Scan stopped after {} of {}: {}",
+                                     describe_bytes(report.bytes_read),
+                                     describe_bytes(report.size_bytes), findings);
+    }
+}
+
+void scan_surface_async(SurfaceReader reader, uint64_t size, uint32_t sector_size,
+                        const SurfaceScanOptions& options, ProgressCallback callback,
+                        const std::atomic<bool>& cancel_flag, SurfaceScanDone on_done) {
+    const auto region_count = std::max<std::size_t>(1, options.regions);
+    auto state = std::shared_ptr<ScanState>(new ScanState{
+        .reader = std::move(reader),
+        .size = size,
+        .sector_size = sector_size == 0 ? 512 : sector_size,
+        .read_size = std::max<std::size_t>(options.read_size, BUFFER_ALIGNMENT),
+        .region_bytes = std::max<uint64_t>(1, (size + region_count - 1) / region_count),
+        .region_count = region_count,
+        .callback = std::move(callback),
+        .cancel_flag = cancel_flag,
+        .on_done = std::move(on_done),
+        .started = Clock::now()});
+    state->last_completion.store(state->started.time_since_epoch().count());
+
+    // Reads in flight: the requested depth, but never more than the lane has workers
+    const auto depth = std::min(std::max<std::size_t>(1, options.queue_depth),
+                                util::Executor::shared().io_threads());
+    for (std::size_t i = 0; i < depth && state->size > 0; ++i) {
+        ReaderStats chain{.buffer = make_buffer(state->read_size)};
+        if (!chain.buffer) {
+            break;
+        }
+        chain.regions.resize(region_count);
+        state->chains.push_back(std::move(chain));
+    }
+    if (state->chains.empty()) {
+        finish_scan(*state);
+        return;
+    }
+
+    state->running.store(state->chains.size());
+    for (std::size_t i = 0; i < state->chains.size(); ++i) {
+        queue_read(state, i);
+    }
+}
+
+auto scan_surface(const SurfaceReader& reader, uint64_t size, uint32_t sector_size,
+                  const SurfaceScanOptions& options, const ProgressCallback& callback,
+                  const std::atomic<bool>& cancel_flag) -> SurfaceScanReport {
+    // Shared with the last chain, which may still be inside set_value() as we return
+    auto result = std::make_shared<std::promise<SurfaceScanReport>>();
+    auto future = result->get_future();
+    scan_surface_async(reader, size, sector_size, options, callback, cancel_flag,
+                       [result](SurfaceScanReport report) {
+                           result->set_value(std::move(report));
+                       });
+    return future.get();
+}
+
+// ============================================================================
+// SurfaceScanService
+// ============================================================================
+
+SurfaceScanService::SurfaceScanService(SurfaceScanOptions options) : options_(options) {}
+
+SurfaceScanService::~SurfaceScanService() {
+    cancel_all();
+}
+
+auto SurfaceScanService::start(const std::string& device_path, ProgressCallback callback)
+    -> std::expected<void, util::Error> {
+    std::lock_guard lock{mutex_};
+    reap_finished();
+    if (jobs_.contains(device_path)) {
+        return std::unexpected(util::Error{"A surface scan of this device is already running"});
+    }
+
+    // O_DIRECT keeps the page cache out of the timings; image files may not support it
+    util::FileDescriptor fd{::open(device_path.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC)};
+    if (!fd) {
+        fd = util::FileDescriptor{::open(device_path.c_str(), O_RDONLY | O_CLOEXEC)};
+    }
+    if (!fd) {
+        return std::unexpected(util::Error{
+            std::format("Cannot open {}: {}", device_path, strerror(errno)), errno});
+    }
+
+    struct stat st{};
+    if (::fstat(fd.get(), &st) != 0) {
+        return std::unexpected(util::Error{std::format("Cannot stat {}", device_path), errno});
+    }
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+    int sector_size = 512;
+    if (S_ISBLK(st.st_mode)) {
+        if (::ioctl(fd.get(), BLKGETSIZE64, &size) != 0) {
+            return std::unexpected(
+                util::Error{std::format("Cannot get the size of {}", device_path), errno});
+        }
+        static_cast<void>(::ioctl(fd.get(), BLKSSZGET, &sector_size));
+    }
+    if (size == 0) {
+        return std::unexpected(util::Error{std::format("{} is empty", device_path)});
+    }
+
+    auto job = std::make_unique<Job>();
+    auto* raw = job.get();
+    auto file = std::make_shared<util::FileDescriptor>(std::move(fd));
+    SurfaceReader reader = [file](void* buffer, std::size_t length, uint64_t offset) {
+        return ::pread(file->get(), buffer, length, static_cast<off_t>(offset));
+    };
+
+    LOG_INFO("SurfaceScanService", std::format("Scanning {} ({} bytes)", device_path, size));
+    auto on_done = [this, raw, device_path, callback](SurfaceScanReport report) {
+        LOG_INFO("SurfaceScanService", std::format("{}: {}", device_path, report.summary));
+
+        WipeProgress done{};
+        done.is_complete = true;
+        done.bytes_written = report.bytes_read;
+        done.total_bytes = report.size_bytes;
+        done.current_pass = 1;
+        done.total_passes = 1;
+        done.percentage = report.complete ? 100.0 : 0.0;
+        done.status = report.summary;
+        if (!report.complete) {
+            done.has_error = true;
+            done.error_message = "Surface scan was cancelled";
+        }
+
+        {
+            // Last use of this service: cancel_all() may destroy it once the lock drops
+            std::lock_guard reports_lock{mutex_};
+            reports_[device_path] = std::move(report);
+            raw->finished.store(true);
+            finished_cv_.notify_all();
+        }
+        if (callback) {
+            callback(done);
+        }
+    };
+    scan_surface_async(std::move(reader), size, static_cast<uint32_t>(sector_size), options_,
+                       callback, raw->cancel, std::move(on_done));
+    jobs_.emplace(device_path, std::move(job));
+    return {};
+}
+
+auto SurfaceScanService::cancel(const std::string& device_path) -> bool {
+    std::lock_guard lock{mutex_};
+    auto it = jobs_.find(device_path);
+    if (it == jobs_.end() || it->second->finished.load()) {
+        return false;
+    }
+    it->second->cancel.store(true);
+    return true;
+}
+
+void SurfaceScanService::cancel_all() {
+    std::unique_lock lock{mutex_};
+    for (auto& [path, job] : jobs_) {
+        job->cancel.store(true);
+    }
+    finished_cv_.wait(lock, [this] {
+        return std::ranges::all_of(jobs_,
+                                   [](const auto& entry) { return entry.second->finished.load(); });
+    });
+    jobs_.clear();
+}
+
+auto SurfaceScanService::report(const std::string& device_path) const
+    -> std::optional<SurfaceScanReport> {
+    std::lock_guard lock{mutex_};
+    if (auto it = reports_.find(device_path); it != reports_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+auto SurfaceScanService::active_count() const -> std::size_t {
+    std::lock_guard lock{mutex_};
+    return static_cast<std::size_t>(std::ranges::count_if(
+        jobs_, [](const auto& entry) { return !entry.second->finished.load(); }));
+}
+
+auto SurfaceScanService::is_scanning(const std::string& device_path) const -> bool {
+    std::lock_guard lock{mutex_};
+    auto it = jobs_.find(device_path);
+    return it != jobs_.end() && !it->second->finished.load();
+}
+
+auto SurfaceScanService::active_devices() const -> std::vector<std::string> {
+    std::lock_guard lock{mutex_};
+    std::vector<std::string> devices;
+    for (const auto& [path, job] : jobs_) {
+        if (!job->finished.load()) {
+            devices.push_back(path);
+        }
+    }
+    return devices;
+}
+
+void SurfaceScanService::reap_finished() {
+    std::erase_if(jobs_, [](const auto& entry) { return entry.second->finished.load(); });
+}
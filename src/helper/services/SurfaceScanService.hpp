@@ -0,0 +1,231 @@
+/**
+ * @file SurfaceScanService.hpp
+ * @brief Read-only full-surface scan that grades a drive before reuse
+ *
+ * Every byte of the device is read once, with several reads in flight so the
+ * drive streams at full bandwidth. The reads run on the shared executor's
+ * blocking-I/O lane, one read per task, so a scan has no threads of its own.
+ * For each read the scan records how long the device took to serve it:
+ *
+ * - a latency histogram and a per-region heatmap (REGIONS slices of the LBA
+ *   range, mean and worst read in each), which show weak zones on a platter
+ *   or a tired flash area;
+ * - every read slower than SLOW_READ, with its offset;
+ * - every unreadable sector: a failed read is retried in smaller pieces, down
+ *   to single logical sectors, so only the bad sectors are listed.
+ *
+ * The result is graded A to F (see grade_surface()). Scans of different
+ * devices are independent and run concurrently; progress is reported as
+ * WipeProgress updates, which the helper publishes as SurfaceScanProgress.
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+#include "util/Result.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tuning of a surface scan
+ */
+struct SurfaceScanOptions {
+    static constexpr std::size_t DEFAULT_READ_SIZE = 1'024 * 1'024;
+    static constexpr std::size_t DEFAULT_QUEUE_DEPTH = 4;
+    static constexpr std::size_t DEFAULT_REGIONS = 100;
+
+    std::size_t read_size = DEFAULT_READ_SIZE;      ///< Bytes per read; a multiple of 4096
+    std::size_t queue_depth = DEFAULT_QUEUE_DEPTH;  ///< Reads in flight per device
+    std::size_t regions = DEFAULT_REGIONS;          ///< Heatmap resolution
+};
+
+/**
+ * @enum LatencyBucket
+ * @brief Histogram bins of per-read service time
+ */
+enum class LatencyBucket : std::uint8_t {
+    UNDER_10MS,
+    UNDER_50MS,
+    UNDER_150MS,
+    UNDER_500MS,  ///< Slow
+    OVER_500MS    ///< Very slow: the drive retried or remapped
+};
+
+inline constexpr std::size_t LATENCY_BUCKETS = 5;
+inline constexpr auto SLOW_READ = std::chrono::milliseconds{150};
+inline constexpr auto VERY_SLOW_READ = std::chrono::milliseconds{500};
+
+// At most this many slow reads and failed sectors are listed; all are counted
+inline constexpr std::size_t MAX_LISTED = 1'000;
+
+/**
+ * @brief Latency of one slice of the LBA range
+ */
+struct SurfaceRegion {
+    uint64_t reads = 0;
+    uint64_t total_us = 0;
+    uint32_t max_us = 0;
+    uint32_t failed_sectors = 0;
+
+    [[nodiscard]] auto mean_us() const -> double {
+        return reads == 0 ? 0.0 : static_cast<double>(total_us) / static_cast<double>(reads);
+    }
+};
+
+/**
+ * @brief A read at or above SLOW_READ
+ */
+struct SlowRead {
+    uint64_t offset = 0;
+    uint32_t length = 0;
+    uint32_t latency_us = 0;
+};
+
+/**
+ * @brief Everything a scan measured
+ */
+struct SurfaceScanReport {
+    uint64_t size_bytes = 0;
+    uint64_t bytes_read = 0;
+    uint32_t sector_size = 512;
+    std::array<uint64_t, LATENCY_BUCKETS> histogram{};
+    std::vector<SurfaceRegion> regions;
+    std::vector<SlowRead> slow_reads;     // By offset, at most MAX_LISTED
+    std::vector<uint64_t> failed_sectors;  // Byte offsets, by offset, at most MAX_LISTED
+    uint64_t slow_read_count = 0;
+    uint64_t failed_sector_count = 0;
+    std::chrono::milliseconds elapsed{0};
+    bool complete = false;  // False when cancelled
+    char grade = '?';
+    std::string summary;
+};
+
+/**
+ * @brief Reads length bytes at offset into buffer; returns bytes read, or -1 with errno set
+ */
+using SurfaceReader =
+    std::function<ssize_t(void* buffer, std::size_t length, uint64_t offset)>;
+
+/**
+ * @brief Histogram bin of a service time
+ */
+[[nodiscard]] auto latency_bucket(std::chrono::microseconds latency) -> LatencyBucket;
+
+/**
+ * @brief Grade a finished scan and describe it
+ *
+ * - F: more than 16 unreadable sectors
+ * - D: any unreadable sector, or more than 0.1% of reads very slow
+ * - C: any very slow read, or more than 0.1% of reads slow
+ * - B: any slow read, or more than 1% of reads over 50 ms
+ * - A: none of the above
+ *
+ * Sets report.grade and report.summary.
+ */
+void grade_surface(SurfaceScanReport& report);
+
+/**
+ * @brief Receives the report of a finished scan
+ */
+using SurfaceScanDone = std::function<void(SurfaceScanReport)>;
+
+/**
+ * @brief Read [0, size) through reader on the executor's blocking-I/O lane and measure it
+ *
+ * options.queue_depth reads are kept in flight, capped at the lane's thread
+ * count. Each read is one BULK task that queues the next read when it
+ * completes, so other blocking work interleaves with a long scan.
+ *
+ * A read's service time is the time since the previous read (any reader)
+ * completed, capped at its own latency. With several reads queued, the
+ * wall-clock latency of each includes waiting behind the others; the gap
+ * between completions is what the device spent on this read.
+ *
+ * @param callback Progress, a few times a second; called from I/O workers
+ * @param cancel_flag Must outlive the scan, up to the return of on_done
+ * @param on_done Called once, from an I/O worker, with the graded report
+ */
+void scan_surface_async(SurfaceReader reader, uint64_t size, uint32_t sector_size,
+                        const SurfaceScanOptions& options, ProgressCallback callback,
+                        const std::atomic<bool>& cancel_flag, SurfaceScanDone on_done);
+
+/**
+ * @brief scan_surface_async() that waits for the report; not for use on an executor worker
+ */
+[[nodiscard]] auto scan_surface(const SurfaceReader& reader, uint64_t size, uint32_t sector_size,
+                                const SurfaceScanOptions& options,
+                                const ProgressCallback& callback,
+                                const std::atomic<bool>& cancel_flag) -> SurfaceScanReport;
+
+/**
+ * @class SurfaceScanService
+ * @brief Runs one background surface scan per device
+ */
+class SurfaceScanService {
+public:
+    explicit SurfaceScanService(SurfaceScanOptions options = {});
+    ~SurfaceScanService();
+
+    SurfaceScanService(const SurfaceScanService&) = delete;
+    SurfaceScanService& operator=(const SurfaceScanService&) = delete;
+
+    /**
+     * @brief Open a device (or image file) read-only and scan it in the background
+     * @param callback Progress; the last update has is_complete set and the grade in status
+     * @return Error if the device is already being scanned or cannot be opened
+     */
+    auto start(const std::string& device_path, ProgressCallback callback)
+        -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Ask a running scan to stop
+     * @return true if the device was being scanned
+     */
+    auto cancel(const std::string& device_path) -> bool;
+
+    /**
+     * @brief Stop every scan and wait for them
+     */
+    void cancel_all();
+
+    /**
+     * @brief Report of the device's last finished scan
+     */
+    [[nodiscard]] auto report(const std::string& device_path) const
+        -> std::optional<SurfaceScanReport>;
+
+    [[nodiscard]] auto active_count() const -> std::size_t;
+    [[nodiscard]] auto is_scanning(const std::string& device_path) const -> bool;
+
+    /**
+     * @brief Paths of the devices being scanned, as passed to start()
+     */
+    [[nodiscard]] auto active_devices() const -> std::vector<std::string>;
+
+private:
+    struct Job {
+        std::atomic<bool> cancel{false};
+        std::atomic<bool> finished{false};  // Set under mutex_; finished_cv_ is notified
+    };
+
+    void reap_finished();  // Caller holds mutex_
+
+    SurfaceScanOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable finished_cv_;
+    std::map<std::string, std::unique_ptr<Job>> jobs_;
+    std::map<std::string, SurfaceScanReport> reports_;
+};
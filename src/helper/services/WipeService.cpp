@@ -4,17 +4,11 @@
 #include "util/FileDescriptor.hpp"
 
 // Algorithm implementations
-#include "algorithms/ATASecureEraseAlgorithm.hpp"
-#include "algorithms/DoD522022MAlgorithm.hpp"
-#include "algorithms/GOSTAlgorithm.hpp"
-#include "algorithms/GutmannAlgorithm.hpp"
-#include "algorithms/RandomFillAlgorithm.hpp"
-#include "algorithms/SchneierAlgorithm.hpp"
-#include "algorithms/VSITRAlgorithm.hpp"
-#include "algorithms/ZeroFillAlgorithm.hpp"
+#include "algorithms/AlgorithmFactory.hpp"
 
 // Project headers
 #include "util/Logger.hpp"
+#include "util/WritePacer.hpp"
 
 // Standard library
 #include <cerrno>
@@ -133,10 +127,21 @@ private:
     std::deque<uint64_t> speed_samples_;
 };
 
+void log_job_io(const std::string& disk_path, const IoStat& io) {
+    LOG_INFO("WipeService",
+             std::format("I/O for {} (io.stat): {} bytes in {} writes, {} bytes in {} reads, "
+                         "{} bytes in {} discards",
+                         disk_path, io.write_bytes, io.write_ios, io.read_bytes, io.read_ios,
+                         io.discard_bytes, io.discard_ios));
+}
+
 }  // namespace
 
-WipeService::WipeService(std::shared_ptr<IDiskService> disk_service)
-    : disk_service_(std::move(disk_service)) {
+WipeService::WipeService(std::shared_ptr<IDiskService> disk_service,
+                         std::shared_ptr<QueueTuner> queue_tuner,
+                         std::shared_ptr<IoCgroup> io_cgroup)
+    : disk_service_(std::move(disk_service)), queue_tuner_(std::move(queue_tuner)),
+      io_cgroup_(std::move(io_cgroup)) {
     state_ = std::make_shared<ThreadState>();
     initialize_algorithms();
 }
@@ -175,14 +180,9 @@ WipeService::~WipeService() {
 }
 
 void WipeService::initialize_algorithms() {
-    algorithms_[WipeAlgorithm::ZERO_FILL] = std::make_shared<ZeroFillAlgorithm>();
-    algorithms_[WipeAlgorithm::RANDOM_FILL] = std::make_shared<RandomFillAlgorithm>();
-    algorithms_[WipeAlgorithm::DOD_5220_22_M] = std::make_shared<DoD522022MAlgorithm>();
-    algorithms_[WipeAlgorithm::SCHNEIER] = std::make_shared<SchneierAlgorithm>();
-    algorithms_[WipeAlgorithm::VSITR] = std::make_shared<VSITRAlgorithm>();
-    algorithms_[WipeAlgorithm::GUTMANN] = std::make_shared<GutmannAlgorithm>();
-    algorithms_[WipeAlgorithm::GOST_R_50739_95] = std::make_shared<GOSTAlgorithm>();
-    algorithms_[WipeAlgorithm::ATA_SECURE_ERASE] = std::make_shared<ATASecureEraseAlgorithm>();
+    for (auto algorithm : ALL_WIPE_ALGORITHMS) {
+        algorithms_[algorithm] = make_wipe_algorithm(algorithm);
+    }
 }
 
 auto WipeService::get_algorithm(WipeAlgorithm algo) const -> std::shared_ptr<IWipeAlgorithm> {
@@ -403,7 +403,8 @@ auto WipeService::wipe_disk(const std::string& disk_path, WipeAlgorithm algorith
     std::lock_guard lock(thread_mutex_);
     wipe_thread_ =
         std::thread([disk_path, callback, state = state_, algorithm_ptr = preparation->algorithm,
-                     requires_device_access = preparation->requires_device_access, do_verify]() {
+                     requires_device_access = preparation->requires_device_access, do_verify,
+                     queue_tuner = queue_tuner_, io_cgroup = io_cgroup_]() {
             bool wipe_result = false;
             bool verify_result = true;
             uint64_t device_size = 0;
@@ -413,9 +414,25 @@ auto WipeService::wipe_disk(const std::string& disk_path, WipeAlgorithm algorith
             auto tracked_callback = [tracker, do_verify](const WipeProgress& progress) {
                 WipeProgress p = progress;
                 p.verification_enabled = do_verify;
+                p.rate_multiplier = util::WritePacer::multiplier();
                 tracker->report(p);
             };
 
+            // Streaming writes go faster with a retuned queue; a hardware erase has no use for it.
+            // The original settings come back when the lease goes, whichever way the wipe ends.
+            std::optional<QueueTuner::Lease> queue_lease;
+            if (queue_tuner && !requires_device_access) {
+                if (auto lease = queue_tuner->tune(disk_path)) {
+                    queue_lease.emplace(std::move(*lease));
+                } else {
+                    LOG_DEBUG("WipeService", lease.error().message);
+                }
+            }
+
+            // io.stat counts per disk; its growth over the job is the job's own I/O
+            const auto disk = io_cgroup ? disk_number(disk_path) : std::nullopt;
+            const auto io_before = disk ? io_cgroup->stat(*disk) : std::nullopt;
+
             try {
                 // Execute the wipe operation
                 auto result = execute_wipe_on_device(
@@ -464,9 +481,15 @@ auto WipeService::wipe_disk(const std::string& disk_path, WipeAlgorithm algorith
                 wipe_result = false;
             }
 
+            queue_lease.reset();
+
             // Build and send completion status
             auto final_progress = build_completion_status(wipe_result, do_verify, verify_result,
                                                           state->cancel_requested.load());
+            if (const auto io_after = io_before ? io_cgroup->stat(*disk) : std::nullopt) {
+                final_progress.io = *io_after - *io_before;
+                log_job_io(disk_path, *final_progress.io);
+            }
             tracked_callback(final_progress);
 
             state->operation_in_progress.store(false);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "helper/services/IoCgroup.hpp"
+#include "helper/services/QueueTuner.hpp"
 #include "services/IDiskService.hpp"
 #include "services/IWipeService.hpp"
 
@@ -17,7 +19,13 @@ class IWipeAlgorithm;
 
 class WipeService : public IWipeService {
 public:
-    explicit WipeService(std::shared_ptr<IDiskService> disk_service);
+    /**
+     * @param queue_tuner Retunes the device's block queue while a wipe runs; null to leave it
+     * @param io_cgroup cgroup the wipe's I/O is accounted to; null for no per-job io.stat
+     */
+    explicit WipeService(std::shared_ptr<IDiskService> disk_service,
+                         std::shared_ptr<QueueTuner> queue_tuner = nullptr,
+                         std::shared_ptr<IoCgroup> io_cgroup = nullptr);
     ~WipeService() override;
 
     auto wipe_disk(const std::string& disk_path, WipeAlgorithm algorithm, ProgressCallback callback)
@@ -58,6 +66,8 @@ private:
     };
 
     std::shared_ptr<IDiskService> disk_service_;
+    std::shared_ptr<QueueTuner> queue_tuner_;
+    std::shared_ptr<IoCgroup> io_cgroup_;
     std::shared_ptr<ThreadState> state_;
     std::thread wipe_thread_;
     mutable std::mutex thread_mutex_;  // Protects wipe_thread_ access
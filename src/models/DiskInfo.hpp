@@ -70,6 +70,8 @@ struct DiskInfo {
     std::string mount_point;    ///< Mount point path
     bool is_lvm_pv = false;     ///< Whether device is an LVM Physical Volume or has dm holders
     SmartData smart;            ///< SMART health data
+    /// Discards release blocks to a backing pool (virtual disk, thin LV or LUN)
+    bool is_thin_provisioned = false;
 
     auto operator==(const DiskInfo&) const -> bool = default;
 };
@@ -0,0 +1,364 @@
+/**
+ * @file DiskInventory.hpp
+ * @brief Compact, immutable snapshot of the disk list
+ *
+ * DiskInfo carries five strings per device and is copied whole at every hop.
+ * A DiskInventory stores the same data as columns (struct-of-arrays) over a
+ * single interned string pool: repeated models, filesystems and empty fields
+ * are stored once, and a row costs a few fixed-size integers. Snapshots are
+ * immutable and shared by pointer, so handing one out is O(1).
+ *
+ * Every device carries a stable integer id that outlives individual snapshots
+ * (assigned by DiskService per path and serial), so consumers can key state
+ * on it instead of on strings.
+ */
+
+#pragma once
+
+#include "models/DiskInfo.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Struct-of-arrays disk list with interned strings and stable device ids
+ */
+class DiskInventory {
+public:
+    using DeviceId = uint32_t;
+    using StringId = uint32_t;
+
+    /// String id 0 is always the empty string
+    static constexpr StringId EMPTY_STRING = 0;
+
+    /**
+     * @brief Boolean DiskInfo fields packed into one byte per row
+     */
+    enum Flag : uint8_t {
+        REMOVABLE = 1U << 0U,
+        SSD = 1U << 1U,
+        MOUNTED = 1U << 2U,
+        LVM_PV = 1U << 3U,
+        THIN_PROVISIONED = 1U << 4U,
+    };
+
+    /**
+     * @brief One row in interned form, as produced by the wire decoder
+     */
+    struct Row {
+        DeviceId id = 0;
+        StringId path = EMPTY_STRING;
+        StringId model = EMPTY_STRING;
+        StringId serial = EMPTY_STRING;
+        StringId filesystem = EMPTY_STRING;
+        StringId mount_point = EMPTY_STRING;
+        uint64_t size_bytes = 0;
+        uint8_t flags = 0;
+        SmartData smart;
+    };
+
+    class Builder;
+
+    /**
+     * @brief Read-only view of one row; valid while its inventory is alive
+     */
+    class DiskView {
+    public:
+        DiskView(const DiskInventory& inventory, std::size_t row) noexcept
+            : inventory_(&inventory), row_(row) {}
+
+        [[nodiscard]] auto id() const noexcept -> DeviceId { return inventory_->ids_[row_]; }
+        [[nodiscard]] auto path() const noexcept -> std::string_view {
+            return inventory_->string(inventory_->paths_[row_]);
+        }
+        [[nodiscard]] auto model() const noexcept -> std::string_view {
+            return inventory_->string(inventory_->models_[row_]);
+        }
+        [[nodiscard]] auto serial() const noexcept -> std::string_view {
+            return inventory_->string(inventory_->serials_[row_]);
+        }
+        [[nodiscard]] auto filesystem() const noexcept -> std::string_view {
+            return inventory_->string(inventory_->filesystems_[row_]);
+        }
+        [[nodiscard]] auto mount_point() const noexcept -> std::string_view {
+            return inventory_->string(inventory_->mount_points_[row_]);
+        }
+        [[nodiscard]] auto size_bytes() const noexcept -> uint64_t {
+            return inventory_->sizes_[row_];
+        }
+        [[nodiscard]] auto flags() const noexcept -> uint8_t { return inventory_->flags_[row_]; }
+        [[nodiscard]] auto is_removable() const noexcept -> bool { return has(REMOVABLE); }
+        [[nodiscard]] auto is_ssd() const noexcept -> bool { return has(SSD); }
+        [[nodiscard]] auto is_mounted() const noexcept -> bool { return has(MOUNTED); }
+        [[nodiscard]] auto is_lvm_pv() const noexcept -> bool { return has(LVM_PV); }
+        [[nodiscard]] auto is_thin_provisioned() const noexcept -> bool {
+            return has(THIN_PROVISIONED);
+        }
+
+        /// SMART health status; UNKNOWN when SMART was not read
+        [[nodiscard]] auto smart_status() const noexcept -> SmartData::HealthStatus {
+            const auto* data = smart();
+            return data ? data->status : SmartData::HealthStatus::UNKNOWN;
+        }
+
+        /// Full SMART data, or nullptr when none was collected for this device
+        [[nodiscard]] auto smart() const noexcept -> const SmartData* {
+            const auto slot = inventory_->smart_slots_[row_];
+            return slot == NO_SMART ? nullptr : &inventory_->smart_[slot];
+        }
+
+        /**
+         * @brief Materialize an owning DiskInfo (copies the strings)
+         */
+        [[nodiscard]] auto to_disk_info() const -> DiskInfo {
+            const auto* data = smart();
+            return DiskInfo{.path = std::string{path()},
+                            .model = std::string{model()},
+                            .serial = std::string{serial()},
+                            .size_bytes = size_bytes(),
+                            .is_removable = is_removable(),
+                            .is_ssd = is_ssd(),
+                            .filesystem = std::string{filesystem()},
+                            .is_mounted = is_mounted(),
+                            .mount_point = std::string{mount_point()},
+                            .is_lvm_pv = is_lvm_pv(),
+                            .smart = data ? *data : SmartData{},
+                            .is_thin_provisioned = is_thin_provisioned()};
+        }
+
+    private:
+        [[nodiscard]] auto has(Flag flag) const noexcept -> bool {
+            return (inventory_->flags_[row_] & flag) != 0;
+        }
+
+        const DiskInventory* inventory_;
+        std::size_t row_;
+    };
+
+    DiskInventory() : offsets_{0, 0} {}
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return ids_.size(); }
+    [[nodiscard]] auto empty() const noexcept -> bool { return ids_.empty(); }
+    [[nodiscard]] auto operator[](std::size_t row) const noexcept -> DiskView {
+        return DiskView{*this, row};
+    }
+
+    /// All rows as views, in enumeration order
+    [[nodiscard]] auto rows() const {
+        return std::views::iota(std::size_t{0}, size()) |
+               std::views::transform([this](std::size_t row) { return DiskView{*this, row}; });
+    }
+
+    /**
+     * @brief Row with the given stable id
+     */
+    [[nodiscard]] auto find(DeviceId id) const noexcept -> std::optional<DiskView> {
+        for (std::size_t row = 0; row < ids_.size(); ++row) {
+            if (ids_[row] == id) {
+                return DiskView{*this, row};
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Row for a device path such as "/dev/sda"
+     */
+    [[nodiscard]] auto find_path(std::string_view path) const noexcept
+        -> std::optional<DiskView> {
+        // Compare interned ids: one string search, then an integer column scan
+        const auto id = string_id(path);
+        if (!id) {
+            return std::nullopt;
+        }
+        for (std::size_t row = 0; row < paths_.size(); ++row) {
+            if (paths_[row] == *id) {
+                return DiskView{*this, row};
+            }
+        }
+        return std::nullopt;
+    }
+
+    // ===== String pool =====
+
+    [[nodiscard]] auto string_count() const noexcept -> std::size_t {
+        return offsets_.size() - 1;
+    }
+
+    [[nodiscard]] auto string(StringId id) const noexcept -> std::string_view {
+        return std::string_view{chars_}.substr(offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+
+    [[nodiscard]] auto string_id(std::string_view value) const noexcept
+        -> std::optional<StringId> {
+        for (StringId id = 0; id < string_count(); ++id) {
+            if (string(id) == value) {
+                return id;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Interned row, for serializing alongside the string pool
+     */
+    [[nodiscard]] auto row(std::size_t row) const -> Row {
+        const auto slot = smart_slots_[row];
+        return Row{.id = ids_[row],
+                   .path = paths_[row],
+                   .model = models_[row],
+                   .serial = serials_[row],
+                   .filesystem = filesystems_[row],
+                   .mount_point = mount_points_[row],
+                   .size_bytes = sizes_[row],
+                   .flags = flags_[row],
+                   .smart = slot == NO_SMART ? SmartData{} : smart_[slot]};
+    }
+
+    /**
+     * @brief Materialize the whole list for APIs that still take DiskInfo
+     */
+    [[nodiscard]] auto to_disk_infos() const -> std::vector<DiskInfo> {
+        std::vector<DiskInfo> disks;
+        disks.reserve(size());
+        for (std::size_t row = 0; row < size(); ++row) {
+            disks.push_back(DiskView{*this, row}.to_disk_info());
+        }
+        return disks;
+    }
+
+    /**
+     * @brief Heap and inline bytes held by this snapshot
+     */
+    [[nodiscard]] auto memory_bytes() const noexcept -> std::size_t {
+        return sizeof(*this) + chars_.capacity() + offsets_.capacity() * sizeof(uint32_t) +
+               ids_.capacity() * sizeof(DeviceId) +
+               (paths_.capacity() + models_.capacity() + serials_.capacity() +
+                filesystems_.capacity() + mount_points_.capacity()) *
+                   sizeof(StringId) +
+               sizes_.capacity() * sizeof(uint64_t) + flags_.capacity() +
+               smart_slots_.capacity() * sizeof(uint32_t) + smart_.capacity() * sizeof(SmartData);
+    }
+
+private:
+    static constexpr uint32_t NO_SMART = std::numeric_limits<uint32_t>::max();
+
+    // String pool: string i is chars_[offsets_[i], offsets_[i + 1])
+    std::string chars_;
+    std::vector<uint32_t> offsets_;
+
+    // One entry per row
+    std::vector<DeviceId> ids_;
+    std::vector<StringId> paths_;
+    std::vector<StringId> models_;
+    std::vector<StringId> serials_;
+    std::vector<StringId> filesystems_;
+    std::vector<StringId> mount_points_;
+    std::vector<uint64_t> sizes_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint32_t> smart_slots_;  // Index into smart_, or NO_SMART
+
+    // SMART is only collected for some devices, so it lives in a side table
+    std::vector<SmartData> smart_;
+};
+
+/**
+ * @brief Accumulates rows and interns their strings
+ */
+class DiskInventory::Builder {
+public:
+    explicit Builder(std::size_t expected_rows = 0) {
+        interned_.emplace(std::string{}, EMPTY_STRING);
+        inventory_.ids_.reserve(expected_rows);
+        inventory_.paths_.reserve(expected_rows);
+        inventory_.models_.reserve(expected_rows);
+        inventory_.serials_.reserve(expected_rows);
+        inventory_.filesystems_.reserve(expected_rows);
+        inventory_.mount_points_.reserve(expected_rows);
+        inventory_.sizes_.reserve(expected_rows);
+        inventory_.flags_.reserve(expected_rows);
+        inventory_.smart_slots_.reserve(expected_rows);
+    }
+
+    /**
+     * @brief Id of a string in the pool, adding it on first use
+     */
+    auto intern(std::string_view value) -> StringId {
+        auto [it, inserted] = interned_.try_emplace(std::string{value}, 0);
+        if (inserted) {
+            it->second = static_cast<StringId>(inventory_.string_count());
+            inventory_.chars_.append(value);
+            inventory_.offsets_.push_back(static_cast<uint32_t>(inventory_.chars_.size()));
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Append a row whose strings are already interned in this builder
+     */
+    void add(const Row& row) {
+        auto& inv = inventory_;
+        inv.ids_.push_back(row.id);
+        inv.paths_.push_back(row.path);
+        inv.models_.push_back(row.model);
+        inv.serials_.push_back(row.serial);
+        inv.filesystems_.push_back(row.filesystem);
+        inv.mount_points_.push_back(row.mount_point);
+        inv.sizes_.push_back(row.size_bytes);
+        inv.flags_.push_back(row.flags);
+        if (row.smart == SmartData{}) {
+            inv.smart_slots_.push_back(NO_SMART);
+        } else {
+            inv.smart_slots_.push_back(static_cast<uint32_t>(inv.smart_.size()));
+            inv.smart_.push_back(row.smart);
+        }
+    }
+
+    /**
+     * @brief Append a DiskInfo under a stable id
+     */
+    void add(DeviceId id, const DiskInfo& disk) {
+        add(Row{.id = id,
+                .path = intern(disk.path),
+                .model = intern(disk.model),
+                .serial = intern(disk.serial),
+                .filesystem = intern(disk.filesystem),
+                .mount_point = intern(disk.mount_point),
+                .size_bytes = disk.size_bytes,
+                .flags = flags_of(disk),
+                .smart = disk.smart});
+    }
+
+    /**
+     * @brief Finish the snapshot; the builder is left empty
+     */
+    [[nodiscard]] auto build() && -> DiskInventory {
+        interned_.clear();
+        inventory_.chars_.shrink_to_fit();
+        inventory_.offsets_.shrink_to_fit();
+        inventory_.smart_.shrink_to_fit();
+        return std::move(inventory_);
+    }
+
+    [[nodiscard]] static auto flags_of(const DiskInfo& disk) noexcept -> uint8_t {
+        unsigned flags = 0;
+        flags |= disk.is_removable ? unsigned{REMOVABLE} : 0U;
+        flags |= disk.is_ssd ? unsigned{SSD} : 0U;
+        flags |= disk.is_mounted ? unsigned{MOUNTED} : 0U;
+        flags |= disk.is_lvm_pv ? unsigned{LVM_PV} : 0U;
+        flags |= disk.is_thin_provisioned ? unsigned{THIN_PROVISIONED} : 0U;
+        return static_cast<uint8_t>(flags);
+    }
+
+private:
+    DiskInventory inventory_;
+    std::unordered_map<std::string, StringId> interned_;
+};
@@ -7,21 +7,57 @@
 
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 /**
  * @enum WipeAlgorithm
  * @brief Available disk wiping algorithms
  */
 enum class WipeAlgorithm {
-    ZERO_FILL,        ///< Single pass with zeros
-    RANDOM_FILL,      ///< Single pass with random data
-    DOD_5220_22_M,    ///< DoD 5220.22-M 3-pass standard
-    GUTMANN,          ///< Gutmann 35-pass method
-    SCHNEIER,         ///< Bruce Schneier 7-pass method
-    VSITR,            ///< German VSITR 7-pass standard
-    GOST_R_50739_95,  ///< Russian GOST R 50739-95 2-pass standard
-    ATA_SECURE_ERASE  ///< Hardware secure erase for SSDs
+    ZERO_FILL,                  ///< Single pass with zeros
+    RANDOM_FILL,                ///< Single pass with random data
+    DOD_5220_22_M,              ///< DoD 5220.22-M 3-pass standard
+    GUTMANN,                    ///< Gutmann 35-pass method
+    SCHNEIER,                   ///< Bruce Schneier 7-pass method
+    VSITR,                      ///< German VSITR 7-pass standard
+    GOST_R_50739_95,            ///< Russian GOST R 50739-95 2-pass standard
+    ATA_SECURE_ERASE,           ///< Hardware secure erase for SSDs
+    THIN_DISCARD,               ///< Discard plus write-zeroes for thin-provisioned storage
+    DOD_5220_22_M_ECE,          ///< DoD 5220.22-M ECE 7-pass, with complement-of-random passes
+    RCMP_TSSIT_OPS_II,          ///< RCMP TSSIT OPS-II 7-pass, alternating complements then random
+    LBA_TAGGED,                 ///< 1 pass of blocks tagged with their address, job id and checksum
+    LBA_TAGGED_ZERO,            ///< LBA-tagged pass, checked on readback, then zeros
+    LUKS_CRYPTO_SHRED,          ///< Destroy LUKS headers and keyslots, leaving ciphertext only
+    LUKS_CRYPTO_SHRED_OVERWRITE ///< LUKS crypto-shred, then a random pass at idle priority
+};
+
+/**
+ * @struct IoStat
+ * @brief Block-layer I/O on one disk, from the helper cgroup's io.stat
+ *
+ * The helper reads it cumulatively; the difference of two readings is the
+ * I/O issued in between.
+ */
+struct IoStat {
+    uint64_t read_bytes = 0;
+    uint64_t write_bytes = 0;
+    uint64_t read_ios = 0;
+    uint64_t write_ios = 0;
+    uint64_t discard_bytes = 0;
+    uint64_t discard_ios = 0;
+
+    auto operator==(const IoStat&) const -> bool = default;
+
+    auto operator-(const IoStat& earlier) const -> IoStat {
+        return {.read_bytes = read_bytes - earlier.read_bytes,
+                .write_bytes = write_bytes - earlier.write_bytes,
+                .read_ios = read_ios - earlier.read_ios,
+                .write_ios = write_ios - earlier.write_ios,
+                .discard_bytes = discard_bytes - earlier.discard_bytes,
+                .discard_ios = discard_ios - earlier.discard_ios};
+    }
 };
 
 /**
@@ -48,6 +84,11 @@ struct WipeProgress {
     double verification_percentage = 0.0;   ///< Verification progress (0-100)
     uint64_t verification_mismatches = 0;   ///< Number of bytes that didn't match
 
+    double rate_multiplier = 1.0;  ///< Share of the full write rate allowed under host pressure
+
+    /// What the job issued to the disk, on the completion update; unset without io.stat
+    std::optional<IoStat> io = std::nullopt;
+
     auto operator==(const WipeProgress&) const -> bool = default;
 };
 
@@ -55,3 +96,23 @@ struct WipeProgress {
  * @brief Callback type for progress reporting
  */
 using ProgressCallback = std::function<void(const WipeProgress&)>;
+
+/**
+ * @struct ShredProgress
+ * @brief Progress of one file in a shred operation
+ *
+ * Warnings are attached to the completion update and list the reasons an
+ * in-place overwrite may not have reached every copy of the file's data.
+ */
+struct ShredProgress {
+    std::string path;
+    WipeProgress progress;
+    std::vector<std::string> warnings;
+
+    auto operator==(const ShredProgress&) const -> bool = default;
+};
+
+/**
+ * @brief Callback type for per-file shred progress
+ */
+using ShredCallback = std::function<void(const ShredProgress&)>;
@@ -5,6 +5,8 @@
 
 #include "services/DBusClient.hpp"
 
+#include "algorithms/AlgorithmFactory.hpp"
+#include "models/DiskInventory.hpp"
 #include "util/Logger.hpp"
 
 #include <format>
@@ -15,6 +17,173 @@ constexpr auto DBUS_NAME = "su.kidoz.storage_wiper.Helper";
 constexpr auto DBUS_PATH = "/su/kidoz/storage_wiper/Helper";
 constexpr auto DBUS_INTERFACE = "su.kidoz.storage_wiper.Helper";
 constexpr auto DBUS_TIMEOUT_MS = 30'000;  // 30 second timeout for polkit dialogs
+
+auto parse_shred_progress(GVariant* parameters) -> ShredProgress {
+    const gchar* path = nullptr;
+    const gchar* status = nullptr;
+    const gchar* error_message = nullptr;
+    gboolean is_complete = FALSE;
+    gboolean has_error = FALSE;
+    guint64 bytes_written = 0;
+    guint64 total_bytes = 0;
+    GVariantIter* warnings = nullptr;
+
+    ShredProgress update;
+    auto& progress = update.progress;
+    g_variant_get(parameters, "(&sdii&sbb&sttas)", &path, &progress.percentage,
+                  &progress.current_pass, &progress.total_passes, &status, &is_complete,
+                  &has_error, &error_message, &bytes_written, &total_bytes, &warnings);
+
+    update.path = path ? path : "";
+    progress.status = status ? status : "";
+    progress.is_complete = is_complete != FALSE;
+    progress.has_error = has_error != FALSE;
+    progress.error_message = error_message ? error_message : "";
+    progress.bytes_written = bytes_written;
+    progress.total_bytes = total_bytes;
+
+    const gchar* warning = nullptr;
+    while (g_variant_iter_next(warnings, "&s", &warning)) {
+        update.warnings.emplace_back(warning);
+    }
+    g_variant_iter_free(warnings);
+    return update;
+}
+
+// ===== Disk list replies =====
+
+struct DisksRequest {
+    GDBusProxy* proxy;  // Reference held until the request finishes
+    std::function<void(std::expected<std::vector<DiskInfo>, util::Error>)> callback;
+};
+
+void finish_disks_request(DisksRequest* request,
+                          std::expected<std::vector<DiskInfo>, util::Error> result) {
+    request->callback(std::move(result));
+    g_object_unref(request->proxy);
+    delete request;
+}
+
+/**
+ * @brief Decode a GetInventory reply: (as a(uuuuuutyy))
+ *
+ * Strings are re-interned through a builder, so out-of-range or duplicate
+ * table entries from the wire cannot produce dangling ids.
+ */
+auto parse_inventory_reply(GVariant* result) -> DiskInventory {
+    GVariant* strings = g_variant_get_child_value(result, 0);
+    GVariant* rows = g_variant_get_child_value(result, 1);
+
+    DiskInventory::Builder builder{g_variant_n_children(rows)};
+    std::vector<DiskInventory::StringId> remap;
+    remap.reserve(g_variant_n_children(strings));
+
+    GVariantIter iter;
+    const gchar* value = nullptr;
+    g_variant_iter_init(&iter, strings);
+    while (g_variant_iter_next(&iter, "&s", &value)) {
+        remap.push_back(builder.intern(value));
+    }
+    auto string_at = [&remap](guint32 index) {
+        return index < remap.size() ? remap[index] : DiskInventory::EMPTY_STRING;
+    };
+
+    guint32 id = 0;
+    guint32 path = 0;
+    guint32 model = 0;
+    guint32 serial = 0;
+    guint32 filesystem = 0;
+    guint32 mount_point = 0;
+    guint64 size_bytes = 0;
+    guchar flags = 0;
+    guchar smart_status = 0;
+
+    g_variant_iter_init(&iter, rows);
+    while (g_variant_iter_next(&iter, "(uuuuuutyy)", &id, &path, &model, &serial, &filesystem,
+                               &mount_point, &size_bytes, &flags, &smart_status)) {
+        if (string_at(path) == DiskInventory::EMPTY_STRING) {
+            continue;
+        }
+        SmartData smart;
+        smart.status = static_cast<SmartData::HealthStatus>(smart_status);
+        smart.available = (smart_status != 0);
+        builder.add(DiskInventory::Row{.id = id,
+                                       .path = string_at(path),
+                                       .model = string_at(model),
+                                       .serial = string_at(serial),
+                                       .filesystem = string_at(filesystem),
+                                       .mount_point = string_at(mount_point),
+                                       .size_bytes = size_bytes,
+                                       .flags = flags,
+                                       .smart = smart});
+    }
+
+    g_variant_unref(rows);
+    g_variant_unref(strings);
+    return std::move(builder).build();
+}
+
+/**
+ * @brief Decode a GetDisks reply: a(sssxbbsbsub)
+ */
+auto parse_disks_reply(GVariant* result) -> std::vector<DiskInfo> {
+    std::vector<DiskInfo> disks;
+    GVariant* array = g_variant_get_child_value(result, 0);
+    GVariantIter iter;
+    g_variant_iter_init(&iter, array);
+
+    const gchar* path = nullptr;
+    const gchar* model = nullptr;
+    const gchar* serial = nullptr;
+    gint64 size_bytes = 0;
+    gboolean is_removable = FALSE;
+    gboolean is_ssd = FALSE;
+    const gchar* filesystem = nullptr;
+    gboolean is_mounted = FALSE;
+    const gchar* mount_point = nullptr;
+    guint32 smart_status = 0;
+    gboolean is_thin = FALSE;
+
+    while (g_variant_iter_next(&iter, "(&s&s&sxbb&sb&sub)", &path, &model, &serial, &size_bytes,
+                               &is_removable, &is_ssd, &filesystem, &is_mounted, &mount_point,
+                               &smart_status, &is_thin)) {
+        if (path) {
+            SmartData smart;
+            smart.status = static_cast<SmartData::HealthStatus>(smart_status);
+            smart.available = (smart_status != 0);
+
+            disks.push_back(DiskInfo{.path = path,
+                                     .model = model ? model : "",
+                                     .serial = serial ? serial : "",
+                                     .size_bytes = static_cast<uint64_t>(size_bytes),
+                                     .is_removable = is_removable != FALSE,
+                                     .is_ssd = is_ssd != FALSE,
+                                     .filesystem = filesystem ? filesystem : "",
+                                     .is_mounted = is_mounted != FALSE,
+                                     .mount_point = mount_point ? mount_point : "",
+                                     .is_lvm_pv = false,
+                                     .smart = smart,
+                                     .is_thin_provisioned = is_thin != FALSE});
+        }
+    }
+    g_variant_unref(array);
+    return disks;
+}
+
+void on_get_disks_reply(GObject* source_object, GAsyncResult* res, gpointer user_data) {
+    auto* request = static_cast<DisksRequest*>(user_data);
+    GError* error = nullptr;
+    GVariant* result = g_dbus_proxy_call_finish(G_DBUS_PROXY(source_object), res, &error);
+    if (!result) {
+        finish_disks_request(
+            request, std::unexpected(util::Error{error ? error->message : "Unknown error"}));
+        g_clear_error(&error);
+        return;
+    }
+    auto disks = parse_disks_reply(result);
+    g_variant_unref(result);
+    finish_disks_request(request, std::move(disks));
+}
 }  // namespace
 
 DBusClient::DBusClient() = default;
@@ -170,8 +339,10 @@ auto DBusClient::attempt_reconnect() -> bool {
     reset_reconnect_state();
     set_state(ConnectionState::CONNECTED, "");
 
-    // Reload algorithms since we have a fresh connection
+    // Refresh the algorithm cache in the background; the getters fall back
+    // to the compiled-in algorithms until the reply arrives
     algorithms_loaded_ = false;
+    load_algorithms_async([] {});
 
     return true;
 }
@@ -228,8 +399,10 @@ void DBusClient::on_name_appeared(GDBusConnection* /*connection*/, const gchar*
         current_state = self->connection_state_;
     }
 
-    // If we're not connected, try to connect now
-    if (current_state != ConnectionState::CONNECTED) {
+    // If we're not connected, try to connect now. A connect_async() in
+    // flight finishes on its own.
+    if (current_state != ConnectionState::CONNECTED &&
+        current_state != ConnectionState::CONNECTING) {
         // Cancel any pending reconnect timer - service is available now
         if (self->reconnect_timer_id_ != 0) {
             g_source_remove(self->reconnect_timer_id_);
@@ -270,6 +443,13 @@ void DBusClient::cleanup() {
     // Stop reconnection attempts
     reset_reconnect_state();
 
+    // Abandon an asynchronous connect; its callbacks see the cancellation
+    if (connect_cancellable_) {
+        g_cancellable_cancel(connect_cancellable_);
+        g_object_unref(connect_cancellable_);
+        connect_cancellable_ = nullptr;
+    }
+
     // Stop name watching
     stop_name_watching();
 
@@ -337,6 +517,86 @@ auto DBusClient::connect() -> bool {
     return true;
 }
 
+void DBusClient::connect_async() {
+    set_state(ConnectionState::CONNECTING, "");
+
+    if (connect_cancellable_) {
+        g_cancellable_cancel(connect_cancellable_);
+        g_object_unref(connect_cancellable_);
+    }
+    connect_cancellable_ = g_cancellable_new();
+
+    g_bus_get(G_BUS_TYPE_SYSTEM, connect_cancellable_, on_bus_ready, this);
+}
+
+void DBusClient::on_bus_ready(GObject* /*source_object*/, GAsyncResult* res,
+                              gpointer user_data) {
+    GError* error = nullptr;
+    GDBusConnection* connection = g_bus_get_finish(res, &error);
+
+    if (!connection) {
+        // On cancellation the client may already be gone
+        if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            auto* self = static_cast<DBusClient*>(user_data);
+            std::string msg = error ? error->message : "unknown";
+            LOG_ERROR("DBusClient", std::format("Failed to connect to system bus: {}", msg));
+            g_object_unref(self->connect_cancellable_);
+            self->connect_cancellable_ = nullptr;
+            self->set_state(ConnectionState::DISCONNECTED, msg);
+            self->schedule_reconnect();
+        }
+        g_clear_error(&error);
+        return;
+    }
+
+    auto* self = static_cast<DBusClient*>(user_data);
+    self->connection_ = connection;
+
+    // Start watching for the helper service name
+    self->start_name_watching();
+
+    // The helper exposes no properties, so skip the GetAll round trip
+    g_dbus_proxy_new(connection, G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES,
+                     nullptr,  // interface info
+                     DBUS_NAME, DBUS_PATH, DBUS_INTERFACE, self->connect_cancellable_,
+                     on_proxy_ready, self);
+}
+
+void DBusClient::on_proxy_ready(GObject* /*source_object*/, GAsyncResult* res,
+                                gpointer user_data) {
+    GError* error = nullptr;
+    GDBusProxy* proxy = g_dbus_proxy_new_finish(res, &error);
+
+    if (!proxy && g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_clear_error(&error);
+        return;
+    }
+
+    auto* self = static_cast<DBusClient*>(user_data);
+    g_object_unref(self->connect_cancellable_);
+    self->connect_cancellable_ = nullptr;
+
+    if (!proxy) {
+        std::string msg = error ? error->message : "unknown";
+        LOG_ERROR("DBusClient", std::format("Failed to create D-Bus proxy: {}", msg));
+        g_clear_error(&error);
+        // Keep connection and name watcher for reconnection
+        self->set_state(ConnectionState::DISCONNECTED, msg);
+        self->schedule_reconnect();
+        return;
+    }
+
+    {
+        std::lock_guard lock(self->proxy_mutex_);
+        self->proxy_ = proxy;
+    }
+
+    // Set up signal handler for WipeProgress
+    self->setup_signal_handler();
+
+    self->set_state(ConnectionState::CONNECTED, "");
+}
+
 auto DBusClient::is_connected() const -> bool {
     std::lock_guard lock(proxy_mutex_);
     return proxy_ != nullptr;
@@ -346,8 +606,11 @@ void DBusClient::setup_signal_handler() {
     if (!connection_)
         return;
 
+    // All interface signals; on_signal_received dispatches by name
     signal_subscription_id_ = g_dbus_connection_signal_subscribe(
-        connection_, DBUS_NAME, DBUS_INTERFACE, "WipeProgress", DBUS_PATH,
+        connection_, DBUS_NAME, DBUS_INTERFACE,
+        nullptr,  // member
+        DBUS_PATH,
         nullptr,  // arg0
         G_DBUS_SIGNAL_FLAGS_NONE, on_signal_received, this,
         nullptr   // user_data_free_func
@@ -360,6 +623,15 @@ void DBusClient::on_signal_received(GDBusConnection* /*connection*/, const gchar
                                     gpointer user_data) {
     auto* self = static_cast<DBusClient*>(user_data);
 
+    if (g_strcmp0(signal_name, "ShredProgress") == 0) {
+        auto update = parse_shred_progress(parameters);
+        std::lock_guard lock(self->callback_mutex_);
+        if (self->shred_callback_) {
+            self->shred_callback_(update);
+        }
+        return;
+    }
+
     if (g_strcmp0(signal_name, "WipeProgress") != 0)
         return;
 
@@ -380,12 +652,26 @@ void DBusClient::on_signal_received(GDBusConnection* /*connection*/, const gchar
     gboolean verification_in_progress = FALSE;
     gboolean verification_passed = FALSE;
     gdouble verification_percentage = 0.0;
-
-    g_variant_get(parameters, "(&sdii&sbb&stttxbbbd)", &device_path, &percentage, &current_pass,
-                  &total_passes, &status, &is_complete, &has_error, &error_message, &bytes_written,
-                  &total_bytes, &speed_bytes_per_sec, &estimated_seconds_remaining,
+    gdouble rate_multiplier = 1.0;
+    gboolean io_accounted = FALSE;
+    guint64 io_read_bytes = 0;
+    guint64 io_write_bytes = 0;
+    guint64 io_discard_bytes = 0;
+
+    g_variant_get(parameters, "(&sdii&sbb&stttxbbbddbttt)", &device_path, &percentage,
+                  &current_pass, &total_passes, &status, &is_complete, &has_error, &error_message,
+                  &bytes_written, &total_bytes, &speed_bytes_per_sec, &estimated_seconds_remaining,
                   &verification_enabled, &verification_in_progress, &verification_passed,
-                  &verification_percentage);
+                  &verification_percentage, &rate_multiplier, &io_accounted, &io_read_bytes,
+                  &io_write_bytes, &io_discard_bytes);
+
+    // The signal carries byte counts only; request counts stay zero
+    std::optional<IoStat> io;
+    if (io_accounted != FALSE) {
+        io = IoStat{.read_bytes = io_read_bytes,
+                    .write_bytes = io_write_bytes,
+                    .discard_bytes = io_discard_bytes};
+    }
 
     WipeProgress progress{.bytes_written = bytes_written,
                           .total_bytes = total_bytes,
@@ -402,7 +688,9 @@ void DBusClient::on_signal_received(GDBusConnection* /*connection*/, const gchar
                           .verification_in_progress = verification_in_progress != FALSE,
                           .verification_passed = verification_passed != FALSE,
                           .verification_percentage = verification_percentage,
-                          .verification_mismatches = 0};
+                          .verification_mismatches = 0,
+                          .rate_multiplier = rate_multiplier,
+                          .io = io};
 
     // Call the callback
     std::lock_guard lock(self->callback_mutex_);
@@ -424,73 +712,36 @@ void DBusClient::get_available_disks(
         g_object_ref(proxy_copy);  // Increment ref count for the async operation
     }
 
-    // Move callback to heap to pass to C callback
-    auto* cb_ptr =
-        new std::function<void(std::expected<std::vector<DiskInfo>, util::Error>)>(
-            std::move(callback));
+    auto* request = new DisksRequest{.proxy = proxy_copy, .callback = std::move(callback)};
 
     g_dbus_proxy_call(
-        proxy_copy, "GetDisks", nullptr, G_DBUS_CALL_FLAGS_NONE, DBUS_TIMEOUT_MS, nullptr,
+        proxy_copy, "GetInventory", nullptr, G_DBUS_CALL_FLAGS_NONE, DBUS_TIMEOUT_MS, nullptr,
         [](GObject* source_object, GAsyncResult* res, gpointer user_data) {
-            auto* proxy = G_DBUS_PROXY(source_object);
-            auto* cb =
-                static_cast<std::function<void(std::expected<std::vector<DiskInfo>, util::Error>)>*>(
-                    user_data);
-
+            auto* req = static_cast<DisksRequest*>(user_data);
             GError* error = nullptr;
-            GVariant* result = g_dbus_proxy_call_finish(proxy, res, &error);
+            GVariant* result = g_dbus_proxy_call_finish(G_DBUS_PROXY(source_object), res, &error);
 
-            if (!result) {
-                (*cb)(std::unexpected(util::Error{error ? error->message : "Unknown error"}));
+            // Older helpers only implement GetDisks
+            if (!result && g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD)) {
                 g_clear_error(&error);
-            } else {
-                std::vector<DiskInfo> disks;
-                GVariant* array = g_variant_get_child_value(result, 0);
-                GVariantIter iter;
-                g_variant_iter_init(&iter, array);
-
-                const gchar* path = nullptr;
-                const gchar* model = nullptr;
-                const gchar* serial = nullptr;
-                gint64 size_bytes = 0;
-                gboolean is_removable = FALSE;
-                gboolean is_ssd = FALSE;
-                const gchar* filesystem = nullptr;
-                gboolean is_mounted = FALSE;
-                const gchar* mount_point = nullptr;
-                guint32 smart_status = 0;
-
-                while (g_variant_iter_next(&iter, "(&s&s&sxbb&sb&su)", &path, &model, &serial,
-                                           &size_bytes, &is_removable, &is_ssd, &filesystem,
-                                           &is_mounted, &mount_point, &smart_status)) {
-                    if (path) {
-                        SmartData smart;
-                        smart.status = static_cast<SmartData::HealthStatus>(smart_status);
-                        smart.available = (smart_status != 0);
-
-                        disks.push_back(DiskInfo{.path = path,
-                                                 .model = model ? model : "",
-                                                 .serial = serial ? serial : "",
-                                                 .size_bytes = static_cast<uint64_t>(size_bytes),
-                                                 .is_removable = is_removable != FALSE,
-                                                 .is_ssd = is_ssd != FALSE,
-                                                 .filesystem = filesystem ? filesystem : "",
-                                                 .is_mounted = is_mounted != FALSE,
-                                                 .mount_point = mount_point ? mount_point : "",
-                                                 .is_lvm_pv = false,
-                                                 .smart = smart});
-                    }
-                }
-                g_variant_unref(array);
-                g_variant_unref(result);
+                g_dbus_proxy_call(req->proxy, "GetDisks", nullptr, G_DBUS_CALL_FLAGS_NONE,
+                                  DBUS_TIMEOUT_MS, nullptr, on_get_disks_reply, req);
+                return;
+            }
 
-                (*cb)(disks);
+            if (!result) {
+                finish_disks_request(
+                    req, std::unexpected(util::Error{error ? error->message : "Unknown error"}));
+                g_clear_error(&error);
+                return;
             }
 
-            delete cb;
-            g_object_unref(proxy);  // Release the reference taken before call
+            // The GUI and CLI consume DiskInfo; materialize once, at the edge
+            auto disks = parse_inventory_reply(result).to_disk_infos();
+            g_variant_unref(result);
+            finish_disks_request(req, std::move(disks));
         },
-        cb_ptr);
+        request);
 }
 
 auto DBusClient::get_available_disks_blocking()
@@ -619,25 +870,51 @@ auto DBusClient::unmount_disk(const std::string& path) -> std::expected<void, ut
     return {};
 }
 
-void DBusClient::load_algorithms() {
+void DBusClient::load_algorithms_async(std::function<void()> on_loaded) {
     GDBusProxy* proxy_copy = nullptr;
     {
         std::lock_guard lock(proxy_mutex_);
-        if (algorithms_loaded_ || !proxy_)
+        if (algorithms_loaded_ || !proxy_) {
+            on_loaded();
             return;
+        }
         proxy_copy = proxy_;
+        g_object_ref(proxy_copy);  // Increment ref count for the async operation
     }
 
-    GError* error = nullptr;
-    GVariant* result =
-        g_dbus_proxy_call_sync(proxy_copy, "GetAlgorithms", nullptr, G_DBUS_CALL_FLAGS_NONE,
-                               DBUS_TIMEOUT_MS, nullptr, &error);
+    // The client outlives the main loop, so the callback may use it directly
+    struct Request {
+        DBusClient* self;
+        std::function<void()> on_loaded;
+    };
+    auto* request = new Request{.self = this, .on_loaded = std::move(on_loaded)};
 
-    if (!result) {
-        g_clear_error(&error);
-        return;
-    }
+    g_dbus_proxy_call(
+        proxy_copy, "GetAlgorithms", nullptr, G_DBUS_CALL_FLAGS_NONE, DBUS_TIMEOUT_MS, nullptr,
+        [](GObject* source_object, GAsyncResult* res, gpointer user_data) {
+            auto* proxy = G_DBUS_PROXY(source_object);
+            auto* req = static_cast<Request*>(user_data);
 
+            GError* error = nullptr;
+            GVariant* result = g_dbus_proxy_call_finish(proxy, res, &error);
+            if (result) {
+                req->self->store_algorithms(result);
+                g_variant_unref(result);
+            } else {
+                LOG_WARNING("DBusClient",
+                            std::format("GetAlgorithms failed: {}",
+                                        error ? error->message : "unknown"));
+                g_clear_error(&error);
+            }
+
+            req->on_loaded();
+            delete req;
+            g_object_unref(proxy);  // Release the reference taken before call
+        },
+        request);
+}
+
+void DBusClient::store_algorithms(GVariant* result) {
     GVariant* array = g_variant_get_child_value(result, 0);
     GVariantIter iter;
     g_variant_iter_init(&iter, array);
@@ -648,16 +925,30 @@ void DBusClient::load_algorithms() {
     gint pass_count = 0;
 
     while (g_variant_iter_next(&iter, "(u&s&si)", &id, &name, &description, &pass_count)) {
-        algorithms_.emplace(id, AlgorithmInfo{.name = name ? name : "",
-                                              .description = description ? description : "",
-                                              .pass_count = pass_count});
+        algorithms_.insert_or_assign(
+            id, AlgorithmInfo{.name = name ? name : "",
+                              .description = description ? description : "",
+                              .pass_count = pass_count});
     }
 
     g_variant_unref(array);
-    g_variant_unref(result);
     algorithms_loaded_ = true;
 }
 
+auto DBusClient::find_algorithm(WipeAlgorithm algo) const -> AlgorithmInfo {
+    if (auto it = algorithms_.find(static_cast<uint32_t>(algo)); it != algorithms_.end()) {
+        return it->second;
+    }
+
+    // Not fetched from the helper (yet): the GUI ships the same algorithms
+    if (auto algorithm = make_wipe_algorithm(algo)) {
+        return AlgorithmInfo{.name = algorithm->get_name(),
+                             .description = algorithm->get_description(),
+                             .pass_count = algorithm->get_pass_count()};
+    }
+    return AlgorithmInfo{.name = "Unknown", .description = "", .pass_count = 1};
+}
+
 auto DBusClient::wipe_disk(const std::string& disk_path, WipeAlgorithm algorithm,
                            ProgressCallback callback) -> bool {
     return wipe_disk(disk_path, algorithm, std::move(callback), false);
@@ -706,40 +997,23 @@ auto DBusClient::wipe_disk(const std::string& disk_path, WipeAlgorithm algorithm
     return started != FALSE;
 }
 
+// Served from the cache filled by load_algorithms_async, or from the
+// compiled-in algorithms, so these never block on a D-Bus round trip
 auto DBusClient::get_algorithm_name(WipeAlgorithm algo) -> std::string {
-    load_algorithms();
-    if (auto it = algorithms_.find(static_cast<uint32_t>(algo)); it != algorithms_.end()) {
-        return it->second.name;
-    }
-    return "Unknown";
+    return find_algorithm(algo).name;
 }
 
 auto DBusClient::get_algorithm_description(WipeAlgorithm algo) -> std::string {
-    load_algorithms();
-    if (auto it = algorithms_.find(static_cast<uint32_t>(algo)); it != algorithms_.end()) {
-        return it->second.description;
-    }
-    return "";
+    return find_algorithm(algo).description;
 }
 
 auto DBusClient::get_pass_count(WipeAlgorithm algo) -> int {
-    load_algorithms();
-    if (auto it = algorithms_.find(static_cast<uint32_t>(algo)); it != algorithms_.end()) {
-        return it->second.pass_count;
-    }
-    return 1;
+    return find_algorithm(algo).pass_count;
 }
 
 auto DBusClient::is_ssd_compatible(WipeAlgorithm algo) -> bool {
-    // Multi-pass algorithms are less effective on SSDs
-    switch (algo) {
-        case WipeAlgorithm::ZERO_FILL:
-        case WipeAlgorithm::RANDOM_FILL:
-        case WipeAlgorithm::ATA_SECURE_ERASE:
-            return true;
-        default:
-            return false;
-    }
+    const auto algorithm = make_wipe_algorithm(algo);
+    return algorithm && algorithm->is_ssd_compatible();
 }
 
 auto DBusClient::cancel_current_operation() -> bool {
@@ -768,6 +1042,97 @@ auto DBusClient::cancel_current_operation() -> bool {
     return cancelled != FALSE;
 }
 
+auto DBusClient::shred_files(const std::vector<std::string>& paths, WipeAlgorithm algorithm,
+                             bool discard, ShredCallback callback)
+    -> std::expected<void, util::Error> {
+    GDBusProxy* proxy_copy = nullptr;
+    {
+        std::lock_guard lock(proxy_mutex_);
+        if (!proxy_)
+            return std::unexpected(util::Error{"Not connected"});
+        proxy_copy = proxy_;
+    }
+
+    {
+        std::lock_guard lock(callback_mutex_);
+        shred_callback_ = std::move(callback);
+    }
+
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
+    for (const auto& path : paths) {
+        g_variant_builder_add(&builder, "s", path.c_str());
+    }
+
+    GError* error = nullptr;
+    GVariant* result = g_dbus_proxy_call_sync(
+        proxy_copy, "ShredFiles",
+        g_variant_new("(asub)", &builder, static_cast<guint32>(algorithm),
+                      discard ? TRUE : FALSE),
+        G_DBUS_CALL_FLAGS_NONE, DBUS_TIMEOUT_MS, nullptr, &error);
+
+    if (!result) {
+        std::string message = error ? error->message : "unknown";
+        g_clear_error(&error);
+        LOG_ERROR("DBusClient", std::format("ShredFiles failed: {}", message));
+        return std::unexpected(util::Error{message});
+    }
+
+    gboolean started = FALSE;
+    const gchar* error_message = nullptr;
+    g_variant_get(result, "(b&s)", &started, &error_message);
+    std::string message = error_message ? error_message : "";
+    g_variant_unref(result);
+
+    if (!started) {
+        return std::unexpected(util::Error{message.empty() ? "Shred not started" : message});
+    }
+    return {};
+}
+
+auto DBusClient::wipe_free_space(const std::string& directory, WipeAlgorithm algorithm,
+                                 uint64_t reserve_bytes, bool trim, ProgressCallback callback)
+    -> std::expected<void, util::Error> {
+    GDBusProxy* proxy_copy = nullptr;
+    {
+        std::lock_guard lock(proxy_mutex_);
+        if (!proxy_)
+            return std::unexpected(util::Error{"Not connected"});
+        proxy_copy = proxy_;
+    }
+
+    {
+        std::lock_guard lock(callback_mutex_);
+        progress_callback_ = std::move(callback);
+    }
+
+    GError* error = nullptr;
+    GVariant* result = g_dbus_proxy_call_sync(
+        proxy_copy, "WipeFreeSpace",
+        g_variant_new("(sutb)", directory.c_str(), static_cast<guint32>(algorithm),
+                      static_cast<guint64>(reserve_bytes), trim ? TRUE : FALSE),
+        G_DBUS_CALL_FLAGS_NONE, DBUS_TIMEOUT_MS, nullptr, &error);
+
+    if (!result) {
+        std::string message = error ? error->message : "unknown";
+        g_clear_error(&error);
+        LOG_ERROR("DBusClient", std::format("WipeFreeSpace failed: {}", message));
+        return std::unexpected(util::Error{message});
+    }
+
+    gboolean started = FALSE;
+    const gchar* error_message = nullptr;
+    g_variant_get(result, "(b&s)", &started, &error_message);
+    std::string message = error_message ? error_message : "";
+    g_variant_unref(result);
+
+    if (!started) {
+        return std::unexpected(
+            util::Error{message.empty() ? "Free-space wipe not started" : message});
+    }
+    return {};
+}
+
 auto DBusClient::get_smart_data(const std::string& path) -> SmartData {
     SmartData smart;
 
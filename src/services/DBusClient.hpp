@@ -59,6 +59,24 @@ public:
      */
     [[nodiscard]] auto connect() -> bool;
 
+    /**
+     * @brief Connect to the helper without blocking the caller
+     *
+     * Obtains the system bus and creates the proxy asynchronously. The outcome
+     * is reported through the connection state callback; on failure automatic
+     * reconnection is scheduled, as with connect(). Must be called from the
+     * thread running the GLib main loop.
+     */
+    void connect_async();
+
+    /**
+     * @brief Fetch algorithm metadata from the helper without blocking
+     * @param on_loaded Called on the main loop once the metadata is cached
+     *
+     * Until it completes, the algorithm getters answer from local metadata.
+     */
+    void load_algorithms_async(std::function<void()> on_loaded);
+
     /**
      * @brief Check if connected to the helper
      * @return true if connected
@@ -123,12 +141,40 @@ public:
     [[nodiscard]] auto is_ssd_compatible(WipeAlgorithm algo) -> bool override;
     auto cancel_current_operation() -> bool override;
 
+    /**
+     * @brief Securely delete files through the helper
+     * @param paths Absolute paths of regular files owned by the caller
+     * @param algorithm Overwrite algorithm (device-level algorithms are rejected)
+     * @param discard Release the overwritten blocks to the device afterwards
+     * @param callback Per-file progress; one completion update per path
+     *
+     * Files are shredded in parallel. CancelWipe (cancel_current_operation)
+     * stops the whole batch.
+     */
+    [[nodiscard]] auto shred_files(const std::vector<std::string>& paths, WipeAlgorithm algorithm,
+                                   bool discard, ShredCallback callback)
+        -> std::expected<void, util::Error>;
+
+    /**
+     * @brief Sanitize the free space of a mounted filesystem through the helper
+     * @param directory Mount point (or directory) on the filesystem
+     * @param algorithm Overwrite algorithm for the filler files
+     * @param reserve_bytes Free space to leave untouched (0 = helper default)
+     * @param trim Discard free blocks with FITRIM instead of overwriting
+     * @param callback Progress, delivered like a disk wipe's
+     */
+    [[nodiscard]] auto wipe_free_space(const std::string& directory, WipeAlgorithm algorithm,
+                                       uint64_t reserve_bytes, bool trim,
+                                       ProgressCallback callback)
+        -> std::expected<void, util::Error>;
+
 private:
     GDBusConnection* connection_ = nullptr;
     GDBusProxy* proxy_ = nullptr;
     mutable std::mutex proxy_mutex_;  // Protects proxy_ access during reconnection
     guint signal_subscription_id_ = 0;
     ProgressCallback progress_callback_;
+    ShredCallback shred_callback_;
     mutable std::mutex callback_mutex_;
 
     // Algorithm info cache (fetched once from helper)
@@ -140,6 +186,9 @@ private:
     std::unordered_map<uint32_t, AlgorithmInfo> algorithms_;
     bool algorithms_loaded_ = false;
 
+    // Cancels in-flight connect_async() steps on cleanup
+    GCancellable* connect_cancellable_ = nullptr;
+
     // Connection state management
     ConnectionState connection_state_ = ConnectionState::DISCONNECTED;
     mutable std::mutex state_mutex_;
@@ -161,7 +210,8 @@ private:
     // Random number generator for jitter
     std::mt19937 rng_{std::random_device{}()};
 
-    void load_algorithms();
+    void store_algorithms(GVariant* result);
+    [[nodiscard]] auto find_algorithm(WipeAlgorithm algo) const -> AlgorithmInfo;
     void setup_signal_handler();
     void cleanup();
 
@@ -187,6 +237,10 @@ private:
 
     static gboolean on_reconnect_timer(gpointer user_data);
 
+    static void on_bus_ready(GObject* source_object, GAsyncResult* res, gpointer user_data);
+
+    static void on_proxy_ready(GObject* source_object, GAsyncResult* res, gpointer user_data);
+
     static void on_name_appeared(GDBusConnection* connection, const gchar* name,
                                  const gchar* name_owner, gpointer user_data);
 
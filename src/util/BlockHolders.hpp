@@ -0,0 +1,54 @@
+/**
+ * @file BlockHolders.hpp
+ * @brief Device-mapper devices stacked on a block device
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace util {
+
+/**
+ * @brief dm-* holders of a block device and of its partitions
+ *
+ * Partitions hold mappings too (e.g. /dev/nvme0n1p1 -> dm-0), so the
+ * partition directories under the device are scanned as well.
+ *
+ * @param sys_device_dir The device's sysfs directory (e.g. /sys/block/sda)
+ * @return The holder entries (e.g. /sys/block/sda/sda1/holders/dm-0), whose
+ *         dm/ subdirectory describes the mapping
+ */
+[[nodiscard]] inline auto dm_holders(const std::filesystem::path& sys_device_dir)
+    -> std::vector<std::filesystem::path> {
+    std::vector<std::filesystem::path> holders;
+
+    auto collect_from_path = [&holders](const std::filesystem::path& holders_path) {
+        std::error_code ec;
+        for (const auto& holder : std::filesystem::directory_iterator{holders_path, ec}) {
+            if (holder.path().filename().string().starts_with("dm-")) {
+                holders.push_back(holder.path());
+            }
+        }
+    };
+
+    // Holders of the device itself
+    collect_from_path(sys_device_dir / "holders");
+
+    // Holders of its partitions
+    const auto device_name = sys_device_dir.filename().string();
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator{sys_device_dir, ec}) {
+        const auto part_name = entry.path().filename().string();
+        if (part_name.starts_with(device_name) && part_name != device_name) {
+            collect_from_path(entry.path() / "holders");
+        }
+    }
+
+    return holders;
+}
+
+}  // namespace util
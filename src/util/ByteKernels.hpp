@@ -0,0 +1,47 @@
+/**
+ * @file ByteKernels.hpp
+ * @brief Bulk byte transforms used on write buffers
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace util {
+
+/**
+ * @brief Invert every bit of data in place
+ *
+ * Works on 32-byte GCC/Clang vector lanes, which lower to AVX2, SSE2 or NEON
+ * depending on the target, with a word/byte tail. Loads and stores go through
+ * memcpy so the buffer needs no particular alignment.
+ */
+inline void complement(std::span<std::uint8_t> data) noexcept {
+    using Lanes = std::uint64_t __attribute__((vector_size(32)));
+    constexpr std::size_t LANES = sizeof(Lanes);
+
+    auto* bytes = data.data();
+    const auto size = data.size();
+    std::size_t i = 0;
+
+    for (; i + LANES <= size; i += LANES) {
+        Lanes block;
+        std::memcpy(&block, bytes + i, LANES);
+        block = ~block;
+        std::memcpy(bytes + i, &block, LANES);
+    }
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        word = ~word;
+        std::memcpy(bytes + i, &word, sizeof(word));
+    }
+    for (; i < size; ++i) {
+        bytes[i] = static_cast<std::uint8_t>(~bytes[i]);
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,318 @@
+/**
+ * @file Coroutine.hpp
+ * @brief C++20 coroutine task type and awaitables for long-running device operations
+ *
+ * Operations that issue a command and then wait or poll for minutes (unmount
+ * retries, SMART queries, hardware erase status) are written as coroutines. While
+ * suspended they hold no thread; blocking syscalls are pushed to the executor's
+ * I/O lane and the coroutine resumes on its Scheduler (the helper's GLib main
+ * context), so hundreds of in-flight operations cost a handful of threads.
+ *
+ * @code
+ * auto unmount(util::Scheduler& sched, std::string path) -> util::Task<bool> {
+ *     for (int attempt = 0; attempt < 5; ++attempt) {
+ *         auto result = co_await util::run_blocking(sched, [&] { return try_unmount(path); });
+ *         if (result) co_return true;
+ *         co_await util::sleep_for(sched, std::chrono::milliseconds{500});
+ *     }
+ *     co_return false;
+ * }
+ * util::spawn(unmount(sched, "/dev/sdb"));
+ * @endcode
+ */
+
+#pragma once
+
+#include "util/Executor.hpp"
+#include "util/Logger.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <format>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace util {
+
+/**
+ * @class Scheduler
+ * @brief Where suspended coroutines are resumed
+ *
+ * Implementations must be thread-safe: completions from executor threads call
+ * post() to hop back onto the scheduler's thread.
+ */
+class Scheduler {
+public:
+    using Callback = std::move_only_function<void()>;
+
+    virtual ~Scheduler() = default;
+
+    /**
+     * @brief Run callback on the scheduler's thread as soon as possible
+     */
+    virtual void post(Callback callback) = 0;
+
+    /**
+     * @brief Run callback on the scheduler's thread after delay
+     */
+    virtual void post_after(std::chrono::milliseconds delay, Callback callback) = 0;
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Resumes the awaiting coroutine when a task finishes (symmetric transfer)
+ */
+struct FinalAwaiter {
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    template <typename Promise>
+    auto await_suspend(std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<> {
+        if (auto continuation = handle.promise().continuation) {
+            return continuation;
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    [[nodiscard]] auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+    [[nodiscard]] auto final_suspend() const noexcept -> FinalAwaiter { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    auto get_return_object() -> Task<T>;
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    auto take() -> T {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    auto get_return_object() -> Task<void>;
+
+    void return_void() const noexcept {}
+
+    void take() const {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @class Task
+ * @brief Lazily started, single-consumer coroutine returning T
+ *
+ * A Task does nothing until it is co_awaited by another coroutine or handed to
+ * spawn(). Exceptions propagate to the awaiting coroutine.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+            auto await_suspend(std::coroutine_handle<> awaiting) noexcept
+                -> std::coroutine_handle<> {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            auto await_resume() -> T { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+auto Promise<T>::get_return_object() -> Task<T> {
+    return Task<T>{std::coroutine_handle<Promise<T>>::from_promise(*this)};
+}
+
+inline auto Promise<void>::get_return_object() -> Task<void> {
+    return Task<void>{std::coroutine_handle<Promise<void>>::from_promise(*this)};
+}
+
+/**
+ * @brief Eagerly started, self-destroying coroutine used to drive detached tasks
+ */
+struct Detached {
+    struct promise_type {
+        [[nodiscard]] auto get_return_object() const noexcept -> Detached { return {}; }
+        [[nodiscard]] auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+        [[nodiscard]] auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {
+            LOG_ERROR("Coroutine", "Unhandled exception escaped a detached task");
+        }
+    };
+};
+
+inline auto drive(Task<void> task) -> Detached {
+    try {
+        co_await std::move(task);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Coroutine", std::format("Detached task failed: {}", e.what()));
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Start a task without awaiting it; it frees itself on completion
+ *
+ * The task runs synchronously until its first suspension point. Exceptions are
+ * logged, so handle expected failures inside the task.
+ */
+inline void spawn(Task<void> task) {
+    detail::drive(std::move(task));
+}
+
+/**
+ * @brief Suspend for at least delay, resuming on scheduler
+ */
+[[nodiscard]] inline auto sleep_for(Scheduler& scheduler, std::chrono::milliseconds delay) {
+    struct Awaiter {
+        Scheduler& scheduler;
+        std::chrono::milliseconds delay;
+
+        [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            scheduler.post_after(delay, [handle] { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{scheduler, delay};
+}
+
+/**
+ * @brief Reschedule the current coroutine onto scheduler
+ */
+[[nodiscard]] inline auto resume_on(Scheduler& scheduler) {
+    struct Awaiter {
+        Scheduler& scheduler;
+
+        [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            scheduler.post([handle] { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{scheduler};
+}
+
+/**
+ * @brief Run a blocking callable on the executor and resume on scheduler with its result
+ *
+ * The coroutine holds no thread while fn runs. Exceptions thrown by fn are
+ * rethrown from the co_await expression.
+ */
+template <typename F>
+[[nodiscard]] auto run_blocking(Scheduler& scheduler, F fn,
+                                TaskLane lane = TaskLane::BLOCKING_IO,
+                                Executor& executor = Executor::shared(),
+                                TaskPriority priority = TaskPriority::NORMAL) {
+    using Result = std::invoke_result_t<F&>;
+    using Stored = std::conditional_t<std::is_void_v<Result>, std::monostate, Result>;
+
+    struct Awaiter {
+        Scheduler& scheduler;
+        Executor& executor;
+        TaskLane lane;
+        TaskPriority priority;
+        F fn;
+        std::optional<Stored> result;
+        std::exception_ptr error;
+
+        [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            executor.post(
+                [this, handle] {
+                    try {
+                        if constexpr (std::is_void_v<Result>) {
+                            fn();
+                            result.emplace();
+                        } else {
+                            result.emplace(fn());
+                        }
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    scheduler.post([handle] { handle.resume(); });
+                },
+                priority, lane);
+        }
+
+        auto await_resume() -> Result {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            if constexpr (!std::is_void_v<Result>) {
+                return std::move(*result);
+            }
+        }
+    };
+    return Awaiter{scheduler, executor, lane, priority, std::move(fn), std::nullopt, nullptr};
+}
+
+}  // namespace util
@@ -0,0 +1,226 @@
+/**
+ * @file Executor.cpp
+ * @brief Implementation of the work-stealing executor
+ */
+
+#include "util/Executor.hpp"
+
+#include "util/Logger.hpp"
+
+// Standard library
+#include <exception>
+#include <format>
+#include <string>
+
+// System headers
+#include <pthread.h>
+
+namespace util {
+
+namespace {
+
+// Identifies the compute worker running on the current thread, if any
+thread_local const Executor* tl_executor = nullptr;
+thread_local std::size_t tl_worker_index = 0;
+
+void name_thread(const std::string& name) {
+    // Linux limits thread names to 15 characters plus the terminator
+    ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+}
+
+auto priority_slot(TaskPriority priority) noexcept -> std::size_t {
+    return priority == TaskPriority::BULK ? 1 : 0;
+}
+
+}  // namespace
+
+Executor::Executor(ExecutorConfig config) {
+    auto compute = config.compute_threads;
+    if (compute == 0) {
+        compute = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    io_thread_count_ = config.io_threads != 0 ? config.io_threads
+                                              : std::max(MIN_IO_THREADS, compute);
+
+    compute_queues_.reserve(compute);
+    for (std::size_t i = 0; i < compute; ++i) {
+        compute_queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    threads_.reserve(compute + io_thread_count_ + 1);
+    for (std::size_t i = 0; i < compute; ++i) {
+        threads_.emplace_back([this, i] { compute_worker(i); });
+    }
+    for (std::size_t i = 0; i < io_thread_count_; ++i) {
+        threads_.emplace_back([this, i] {
+            name_thread(std::format("sw-io-{}", i));
+            io_worker();
+        });
+    }
+    threads_.emplace_back([this] {
+        name_thread("sw-control");
+        control_worker();
+    });
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard lock{sleep_mutex_};
+        stopping_.store(true);
+    }
+    work_available_.notify_all();
+    for (auto* queue : {&io_queue_, &control_queue_}) {
+        std::lock_guard lock{queue->mutex};
+        queue->available.notify_all();
+    }
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+auto Executor::shared() -> Executor& {
+    static Executor instance;
+    return instance;
+}
+
+auto Executor::on_compute_worker() const noexcept -> bool {
+    return tl_executor == this;
+}
+
+void Executor::post(Task task, TaskPriority priority, TaskLane lane) {
+    if (priority == TaskPriority::CONTROL) {
+        {
+            std::lock_guard lock{control_queue_.mutex};
+            control_queue_.tasks[0].push_back(std::move(task));
+        }
+        control_queue_.available.notify_one();
+        return;
+    }
+
+    const auto slot = priority_slot(priority);
+
+    if (lane == TaskLane::BLOCKING_IO) {
+        {
+            std::lock_guard lock{io_queue_.mutex};
+            io_queue_.tasks[slot].push_back(std::move(task));
+        }
+        io_queue_.available.notify_one();
+        return;
+    }
+
+    // Keep work spawned by a compute worker local to it; spread external work round-robin
+    const auto target = on_compute_worker()
+                            ? tl_worker_index
+                            : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                  compute_queues_.size();
+    {
+        auto& queue = *compute_queues_[target];
+        std::lock_guard lock{queue.mutex};
+        queue.tasks[slot].push_back(std::move(task));
+    }
+    {
+        std::lock_guard lock{sleep_mutex_};
+        pending_.fetch_add(1);
+    }
+    work_available_.notify_one();
+}
+
+auto Executor::find_compute_task(std::size_t self) -> Task {
+    const auto count = compute_queues_.size();
+
+    // Exhaust NORMAL work everywhere before touching BULK work anywhere
+    for (std::size_t slot = 0; slot < PRIORITY_LEVELS; ++slot) {
+        {
+            auto& own = *compute_queues_[self];
+            std::lock_guard lock{own.mutex};
+            if (auto& tasks = own.tasks[slot]; !tasks.empty()) {
+                auto task = std::move(tasks.back());
+                tasks.pop_back();
+                return task;
+            }
+        }
+        for (std::size_t offset = 1; offset < count; ++offset) {
+            auto& victim = *compute_queues_[(self + offset) % count];
+            std::lock_guard lock{victim.mutex};
+            if (auto& tasks = victim.tasks[slot]; !tasks.empty()) {
+                auto task = std::move(tasks.front());
+                tasks.pop_front();
+                return task;
+            }
+        }
+    }
+    return {};
+}
+
+void Executor::run(Task& task) noexcept {
+    try {
+        task();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Executor", std::format("Task threw: {}", e.what()));
+    } catch (...) {
+        LOG_ERROR("Executor", "Task threw an unknown exception");
+    }
+}
+
+void Executor::compute_worker(std::size_t index) {
+    tl_executor = this;
+    tl_worker_index = index;
+    name_thread(std::format("sw-compute-{}", index));
+
+    while (true) {
+        if (auto task = find_compute_task(index)) {
+            pending_.fetch_sub(1);
+            run(task);
+            continue;
+        }
+
+        std::unique_lock lock{sleep_mutex_};
+        work_available_.wait(lock, [this] { return stopping_.load() || pending_.load() > 0; });
+        if (stopping_.load() && pending_.load() == 0) {
+            return;
+        }
+    }
+}
+
+void Executor::io_worker() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock{io_queue_.mutex};
+            io_queue_.available.wait(lock, [this] {
+                return stopping_.load() || !io_queue_.tasks[0].empty() ||
+                       !io_queue_.tasks[1].empty();
+            });
+            auto& queue = !io_queue_.tasks[0].empty() ? io_queue_.tasks[0] : io_queue_.tasks[1];
+            if (queue.empty()) {
+                return;  // Stopping and drained
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        run(task);
+    }
+}
+
+void Executor::control_worker() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock{control_queue_.mutex};
+            auto& queue = control_queue_.tasks[0];
+            control_queue_.available.wait(lock,
+                                          [&] { return stopping_.load() || !queue.empty(); });
+            if (queue.empty()) {
+                return;  // Stopping and drained
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        run(task);
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,245 @@
+/**
+ * @file Executor.hpp
+ * @brief Process-wide work-stealing thread pool with priorities and I/O lanes
+ *
+ * One executor replaces ad hoc std::async/std::thread usage for short and
+ * medium-sized work: SMART queries, random buffer generation, verification
+ * compares and device enumeration. Work that blocks for minutes or hours
+ * (an ATA SECURITY ERASE ioctl) does not belong here; it would hold a
+ * blocking-I/O worker for that long.
+ *
+ * Three sets of threads serve three kinds of work:
+ * - Compute workers (one per core) each own a deque and steal from their
+ *   peers when idle. Use this lane for CPU-bound work that never blocks.
+ * - Blocking I/O workers serve a shared priority queue. Use this lane for
+ *   ioctls, sysfs/procfs reads and anything else that can sleep in the kernel.
+ * - A dedicated control thread runs TaskPriority::CONTROL tasks only, so
+ *   progress and control work never queues behind bulk compute or I/O.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/**
+ * @enum TaskPriority
+ * @brief Scheduling priority for executor tasks
+ */
+enum class TaskPriority : std::uint8_t {
+    CONTROL,  ///< Short latency-sensitive work (progress, cancellation, resumption)
+    NORMAL,   ///< Default interactive work (enumeration, SMART)
+    BULK      ///< Throughput work that may be delayed (RNG fill, verification compare)
+};
+
+/**
+ * @enum TaskLane
+ * @brief Which worker set runs a task
+ */
+enum class TaskLane : std::uint8_t {
+    COMPUTE,     ///< CPU-bound, never blocks
+    BLOCKING_IO  ///< May block in the kernel (ioctl, read, sleep)
+};
+
+/**
+ * @struct ExecutorConfig
+ * @brief Thread counts for each executor lane
+ */
+struct ExecutorConfig {
+    std::size_t compute_threads = 0;  ///< 0 = one per hardware thread
+    std::size_t io_threads = 0;       ///< 0 = max(4, compute threads)
+};
+
+/**
+ * @class Executor
+ * @brief Work-stealing thread pool shared by the helper's services and algorithms
+ *
+ * Usage:
+ * @code
+ * auto smart = util::Executor::shared().submit(
+ *     [&] { return service.get_smart_data(path); }, util::TaskPriority::NORMAL,
+ *     util::TaskLane::BLOCKING_IO);
+ * @endcode
+ *
+ * Tasks posted from a compute worker go to that worker's own deque (LIFO for
+ * cache locality); idle workers steal the oldest task from their peers. Tasks
+ * that throw are logged and swallowed by post(); submit() forwards exceptions
+ * through the returned future.
+ */
+class Executor {
+public:
+    using Task = std::move_only_function<void()>;
+
+    explicit Executor(ExecutorConfig config = {});
+
+    /**
+     * @brief Drains every queued task, then joins all workers
+     */
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    Executor(Executor&&) = delete;
+    Executor& operator=(Executor&&) = delete;
+
+    /**
+     * @brief Process-wide executor, created on first use
+     */
+    static auto shared() -> Executor&;
+
+    /**
+     * @brief Queue a fire-and-forget task
+     * @param task Work to run
+     * @param priority Scheduling priority (CONTROL always runs on the control thread)
+     * @param lane Worker set for NORMAL and BULK tasks
+     */
+    void post(Task task, TaskPriority priority = TaskPriority::NORMAL,
+              TaskLane lane = TaskLane::COMPUTE);
+
+    /**
+     * @brief Queue a task and obtain its result through a future
+     */
+    template <typename F>
+    [[nodiscard]] auto submit(F&& fn, TaskPriority priority = TaskPriority::NORMAL,
+                              TaskLane lane = TaskLane::COMPUTE)
+        -> std::future<std::invoke_result_t<std::decay_t<F>&>> {
+        using Result = std::invoke_result_t<std::decay_t<F>&>;
+        std::packaged_task<Result()> task{std::forward<F>(fn)};
+        auto future = task.get_future();
+        post([task = std::move(task)]() mutable { task(); }, priority, lane);
+        return future;
+    }
+
+    /**
+     * @brief Run fn(i) for i in [0, count) across the compute lane and the caller
+     *
+     * The calling thread claims indices alongside the workers, so this is safe to
+     * call from inside a worker and never deadlocks waiting for queued helpers.
+     * Returns once every index has completed; the first exception thrown by fn
+     * is rethrown here.
+     */
+    template <typename F>
+    void parallel_for(std::size_t count, F&& fn, TaskPriority priority = TaskPriority::NORMAL) {
+        if (count == 0) {
+            return;
+        }
+        if (count == 1 || compute_threads() == 1) {
+            for (std::size_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        struct Shared {
+            std::atomic<std::size_t> next{0};
+            std::atomic<std::size_t> done{0};
+            std::size_t count;
+            std::remove_reference_t<F>* fn;
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr error;
+        };
+        auto state = std::make_shared<Shared>();
+        state->count = count;
+        state->fn = &fn;
+
+        auto drain = [](Shared& s) {
+            std::size_t completed = 0;
+            for (std::size_t i = s.next.fetch_add(1); i < s.count; i = s.next.fetch_add(1)) {
+                try {
+                    (*s.fn)(i);
+                } catch (...) {
+                    std::lock_guard lock{s.mutex};
+                    if (!s.error) {
+                        s.error = std::current_exception();
+                    }
+                }
+                ++completed;
+            }
+            if (completed > 0 && s.done.fetch_add(completed) + completed == s.count) {
+                std::lock_guard lock{s.mutex};
+                s.finished.notify_all();
+            }
+        };
+
+        const auto helpers = std::min(count - 1, compute_threads());
+        for (std::size_t h = 0; h < helpers; ++h) {
+            post([state, drain] { drain(*state); }, priority, TaskLane::COMPUTE);
+        }
+        drain(*state);
+
+        std::unique_lock lock{state->mutex};
+        state->finished.wait(lock, [&] { return state->done.load() == count; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    [[nodiscard]] auto compute_threads() const noexcept -> std::size_t {
+        return compute_queues_.size();
+    }
+    [[nodiscard]] auto io_threads() const noexcept -> std::size_t { return io_thread_count_; }
+
+    /**
+     * @brief Whether the calling thread is one of this executor's compute workers
+     */
+    [[nodiscard]] auto on_compute_worker() const noexcept -> bool;
+
+private:
+    static constexpr std::size_t PRIORITY_LEVELS = 2;  // NORMAL, BULK (CONTROL is separate)
+    static constexpr std::size_t MIN_IO_THREADS = 4;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<Task>, PRIORITY_LEVELS> tasks;
+    };
+
+    /**
+     * @brief A simple mutex/condvar protected queue (control and I/O lanes)
+     */
+    struct SharedQueue {
+        std::mutex mutex;
+        std::condition_variable available;
+        std::array<std::deque<Task>, PRIORITY_LEVELS> tasks;
+    };
+
+    void compute_worker(std::size_t index);
+    void io_worker();
+    void control_worker();
+
+    [[nodiscard]] auto find_compute_task(std::size_t self) -> Task;
+    static void run(Task& task) noexcept;
+
+    std::vector<std::unique_ptr<WorkerQueue>> compute_queues_;
+    std::size_t io_thread_count_ = 0;
+    std::atomic<std::size_t> next_queue_{0};
+
+    // Sleep/wake for compute workers; pending_ is incremented under sleep_mutex_
+    std::mutex sleep_mutex_;
+    std::condition_variable work_available_;
+    std::atomic<std::size_t> pending_{0};
+
+    SharedQueue io_queue_;
+    SharedQueue control_queue_;
+
+    std::atomic<bool> stopping_{false};
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace util
@@ -0,0 +1,45 @@
+/**
+ * @file FilesystemKind.hpp
+ * @brief Recognize filesystems by their statfs() magic number
+ */
+
+#pragma once
+
+#include <span>
+
+namespace util {
+
+/**
+ * @brief statfs() magic number with a display name
+ */
+struct FilesystemKind {
+    long magic;
+    const char* name;
+};
+
+// Copy-on-write and log-structured filesystems never overwrite data in place
+inline constexpr FilesystemKind OUT_OF_PLACE_FILESYSTEMS[] = {
+    {0x9123683E, "btrfs"}, {0x2FC12FC1, "ZFS"},   {0xCA451A4E, "bcachefs"},
+    {0xF2F52010, "F2FS"},  {0x3434, "NILFS2"},
+};
+
+// Writing "files" here has side effects instead of touching storage
+inline constexpr FilesystemKind PSEUDO_FILESYSTEMS[] = {
+    {0x9FA0, "procfs"}, {0x62656572, "sysfs"}, {0x64626720, "debugfs"}, {0x1CD1, "devpts"},
+};
+
+/**
+ * @brief Name of the filesystem in @p table with this magic number
+ * @return Display name, or nullptr when the table has no such entry
+ */
+[[nodiscard]] inline auto lookup_filesystem(long magic, std::span<const FilesystemKind> table)
+    -> const char* {
+    for (const auto& kind : table) {
+        if (kind.magic == magic) {
+            return kind.name;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace util
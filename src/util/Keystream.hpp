@@ -0,0 +1,82 @@
+/**
+ * @file Keystream.hpp
+ * @brief Seekable pseudo-random byte stream for passes that must be regenerated
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+
+namespace util {
+
+/**
+ * @class Keystream
+ * @brief Counter-based generator: the bytes at any offset depend only on (seed, offset)
+ *
+ * Word i of the stream is the SplitMix64 output for counter i, so a block can
+ * be produced for any device offset without generating what precedes it. A
+ * later pass (e.g. "complement of the previous pass") or a verification read
+ * regenerates the exact data from the 8-byte seed instead of storing it.
+ *
+ * Not a cryptographic generator; like RandomBufferGenerator it is meant for
+ * overwrite data, not for keys.
+ */
+class Keystream {
+public:
+    explicit Keystream(std::uint64_t seed) noexcept : seed_(seed) {}
+
+    /**
+     * @brief Fresh seed from the system entropy source
+     */
+    [[nodiscard]] static auto random_seed() -> std::uint64_t {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    }
+
+    [[nodiscard]] auto seed() const noexcept -> std::uint64_t { return seed_; }
+
+    /**
+     * @brief Write the stream bytes [offset, offset + out.size()) into out
+     */
+    void fill(std::uint64_t offset, std::span<std::uint8_t> out) const noexcept {
+        auto counter = offset / WORD;
+        std::size_t pos = 0;
+
+        // Unaligned head: the tail end of one word
+        if (const auto skip = static_cast<std::size_t>(offset % WORD); skip != 0) {
+            const auto word = at(counter++);
+            const auto count = std::min(WORD - skip, out.size());
+            std::memcpy(out.data(), reinterpret_cast<const std::uint8_t*>(&word) + skip, count);
+            pos = count;
+        }
+
+        for (; pos + WORD <= out.size(); pos += WORD) {
+            const auto word = at(counter++);
+            std::memcpy(out.data() + pos, &word, WORD);
+        }
+
+        if (pos < out.size()) {
+            const auto word = at(counter);
+            std::memcpy(out.data() + pos, &word, out.size() - pos);
+        }
+    }
+
+private:
+    static constexpr std::size_t WORD = sizeof(std::uint64_t);
+
+    [[nodiscard]] auto at(std::uint64_t counter) const noexcept -> std::uint64_t {
+        auto z = seed_ + (counter + 1) * 0x9E37'79B9'7F4A'7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t seed_;
+};
+
+}  // namespace util
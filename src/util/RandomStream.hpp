@@ -0,0 +1,74 @@
+/**
+ * @file RandomStream.hpp
+ * @brief Double-buffered random data source that generates ahead on the executor
+ */
+
+#pragma once
+
+#include "util/Executor.hpp"
+#include "util/RandomBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+namespace util {
+
+/**
+ * @class RandomStream
+ * @brief Yields buffers of fresh random bytes while the next one is filled in the background
+ *
+ * The writer thread only waits for the RNG when generation is slower than the
+ * device; otherwise the fill of buffer N+1 overlaps the write of buffer N.
+ *
+ * @code
+ * util::RandomStream stream{BUFFER_SIZE};
+ * while (written < size) {
+ *     const auto& block = stream.next();
+ *     write(fd, block.data(), ...);
+ * }
+ * @endcode
+ */
+class RandomStream {
+public:
+    explicit RandomStream(std::size_t buffer_size, Executor& executor = Executor::shared())
+        : executor_(executor), front_(buffer_size), back_(buffer_size) {
+        prefetch();
+    }
+
+    ~RandomStream() {
+        // The background fill references back_; it must finish before we go away
+        if (pending_.valid()) {
+            pending_.wait();
+        }
+    }
+
+    RandomStream(const RandomStream&) = delete;
+    RandomStream& operator=(const RandomStream&) = delete;
+    RandomStream(RandomStream&&) = delete;
+    RandomStream& operator=(RandomStream&&) = delete;
+
+    /**
+     * @brief Next buffer of random bytes; valid until the following call
+     */
+    [[nodiscard]] auto next() -> const std::vector<uint8_t>& {
+        pending_.get();
+        front_.swap(back_);
+        prefetch();
+        return front_;
+    }
+
+private:
+    void prefetch() {
+        pending_ = executor_.submit([this] { RandomBufferGenerator::fill(back_); },
+                                    TaskPriority::BULK);
+    }
+
+    Executor& executor_;
+    std::vector<uint8_t> front_;
+    std::vector<uint8_t> back_;
+    std::future<void> pending_;
+};
+
+}  // namespace util
@@ -0,0 +1,101 @@
+/**
+ * @file StartupTrace.cpp
+ * @brief Implementation of startup phase timing
+ */
+
+#include "util/StartupTrace.hpp"
+
+#include "util/Logger.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+
+namespace util {
+
+namespace {
+
+// Taken while static objects are constructed, i.e. before main()
+const StartupTrace::Clock::time_point PROCESS_START = StartupTrace::Clock::now();
+
+auto echo_enabled() -> bool {
+    const char* value = std::getenv(StartupTrace::ENV_VAR);
+    return value != nullptr && *value != '\0' && std::string_view{value} != "0";
+}
+
+auto format_offset(std::chrono::microseconds offset) -> std::string {
+    return std::format("+{:.1f} ms", static_cast<double>(offset.count()) / 1000.0);
+}
+
+}  // namespace
+
+StartupTrace::StartupTrace(Clock::time_point origin, bool echo) : origin_(origin), echo_(echo) {}
+
+auto StartupTrace::instance() -> StartupTrace& {
+    static StartupTrace trace{PROCESS_START, echo_enabled()};
+    return trace;
+}
+
+void StartupTrace::mark(std::string_view phase, Clock::time_point now) {
+    auto offset = std::chrono::duration_cast<std::chrono::microseconds>(now - origin_);
+    {
+        std::lock_guard lock(mutex_);
+        if (std::ranges::any_of(phases_, [phase](const Phase& p) { return p.name == phase; })) {
+            return;
+        }
+        phases_.push_back(Phase{.name = std::string(phase), .offset = offset});
+    }
+
+    if (echo_) {
+        std::cerr << std::format("[startup] {} {}\n", format_offset(offset), phase);
+    }
+}
+
+auto StartupTrace::offset_of(std::string_view phase) const
+    -> std::optional<std::chrono::microseconds> {
+    std::lock_guard lock(mutex_);
+    auto it = std::ranges::find(phases_, phase, &Phase::name);
+    if (it == phases_.end()) {
+        return std::nullopt;
+    }
+    return it->offset;
+}
+
+auto StartupTrace::phases() const -> std::vector<Phase> {
+    std::lock_guard lock(mutex_);
+    return phases_;
+}
+
+auto StartupTrace::report() const -> std::string {
+    std::string result;
+    for (const auto& phase : phases()) {
+        if (!result.empty()) {
+            result += ", ";
+        }
+        result += std::format("{} {}", phase.name, format_offset(phase.offset));
+    }
+    return result;
+}
+
+void StartupTrace::finish() {
+    {
+        std::lock_guard lock(mutex_);
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+    }
+
+    LOG_INFO("Startup", report());
+
+    auto first_frame = offset_of(FIRST_FRAME);
+    if (first_frame && *first_frame > FIRST_FRAME_TARGET) {
+        LOG_WARNING("Startup", std::format("First frame took {}, target is {} ms",
+                                           format_offset(*first_frame),
+                                           FIRST_FRAME_TARGET.count()));
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,110 @@
+/**
+ * @file StartupTrace.hpp
+ * @brief Timing of the GUI's cold-start phases
+ *
+ * Records how long after process start the window was presented, painted
+ * its first frame, connected to the helper and showed the disk list. The
+ * summary is logged once the disks are on screen; setting
+ * STORAGE_WIPER_TRACE_STARTUP=1 also prints every phase to stderr as it
+ * happens.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace util {
+
+/**
+ * @class StartupTrace
+ * @brief Collects named startup phases as offsets from process start
+ *
+ * Thread-safe. Each phase is recorded once; later marks of the same name
+ * are ignored so that reconnects do not overwrite cold-start numbers.
+ */
+class StartupTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Budget for the first painted frame after process start
+    static constexpr std::chrono::milliseconds FIRST_FRAME_TARGET{150};
+
+    /// Environment variable that enables printing phases to stderr
+    static constexpr auto ENV_VAR = "STORAGE_WIPER_TRACE_STARTUP";
+
+    // Phase names used by the application
+    static constexpr std::string_view WINDOW_PRESENTED = "window presented";
+    static constexpr std::string_view FIRST_FRAME = "first frame";
+    static constexpr std::string_view HELPER_CONNECTED = "helper connected";
+    static constexpr std::string_view DISKS_SHOWN = "disks shown";
+
+    /**
+     * @struct Phase
+     * @brief One recorded phase
+     */
+    struct Phase {
+        std::string name;
+        std::chrono::microseconds offset;  ///< Time since process start
+    };
+
+    /**
+     * @brief Create a trace with an explicit origin
+     * @param origin Time treated as process start
+     * @param echo Print each phase to stderr when it is marked
+     */
+    StartupTrace(Clock::time_point origin, bool echo);
+
+    /**
+     * @brief Process-wide trace
+     *
+     * The origin is taken during static initialization, before main() runs;
+     * echo is enabled by STORAGE_WIPER_TRACE_STARTUP.
+     */
+    [[nodiscard]] static auto instance() -> StartupTrace&;
+
+    /**
+     * @brief Record a phase
+     * @param phase Phase name
+     * @param now Time the phase was reached
+     */
+    void mark(std::string_view phase, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Offset of a recorded phase
+     * @return Time since process start, or nullopt if not reached yet
+     */
+    [[nodiscard]] auto offset_of(std::string_view phase) const
+        -> std::optional<std::chrono::microseconds>;
+
+    /**
+     * @brief Recorded phases in the order they were reached
+     */
+    [[nodiscard]] auto phases() const -> std::vector<Phase>;
+
+    /**
+     * @brief One-line summary, e.g. "window presented +41.2 ms, first frame +83.0 ms"
+     */
+    [[nodiscard]] auto report() const -> std::string;
+
+    /**
+     * @brief Log the summary once
+     *
+     * Warns when the first frame missed FIRST_FRAME_TARGET. Later calls do
+     * nothing.
+     */
+    void finish();
+
+private:
+    Clock::time_point origin_;
+    bool echo_;
+    mutable std::mutex mutex_;
+    std::vector<Phase> phases_;
+    bool finished_ = false;
+};
+
+}  // namespace util
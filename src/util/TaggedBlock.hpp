@@ -0,0 +1,173 @@
+/**
+ * @file TaggedBlock.hpp
+ * @brief Self-describing overwrite blocks that record where and by whom they were written
+ */
+
+#pragma once
+
+#include "util/Keystream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace util {
+
+/**
+ * @brief Layout of one tagged block
+ *
+ * Every TAGGED_BLOCK_SIZE bytes of the device hold, in host byte order:
+ *
+ *   0  magic "SWLBATAG"      8  block address (offset / block size)
+ *  16  job id               24  block size (u32), format version (u32)
+ *  32  checksum             40  zero up to the payload
+ *  64  keystream payload (seeded by the job id, at the block's device offset)
+ *
+ * The checksum covers the whole block with the checksum field zeroed. A
+ * block read back therefore proves on its own, without regenerating
+ * anything, that it was written intact, at its own address, by this job.
+ * The keystream payload keeps every block distinct, so deduplicating or
+ * compressing controllers still have to store it.
+ */
+inline constexpr std::size_t TAGGED_BLOCK_SIZE = 4'096;
+inline constexpr std::size_t TAGGED_HEADER_SIZE = 64;
+inline constexpr std::uint32_t TAGGED_BLOCK_VERSION = 1;
+inline constexpr std::array<std::uint8_t, 8> TAGGED_BLOCK_MAGIC = {'S', 'W', 'L', 'B',
+                                                                   'A', 'T', 'A', 'G'};
+
+/**
+ * @brief Header fields of a block read back from the device
+ */
+struct BlockTag {
+    std::uint64_t address = 0;
+    std::uint64_t job_id = 0;
+};
+
+/**
+ * @brief What a block read back from the device holds
+ */
+enum class TagStatus : std::uint8_t {
+    VALID,    ///< Magic, layout and checksum are right; see the tag for where it belongs
+    CORRUPT,  ///< Looks like a tagged block but the checksum does not match
+    FOREIGN   ///< Not a tagged block at all (zeros, old data, a dropped write)
+};
+
+namespace detail {
+
+inline constexpr std::size_t CHECKSUM_FIELD = 32;
+
+template <typename T>
+[[nodiscard]] inline auto load(const std::uint8_t* bytes) noexcept -> T {
+    T value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+template <typename T>
+inline void store(std::uint8_t* bytes, T value) noexcept {
+    std::memcpy(bytes, &value, sizeof(value));
+}
+
+}  // namespace detail
+
+/**
+ * @brief 64-bit Fletcher-style checksum of one block, with the checksum field read as zero
+ *
+ * Runs four independent 32-bit Fletcher sums over 16-byte GCC vector lanes
+ * (SSE2 or NEON), then folds the lanes together with their position so a
+ * swap between lanes changes the result. Meant to catch media and transport
+ * corruption, not tampering.
+ */
+[[nodiscard]] inline auto tagged_checksum(std::span<const std::uint8_t, TAGGED_BLOCK_SIZE> block)
+    -> std::uint64_t {
+    using Lanes = std::uint32_t __attribute__((vector_size(16)));
+    constexpr std::size_t LANES = sizeof(Lanes);
+    static_assert(detail::CHECKSUM_FIELD % LANES == 0);
+
+    Lanes sum{};
+    Lanes running{};
+    for (std::size_t i = 0; i < TAGGED_BLOCK_SIZE; i += LANES) {
+        Lanes words;
+        std::memcpy(&words, block.data() + i, LANES);
+        if (i == detail::CHECKSUM_FIELD) {
+            words[0] = 0;  // The checksum itself, two 32-bit words
+            words[1] = 0;
+        }
+        sum += words;
+        running += sum;
+    }
+
+    std::uint64_t result = 0xCBF2'9CE4'8422'2325ULL;
+    for (std::size_t lane = 0; lane < LANES / sizeof(std::uint32_t); ++lane) {
+        const auto folded = (static_cast<std::uint64_t>(running[lane]) << 32) | sum[lane];
+        result = (result ^ folded) * 0x0000'0100'0000'01B3ULL;
+    }
+    return result;
+}
+
+/**
+ * @brief Build the block at a block address into out
+ */
+inline void make_tagged_block(std::uint64_t job_id, std::uint64_t address,
+                              std::span<std::uint8_t, TAGGED_BLOCK_SIZE> out) {
+    Keystream{job_id}.fill(address * TAGGED_BLOCK_SIZE, out);
+
+    auto* bytes = out.data();
+    std::memset(bytes, 0, TAGGED_HEADER_SIZE);
+    std::memcpy(bytes, TAGGED_BLOCK_MAGIC.data(), TAGGED_BLOCK_MAGIC.size());
+    detail::store<std::uint64_t>(bytes + 8, address);
+    detail::store<std::uint64_t>(bytes + 16, job_id);
+    detail::store<std::uint32_t>(bytes + 24, static_cast<std::uint32_t>(TAGGED_BLOCK_SIZE));
+    detail::store<std::uint32_t>(bytes + 28, TAGGED_BLOCK_VERSION);
+    detail::store<std::uint64_t>(bytes + detail::CHECKSUM_FIELD, tagged_checksum(out));
+}
+
+/**
+ * @brief Write the tagged stream bytes [offset, offset + out.size()) into out
+ *
+ * Offsets need not be block-aligned; partial blocks at either end are cut
+ * from a whole block built on the stack.
+ */
+inline void fill_tagged(std::uint64_t job_id, std::uint64_t offset, std::span<std::uint8_t> out) {
+    std::size_t pos = 0;
+    while (pos < out.size()) {
+        const auto device_offset = offset + pos;
+        const auto address = device_offset / TAGGED_BLOCK_SIZE;
+        const auto within = static_cast<std::size_t>(device_offset % TAGGED_BLOCK_SIZE);
+        const auto count = std::min(TAGGED_BLOCK_SIZE - within, out.size() - pos);
+
+        if (within == 0 && count == TAGGED_BLOCK_SIZE) {
+            make_tagged_block(job_id, address, out.subspan(pos).first<TAGGED_BLOCK_SIZE>());
+        } else {
+            std::array<std::uint8_t, TAGGED_BLOCK_SIZE> block;
+            make_tagged_block(job_id, address, block);
+            std::memcpy(out.data() + pos, block.data() + within, count);
+        }
+        pos += count;
+    }
+}
+
+/**
+ * @brief Decode a block read back from the device
+ * @param tag Set when the result is VALID
+ */
+[[nodiscard]] inline auto read_tag(std::span<const std::uint8_t, TAGGED_BLOCK_SIZE> block,
+                                   BlockTag& tag) -> TagStatus {
+    const auto* bytes = block.data();
+    if (std::memcmp(bytes, TAGGED_BLOCK_MAGIC.data(), TAGGED_BLOCK_MAGIC.size()) != 0 ||
+        detail::load<std::uint32_t>(bytes + 24) != TAGGED_BLOCK_SIZE ||
+        detail::load<std::uint32_t>(bytes + 28) != TAGGED_BLOCK_VERSION) {
+        return TagStatus::FOREIGN;
+    }
+    if (detail::load<std::uint64_t>(bytes + detail::CHECKSUM_FIELD) != tagged_checksum(block)) {
+        return TagStatus::CORRUPT;
+    }
+    tag.address = detail::load<std::uint64_t>(bytes + 8);
+    tag.job_id = detail::load<std::uint64_t>(bytes + 16);
+    return TagStatus::VALID;
+}
+
+}  // namespace util
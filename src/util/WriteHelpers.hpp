@@ -1,17 +1,24 @@
 #pragma once
 
+#include "util/WritePacer.hpp"
+
 #include <unistd.h>
 
 #include <cerrno>
+#include <chrono>
 
 namespace util {
 
 inline auto write_with_retry(int fd, const void* buffer, size_t size) -> ssize_t {
+    const auto start = std::chrono::steady_clock::now();
     while (true) {
         const auto result = ::write(fd, buffer, size);
         if (result < 0 && (errno == EINTR || errno == EAGAIN)) {
             continue;
         }
+        if (result > 0) {
+            WritePacer::pace(std::chrono::steady_clock::now() - start);
+        }
         return result;
     }
 }
@@ -0,0 +1,69 @@
+/**
+ * @file WritePacer.hpp
+ * @brief Process-wide scaling of the wipe write rate
+ *
+ * The helper lowers the multiplier while other workloads on the host stall
+ * on I/O or memory (see PressureMonitor) and raises it again as they
+ * recover. Sequential wipe writes go through util::write_with_retry(), which
+ * pauses after each write in proportion to the time the write took. So a
+ * multiplier of 0.25 leaves the device idle for three quarters of the time,
+ * whatever its speed. At 1.0 nothing is paused. The parallel overwrite loop
+ * (write_stream) first lowers its queue depth and pauses only for the rest.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace util {
+
+/**
+ * @class WritePacer
+ * @brief Shared rate multiplier for every running wipe
+ */
+class WritePacer {
+public:
+    static constexpr double MIN_MULTIPLIER = 0.05;
+    static constexpr auto MAX_PAUSE = std::chrono::milliseconds{500};  // Keeps cancel responsive
+
+    /**
+     * @brief Share of the full write rate wipes may use, 1.0 when unthrottled
+     */
+    [[nodiscard]] static auto multiplier() noexcept -> double {
+        return multiplier_.load(std::memory_order_relaxed);
+    }
+
+    static void set_multiplier(double multiplier) noexcept {
+        multiplier_.store(std::clamp(multiplier, MIN_MULTIPLIER, 1.0), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pause after a write that took `elapsed`, so writes fill `multiplier` of the time
+     */
+    static void pace(std::chrono::steady_clock::duration elapsed) { pace(elapsed, multiplier()); }
+
+    /**
+     * @brief Pause after `elapsed` of writing so writes fill `share` of the time
+     *
+     * For writers that already give up part of the rate some other way (fewer
+     * requests in flight) and only pause for the rest.
+     */
+    static void pace(std::chrono::steady_clock::duration elapsed, double share) {
+        using Duration = std::chrono::steady_clock::duration;
+        const double current = std::clamp(share, MIN_MULTIPLIER, 1.0);
+        if (current >= 1.0) {
+            return;
+        }
+        const auto pause =
+            std::chrono::duration_cast<Duration>(elapsed * ((1.0 - current) / current));
+        std::this_thread::sleep_for(std::min<Duration>(pause, MAX_PAUSE));
+    }
+
+private:
+    static inline std::atomic<double> multiplier_{1.0};
+};
+
+}  // namespace util
@@ -0,0 +1,73 @@
+/**
+ * @file DiskListDiff.cpp
+ * @brief Keyed diff between two disk lists
+ */
+
+#include "viewmodels/DiskListDiff.hpp"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+auto diff_disk_lists(const std::vector<DiskInfo>& before, const std::vector<DiskInfo>& after)
+    -> std::vector<DiskListEdit> {
+    std::vector<DiskListEdit> edits;
+
+    std::unordered_set<std::string> wanted;
+    wanted.reserve(after.size());
+    for (const auto& disk : after) {
+        wanted.insert(disk.path);
+    }
+
+    // Drop vanished disks back to front so earlier positions stay valid.
+    // `rows` tracks the displayed list (indices into `before`) as edits apply.
+    std::vector<std::size_t> rows;
+    rows.reserve(before.size());
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        if (wanted.contains(before[i].path)) {
+            rows.push_back(i);
+        }
+    }
+    for (std::size_t i = before.size(); i-- > 0;) {
+        if (!wanted.contains(before[i].path)) {
+            edits.push_back({.kind = DiskListEdit::Kind::REMOVE, .position = i, .source = 0});
+        }
+    }
+
+    std::unordered_map<std::string, std::size_t> old_index;
+    old_index.reserve(rows.size());
+    for (auto i : rows) {
+        old_index.emplace(before[i].path, i);
+    }
+
+    // Walk the new order; surviving rows normally line up, so this is linear
+    // unless disks were reordered
+    constexpr std::size_t NEW_ROW = static_cast<std::size_t>(-1);
+    for (std::size_t k = 0; k < after.size(); ++k) {
+        const auto& disk = after[k];
+        auto found = old_index.find(disk.path);
+        if (found == old_index.end()) {
+            edits.push_back({.kind = DiskListEdit::Kind::INSERT, .position = k, .source = k});
+            rows.insert(rows.begin() + static_cast<std::ptrdiff_t>(k), NEW_ROW);
+            continue;
+        }
+
+        const auto old = found->second;
+        if (rows[k] != old) {
+            auto current =
+                std::find(rows.begin() + static_cast<std::ptrdiff_t>(k), rows.end(), old);
+            edits.push_back({.kind = DiskListEdit::Kind::REMOVE,
+                             .position = static_cast<std::size_t>(current - rows.begin()),
+                             .source = 0});
+            edits.push_back({.kind = DiskListEdit::Kind::INSERT, .position = k, .source = k});
+            rows.erase(current);
+            rows.insert(rows.begin() + static_cast<std::ptrdiff_t>(k), old);
+            continue;
+        }
+        if (!(before[old] == disk)) {
+            edits.push_back({.kind = DiskListEdit::Kind::UPDATE, .position = k, .source = k});
+        }
+    }
+    return edits;
+}
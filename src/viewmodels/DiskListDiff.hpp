@@ -0,0 +1,53 @@
+/**
+ * @file DiskListDiff.hpp
+ * @brief Keyed diff between two disk lists for incremental list updates
+ */
+
+#pragma once
+
+#include "models/DiskInfo.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct DiskListEdit
+ * @brief One positional change to a displayed disk list
+ */
+struct DiskListEdit {
+    enum class Kind {
+        INSERT,  ///< Insert after[source] at position
+        REMOVE,  ///< Remove the row at position
+        UPDATE   ///< Replace the row at position with after[source] (same device)
+    };
+
+    Kind kind = Kind::INSERT;
+    std::size_t position = 0;
+    std::size_t source = 0;  ///< Index into the new list; unused for REMOVE
+
+    auto operator==(const DiskListEdit&) const -> bool = default;
+};
+
+/**
+ * @struct DiskListUpdate
+ * @brief New disk list together with the edits that produce it from the previous one
+ */
+struct DiskListUpdate {
+    std::shared_ptr<const std::vector<DiskInfo>> disks;
+    std::vector<DiskListEdit> edits;
+
+    auto operator==(const DiskListUpdate&) const -> bool = default;
+};
+
+/**
+ * @brief Compute the row edits that turn @p before into @p after
+ *
+ * Disks are matched by device path. Applying the edits in order to a list
+ * equal to @p before yields @p after; disks present in both with identical
+ * info produce no edit, so a refresh where nothing changed is empty. A disk
+ * that moved is removed and re-inserted.
+ */
+[[nodiscard]] auto diff_disk_lists(const std::vector<DiskInfo>& before,
+                                   const std::vector<DiskInfo>& after)
+    -> std::vector<DiskListEdit>;
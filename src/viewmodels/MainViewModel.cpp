@@ -1,5 +1,7 @@
 #include "viewmodels/MainViewModel.hpp"
 
+#include "algorithms/AlgorithmFactory.hpp"
+
 #include <glibmm/main.h>
 
 #include <algorithm>
@@ -38,6 +40,14 @@ MainViewModel::MainViewModel(std::shared_ptr<IDiskService> disk_service,
         update_can_wipe();
         refresh_command->raise_can_execute_changed();
     });
+
+    // Diff every new disk list against the previous one for incremental views
+    shown_disks_ = disks.get();
+    disks_subscription_id_ = disks.subscribe([this](const auto& snapshot) {
+        auto edits = diff_disk_lists(*shown_disks_, *snapshot);
+        shown_disks_ = snapshot;
+        disk_list_update.set(DiskListUpdate{.disks = snapshot, .edits = std::move(edits)});
+    });
 }
 
 MainViewModel::~MainViewModel() {
@@ -50,11 +60,16 @@ void MainViewModel::initialize() {
     update_can_wipe();
 }
 
+void MainViewModel::refresh_algorithms() {
+    load_algorithms();
+}
+
 void MainViewModel::cleanup() {
     // Unsubscribe from observables
     selected_disk_path.unsubscribe(selected_disk_subscription_id_);
     is_wipe_in_progress.unsubscribe(wipe_in_progress_subscription_id_);
     is_connected.unsubscribe(connection_subscription_id_);
+    disks.unsubscribe(disks_subscription_id_);
 
     if (is_wipe_in_progress.get()) {
         wipe_service_->cancel_current_operation();
@@ -105,6 +120,7 @@ void MainViewModel::load_disks() {
                         vm->show_message(MessageInfo::Type::ERROR, "Error",
                                          "Failed to refresh disk list: " + result.error().message);
                     }
+                    vm->disks_loaded.set(true);
                 }
                 return false;  // G_SOURCE_REMOVE
             });
@@ -115,12 +131,7 @@ void MainViewModel::load_algorithms() {
     std::vector<AlgorithmInfo> algo_list;
 
     // Get algorithm info from WipeService
-    constexpr std::array all_algorithms = {
-        WipeAlgorithm::ZERO_FILL, WipeAlgorithm::RANDOM_FILL, WipeAlgorithm::DOD_5220_22_M,
-        WipeAlgorithm::SCHNEIER,  WipeAlgorithm::VSITR,       WipeAlgorithm::GOST_R_50739_95,
-        WipeAlgorithm::GUTMANN};
-
-    for (auto algo : all_algorithms) {
+    for (auto algo : OFFERED_WIPE_ALGORITHMS) {
         algo_list.push_back(
             AlgorithmInfo{.algorithm = algo,
                           .name = wipe_service_->get_algorithm_name(algo),
@@ -129,7 +140,7 @@ void MainViewModel::load_algorithms() {
                           .is_ssd_compatible = wipe_service_->is_ssd_compatible(algo)});
     }
 
-    algorithms.set(algo_list);
+    algorithms.set(std::move(algo_list));
 }
 
 void MainViewModel::update_can_wipe() {
@@ -199,6 +210,13 @@ void MainViewModel::start_wipe() {
     message << "Algorithm: " << wipe_service_->get_algorithm_name(selected_algorithm.get()) << "\n";
     message << "Description: " << wipe_service_->get_algorithm_description(selected_algorithm.get())
             << "\n\n";
+    if (disk_info && disk_info->is_thin_provisioned &&
+        selected_algorithm.get() != WipeAlgorithm::THIN_DISCARD) {
+        message << "This disk is thin-provisioned. Overwriting it allocates its full size in the "
+                   "backing storage; "
+                << wipe_service_->get_algorithm_name(WipeAlgorithm::THIN_DISCARD)
+                << " releases it instead and finishes much faster.\n\n";
+    }
     message << "WARNING: This will permanently destroy ALL data on the disk!\n";
     message << "This action cannot be undone!";
 
@@ -325,10 +343,10 @@ void MainViewModel::show_message(MessageInfo::Type type, const std::string& titl
 }
 
 auto MainViewModel::find_disk_info(const std::string& path) const -> std::optional<DiskInfo> {
-    auto disk_list = disks.get();
-    auto it = std::find_if(disk_list.begin(), disk_list.end(),
+    const auto disk_list = disks.get();
+    auto it = std::find_if(disk_list->begin(), disk_list->end(),
                            [&path](const DiskInfo& disk) { return disk.path == path; });
-    if (it != disk_list.end()) {
+    if (it != disk_list->end()) {
         return *it;
     }
     return std::nullopt;
@@ -13,6 +13,7 @@
 #include "models/ViewTypes.hpp"
 #include "services/IDiskService.hpp"
 #include "services/IWipeService.hpp"
+#include "viewmodels/DiskListDiff.hpp"
 
 #include <memory>
 #include <optional>
@@ -44,12 +45,20 @@ public:
     /**
      * @brief List of available disks
      */
-    mvvm::Observable<std::vector<DiskInfo>> disks{{}};
+    mvvm::SnapshotObservable<std::vector<DiskInfo>> disks{{}};
+
+    /**
+     * @brief Row edits from the previous disk list to the current one
+     *
+     * Published after every change of disks, so views can update only the
+     * rows that were inserted, removed or changed.
+     */
+    mvvm::Observable<DiskListUpdate> disk_list_update{{}};
 
     /**
      * @brief List of available wipe algorithms
      */
-    mvvm::Observable<std::vector<AlgorithmInfo>> algorithms{{}};
+    mvvm::SnapshotObservable<std::vector<AlgorithmInfo>> algorithms{{}};
 
     /**
      * @brief Currently selected disk path
@@ -91,6 +100,13 @@ public:
      */
     mvvm::Observable<std::string> connection_error{""};
 
+    /**
+     * @brief Whether the helper has answered the first disk query
+     *
+     * Views show a placeholder until then instead of an empty list.
+     */
+    mvvm::Observable<bool> disks_loaded{false};
+
     // ========== Commands ==========
 
     /**
@@ -120,6 +136,14 @@ public:
      */
     void cleanup();
 
+    /**
+     * @brief Re-read algorithm metadata from the wipe service
+     *
+     * Called once the helper's metadata has been fetched, replacing the
+     * local defaults shown at startup.
+     */
+    void refresh_algorithms();
+
     /**
      * @brief Set the selected disk
      * @param disk_path Path of the selected disk
@@ -168,6 +192,10 @@ private:
     size_t selected_disk_subscription_id_ = 0;
     size_t wipe_in_progress_subscription_id_ = 0;
     size_t connection_subscription_id_ = 0;
+    size_t disks_subscription_id_ = 0;
+
+    // Disk list the last disk_list_update was diffed against
+    std::shared_ptr<const std::vector<DiskInfo>> shown_disks_;
 
     void load_disks();
     void load_algorithms();
@@ -2,8 +2,12 @@
 
 #include <format>
 
-DiskRow::DiskRow(const DiskInfo& disk) : disk_(disk) {
+DiskRow::DiskRow() : Gtk::Box(Gtk::Orientation::HORIZONTAL, 0) {
     setup_from_builder();
+}
+
+void DiskRow::set_disk(const DiskInfo& disk) {
+    disk_ = disk;
     populate_from_disk_info();
 }
 
@@ -18,7 +22,8 @@ void DiskRow::setup_from_builder() {
     }
 
     // Set the content as our child
-    set_child(*row_content);
+    row_content->set_hexpand(true);
+    append(*row_content);
 
     // Get references to child widgets
     disk_icon_ = builder->get_widget<Gtk::Image>("disk_icon");
@@ -51,6 +56,10 @@ void DiskRow::populate_from_disk_info() {
         info_text += " [LVM]";
     }
 
+    if (disk_.is_thin_provisioned) {
+        info_text += " [Thin]";
+    }
+
     if (disk_.is_mounted) {
         info_text += " - Mounted at " + disk_.mount_point;
     }
@@ -128,6 +137,7 @@ void DiskRow::setup_health_indicator() {
     if (!tooltip.empty()) {
         // Remove trailing newline
         tooltip.pop_back();
-        health_box_->set_tooltip_text(tooltip);
     }
+    // Rows are reused for other disks, so always replace the previous tooltip
+    health_box_->set_tooltip_text(tooltip);
 }
@@ -1,8 +1,10 @@
 /**
  * @file DiskRow.hpp
- * @brief Disk list row composite widget using gtkmm4
+ * @brief Disk list row composite widget and list item using gtkmm4
  *
- * Represents a single disk entry in the disk selection list.
+ * Represents a single disk entry in the disk selection list. The list is a
+ * Gtk::ListView over a Gio::ListStore of DiskItem, so DiskRow widgets exist
+ * only for visible rows and are rebound to other items while scrolling.
  */
 
 #pragma once
@@ -11,6 +13,29 @@
 
 #include <gtkmm.h>
 
+#include <typeinfo>
+#include <utility>
+
+/**
+ * @class DiskItem
+ * @brief Immutable list model item holding one disk's information
+ */
+class DiskItem : public Glib::Object {
+public:
+    static auto create(DiskInfo disk) -> Glib::RefPtr<DiskItem> {
+        return Glib::make_refptr_for_instance<DiskItem>(new DiskItem(std::move(disk)));
+    }
+
+    [[nodiscard]] auto get_disk_info() const -> const DiskInfo& { return disk_; }
+
+protected:
+    explicit DiskItem(DiskInfo disk)
+        : Glib::ObjectBase(typeid(DiskItem)), disk_(std::move(disk)) {}
+
+private:
+    DiskInfo disk_;
+};
+
 /**
  * @class DiskRow
  * @brief Composite widget for displaying disk information in a list row
@@ -21,13 +46,9 @@
  * - Size, type (SSD/HDD), and mount status
  * - Mounted indicator badge
  */
-class DiskRow : public Gtk::ListBoxRow {
+class DiskRow : public Gtk::Box {
 public:
-    /**
-     * @brief Construct a new DiskRow from disk info
-     * @param disk The disk information to display
-     */
-    explicit DiskRow(const DiskInfo& disk);
+    DiskRow();
     ~DiskRow() override = default;
 
     // Prevent copying
@@ -36,6 +57,12 @@ public:
     DiskRow(DiskRow&&) = delete;
     DiskRow& operator=(DiskRow&&) = delete;
 
+    /**
+     * @brief Show a disk in this row (called when the row is bound to an item)
+     * @param disk The disk information to display
+     */
+    void set_disk(const DiskInfo& disk);
+
     /**
      * @brief Get the disk path this row represents
      * @return The device path (e.g., "/dev/sda")
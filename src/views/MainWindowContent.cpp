@@ -1,5 +1,6 @@
 #include "views/MainWindowContent.hpp"
 
+#include "util/StartupTrace.hpp"
 #include "views/AlgorithmRow.hpp"
 #include "views/DiskRow.hpp"
 
@@ -54,6 +55,7 @@ auto format_time(int64_t seconds) -> std::string {
 
 MainWindowContent::MainWindowContent() : Gtk::Box(Gtk::Orientation::VERTICAL, 0) {
     setup_from_builder();
+    setup_disk_list();
     setup_dispatcher();
     connect_signals();
 }
@@ -81,19 +83,44 @@ void MainWindowContent::setup_from_builder() {
     }
 
     // Get references to child widgets we need to interact with
-    disk_list_ = builder->get_widget<Gtk::ListBox>("disk_list");
+    disk_stack_ = builder->get_widget<Gtk::Stack>("disk_stack");
+    disk_status_label_ = builder->get_widget<Gtk::Label>("disk_status_label");
+    disk_list_ = builder->get_widget<Gtk::ListView>("disk_list");
     options_box_ = builder->get_widget<Gtk::Box>("options_box");
     progress_bar_ = builder->get_widget<Gtk::ProgressBar>("progress_bar");
     progress_label_ = builder->get_widget<Gtk::Label>("progress_label");
     wipe_button_ = builder->get_widget<Gtk::Button>("wipe_button");
     cancel_button_ = builder->get_widget<Gtk::Button>("cancel_button");
 
-    if (!disk_list_ || !options_box_ || !progress_bar_ || !progress_label_ || !wipe_button_ ||
-        !cancel_button_) {
+    if (!disk_stack_ || !disk_status_label_ || !disk_list_ || !options_box_ || !progress_bar_ ||
+        !progress_label_ || !wipe_button_ || !cancel_button_) {
         throw std::runtime_error("Failed to load main-window.ui: required widgets not found");
     }
 }
 
+void MainWindowContent::setup_disk_list() {
+    disk_store_ = Gio::ListStore<DiskItem>::create();
+    disk_selection_ = Gtk::SingleSelection::create(disk_store_);
+    disk_selection_->set_autoselect(false);
+    disk_selection_->set_can_unselect(true);
+
+    // Rows are created for visible items only and rebound while scrolling
+    auto factory = Gtk::SignalListItemFactory::create();
+    factory->signal_setup().connect([](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        list_item->set_child(*Gtk::make_managed<DiskRow>());
+    });
+    factory->signal_bind().connect([](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        auto item = std::dynamic_pointer_cast<DiskItem>(list_item->get_item());
+        auto* row = dynamic_cast<DiskRow*>(list_item->get_child());
+        if (item && row) {
+            row->set_disk(item->get_disk_info());
+        }
+    });
+
+    disk_list_->set_model(disk_selection_);
+    disk_list_->set_factory(factory);
+}
+
 void MainWindowContent::setup_dispatcher() {
     // Connect dispatcher to process pending UI updates on main thread
     dispatcher_.connect(sigc::mem_fun(*this, &MainWindowContent::process_pending_tasks));
@@ -101,7 +128,7 @@ void MainWindowContent::setup_dispatcher() {
 
 void MainWindowContent::connect_signals() {
     // Disk list selection
-    disk_list_->signal_row_selected().connect(
+    disk_selection_->property_selected().signal_changed().connect(
         sigc::mem_fun(*this, &MainWindowContent::on_disk_selected));
 
     // Button clicks
@@ -148,32 +175,44 @@ void MainWindowContent::bind_disks() {
     if (!view_model_)
         return;
 
-    auto id = view_model_->disks.subscribe([this](const std::vector<DiskInfo>& disks) {
-        auto disks_copy = disks;
-        post_ui_update(
-            [this, disks_copy = std::move(disks_copy)]() { update_disk_list(disks_copy); });
+    // Updates carry an immutable snapshot, so the UI thread shares it instead of copying
+    auto id = view_model_->disk_list_update.subscribe([this](const DiskListUpdate& update) {
+        post_ui_update([this, update]() { update_disk_list(update); });
     });
     subscriptions_.push_back(id);
 
-    // Initialize with current value (subscribe doesn't call callback with existing value)
-    update_disk_list(view_model_->disks.get());
+    // Initialize with current value; with no edits the list is filled from scratch
+    update_disk_list(DiskListUpdate{.disks = view_model_->disks.get(), .edits = {}});
+
+    // Placeholder until the helper has answered, then the list
+    auto loaded_id = view_model_->disks_loaded.subscribe([this](const bool& loaded) {
+        post_ui_update([this, loaded]() {
+            update_disk_placeholder(loaded, view_model_->connection_error.get());
+        });
+    });
+    subscriptions_.push_back(loaded_id);
+
+    auto error_id = view_model_->connection_error.subscribe([this](const std::string& error) {
+        post_ui_update([this, error]() {
+            update_disk_placeholder(view_model_->disks_loaded.get(), error);
+        });
+    });
+    subscriptions_.push_back(error_id);
+
+    update_disk_placeholder(view_model_->disks_loaded.get(), view_model_->connection_error.get());
 }
 
 void MainWindowContent::bind_algorithms() {
     if (!view_model_)
         return;
 
-    auto id =
-        view_model_->algorithms.subscribe([this](const std::vector<AlgorithmInfo>& algorithms) {
-            auto algos_copy = algorithms;
-            post_ui_update([this, algos_copy = std::move(algos_copy)]() {
-                update_algorithm_list(algos_copy);
-            });
-        });
+    auto id = view_model_->algorithms.subscribe([this](const auto& algorithms) {
+        post_ui_update([this, algorithms]() { update_algorithm_list(*algorithms); });
+    });
     subscriptions_.push_back(id);
 
     // Initialize with current value (subscribe doesn't call callback with existing value)
-    update_algorithm_list(view_model_->algorithms.get());
+    update_algorithm_list(*view_model_->algorithms.get());
 }
 
 void MainWindowContent::bind_progress() {
@@ -206,44 +245,40 @@ void MainWindowContent::bind_can_wipe() {
     }
 }
 
-void MainWindowContent::update_disk_list(const std::vector<DiskInfo>& disks) {
-    if (!disk_list_)
+void MainWindowContent::update_disk_list(const DiskListUpdate& update) {
+    if (!disk_store_ || !update.disks)
         return;
+    const auto& disks = *update.disks;
 
-    // Save the selected path before clearing (clearing triggers row-selected with nullptr)
+    // Save the selected path; removing or replacing the selected row clears the selection
     std::string selected_path;
     if (view_model_) {
         selected_path = view_model_->selected_disk_path.get();
     }
 
-    // Set flag to ignore selection changes during list rebuild
+    // Set flag to ignore selection changes during list update
     updating_disk_list_ = true;
 
-    // Clear existing rows
-    while (auto* child = disk_list_->get_first_child()) {
-        disk_list_->remove(*child);
-    }
-
-    // Add new rows
-    for (const auto& disk : disks) {
-        auto* row = Gtk::make_managed<DiskRow>(disk);
-        disk_list_->append(*row);
+    // Touch only changed rows. If the store is out of step with the edits
+    // (e.g. an update raced the initial fill), replace everything instead.
+    if (!apply_disk_edits(update)) {
+        std::vector<Glib::RefPtr<DiskItem>> items;
+        items.reserve(disks.size());
+        for (const auto& disk : disks) {
+            items.push_back(DiskItem::create(disk));
+        }
+        disk_store_->splice(0, disk_store_->get_n_items(), items);
     }
 
     // Restore selection if a disk was previously selected
-    if (!selected_path.empty()) {
-        for (int i = 0;; ++i) {
-            auto* row = disk_list_->get_row_at_index(i);
-            if (!row)
-                break;
-
-            auto* disk_row = dynamic_cast<DiskRow*>(row);
-            if (disk_row && disk_row->get_disk_path() == selected_path) {
-                disk_list_->select_row(*row);
-                break;
-            }
+    guint selected = GTK_INVALID_LIST_POSITION;
+    for (guint i = 0; i < disks.size(); ++i) {
+        if (!selected_path.empty() && disks[i].path == selected_path) {
+            selected = i;
+            break;
         }
     }
+    disk_selection_->set_selected(selected);
 
     // Re-enable selection handling
     updating_disk_list_ = false;
@@ -254,6 +289,66 @@ void MainWindowContent::update_disk_list(const std::vector<DiskInfo>& disks) {
     }
 }
 
+auto MainWindowContent::apply_disk_edits(const DiskListUpdate& update) -> bool {
+    const auto& disks = *update.disks;
+    for (const auto& edit : update.edits) {
+        const auto size = static_cast<std::size_t>(disk_store_->get_n_items());
+        const auto position = static_cast<guint>(edit.position);
+        if (edit.kind != DiskListEdit::Kind::REMOVE && edit.source >= disks.size()) {
+            return false;
+        }
+        switch (edit.kind) {
+            case DiskListEdit::Kind::INSERT:
+                if (edit.position > size) {
+                    return false;
+                }
+                disk_store_->insert(position, DiskItem::create(disks[edit.source]));
+                break;
+            case DiskListEdit::Kind::REMOVE:
+                if (edit.position >= size) {
+                    return false;
+                }
+                disk_store_->remove(position);
+                break;
+            case DiskListEdit::Kind::UPDATE:
+                if (edit.position >= size) {
+                    return false;
+                }
+                // Replacing the item makes the view rebind just this row
+                disk_store_->splice(position, 1,
+                                    std::vector{DiskItem::create(disks[edit.source])});
+                break;
+        }
+    }
+
+    if (disk_store_->get_n_items() != disks.size()) {
+        return false;
+    }
+    for (guint i = 0; i < disks.size(); ++i) {
+        auto item = disk_store_->get_item(i);
+        if (!item || item->get_disk_info().path != disks[i].path) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MainWindowContent::update_disk_placeholder(bool loaded,
+                                                const std::string& connection_error) {
+    if (loaded) {
+        if (disk_stack_->get_visible_child_name() != "list") {
+            disk_stack_->set_visible_child("list");
+            util::StartupTrace::instance().mark(util::StartupTrace::DISKS_SHOWN);
+            util::StartupTrace::instance().finish();
+        }
+        return;
+    }
+
+    disk_status_label_->set_text(connection_error.empty()
+                                     ? "Connecting to storage-wiper-helper…"
+                                     : "Waiting for storage-wiper-helper: " + connection_error);
+}
+
 void MainWindowContent::update_algorithm_list(const std::vector<AlgorithmInfo>& algorithms) {
     if (!options_box_)
         return;
@@ -310,6 +405,12 @@ void MainWindowContent::update_progress(const WipeProgress& progress) {
             status << " - ETA: " << format_time(progress.estimated_seconds_remaining);
         }
 
+        // Backed off for other workloads on the host
+        if (progress.rate_multiplier < 1.0) {
+            status << " (throttled to " << static_cast<int>(progress.rate_multiplier * 100.0)
+                   << "% for host load)";
+        }
+
         progress_label_->set_text(status.str());
     }
 
@@ -331,22 +432,16 @@ void MainWindowContent::update_progress_visibility(bool visible) {
     }
 }
 
-void MainWindowContent::on_disk_selected(Gtk::ListBoxRow* row) {
+void MainWindowContent::on_disk_selected() {
     if (!view_model_)
         return;
 
-    // Ignore selection changes during list updates (e.g., when clearing rows)
+    // Ignore selection changes during list updates (e.g., when removing rows)
     if (updating_disk_list_)
         return;
 
-    if (row) {
-        auto* disk_row = dynamic_cast<DiskRow*>(row);
-        if (disk_row) {
-            view_model_->select_disk(disk_row->get_disk_path());
-        }
-    } else {
-        view_model_->select_disk("");
-    }
+    auto item = std::dynamic_pointer_cast<DiskItem>(disk_selection_->get_selected_item());
+    view_model_->select_disk(item ? item->get_disk_info().path : "");
 }
 
 void MainWindowContent::on_wipe_clicked() {
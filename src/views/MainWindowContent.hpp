@@ -9,6 +9,7 @@
 #pragma once
 
 #include "viewmodels/MainViewModel.hpp"
+#include "views/DiskRow.hpp"
 
 #include <gtkmm.h>
 
@@ -18,7 +19,6 @@
 #include <vector>
 
 // Forward declarations
-class DiskRow;
 class AlgorithmRow;
 
 /**
@@ -60,13 +60,19 @@ private:
     std::shared_ptr<MainViewModel> view_model_;
 
     // Template child widgets (from UI file)
-    Gtk::ListBox* disk_list_ = nullptr;
+    Gtk::Stack* disk_stack_ = nullptr;
+    Gtk::Label* disk_status_label_ = nullptr;
+    Gtk::ListView* disk_list_ = nullptr;
     Gtk::Box* options_box_ = nullptr;
     Gtk::ProgressBar* progress_bar_ = nullptr;
     Gtk::Label* progress_label_ = nullptr;
     Gtk::Button* wipe_button_ = nullptr;
     Gtk::Button* cancel_button_ = nullptr;
 
+    // Virtualized disk list: rows exist only for visible items
+    Glib::RefPtr<Gio::ListStore<DiskItem>> disk_store_;
+    Glib::RefPtr<Gtk::SingleSelection> disk_selection_;
+
     // Algorithm radio button group
     std::vector<AlgorithmRow*> algorithm_rows_;
     Gtk::CheckButton* first_radio_ = nullptr;
@@ -84,6 +90,7 @@ private:
 
     // Setup methods
     void setup_from_builder();
+    void setup_disk_list();
     void setup_dispatcher();
     void connect_signals();
 
@@ -98,13 +105,15 @@ private:
     void bind_can_wipe();
 
     // UI update methods (called from bindings via dispatcher)
-    void update_disk_list(const std::vector<DiskInfo>& disks);
+    void update_disk_list(const DiskListUpdate& update);
+    void update_disk_placeholder(bool loaded, const std::string& connection_error);
+    auto apply_disk_edits(const DiskListUpdate& update) -> bool;
     void update_algorithm_list(const std::vector<AlgorithmInfo>& algorithms);
     void update_progress(const WipeProgress& progress);
     void update_progress_visibility(bool visible);
 
     // Signal handlers
-    void on_disk_selected(Gtk::ListBoxRow* row);
+    void on_disk_selected();
     void on_wipe_clicked();
     void on_cancel_clicked();
 };
@@ -0,0 +1,87 @@
+/**
+ * @file MainLoopProbe.hpp
+ * @brief Frame pacing and dispatch latency of the default GLib main context
+ *
+ * Two periodic sources stand in for what a user would notice:
+ * - A 60 Hz source at GTK's redraw priority records the interval between
+ *   consecutive "frames". It measures pacing only; no widgets are painted.
+ * - A short default-priority timeout records how late each dispatch was
+ *   relative to its due time, i.e. how long ready work waited for the loop.
+ */
+
+#pragma once
+
+#include "fixtures/ProgressReplay.hpp"
+
+#include <glibmm.h>
+
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Samples frame intervals and loop latency while it is alive
+ */
+class MainLoopProbe {
+public:
+    static constexpr auto FRAME_INTERVAL = std::chrono::milliseconds{16};
+    static constexpr auto PROBE_INTERVAL = std::chrono::milliseconds{4};
+
+    // GDK_PRIORITY_REDRAW; GTK's frame clock paints at this priority
+    static constexpr int FRAME_PRIORITY = G_PRIORITY_HIGH_IDLE + 20;
+
+    MainLoopProbe() {
+        last_frame_ = last_probe_ = Clock::now();
+        frame_connection_ = Glib::signal_timeout().connect(
+            [this]() {
+                const auto now = Clock::now();
+                frames_.push_back(to_us(now - last_frame_));
+                last_frame_ = now;
+                return true;
+            },
+            static_cast<unsigned>(FRAME_INTERVAL.count()), FRAME_PRIORITY);
+        probe_connection_ = Glib::signal_timeout().connect(
+            [this]() {
+                // GLib re-arms a timeout from its dispatch time
+                const auto now = Clock::now();
+                const auto due = last_probe_ + PROBE_INTERVAL;
+                latency_.push_back(now > due ? to_us(now - due) : std::chrono::microseconds{0});
+                last_probe_ = now;
+                return true;
+            },
+            static_cast<unsigned>(PROBE_INTERVAL.count()), G_PRIORITY_DEFAULT);
+    }
+
+    ~MainLoopProbe() { stop(); }
+
+    MainLoopProbe(const MainLoopProbe&) = delete;
+    MainLoopProbe& operator=(const MainLoopProbe&) = delete;
+    MainLoopProbe(MainLoopProbe&&) = delete;
+    MainLoopProbe& operator=(MainLoopProbe&&) = delete;
+
+    void stop() {
+        frame_connection_.disconnect();
+        probe_connection_.disconnect();
+    }
+
+    [[nodiscard]] auto frame_intervals() const -> DurationStats {
+        return DurationStats::of(frames_);
+    }
+
+    [[nodiscard]] auto loop_latency() const -> DurationStats {
+        return DurationStats::of(latency_);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static auto to_us(Clock::duration d) -> std::chrono::microseconds {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d);
+    }
+
+    sigc::connection frame_connection_;
+    sigc::connection probe_connection_;
+    Clock::time_point last_frame_;
+    Clock::time_point last_probe_;
+    std::vector<std::chrono::microseconds> frames_;
+    std::vector<std::chrono::microseconds> latency_;
+};
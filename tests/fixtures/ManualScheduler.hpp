@@ -0,0 +1,79 @@
+/**
+ * @file ManualScheduler.hpp
+ * @brief Test double for util::Scheduler with virtual time
+ */
+
+#pragma once
+
+#include "util/Coroutine.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+
+/**
+ * @brief Single-threaded scheduler with virtual time, driven explicitly by the test
+ *
+ * post() may be called from any thread (run_blocking completions do so); timers
+ * fire in due order when the test runs out of immediate work.
+ */
+class ManualScheduler final : public util::Scheduler {
+public:
+    void post(Callback callback) override {
+        {
+            std::lock_guard lock{mutex_};
+            ready_.push_back(std::move(callback));
+        }
+        posted_.notify_all();
+    }
+
+    void post_after(std::chrono::milliseconds delay, Callback callback) override {
+        std::lock_guard lock{mutex_};
+        timers_.emplace(now_ + delay, std::move(callback));
+    }
+
+    /**
+     * @brief Run callbacks until done() holds, advancing virtual time as needed
+     * @return false if the real-time limit expired first
+     */
+    template <typename Pred>
+    auto run_until(Pred done, std::chrono::milliseconds limit = std::chrono::milliseconds{5'000})
+        -> bool {
+        const auto deadline = std::chrono::steady_clock::now() + limit;
+        while (!done()) {
+            Callback next;
+            {
+                std::unique_lock lock{mutex_};
+                if (ready_.empty() && !timers_.empty()) {
+                    auto it = timers_.begin();
+                    now_ = it->first;
+                    ready_.push_back(std::move(it->second));
+                    timers_.erase(it);
+                }
+                if (ready_.empty()) {
+                    if (!posted_.wait_until(lock, deadline, [this] { return !ready_.empty(); })) {
+                        return done();
+                    }
+                }
+                next = std::move(ready_.front());
+                ready_.pop_front();
+            }
+            next();
+        }
+        return true;
+    }
+
+    [[nodiscard]] auto now() const -> std::chrono::milliseconds {
+        std::lock_guard lock{mutex_};
+        return now_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable posted_;
+    std::deque<Callback> ready_;
+    std::multimap<std::chrono::milliseconds, Callback> timers_;
+    std::chrono::milliseconds now_{0};
+};
@@ -0,0 +1,271 @@
+/**
+ * @file ProgressReplay.hpp
+ * @brief Synthetic and recorded WipeProgress streams replayed in real time
+ *
+ * Drives the progress pipeline (MainViewModel, cli::ProgressDisplay) at update
+ * rates no real disk produces, so its cost can be measured and gated without
+ * hardware. A trace is either generated (rate, concurrent jobs, jitter) or read
+ * from a recording; ProgressReplayer plays it from a producer thread, as the
+ * helper's signals would arrive, while the test thread pumps its event loop.
+ *
+ * The benchmarks read these environment variables to replay other scenarios:
+ * - STORAGE_WIPER_REPLAY_TRACE: recorded trace file (overrides the generator)
+ * - STORAGE_WIPER_REPLAY_RATE: updates per second per job
+ * - STORAGE_WIPER_REPLAY_JOBS: concurrent jobs
+ * - STORAGE_WIPER_REPLAY_JITTER: interval jitter as a fraction (0.0-1.0)
+ * - STORAGE_WIPER_REPLAY_SECONDS: generated trace length
+ */
+
+#pragma once
+
+#include "models/WipeTypes.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+/**
+ * @brief Shape of a generated trace
+ */
+struct ProgressTraceConfig {
+    double rate_hz = 1'000.0;  // Updates per second per job
+    std::size_t jobs = 1;
+    std::chrono::milliseconds duration{1'000};
+    double jitter = 0.0;  // Fraction of the update interval, applied uniformly +/-
+    uint32_t seed = 1;
+    uint64_t total_bytes = 1'000'000'000'000;
+    int passes = 3;
+};
+
+/**
+ * @brief One progress update at an offset from the start of the replay
+ */
+struct TraceEvent {
+    std::chrono::microseconds at;
+    std::size_t job;
+    WipeProgress progress;
+};
+
+/**
+ * @brief Generate a trace of steadily advancing jobs, each ending with a completion
+ */
+inline auto make_synthetic_trace(const ProgressTraceConfig& config) -> std::vector<TraceEvent> {
+    std::vector<TraceEvent> trace;
+    std::mt19937 rng{config.seed};
+    const double interval_us = 1'000'000.0 / config.rate_hz;
+    std::uniform_real_distribution<double> jitter{-config.jitter, config.jitter};
+    const auto end_us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(config.duration).count());
+
+    for (std::size_t job = 0; job < config.jobs; ++job) {
+        // Stagger job starts so updates do not arrive in lockstep
+        double at = interval_us * static_cast<double>(job) / static_cast<double>(config.jobs);
+        while (true) {
+            const double fraction = std::min(at / end_us, 1.0);
+            const bool complete = fraction >= 1.0;
+            const int pass =
+                std::min(static_cast<int>(fraction * config.passes), config.passes - 1);
+            const auto total = config.total_bytes * static_cast<uint64_t>(config.passes);
+
+            WipeProgress progress;
+            progress.bytes_written = static_cast<uint64_t>(fraction * static_cast<double>(total));
+            progress.total_bytes = total;
+            progress.current_pass = pass + 1;
+            progress.total_passes = config.passes;
+            progress.percentage = fraction * 100.0;
+            progress.status = complete ? "Completed" : std::format("Pass {}", pass + 1);
+            progress.is_complete = complete;
+            progress.speed_bytes_per_sec = 200'000'000;
+            trace.push_back(TraceEvent{.at = std::chrono::microseconds{static_cast<int64_t>(at)},
+                                       .job = job,
+                                       .progress = std::move(progress)});
+            if (complete) {
+                break;
+            }
+            at = std::min(at + interval_us * (1.0 + jitter(rng)), end_us);
+        }
+    }
+
+    std::ranges::stable_sort(trace, {}, &TraceEvent::at);
+    return trace;
+}
+
+/**
+ * @brief Write a trace as tab-separated lines
+ *
+ * Columns: offset_us, job, percentage, current_pass, total_passes,
+ * bytes_written, total_bytes, speed_bytes_per_sec, is_complete, status.
+ */
+inline void write_progress_trace(std::ostream& out, const std::vector<TraceEvent>& trace) {
+    for (const auto& event : trace) {
+        const auto& p = event.progress;
+        out << event.at.count() << '\t' << event.job << '\t' << p.percentage << '\t'
+            << p.current_pass << '\t' << p.total_passes << '\t' << p.bytes_written << '\t'
+            << p.total_bytes << '\t' << p.speed_bytes_per_sec << '\t' << (p.is_complete ? 1 : 0)
+            << '\t' << p.status << '\n';
+    }
+}
+
+/**
+ * @brief Read a trace written by write_progress_trace()
+ *
+ * Blank lines and lines starting with '#' are skipped. Events are sorted by
+ * offset, so recordings may be concatenated.
+ */
+inline auto read_progress_trace(std::istream& in) -> std::vector<TraceEvent> {
+    std::vector<TraceEvent> trace;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        std::istringstream fields{line};
+        int64_t at = 0;
+        int complete = 0;
+        TraceEvent event{};
+        auto& p = event.progress;
+        fields >> at >> event.job >> p.percentage >> p.current_pass >> p.total_passes >>
+            p.bytes_written >> p.total_bytes >> p.speed_bytes_per_sec >> complete;
+        if (!fields) {
+            continue;
+        }
+        fields >> std::ws;
+        std::getline(fields, p.status);
+        event.at = std::chrono::microseconds{at};
+        p.is_complete = complete != 0;
+        trace.push_back(std::move(event));
+    }
+    std::ranges::stable_sort(trace, {}, &TraceEvent::at);
+    return trace;
+}
+
+/**
+ * @brief Trace selected by the STORAGE_WIPER_REPLAY_* environment variables
+ * @param defaults Generator settings for variables that are not set
+ */
+inline auto trace_from_environment(ProgressTraceConfig defaults) -> std::vector<TraceEvent> {
+    if (const char* path = std::getenv("STORAGE_WIPER_REPLAY_TRACE"); path && *path) {
+        std::ifstream file{path};
+        return read_progress_trace(file);
+    }
+    if (const char* rate = std::getenv("STORAGE_WIPER_REPLAY_RATE")) {
+        defaults.rate_hz = std::strtod(rate, nullptr);
+    }
+    if (const char* jobs = std::getenv("STORAGE_WIPER_REPLAY_JOBS")) {
+        defaults.jobs = std::strtoul(jobs, nullptr, 10);
+    }
+    if (const char* jitter = std::getenv("STORAGE_WIPER_REPLAY_JITTER")) {
+        defaults.jitter = std::strtod(jitter, nullptr);
+    }
+    if (const char* seconds = std::getenv("STORAGE_WIPER_REPLAY_SECONDS")) {
+        defaults.duration = std::chrono::milliseconds{
+            static_cast<int64_t>(std::strtod(seconds, nullptr) * 1'000.0)};
+    }
+    return make_synthetic_trace(defaults);
+}
+
+/**
+ * @brief Distribution summary of a set of durations
+ */
+struct DurationStats {
+    std::size_t count = 0;
+    std::chrono::microseconds p50{0};
+    std::chrono::microseconds p99{0};
+    std::chrono::microseconds max{0};
+
+    static auto of(std::vector<std::chrono::microseconds> samples) -> DurationStats {
+        if (samples.empty()) {
+            return {};
+        }
+        std::ranges::sort(samples);
+        auto at = [&samples](double q) {
+            return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))];
+        };
+        return DurationStats{
+            .count = samples.size(), .p50 = at(0.50), .p99 = at(0.99), .max = samples.back()};
+    }
+};
+
+/**
+ * @brief What one replay cost
+ */
+struct ReplayReport {
+    std::size_t delivered = 0;
+    std::chrono::microseconds wall{0};
+    std::chrono::microseconds cpu{0};  // User + system time of the whole process
+
+    /// CPU time per wall-clock second, in cores
+    [[nodiscard]] auto cpu_load() const -> double {
+        if (wall.count() <= 0) {
+            return 0.0;
+        }
+        return static_cast<double>(cpu.count()) / static_cast<double>(wall.count());
+    }
+};
+
+/**
+ * @brief Plays a trace in real time from a producer thread
+ */
+class ProgressReplayer {
+public:
+    using Sink = std::function<void(const TraceEvent&)>;
+
+    /**
+     * @brief Replay a trace
+     * @param trace Events ordered by offset
+     * @param sink Receives every event on the producer thread
+     * @param pump Called repeatedly on this thread until the producer is done;
+     *             it should block briefly (e.g. one event-loop iteration)
+     */
+    static auto replay(const std::vector<TraceEvent>& trace, const Sink& sink,
+                       const std::function<void()>& pump) -> ReplayReport {
+        std::atomic<bool> done{false};
+        std::atomic<std::size_t> delivered{0};
+        const auto cpu_before = process_cpu_time();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::thread producer([&] {
+            for (const auto& event : trace) {
+                std::this_thread::sleep_until(start + event.at);
+                sink(event);
+                delivered.fetch_add(1, std::memory_order_relaxed);
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        while (!done.load(std::memory_order_acquire)) {
+            pump();
+        }
+        producer.join();
+
+        return ReplayReport{.delivered = delivered.load(),
+                            .wall = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start),
+                            .cpu = process_cpu_time() - cpu_before};
+    }
+
+private:
+    static auto process_cpu_time() -> std::chrono::microseconds {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        auto to_us = [](const timeval& tv) {
+            return std::chrono::seconds{tv.tv_sec} + std::chrono::microseconds{tv.tv_usec};
+        };
+        return to_us(usage.ru_utime) + to_us(usage.ru_stime);
+    }
+};
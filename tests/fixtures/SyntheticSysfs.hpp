@@ -0,0 +1,204 @@
+/**
+ * @file SyntheticSysfs.hpp
+ * @brief Generator for synthetic /sys/block, /proc/mounts and /dev trees
+ *
+ * Builds a throwaway topology in a temporary directory so DiskService enumeration
+ * can be exercised (and timed) at arbitrary scale without real hardware.
+ */
+
+#pragma once
+
+#include "helper/services/DiskService.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/**
+ * @brief Shape of the generated topology
+ */
+struct SyntheticTopology {
+    std::size_t disk_count = 8;
+    std::size_t partitions_per_disk = 2;
+    // Every Nth disk gets its first partition mounted directly (0 = never)
+    std::size_t mount_every = 2;
+    // Every Nth disk gets a dm holder on its last partition, mounted via /dev/mapper (0 = never)
+    std::size_t dm_every = 3;
+    // Every Nth disk is a thin-provisioned SCSI LUN (provisioning_mode=unmap) (0 = never)
+    std::size_t thin_every = 4;
+    // Extra unrelated mount table lines (tmpfs, proc, ...) to widen the table
+    std::size_t noise_mounts = 16;
+    uint64_t sectors = 2'097'152;  // 1 GiB
+};
+
+/**
+ * @brief Expected properties of one generated disk
+ */
+struct SyntheticDisk {
+    std::string name;
+    bool mounted = false;
+    bool lvm_pv = false;
+    bool ssd = false;
+    std::string mount_point;
+    bool thin = false;
+};
+
+/**
+ * @brief Temporary sysfs/procfs/dev tree that removes itself on destruction
+ */
+class SyntheticSysfs {
+public:
+    explicit SyntheticSysfs(const SyntheticTopology& topology) {
+        auto tmpl =
+            (std::filesystem::temp_directory_path() / "storage_wiper_sysfs_XXXXXX").string();
+        if (::mkdtemp(tmpl.data()) == nullptr) {
+            throw std::filesystem::filesystem_error(
+                "mkdtemp failed", tmpl, std::error_code{errno, std::generic_category()});
+        }
+        root_ = tmpl;
+        generate(topology);
+    }
+
+    ~SyntheticSysfs() {
+        std::error_code ec;
+        std::filesystem::remove_all(root_, ec);
+    }
+
+    SyntheticSysfs(const SyntheticSysfs&) = delete;
+    SyntheticSysfs& operator=(const SyntheticSysfs&) = delete;
+    SyntheticSysfs(SyntheticSysfs&&) = delete;
+    SyntheticSysfs& operator=(SyntheticSysfs&&) = delete;
+
+    /**
+     * @brief Roots to hand to DiskService
+     */
+    [[nodiscard]] auto paths() const -> SystemPaths {
+        return SystemPaths{.sys_block = root_ / "sys" / "block",
+                           .proc_mounts = root_ / "proc" / "mounts",
+                           .dev = root_ / "dev"};
+    }
+
+    [[nodiscard]] auto disks() const -> const std::vector<SyntheticDisk>& { return disks_; }
+
+    /**
+     * @brief Top of the tree; files placed here are removed with it
+     */
+    [[nodiscard]] auto root() const -> const std::filesystem::path& { return root_; }
+
+    /**
+     * @brief Kernel-style disk name for an index: sda..sdz, sdaa..sdzz, ...
+     */
+    [[nodiscard]] static auto disk_name(std::size_t index) -> std::string {
+        std::string suffix;
+        ++index;
+        while (index > 0) {
+            --index;
+            suffix.insert(suffix.begin(), static_cast<char>('a' + (index % 26)));
+            index /= 26;
+        }
+        return "sd" + suffix;
+    }
+
+private:
+    static void write_file(const std::filesystem::path& path, const std::string& content) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream{path} << content << '\n';
+    }
+
+    void generate(const SyntheticTopology& topology) {
+        namespace fs = std::filesystem;
+
+        const auto sys_block = root_ / "sys" / "block";
+        const auto dev = root_ / "dev";
+        fs::create_directories(sys_block);
+        fs::create_directories(dev / "mapper");
+
+        std::string mounts;
+        for (std::size_t i = 0; i < topology.noise_mounts; ++i) {
+            mounts += std::format("tmpfs /run/noise{} tmpfs rw 0 0\n", i);
+        }
+
+        // Virtual devices must be skipped by enumeration
+        write_file(sys_block / "loop0" / "size", "0");
+
+        std::size_t dm_index = 0;
+        for (std::size_t i = 0; i < topology.disk_count; ++i) {
+            const bool thin = topology.thin_every != 0 && (i + 1) % topology.thin_every == 0;
+            SyntheticDisk disk{.name = disk_name(i),
+                               .mounted = false,
+                               .lvm_pv = false,
+                               .ssd = (i % 2) == 0,
+                               .mount_point = {},
+                               .thin = thin};
+            const auto disk_dir = sys_block / disk.name;
+
+            write_file(disk_dir / "size", std::to_string(topology.sectors));
+            write_file(disk_dir / "removable", "0");
+            write_file(disk_dir / "queue" / "rotational", disk.ssd ? "0" : "1");
+            write_file(disk_dir / "device" / "model", std::format("Synthetic {}   ", i));
+            write_file(disk_dir / "device" / "serial", std::format("SYN{:06}", i));
+            fs::create_directories(disk_dir / "holders");
+            if (disk.thin) {
+                write_file(disk_dir / "queue" / "discard_max_bytes", "4294966784");
+                write_file(disk_dir / "device" / "scsi_disk" / "0:0:0:0" / "provisioning_mode",
+                           "unmap");
+            }
+            write_file(dev / disk.name, "");
+
+            for (std::size_t p = 1; p <= topology.partitions_per_disk; ++p) {
+                const auto part = std::format("{}{}", disk.name, p);
+                write_file(disk_dir / part / "size", std::to_string(topology.sectors / 4));
+                fs::create_directories(disk_dir / part / "holders");
+            }
+
+            const bool has_parts = topology.partitions_per_disk > 0;
+            if (has_parts && topology.mount_every != 0 && i % topology.mount_every == 0) {
+                disk.mounted = true;
+                disk.mount_point = std::format("/mnt/{}", disk.name);
+                mounts += std::format("/dev/{}1 {} ext4 rw 0 0\n", disk.name, disk.mount_point);
+            }
+
+            if (has_parts && topology.dm_every != 0 && i % topology.dm_every == 0) {
+                const auto dm = std::format("dm-{}", dm_index++);
+                const auto part =
+                    std::format("{}{}", disk.name, topology.partitions_per_disk);
+                fs::create_directories(disk_dir / part / "holders" / dm);
+                write_file(sys_block / dm / "size", std::to_string(topology.sectors / 4));
+                const auto lv = std::format("vg-lv_{}", disk.name);
+                fs::create_symlink(fs::path{".."} / dm, dev / "mapper" / lv);
+                disk.lvm_pv = true;
+                if (!disk.mounted) {
+                    disk.mounted = true;
+                    disk.mount_point = std::format("/srv/{}", disk.name);
+                    mounts +=
+                        std::format("/dev/mapper/{} {} xfs rw 0 0\n", lv, disk.mount_point);
+                }
+            }
+
+            disks_.push_back(std::move(disk));
+        }
+
+        write_file(root_ / "proc" / "mounts", mounts);
+    }
+
+    std::filesystem::path root_;
+    std::vector<SyntheticDisk> disks_;
+};
+
+/**
+ * @brief DiskService that accepts the regular files a SyntheticSysfs puts in /dev
+ */
+class SyntheticDiskService final : public DiskService {
+public:
+    using DiskService::DiskService;
+
+protected:
+    [[nodiscard]] auto is_device_node(mode_t /*mode*/) const -> bool override { return true; }
+};
@@ -19,6 +19,8 @@
 #include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <future>
 #include <memory>
 #include <string>
@@ -180,6 +182,54 @@ private:
     std::string path_;
 };
 
+/**
+ * @brief RAII helper for a temporary directory holding fake sysfs/cgroupfs/procfs trees
+ */
+class TempTestDir {
+public:
+    TempTestDir() {
+        char templ[] = "/tmp/storage_wiper_test_XXXXXX";
+        if (mkdtemp(templ) != nullptr) {
+            path_ = templ;
+        }
+    }
+
+    ~TempTestDir() {
+        if (!path_.empty()) {
+            std::error_code ec;
+            std::filesystem::remove_all(path_, ec);
+        }
+    }
+
+    // Non-copyable
+    TempTestDir(const TempTestDir&) = delete;
+    TempTestDir& operator=(const TempTestDir&) = delete;
+
+    const std::filesystem::path& path() const { return path_; }
+    bool valid() const { return !path_.empty(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+/**
+ * @brief Write a one-line attribute file the way sysfs shows it, creating parent directories
+ */
+inline void write_value(const std::filesystem::path& path, const std::string& value) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream{path} << value << '\n';
+}
+
+/**
+ * @brief First line of an attribute file, empty if it cannot be read
+ */
+inline auto read_value(const std::filesystem::path& path) -> std::string {
+    std::ifstream file{path};
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
 /**
  * @brief RAII helper for temporary test buffers
  */
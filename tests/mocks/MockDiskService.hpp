@@ -57,6 +57,7 @@ public:
                         .is_mounted = mounted,
                         .mount_point = mounted ? "/mnt/test" : "",
                         .is_lvm_pv = false,
-                        .smart = {}};
+                        .smart = {},
+                        .is_thin_provisioned = false};
     }
 };
@@ -89,3 +89,17 @@ TEST_F(ATASecureEraseAlgorithmTest, ExecuteOnDevice_InvalidPath_ReportsError) {
     }
     EXPECT_TRUE(found_error);
 }
+
+// Test: hardware erases are verified by sampled readback
+TEST_F(ATASecureEraseAlgorithmTest, SupportsVerification_ReturnsTrue) {
+    EXPECT_TRUE(algorithm.supports_verification());
+}
+
+// Test: without pre-erase samples, a uniform fill still verifies
+TEST_F(ATASecureEraseAlgorithmTest, Verify_UniformFillWithoutPreSamples_Passes) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(1'024 * 1'024));
+
+    EXPECT_TRUE(algorithm.verify(temp_file.fd(), 1'024 * 1'024, nullptr, cancel_flag));
+}
@@ -0,0 +1,233 @@
+/**
+ * @file AdaptiveWriterTest.cpp
+ * @brief Unit tests for the AIMD write controller and the parallel overwrite loop
+ */
+
+#include "algorithms/AdaptiveWriter.hpp"
+#include "util/Keystream.hpp"
+#include "util/WritePacer.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = WriteController::Clock;
+using Reason = WriteController::Reason;
+
+/**
+ * @brief Drive model: each stream runs at a fixed rate after a per-request overhead, up to
+ *        a device-wide ceiling
+ */
+struct SimulatedDrive {
+    double overhead_s = 0.001;
+    double stream_bps = 200e6;
+    double ceiling_bps = 800e6;
+
+    auto throughput(const WriteController::Settings& settings) const -> double {
+        const auto request = static_cast<double>(settings.request_bytes);
+        const double service_s = overhead_s + (request / stream_bps);
+        return std::min(static_cast<double>(settings.depth) * request / service_s, ceiling_bps);
+    }
+};
+
+/**
+ * @brief Feed `completions` requests through the controller, collecting its adjustments
+ */
+auto run(WriteController& controller, const SimulatedDrive& drive, int completions,
+         Clock::time_point& now) -> std::vector<WriteController::Adjustment> {
+    std::vector<WriteController::Adjustment> adjustments;
+    for (int i = 0; i < completions; ++i) {
+        const auto settings = controller.settings();
+        const double throughput = drive.throughput(settings);
+        const auto request = static_cast<double>(settings.request_bytes);
+        // Little's law: everything in flight waits its turn
+        const auto latency = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(settings.depth) * request /
+                                          throughput));
+        now += std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(request / throughput));
+        if (auto adjustment = controller.record(settings.request_bytes, latency, now)) {
+            adjustments.push_back(*adjustment);
+        }
+    }
+    return adjustments;
+}
+
+auto count(const std::vector<WriteController::Adjustment>& adjustments, Reason reason) -> long {
+    return std::ranges::count_if(adjustments,
+                                 [reason](const auto& a) { return a.reason == reason; });
+}
+
+}  // namespace
+
+TEST(WriteControllerTest, ClimbsToTheKneeAndHolds) {
+    WriteController controller{16};
+    const SimulatedDrive drive;
+    auto now = Clock::time_point{};
+
+    const auto adjustments = run(controller, drive, 20'000, now);
+    ASSERT_GT(count(adjustments, Reason::SETTLED), 0);
+
+    // Near the ceiling, without queueing far past it
+    EXPECT_GE(drive.throughput(controller.settings()), 0.9 * drive.ceiling_bps);
+    EXPECT_LE(controller.settings().depth, 8U);
+}
+
+TEST(WriteControllerTest, RevertsProbesThatDoNotPay) {
+    WriteController controller{16};
+    const auto initial = controller.settings();
+    // Already saturated at the initial settings
+    const SimulatedDrive drive{.overhead_s = 0.0, .stream_bps = 1e9, .ceiling_bps = 100e6};
+    auto now = Clock::time_point{};
+
+    // Long enough for both probes, too short for the next round after the hold
+    const auto adjustments = run(controller, drive, 500, now);
+    EXPECT_EQ(count(adjustments, Reason::NO_GAIN), 2);
+    EXPECT_EQ(controller.settings(), initial);
+    ASSERT_FALSE(adjustments.empty());
+    EXPECT_EQ(adjustments.back().reason, Reason::SETTLED);
+}
+
+TEST(WriteControllerTest, BacksOffWhenTheDriveSlowsDown) {
+    WriteController controller{16};
+    SimulatedDrive drive;
+    auto now = Clock::time_point{};
+    run(controller, drive, 20'000, now);
+    const auto before = controller.settings();
+
+    // SLC cache full: every stream and the device as a whole get much slower
+    drive.stream_bps = 40e6;
+    drive.ceiling_bps = 60e6;
+    const auto adjustments = run(controller, drive, 200, now);
+
+    ASSERT_GT(count(adjustments, Reason::SLOWDOWN), 0);
+    EXPECT_LT(controller.settings().depth, before.depth);
+}
+
+TEST(WriteControllerTest, RestartForgetsTheReferenceThroughput) {
+    WriteController controller{16};
+    SimulatedDrive drive;
+    auto now = Clock::time_point{};
+    run(controller, drive, 20'000, now);
+    const auto before = controller.settings();
+
+    // Throttled from outside to half the rate: not a slowdown of the drive
+    controller.restart();
+    drive.stream_bps /= 2;
+    drive.ceiling_bps /= 2;
+    const auto adjustments = run(controller, drive, 200, now);
+
+    EXPECT_EQ(count(adjustments, Reason::SLOWDOWN), 0);
+    EXPECT_GE(controller.settings().depth, before.depth);
+}
+
+TEST(WriteControllerTest, RespectsTheDepthLimit) {
+    WriteController controller{1};
+    // Scales with depth forever; only the limit stops it
+    const SimulatedDrive drive{.overhead_s = 0.01, .stream_bps = 1e8, .ceiling_bps = 1e12};
+    auto now = Clock::time_point{};
+    run(controller, drive, 5'000, now);
+
+    EXPECT_EQ(controller.settings().depth, 1U);
+    EXPECT_EQ(controller.settings().request_bytes, WriteController::MAX_REQUEST_BYTES);
+}
+
+TEST(WriteStreamTest, WritesEveryByteAtItsOffset) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    constexpr uint64_t size = (9 * 1'024 * 1'024) + 13;  // Several requests and a ragged tail
+    constexpr uint64_t start = 4'096;
+    ASSERT_EQ(lseek(file.fd(), static_cast<off_t>(start), SEEK_SET), static_cast<off_t>(start));
+
+    const util::Keystream keystream{42};
+    uint64_t last_progress = 0;
+    const std::atomic<bool> cancel{false};
+    const bool ok = write_stream(
+        file.fd(), size,
+        [&](uint64_t offset, std::span<uint8_t> out) { keystream.fill(offset, out); }, false,
+        [&](uint64_t written) { last_progress = written; }, cancel);
+
+    ASSERT_TRUE(ok);
+    EXPECT_EQ(last_progress, size);
+    EXPECT_EQ(lseek(file.fd(), 0, SEEK_CUR), static_cast<off_t>(start + size));
+
+    std::vector<uint8_t> expected(size);
+    keystream.fill(0, expected);
+    std::vector<uint8_t> actual(size);
+    ASSERT_EQ(pread(file.fd(), actual.data(), size, static_cast<off_t>(start)),
+              static_cast<ssize_t>(size));
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(WriteStreamTest, WritesEveryByteWhileThrottled) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    constexpr uint64_t size = 3 * 1'024 * 1'024;
+
+    util::WritePacer::set_multiplier(0.5);
+    const std::atomic<bool> cancel{false};
+    const bool ok = write_stream(
+        file.fd(), size, [](uint64_t, std::span<uint8_t> out) { std::ranges::fill(out, 0x5A); },
+        true, nullptr, cancel);
+    util::WritePacer::set_multiplier(1.0);
+
+    ASSERT_TRUE(ok);
+    std::vector<uint8_t> actual(size);
+    ASSERT_EQ(pread(file.fd(), actual.data(), size, 0), static_cast<ssize_t>(size));
+    EXPECT_TRUE(std::ranges::all_of(actual, [](uint8_t b) { return b == 0x5A; }));
+}
+
+TEST(WriteStreamTest, FallsBackToSequentialWritesOnAPipe) {
+    int fds[2] = {-1, -1};
+    ASSERT_EQ(pipe(fds), 0);
+    constexpr uint64_t size = (2 * 1'024 * 1'024) + 7;
+
+    std::vector<uint8_t> received;
+    std::thread reader([&] {
+        std::vector<uint8_t> buffer(65'536);
+        ssize_t n = 0;
+        while ((n = read(fds[0], buffer.data(), buffer.size())) > 0) {
+            received.insert(received.end(), buffer.begin(), buffer.begin() + n);
+        }
+    });
+
+    const std::atomic<bool> cancel{false};
+    const bool ok = write_stream(
+        fds[1], size, [](uint64_t, std::span<uint8_t> out) { std::ranges::fill(out, 0xA5); },
+        true, nullptr, cancel);
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+
+    EXPECT_TRUE(ok);
+    ASSERT_EQ(received.size(), size);
+    EXPECT_TRUE(std::ranges::all_of(received, [](uint8_t b) { return b == 0xA5; }));
+}
+
+TEST(WriteStreamTest, StopsWhenCancelled) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    std::atomic<bool> cancel{false};
+    uint64_t last_progress = 0;
+
+    const bool ok = write_stream(
+        file.fd(), 64ULL * 1'024 * 1'024, [](uint64_t, std::span<uint8_t>) {}, true,
+        [&](uint64_t written) {
+            last_progress = written;
+            cancel.store(true);
+        },
+        cancel);
+
+    EXPECT_FALSE(ok);
+    EXPECT_LT(last_progress, 64ULL * 1'024 * 1'024);
+}
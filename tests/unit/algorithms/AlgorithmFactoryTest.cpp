@@ -0,0 +1,59 @@
+/**
+ * @file AlgorithmFactoryTest.cpp
+ * @brief Unit tests for the algorithm catalog and factory
+ */
+
+#include "algorithms/AlgorithmFactory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <set>
+#include <string_view>
+
+TEST(AlgorithmFactoryTest, EveryCatalogEntryHasAnImplementation) {
+    for (auto algorithm : ALL_WIPE_ALGORITHMS) {
+        EXPECT_NE(make_wipe_algorithm(algorithm), nullptr)
+            << wipe_algorithm_name(algorithm) << " has no implementation";
+    }
+}
+
+TEST(AlgorithmFactoryTest, NamesAndAliasesRoundTrip) {
+    std::set<std::string_view> seen;
+    for (const auto& entry : WIPE_ALGORITHM_CATALOG) {
+        EXPECT_EQ(wipe_algorithm_name(entry.algorithm), entry.name);
+        const auto expected =
+            entry.offered ? std::optional{entry.algorithm} : std::optional<WipeAlgorithm>{};
+        EXPECT_EQ(parse_wipe_algorithm(entry.name), expected);
+        EXPECT_TRUE(seen.insert(entry.name).second) << entry.name << " is listed twice";
+        for (auto alias : entry.aliases) {
+            if (alias.empty()) {
+                continue;
+            }
+            EXPECT_EQ(parse_wipe_algorithm(alias), expected) << alias;
+            EXPECT_TRUE(seen.insert(alias).second) << alias << " is listed twice";
+        }
+    }
+}
+
+TEST(AlgorithmFactoryTest, ParsingIgnoresCaseAndRejectsUnknownNames) {
+    EXPECT_EQ(parse_wipe_algorithm("DoD-5220-22-M"), WipeAlgorithm::DOD_5220_22_M);
+    EXPECT_EQ(parse_wipe_algorithm("GOST-R-50739-95"), WipeAlgorithm::GOST_R_50739_95);
+    EXPECT_EQ(parse_wipe_algorithm("dod-5220"), std::nullopt);
+    EXPECT_EQ(parse_wipe_algorithm(""), std::nullopt);
+}
+
+TEST(AlgorithmFactoryTest, WithholdsAtaSecureEraseFromFrontEnds) {
+    // Implemented, but not offered until its SECURITY commands carry data
+    EXPECT_NE(make_wipe_algorithm(WipeAlgorithm::ATA_SECURE_ERASE), nullptr);
+    EXPECT_FALSE(is_offered_wipe_algorithm(WipeAlgorithm::ATA_SECURE_ERASE));
+    EXPECT_EQ(parse_wipe_algorithm("ata-secure-erase"), std::nullopt);
+    EXPECT_EQ(parse_wipe_algorithm("ata"), std::nullopt);
+    EXPECT_EQ(OFFERED_WIPE_ALGORITHMS.size() + 1, ALL_WIPE_ALGORITHMS.size());
+}
+
+TEST(AlgorithmFactoryTest, RejectsIdentifiersOutsideTheEnum) {
+    EXPECT_TRUE(is_offered_wipe_algorithm(WipeAlgorithm::LUKS_CRYPTO_SHRED_OVERWRITE));
+    EXPECT_FALSE(is_offered_wipe_algorithm(static_cast<WipeAlgorithm>(999)));
+    EXPECT_EQ(make_wipe_algorithm(static_cast<WipeAlgorithm>(999)), nullptr);
+}
@@ -0,0 +1,273 @@
+/**
+ * @file LuksCryptoShredTest.cpp
+ * @brief Unit tests for LUKS header decoding and the crypto-shred algorithms
+ */
+
+#include "algorithms/LuksCryptoShredAlgorithm.hpp"
+#include "algorithms/LuksCryptoShredOverwriteAlgorithm.hpp"
+#include "algorithms/LuksHeader.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t KIB = 1ULL << 10;
+constexpr uint64_t MIB = 1ULL << 20;
+constexpr uint64_t LUKS2_HDR = 16 * KIB;
+constexpr uint64_t LUKS2_DATA = 1 * MIB;
+constexpr uint64_t LUKS2_KEYSLOTS_END = (2 * LUKS2_HDR) + (256 * KIB);
+
+template <typename T>
+void store_be(std::vector<uint8_t>& bytes, std::size_t at, T value) {
+    if constexpr (std::endian::native == std::endian::little) {
+        value = std::byteswap(value);
+    }
+    std::memcpy(bytes.data() + at, &value, sizeof(value));
+}
+
+void store_string(std::vector<uint8_t>& bytes, std::size_t at, std::string_view text) {
+    std::memcpy(bytes.data() + at, text.data(), text.size());
+}
+
+/**
+ * @brief LUKS1 header with two keyslots of 32-byte keys in 4000 stripes
+ */
+auto luks1_header() -> std::vector<uint8_t> {
+    std::vector<uint8_t> header(luks::BINARY_HEADER_SIZE, 0);
+    std::ranges::copy(luks::MAGIC, header.begin());
+    store_be<uint16_t>(header, 6, 1);
+    store_be<uint32_t>(header, 104, 4'096);  // Payload at 2 MiB
+    store_be<uint32_t>(header, 108, 32);     // Key bytes
+    store_string(header, 168, "0b8c1f6a-1e2d-4c53-9a61-5d1f5b0f1c01");
+    store_be<uint32_t>(header, 208 + 40, 8);         // Keyslot 0 at 4 KiB
+    store_be<uint32_t>(header, 208 + 44, 4'000);
+    store_be<uint32_t>(header, 208 + 48 + 40, 264);  // Keyslot 1 at 132 KiB
+    store_be<uint32_t>(header, 208 + 48 + 44, 4'000);
+    return header;
+}
+
+/**
+ * @brief One LUKS2 header copy (binary header plus JSON area), 16 KiB
+ */
+auto luks2_header(bool secondary) -> std::vector<uint8_t> {
+    std::vector<uint8_t> header(LUKS2_HDR, 0);
+    std::ranges::copy(secondary ? luks::SECONDARY_MAGIC : luks::MAGIC, header.begin());
+    store_be<uint16_t>(header, 6, 2);
+    store_be<uint64_t>(header, 8, LUKS2_HDR);
+    store_string(header, 168, "5c2e9d07-3f4a-4b8e-8c1d-2a7f6e9b0d42");
+    store_be<uint64_t>(header, 256, secondary ? LUKS2_HDR : 0);
+    store_string(header, luks::BINARY_HEADER_SIZE,
+                 R"({"keyslots":{"0":{"type":"luks2","key_size":64,"area":{"type":"raw",)"
+                 R"("offset":"32768","size":"258048","encryption":"aes-xts-plain64",)"
+                 R"("key_size":64}}},"tokens":{},"segments":{"0":{"type":"crypt",)"
+                 R"("offset":"1048576","size":"dynamic","iv_tweak":"0",)"
+                 R"("encryption":"aes-xts-plain64","sector_size":512}},"digests":{},)"
+                 R"("config":{"json_size":"12288","keyslots_size":"262144"}})");
+    return header;
+}
+
+auto write_at(int fd, const std::vector<uint8_t>& bytes, uint64_t offset) -> bool {
+    return pwrite(fd, bytes.data(), bytes.size(), static_cast<off_t>(offset)) ==
+           static_cast<ssize_t>(bytes.size());
+}
+
+auto read_at(int fd, uint64_t offset, std::size_t length) -> std::vector<uint8_t> {
+    std::vector<uint8_t> bytes(length);
+    bytes.resize(static_cast<std::size_t>(
+        std::max<ssize_t>(0, pread(fd, bytes.data(), length, static_cast<off_t>(offset)))));
+    return bytes;
+}
+
+}  // namespace
+
+class LuksCryptoShredTest : public AlgorithmTestFixture {
+protected:
+    TempTestFile file;
+
+    // A LUKS2 volume at `offset`, its payload filled with 'P' up to `size`
+    void write_luks2(uint64_t offset, uint64_t size) {
+        ASSERT_TRUE(file.valid());
+        ASSERT_TRUE(write_at(file.fd(), luks2_header(false), offset));
+        ASSERT_TRUE(write_at(file.fd(), luks2_header(true), offset + LUKS2_HDR));
+        ASSERT_TRUE(write_at(file.fd(), std::vector<uint8_t>(size - LUKS2_DATA, 'P'),
+                             offset + LUKS2_DATA));
+    }
+
+    auto payload_intact(uint64_t offset, uint64_t size) -> bool {
+        const auto payload = read_at(file.fd(), offset + LUKS2_DATA, size - LUKS2_DATA);
+        return payload.size() == size - LUKS2_DATA &&
+               std::ranges::all_of(payload, [](uint8_t byte) { return byte == 'P'; });
+    }
+};
+
+TEST(LuksHeaderTest, Parse_Luks1HeaderAndKeyslots) {
+    const auto container = luks::parse(luks1_header(), 0, 64 * MIB);
+    ASSERT_TRUE(container.has_value());
+
+    EXPECT_EQ(container->version, 1);
+    EXPECT_EQ(container->uuid, "0b8c1f6a-1e2d-4c53-9a61-5d1f5b0f1c01");
+    EXPECT_EQ(container->data_offset, 2 * MIB);
+    ASSERT_EQ(container->regions.size(), 3U);
+    EXPECT_EQ(container->regions[0].offset, 0U);
+    EXPECT_EQ(container->regions[0].length, luks::BINARY_HEADER_SIZE);
+    // 32 * 4000 bytes of anti-forensic material, rounded up to 4 KiB
+    EXPECT_EQ(container->regions[1].offset, 4 * KIB);
+    EXPECT_EQ(container->regions[1].length, 128 * KIB);
+    EXPECT_EQ(container->regions[2].offset, 132 * KIB);
+    EXPECT_EQ(container->regions[2].what, "keyslot 1");
+}
+
+TEST(LuksHeaderTest, Parse_Luks2HeadersAndKeyslotsArea) {
+    constexpr uint64_t AT = 4 * MIB;
+    const auto container = luks::parse(luks2_header(false), AT, 16 * MIB);
+    ASSERT_TRUE(container.has_value());
+
+    EXPECT_EQ(container->version, 2);
+    EXPECT_EQ(container->data_offset, AT + LUKS2_DATA);
+    ASSERT_EQ(container->regions.size(), 3U);
+    EXPECT_EQ(container->regions[0].offset, AT);
+    EXPECT_EQ(container->regions[1].offset, AT + LUKS2_HDR);
+    EXPECT_EQ(container->regions[2].offset, AT + (2 * LUKS2_HDR));
+    EXPECT_EQ(container->regions[2].length, LUKS2_KEYSLOTS_END - (2 * LUKS2_HDR));
+    EXPECT_EQ(container->bytes(), LUKS2_KEYSLOTS_END);
+}
+
+TEST(LuksHeaderTest, Parse_ClipsRegionsToTheDevice) {
+    const auto container = luks::parse(luks2_header(false), 0, 64 * KIB);
+    ASSERT_TRUE(container.has_value());
+    EXPECT_EQ(container->bytes(), 64 * KIB);
+}
+
+TEST(LuksHeaderTest, Parse_RejectsOtherData) {
+    std::vector<uint8_t> zeros(luks::BINARY_HEADER_SIZE, 0);
+    EXPECT_FALSE(luks::parse(zeros, 0, MIB).has_value());
+
+    auto unknown_version = luks1_header();
+    store_be<uint16_t>(unknown_version, 6, 3);
+    EXPECT_FALSE(luks::parse(unknown_version, 0, MIB).has_value());
+}
+
+TEST_F(LuksCryptoShredTest, Probe_FallsBackToSecondaryHeader) {
+    write_luks2(0, 2 * MIB);
+    ASSERT_TRUE(write_at(file.fd(), std::vector<uint8_t>(luks::BINARY_HEADER_SIZE, 0), 0));
+
+    const auto container = luks::probe(file.fd(), 0, 2 * MIB);
+    ASSERT_TRUE(container.has_value());
+    EXPECT_EQ(container->version, 2);
+    EXPECT_EQ(container->uuid, "5c2e9d07-3f4a-4b8e-8c1d-2a7f6e9b0d42");
+    EXPECT_EQ(container->bytes(), LUKS2_KEYSLOTS_END);
+}
+
+TEST_F(LuksCryptoShredTest, FindContainers_OnEveryPartition) {
+    ASSERT_TRUE(file.valid());
+    ASSERT_TRUE(write_at(file.fd(), luks1_header(), 0));
+    write_luks2(4 * MIB, 2 * MIB);
+
+    const std::array<uint64_t, 3> offsets = {0, 4 * MIB, 4 * MIB};
+    const auto containers = luks::find_containers(file.fd(), 6 * MIB, offsets);
+    ASSERT_EQ(containers.size(), 2U);
+    EXPECT_EQ(containers[0].version, 1);
+    EXPECT_EQ(containers[1].version, 2);
+    EXPECT_EQ(containers[1].offset, 4 * MIB);
+}
+
+TEST(LuksHeaderTest, ReadPartitions_FromSysfs) {
+    const TempTestDir temp_dir;
+    const auto dir = temp_dir.path() / "sda";
+    write_value(dir / "sda2" / "start", "8192");
+    write_value(dir / "sda2" / "size", "2048");
+    write_value(dir / "sda1" / "start", "2048");
+    write_value(dir / "sda1" / "size", "6144");
+    write_value(dir / "queue" / "rotational", "1");
+    fs::create_directories(dir / "holders");
+
+    const auto partitions = luks::read_partitions(dir);
+
+    ASSERT_EQ(partitions.size(), 2U);
+    EXPECT_EQ(partitions[0].name, "sda1");
+    EXPECT_EQ(partitions[0].start, 2'048U * 512);
+    EXPECT_EQ(partitions[0].size, 6'144U * 512);
+    EXPECT_EQ(partitions[1].start, 8'192U * 512);
+}
+
+TEST(LuksHeaderTest, OpenMappings_FindsDmCryptHoldersOfDiskAndPartitions) {
+    const TempTestDir temp_dir;
+    const auto dir = temp_dir.path() / "sda";
+    write_value(dir / "holders" / "dm-0" / "dm" / "uuid", "LVM-Yq3bX0dRk2");
+    write_value(dir / "holders" / "dm-0" / "dm" / "name", "vg-root");
+    write_value(dir / "sda2" / "holders" / "dm-1" / "dm" / "uuid",
+                "CRYPT-LUKS2-0b8c1f6a1e2d4c539a615d1f5b0f1c01-cryptdata");
+    write_value(dir / "sda2" / "holders" / "dm-1" / "dm" / "name", "cryptdata");
+    fs::create_directories(dir / "sda1" / "holders");
+
+    EXPECT_EQ(luks::open_mappings(dir), std::vector<std::string>{"cryptdata"});
+
+    fs::remove_all(dir / "sda2" / "holders" / "dm-1");
+    EXPECT_TRUE(luks::open_mappings(dir).empty());
+}
+
+TEST_F(LuksCryptoShredTest, Execute_DestroysKeyMaterialAndKeepsPayload) {
+    constexpr uint64_t SIZE = 2 * MIB;
+    write_luks2(0, SIZE);
+    const auto before = read_at(file.fd(), 0, LUKS2_KEYSLOTS_END);
+
+    LuksCryptoShredAlgorithm algorithm;
+    ASSERT_TRUE(algorithm.execute(file.fd(), SIZE, CreateCapturingCallback(), cancel_flag));
+
+    EXPECT_FALSE(luks::probe(file.fd(), 0, SIZE).has_value());
+    EXPECT_NE(read_at(file.fd(), 0, LUKS2_KEYSLOTS_END), before);
+    EXPECT_TRUE(payload_intact(0, SIZE));
+    ASSERT_FALSE(captured_progress.empty());
+    EXPECT_DOUBLE_EQ(captured_progress.back().percentage, 100.0);
+    EXPECT_TRUE(algorithm.verify(file.fd(), SIZE, nullptr, cancel_flag));
+}
+
+TEST_F(LuksCryptoShredTest, Verify_FailsWhenAHeaderComesBack) {
+    constexpr uint64_t SIZE = 2 * MIB;
+    write_luks2(0, SIZE);
+
+    LuksCryptoShredAlgorithm algorithm;
+    ASSERT_TRUE(algorithm.execute(file.fd(), SIZE, nullptr, cancel_flag));
+    ASSERT_TRUE(write_at(file.fd(), luks2_header(true), LUKS2_HDR));
+    EXPECT_FALSE(algorithm.verify(file.fd(), SIZE, nullptr, cancel_flag));
+}
+
+TEST_F(LuksCryptoShredTest, Execute_FailsWithoutLuks) {
+    ASSERT_TRUE(file.valid());
+    ASSERT_TRUE(file.resize(MIB));
+
+    LuksCryptoShredAlgorithm algorithm;
+    EXPECT_FALSE(algorithm.execute(file.fd(), MIB, nullptr, cancel_flag));
+}
+
+TEST_F(LuksCryptoShredTest, Overwrite_ShredsThenFillsTheDevice) {
+    constexpr uint64_t SIZE = 2 * MIB;
+    write_luks2(0, SIZE);
+
+    LuksCryptoShredOverwriteAlgorithm algorithm;
+    EXPECT_EQ(algorithm.get_pass_count(), 2);
+    EXPECT_FALSE(algorithm.is_ssd_compatible());
+    ASSERT_TRUE(algorithm.execute(file.fd(), SIZE, CreateCapturingCallback(), cancel_flag));
+
+    EXPECT_FALSE(payload_intact(0, SIZE));
+    ASSERT_FALSE(captured_progress.empty());
+    EXPECT_EQ(captured_progress.back().current_pass, 2);
+    EXPECT_EQ(captured_progress.back().bytes_written, SIZE);
+    EXPECT_TRUE(algorithm.verify(file.fd(), SIZE, nullptr, cancel_flag));
+}
@@ -0,0 +1,250 @@
+/**
+ * @file PassSequenceAlgorithmTest.cpp
+ * @brief Unit tests for pass-sequence algorithms, the seekable keystream and the complement kernel
+ */
+
+#include "algorithms/DoDECEAlgorithm.hpp"
+#include "algorithms/PassSequenceAlgorithm.hpp"
+#include "algorithms/RCMPAlgorithm.hpp"
+#include "util/ByteKernels.hpp"
+#include "util/Keystream.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <vector>
+
+namespace {
+
+// Several buffers plus a tail that is not a whole word
+constexpr uint64_t MULTI_BLOCK_SIZE = (3 * 1'024 * 1'024) + 13;
+
+// Regeneration must comfortably outrun a disk, even in debug builds
+constexpr double MIN_GENERATE_MB_PER_S = 100.0;
+
+/**
+ * @brief Algorithm with a caller-supplied pass list
+ */
+class ScriptedAlgorithm : public PassSequenceAlgorithm {
+public:
+    explicit ScriptedAlgorithm(std::vector<WipePass> passes) : passes_(std::move(passes)) {}
+
+    std::string get_name() const override { return "Scripted"; }
+    std::string get_description() const override { return "Test pass list"; }
+
+protected:
+    auto passes() const -> std::span<const WipePass> override { return passes_; }
+
+private:
+    std::vector<WipePass> passes_;
+};
+
+auto read_all(int fd, uint64_t size) -> std::vector<uint8_t> {
+    std::vector<uint8_t> data(size);
+    uint64_t done = 0;
+    while (done < size) {
+        const auto n = pread(fd, data.data() + done, size - done, static_cast<off_t>(done));
+        if (n <= 0) {
+            data.resize(done);
+            break;
+        }
+        done += static_cast<uint64_t>(n);
+    }
+    return data;
+}
+
+}  // namespace
+
+class PassSequenceAlgorithmTest : public AlgorithmTestFixture {};
+
+TEST(KeystreamTest, Fill_IsSeekable) {
+    const util::Keystream stream{0x1234'5678'9ABC'DEF0ULL};
+    std::vector<uint8_t> whole(4'096);
+    stream.fill(0, whole);
+
+    // Any window, aligned or not, matches the same bytes of a fill from zero
+    for (const auto& [offset, length] : std::array{std::pair{0UL, 5UL}, std::pair{3UL, 1UL},
+                                                  std::pair{7UL, 20UL}, std::pair{8UL, 64UL},
+                                                  std::pair{1'001UL, 2'000UL}}) {
+        std::vector<uint8_t> window(length);
+        stream.fill(offset, window);
+        EXPECT_TRUE(std::equal(window.begin(), window.end(),
+                               whole.begin() + static_cast<std::ptrdiff_t>(offset)))
+            << "offset " << offset << " length " << length;
+    }
+}
+
+TEST(KeystreamTest, Fill_DependsOnSeed) {
+    std::vector<uint8_t> a(256);
+    std::vector<uint8_t> b(256);
+    util::Keystream{1}.fill(0, a);
+    util::Keystream{2}.fill(0, b);
+    EXPECT_NE(a, b);
+}
+
+TEST(ByteKernelsTest, Complement_InvertsEveryByteAtAnyLength) {
+    for (const size_t length : {0UL, 1UL, 7UL, 8UL, 31UL, 32UL, 33UL, 100UL}) {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; ++i) {
+            data[i] = static_cast<uint8_t>(i * 37);
+        }
+        const auto original = data;
+
+        util::complement(data);
+        for (size_t i = 0; i < length; ++i) {
+            ASSERT_EQ(data[i], static_cast<uint8_t>(~original[i])) << "length " << length;
+        }
+        util::complement(data);
+        EXPECT_EQ(data, original);
+    }
+}
+
+TEST_F(PassSequenceAlgorithmTest, DoDECE_Metadata) {
+    DoDECEAlgorithm algorithm;
+    EXPECT_EQ(algorithm.get_name(), "DoD 5220.22-M ECE");
+    EXPECT_EQ(algorithm.get_pass_count(), 7);
+    EXPECT_FALSE(algorithm.is_ssd_compatible());
+    EXPECT_TRUE(algorithm.supports_verification());
+}
+
+TEST_F(PassSequenceAlgorithmTest, RCMP_Metadata) {
+    RCMPAlgorithm algorithm;
+    EXPECT_EQ(algorithm.get_name(), "RCMP TSSIT OPS-II");
+    EXPECT_EQ(algorithm.get_pass_count(), 7);
+    EXPECT_TRUE(algorithm.supports_verification());
+}
+
+// Test: the complement pass is the exact inverse of the random pass before it
+TEST_F(PassSequenceAlgorithmTest, Execute_ComplementInvertsPreviousRandomPass) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(MULTI_BLOCK_SIZE));
+
+    ScriptedAlgorithm algorithm{{{.kind = WipePass::Kind::RANDOM, .character = 0x00},
+                                 {.kind = WipePass::Kind::COMPLEMENT, .character = 0x00}}};
+
+    // Snapshot the device as soon as the random pass completes
+    std::vector<uint8_t> random_pass;
+    auto callback = [&](const WipeProgress& progress) {
+        if (progress.current_pass == 1 && progress.bytes_written == progress.total_bytes) {
+            random_pass = read_all(temp_file.fd(), MULTI_BLOCK_SIZE);
+        }
+    };
+
+    ASSERT_TRUE(algorithm.execute(temp_file.fd(), MULTI_BLOCK_SIZE, callback, cancel_flag));
+    ASSERT_EQ(random_pass.size(), MULTI_BLOCK_SIZE);
+
+    const auto final_pass = read_all(temp_file.fd(), MULTI_BLOCK_SIZE);
+    ASSERT_EQ(final_pass.size(), MULTI_BLOCK_SIZE);
+    for (uint64_t i = 0; i < MULTI_BLOCK_SIZE; ++i) {
+        ASSERT_EQ(final_pass[i], static_cast<uint8_t>(~random_pass[i])) << "byte " << i;
+    }
+    EXPECT_FALSE(std::all_of(random_pass.begin(), random_pass.end(),
+                             [&](uint8_t b) { return b == random_pass[0]; }));
+}
+
+TEST_F(PassSequenceAlgorithmTest, Execute_ComplementOfCharacter) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(4'096));
+
+    ScriptedAlgorithm algorithm{{{.kind = WipePass::Kind::CHARACTER, .character = 0x35},
+                                 {.kind = WipePass::Kind::COMPLEMENT, .character = 0x00}}};
+    ASSERT_TRUE(algorithm.execute(temp_file.fd(), 4'096, nullptr, cancel_flag));
+
+    const auto data = read_all(temp_file.fd(), 4'096);
+    EXPECT_TRUE(std::all_of(data.begin(), data.end(), [](uint8_t b) { return b == 0xCA; }));
+}
+
+TEST_F(PassSequenceAlgorithmTest, Execute_LeadingComplementIsRejected) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(1'024));
+
+    ScriptedAlgorithm algorithm{{{.kind = WipePass::Kind::COMPLEMENT, .character = 0x00}}};
+    EXPECT_FALSE(algorithm.execute(temp_file.fd(), 1'024, nullptr, cancel_flag));
+}
+
+TEST_F(PassSequenceAlgorithmTest, Execute_ReportsEveryPass) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(4'096));
+
+    RCMPAlgorithm algorithm;
+    ASSERT_TRUE(
+        algorithm.execute(temp_file.fd(), 4'096, CreateCapturingCallback(), cancel_flag));
+
+    std::vector<int> passes;
+    for (const auto& progress : captured_progress) {
+        EXPECT_EQ(progress.total_passes, 7);
+        passes.push_back(progress.current_pass);
+    }
+    EXPECT_EQ(passes, (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST_F(PassSequenceAlgorithmTest, Execute_CancellationStopsWriting) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(4'096));
+
+    cancel_flag.store(true);
+    DoDECEAlgorithm algorithm;
+    EXPECT_FALSE(algorithm.execute(temp_file.fd(), 4'096, nullptr, cancel_flag));
+}
+
+// Test: verification regenerates the last pass and catches a single flipped byte
+TEST_F(PassSequenceAlgorithmTest, Verify_RegeneratesLastPassExactly) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(MULTI_BLOCK_SIZE));
+
+    DoDECEAlgorithm algorithm;
+    ASSERT_TRUE(algorithm.execute(temp_file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+    EXPECT_TRUE(algorithm.verify(temp_file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+
+    uint8_t byte = 0;
+    constexpr off_t CORRUPT_AT = 2'000'000;
+    ASSERT_EQ(pread(temp_file.fd(), &byte, 1, CORRUPT_AT), 1);
+    byte ^= 0x01;
+    ASSERT_EQ(pwrite(temp_file.fd(), &byte, 1, CORRUPT_AT), 1);
+    EXPECT_FALSE(algorithm.verify(temp_file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+}
+
+TEST_F(PassSequenceAlgorithmTest, Verify_WithoutExecuteChecksLastPassKind) {
+    TempTestFile temp_file;
+    ASSERT_TRUE(temp_file.valid());
+    ASSERT_TRUE(temp_file.resize(4'096));
+
+    ScriptedAlgorithm writer{{{.kind = WipePass::Kind::CHARACTER, .character = 0x00},
+                              {.kind = WipePass::Kind::COMPLEMENT, .character = 0x00}}};
+    ASSERT_TRUE(writer.execute(temp_file.fd(), 4'096, nullptr, cancel_flag));
+
+    ScriptedAlgorithm fresh{{{.kind = WipePass::Kind::CHARACTER, .character = 0x00},
+                             {.kind = WipePass::Kind::COMPLEMENT, .character = 0x00}}};
+    EXPECT_TRUE(fresh.verify(temp_file.fd(), 4'096, nullptr, cancel_flag));
+}
+
+TEST(KeystreamTest, Benchmark_ComplementRegenerationThroughput) {
+    constexpr size_t BLOCK = 1'024 * 1'024;
+    constexpr int BLOCKS = 64;
+    const util::Keystream stream{util::Keystream::random_seed()};
+    std::vector<uint8_t> buffer(BLOCK);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BLOCKS; ++i) {
+        stream.fill(static_cast<uint64_t>(i) * BLOCK, buffer);
+        util::complement(buffer);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double mb_per_s = BLOCKS / std::max(elapsed.count(), 1e-9);
+    RecordProperty("complement_regeneration_mb_per_s", std::format("{:.0f}", mb_per_s));
+    EXPECT_GT(mb_per_s, MIN_GENERATE_MB_PER_S);
+}
@@ -0,0 +1,199 @@
+/**
+ * @file SampledVerificationTest.cpp
+ * @brief Unit tests for sampled post-erase readback verification
+ */
+
+#include "algorithms/SampledVerification.hpp"
+#include "util/Keystream.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using verification::FillPattern;
+using verification::Sample;
+
+namespace {
+
+constexpr std::size_t BLOCK = 4'096;
+constexpr uint64_t DEVICE_SIZE = 2 * 1'024 * 1'024;
+constexpr std::size_t COUNT = 64;
+
+auto write_all(int fd, const std::vector<uint8_t>& data) -> bool {
+    return pwrite(fd, data.data(), data.size(), 0) == static_cast<ssize_t>(data.size());
+}
+
+// Text-like content standing in for user data
+auto document_bytes(std::size_t size) -> std::vector<uint8_t> {
+    const std::string line = "invoice 2026-10-18 customer=42 total=199.00\n";
+    std::vector<uint8_t> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(line[(i + (i / 4'096)) % line.size()]);
+    }
+    return data;
+}
+
+auto keystream_bytes(std::size_t size, uint64_t seed) -> std::vector<uint8_t> {
+    std::vector<uint8_t> data(size);
+    util::Keystream{seed}.fill(0, data);
+    return data;
+}
+
+auto sample(int fd, std::span<const uint64_t> offsets) -> std::vector<Sample> {
+    const std::atomic<bool> cancel{false};
+    return verification::take_samples(fd, DEVICE_SIZE, offsets, BLOCK, cancel);
+}
+
+}  // namespace
+
+class SampledVerificationTest : public AlgorithmTestFixture {
+protected:
+    void SetUp() override {
+        AlgorithmTestFixture::SetUp();
+        ASSERT_TRUE(device.valid());
+        ASSERT_TRUE(device.resize(DEVICE_SIZE));
+        offsets = verification::plan_sample_offsets(DEVICE_SIZE, COUNT, BLOCK, 7);
+    }
+
+    TempTestFile device;
+    std::vector<uint64_t> offsets;
+};
+
+TEST(SamplePlanTest, SpreadsAlignedDistinctOffsetsAcrossDevice) {
+    constexpr uint64_t size = 18ULL * 1'000 * 1'000 * 1'000 * 1'000;  // 18 TB
+    const auto offsets = verification::plan_sample_offsets(
+        size, verification::SAMPLE_COUNT, verification::SAMPLE_BYTES, 1);
+
+    ASSERT_EQ(offsets.size(), verification::SAMPLE_COUNT);
+    EXPECT_EQ(offsets.front(), 0U);
+    EXPECT_GT(offsets.back() + verification::SAMPLE_BYTES, size - verification::SAMPLE_BYTES);
+    EXPECT_TRUE(std::ranges::is_sorted(offsets));
+    EXPECT_EQ(std::ranges::adjacent_find(offsets), offsets.end());
+    for (const auto offset : offsets) {
+        EXPECT_EQ(offset % verification::SAMPLE_BYTES, 0U);
+        EXPECT_LT(offset, size);
+    }
+
+    // Each stratum gets one sample, so no gap exceeds two strata
+    const uint64_t stratum = size / (verification::SAMPLE_COUNT - 2);
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+        EXPECT_LE(offsets[i] - offsets[i - 1], 2 * stratum + verification::SAMPLE_BYTES);
+    }
+}
+
+TEST(SamplePlanTest, SmallDevice_SamplesEveryBlock) {
+    const auto offsets = verification::plan_sample_offsets(10 * BLOCK + 1, COUNT, BLOCK, 1);
+    ASSERT_EQ(offsets.size(), 11U);
+    EXPECT_EQ(offsets.back(), 10 * BLOCK);
+    EXPECT_TRUE(verification::plan_sample_offsets(0, COUNT, BLOCK, 1).empty());
+}
+
+TEST(ClassifyFillTest, RecognisesVendorFills) {
+    EXPECT_EQ(verification::classify_fill(std::vector<uint8_t>(BLOCK, 0x00)), FillPattern::ZEROS);
+    EXPECT_EQ(verification::classify_fill(std::vector<uint8_t>(BLOCK, 0xFF)), FillPattern::ONES);
+    EXPECT_EQ(verification::classify_fill(keystream_bytes(BLOCK, 3)), FillPattern::HIGH_ENTROPY);
+    EXPECT_EQ(verification::classify_fill(document_bytes(BLOCK)), FillPattern::OTHER);
+    EXPECT_EQ(verification::classify_fill(std::vector<uint8_t>(BLOCK, 0x5A)), FillPattern::OTHER);
+}
+
+TEST_F(SampledVerificationTest, ZeroFillAfterUserData_Passes) {
+    ASSERT_TRUE(write_all(device.fd(), document_bytes(DEVICE_SIZE)));
+    const auto before = sample(device.fd(), offsets);
+    ASSERT_EQ(before.size(), offsets.size());
+
+    ASSERT_TRUE(write_all(device.fd(), std::vector<uint8_t>(DEVICE_SIZE, 0x00)));
+    const auto verdict = verification::verify_erase_sampled(device.fd(), DEVICE_SIZE, before,
+                                                            nullptr, cancel_flag);
+
+    EXPECT_TRUE(verdict.passed) << verdict.detail;
+    EXPECT_EQ(verdict.pattern, FillPattern::ZEROS);
+    EXPECT_EQ(verdict.samples, offsets.size());
+}
+
+// Test: a crypto erase leaves high-entropy data that differs from the old ciphertext
+TEST_F(SampledVerificationTest, CryptoEraseOverEncryptedData_Passes) {
+    ASSERT_TRUE(write_all(device.fd(), keystream_bytes(DEVICE_SIZE, 1)));
+    const auto before = sample(device.fd(), offsets);
+
+    ASSERT_TRUE(write_all(device.fd(), keystream_bytes(DEVICE_SIZE, 2)));
+    const auto verdict = verification::verify_erase_sampled(device.fd(), DEVICE_SIZE, before,
+                                                            nullptr, cancel_flag);
+
+    EXPECT_TRUE(verdict.passed) << verdict.detail;
+    EXPECT_EQ(verdict.pattern, FillPattern::HIGH_ENTROPY);
+}
+
+// Test: random-looking data with nothing to compare against proves nothing
+TEST_F(SampledVerificationTest, HighEntropyWithoutPreEraseSamples_IsInconclusive) {
+    ASSERT_TRUE(write_all(device.fd(), keystream_bytes(DEVICE_SIZE, 1)));
+
+    const auto verdict = verification::verify_erase_sampled(device.fd(), DEVICE_SIZE, {},
+                                                            nullptr, cancel_flag);
+
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_TRUE(verdict.inconclusive);
+    EXPECT_EQ(verdict.pattern, FillPattern::HIGH_ENTROPY);
+}
+
+// Test: firmware that acknowledges the erase but skips it is caught
+TEST_F(SampledVerificationTest, SkippedErase_Fails) {
+    ASSERT_TRUE(write_all(device.fd(), keystream_bytes(DEVICE_SIZE, 1)));
+    const auto before = sample(device.fd(), offsets);
+
+    const auto verdict = verification::verify_erase_sampled(device.fd(), DEVICE_SIZE, before,
+                                                            nullptr, cancel_flag);
+
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_EQ(verdict.unchanged, offsets.size());
+}
+
+// Test: an erase that stopped part way leaves an inconsistent fill
+TEST_F(SampledVerificationTest, PartialErase_Fails) {
+    ASSERT_TRUE(write_all(device.fd(), document_bytes(DEVICE_SIZE)));
+    const auto before = sample(device.fd(), offsets);
+
+    std::vector<uint8_t> half_erased(DEVICE_SIZE, 0xFF);
+    const auto tail = document_bytes(DEVICE_SIZE);
+    std::copy(tail.begin() + DEVICE_SIZE / 2, tail.end(), half_erased.begin() + DEVICE_SIZE / 2);
+    ASSERT_TRUE(write_all(device.fd(), half_erased));
+
+    const auto verdict = verification::verify_erase_sampled(device.fd(), DEVICE_SIZE, before,
+                                                            nullptr, cancel_flag);
+
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_EQ(verdict.pattern, FillPattern::ONES);
+    EXPECT_GT(verdict.inconsistent, 0U);
+}
+
+TEST_F(SampledVerificationTest, AlreadyBlankSamples_AreCountedNotFailed) {
+    const auto before = sample(device.fd(), offsets);  // Sparse file reads as zeros
+
+    const auto verdict = verification::verify_erase_sampled(device.fd(), DEVICE_SIZE, before,
+                                                            nullptr, cancel_flag);
+
+    EXPECT_TRUE(verdict.passed) << verdict.detail;
+    EXPECT_EQ(verdict.blank_before, offsets.size());
+}
+
+TEST_F(SampledVerificationTest, ReportsVerificationProgress) {
+    const auto verdict = verification::verify_erase_sampled(
+        device.fd(), DEVICE_SIZE, {}, CreateCapturingCallback(), cancel_flag);
+
+    EXPECT_TRUE(verdict.passed) << verdict.detail;
+    ASSERT_FALSE(captured_progress.empty());
+    EXPECT_TRUE(captured_progress.back().verification_in_progress);
+    EXPECT_DOUBLE_EQ(captured_progress.back().verification_percentage, 100.0);
+}
+
+TEST_F(SampledVerificationTest, ReadPastEnd_ReturnsNoSamples) {
+    const std::vector<uint64_t> past_end = {0, DEVICE_SIZE + BLOCK};
+    EXPECT_TRUE(sample(device.fd(), past_end).empty());
+    EXPECT_FALSE(verification::judge_erase({}, {}).passed);
+}
@@ -0,0 +1,234 @@
+/**
+ * @file TaggedVerificationTest.cpp
+ * @brief Unit tests for LBA-tagged blocks, their readback check and the tagged algorithms
+ */
+
+#include "algorithms/LBATaggedAlgorithm.hpp"
+#include "algorithms/LBATaggedZeroAlgorithm.hpp"
+#include "algorithms/TaggedVerification.hpp"
+#include "util/TaggedBlock.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <vector>
+
+using util::TAGGED_BLOCK_SIZE;
+
+namespace {
+
+constexpr uint64_t JOB = 0xA11C'E5ED'0000'0001ULL;
+constexpr uint64_t OTHER_JOB = 0xB0B0'0000'0000'0002ULL;
+
+// Several read buffers plus a short last block
+constexpr uint64_t MULTI_BLOCK_SIZE = (3 * 1'024 * 1'024) + 1'000;
+
+// Tagging and checking must comfortably outrun a disk, even in debug builds
+constexpr double MIN_TAG_MB_PER_S = 100.0;
+
+auto tagged_stream(uint64_t job_id, uint64_t offset, std::size_t length) -> std::vector<uint8_t> {
+    std::vector<uint8_t> data(length);
+    util::fill_tagged(job_id, offset, data);
+    return data;
+}
+
+void write_at(int fd, const std::vector<uint8_t>& data, uint64_t offset) {
+    ASSERT_EQ(pwrite(fd, data.data(), data.size(), static_cast<off_t>(offset)),
+              static_cast<ssize_t>(data.size()));
+}
+
+auto check(int fd, uint64_t size, std::optional<uint64_t> job_id = JOB)
+    -> verification::TaggedVerdict {
+    const std::atomic<bool> cancel{false};
+    return verification::verify_tagged(fd, size, job_id, nullptr, cancel);
+}
+
+}  // namespace
+
+class TaggedVerificationTest : public AlgorithmTestFixture {};
+
+TEST(TaggedBlockTest, ReadTag_RecoversAddressAndJob) {
+    std::array<uint8_t, TAGGED_BLOCK_SIZE> block;
+    util::make_tagged_block(JOB, 12'345, block);
+
+    util::BlockTag tag;
+    ASSERT_EQ(util::read_tag(block, tag), util::TagStatus::VALID);
+    EXPECT_EQ(tag.address, 12'345U);
+    EXPECT_EQ(tag.job_id, JOB);
+}
+
+TEST(TaggedBlockTest, ReadTag_DetectsCorruptionAndForeignData) {
+    std::array<uint8_t, TAGGED_BLOCK_SIZE> block;
+    util::make_tagged_block(JOB, 7, block);
+    util::BlockTag tag;
+
+    block[3'000] ^= 0x10;
+    EXPECT_EQ(util::read_tag(block, tag), util::TagStatus::CORRUPT);
+
+    // Two payload words swapped between checksum lanes
+    util::make_tagged_block(JOB, 7, block);
+    std::swap_ranges(block.begin() + 100, block.begin() + 104, block.begin() + 104);
+    EXPECT_EQ(util::read_tag(block, tag), util::TagStatus::CORRUPT);
+
+    block.fill(0x00);
+    EXPECT_EQ(util::read_tag(block, tag), util::TagStatus::FOREIGN);
+}
+
+TEST(TaggedBlockTest, FillTagged_IsSeekable) {
+    const auto whole = tagged_stream(JOB, 0, 4 * TAGGED_BLOCK_SIZE);
+
+    for (const auto& [offset, length] :
+         std::array{std::pair{0UL, 10UL}, std::pair{4'000UL, 200UL}, std::pair{4'096UL, 4'096UL},
+                    std::pair{5'000UL, 9'000UL}}) {
+        const auto window = tagged_stream(JOB, offset, length);
+        EXPECT_TRUE(std::equal(window.begin(), window.end(),
+                               whole.begin() + static_cast<std::ptrdiff_t>(offset)))
+            << "offset " << offset << " length " << length;
+    }
+}
+
+TEST_F(TaggedVerificationTest, Verify_AcceptsAnIntactPass) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    write_at(file.fd(), tagged_stream(JOB, 0, MULTI_BLOCK_SIZE), 0);
+
+    const auto verdict = check(file.fd(), MULTI_BLOCK_SIZE);
+    EXPECT_TRUE(verdict.passed) << verdict.detail;
+    EXPECT_EQ(verdict.blocks, (MULTI_BLOCK_SIZE + TAGGED_BLOCK_SIZE - 1) / TAGGED_BLOCK_SIZE);
+    EXPECT_EQ(verdict.real_capacity, MULTI_BLOCK_SIZE);
+
+    // Without a job id, the one on disk is adopted
+    EXPECT_TRUE(check(file.fd(), MULTI_BLOCK_SIZE, std::nullopt).passed);
+    EXPECT_FALSE(check(file.fd(), MULTI_BLOCK_SIZE, OTHER_JOB).passed);
+}
+
+// Test: a dropped write leaves an earlier run's intact block behind
+TEST_F(TaggedVerificationTest, Verify_DetectsDroppedWrite) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    write_at(file.fd(), tagged_stream(JOB, 0, MULTI_BLOCK_SIZE), 0);
+    write_at(file.fd(), tagged_stream(OTHER_JOB, 100 * TAGGED_BLOCK_SIZE, TAGGED_BLOCK_SIZE),
+             100 * TAGGED_BLOCK_SIZE);
+
+    const auto verdict = check(file.fd(), MULTI_BLOCK_SIZE);
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_EQ(verdict.stale, 1U);
+    EXPECT_EQ(verdict.first_bad_offset, 100 * TAGGED_BLOCK_SIZE);
+    EXPECT_EQ(verdict.real_capacity, MULTI_BLOCK_SIZE);  // Scattered, not a capacity limit
+}
+
+TEST_F(TaggedVerificationTest, Verify_DetectsMisdirectedWrite) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    write_at(file.fd(), tagged_stream(JOB, 0, MULTI_BLOCK_SIZE), 0);
+    // Block 9's data landed on block 5 too
+    write_at(file.fd(), tagged_stream(JOB, 9 * TAGGED_BLOCK_SIZE, TAGGED_BLOCK_SIZE),
+             5 * TAGGED_BLOCK_SIZE);
+
+    const auto verdict = check(file.fd(), MULTI_BLOCK_SIZE);
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_EQ(verdict.misplaced, 1U);
+    EXPECT_EQ(verdict.first_bad_offset, 5 * TAGGED_BLOCK_SIZE);
+}
+
+// Test: counterfeit flash that wraps addresses at its real size
+TEST_F(TaggedVerificationTest, Verify_FindsRealSizeOfWrappingDrive) {
+    constexpr uint64_t REAL = 1'024 * 1'024;
+    constexpr uint64_t CLAIMED = 4 * REAL;
+
+    // The last write to each physical block wins: the pass for the top quarter
+    const auto physical = tagged_stream(JOB, CLAIMED - REAL, REAL);
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    for (uint64_t offset = 0; offset < CLAIMED; offset += REAL) {
+        write_at(file.fd(), physical, offset);
+    }
+
+    const auto verdict = check(file.fd(), CLAIMED);
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_EQ(verdict.real_capacity, REAL);
+    EXPECT_NE(verdict.detail.find(std::format("only {} of {} bytes", REAL, CLAIMED)),
+              std::string::npos)
+        << verdict.detail;
+}
+
+// Test: a drive that silently discards writes past its real end
+TEST_F(TaggedVerificationTest, Verify_FindsRealSizeOfTruncatingDrive) {
+    constexpr uint64_t REAL = (2 * 1'024 * 1'024) + (3 * TAGGED_BLOCK_SIZE);
+    constexpr uint64_t CLAIMED = 4 * 1'024 * 1'024;
+
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    ASSERT_TRUE(file.resize(CLAIMED));
+    write_at(file.fd(), tagged_stream(JOB, 0, REAL), 0);
+
+    const auto verdict = check(file.fd(), CLAIMED);
+    EXPECT_FALSE(verdict.passed);
+    EXPECT_EQ(verdict.foreign, (CLAIMED - REAL) / TAGGED_BLOCK_SIZE);
+    EXPECT_EQ(verdict.real_capacity, REAL);
+}
+
+TEST_F(TaggedVerificationTest, LBATagged_ExecuteAndVerify) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    ASSERT_TRUE(file.resize(MULTI_BLOCK_SIZE));
+
+    LBATaggedAlgorithm algorithm;
+    EXPECT_EQ(algorithm.get_pass_count(), 1);
+    EXPECT_TRUE(algorithm.is_ssd_compatible());
+    ASSERT_TRUE(algorithm.execute(file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+    EXPECT_TRUE(algorithm.verify(file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+
+    // A fresh instance (e.g. a later verify-only run) accepts the job id on disk
+    LBATaggedAlgorithm fresh;
+    EXPECT_TRUE(fresh.verify(file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+
+    std::vector<uint8_t> zeros(TAGGED_BLOCK_SIZE, 0x00);
+    write_at(file.fd(), zeros, 2 * TAGGED_BLOCK_SIZE);
+    EXPECT_FALSE(algorithm.verify(file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+}
+
+TEST_F(TaggedVerificationTest, LBATaggedZero_ChecksTagsThenLeavesZeros) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    ASSERT_TRUE(file.resize(MULTI_BLOCK_SIZE));
+
+    LBATaggedZeroAlgorithm algorithm;
+    EXPECT_EQ(algorithm.get_pass_count(), 2);
+    ASSERT_TRUE(
+        algorithm.execute(file.fd(), MULTI_BLOCK_SIZE, CreateCapturingCallback(), cancel_flag));
+    EXPECT_TRUE(algorithm.verify(file.fd(), MULTI_BLOCK_SIZE, nullptr, cancel_flag));
+
+    // The tagged pass was read back between the two write passes
+    const bool checked = std::ranges::any_of(captured_progress, [](const WipeProgress& p) {
+        return p.status.starts_with("Checking tagged blocks");
+    });
+    EXPECT_TRUE(checked);
+}
+
+TEST(TaggedBlockTest, Benchmark_TagAndCheckThroughput) {
+    constexpr std::size_t BLOCKS = 16'384;  // 64 MiB
+    std::array<uint8_t, TAGGED_BLOCK_SIZE> block;
+    std::size_t valid = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t address = 0; address < BLOCKS; ++address) {
+        util::make_tagged_block(JOB, address, block);
+        util::BlockTag tag;
+        valid += util::read_tag(block, tag) == util::TagStatus::VALID ? 1 : 0;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(valid, BLOCKS);
+    const double mb_per_s =
+        (BLOCKS * TAGGED_BLOCK_SIZE / (1'024.0 * 1'024.0)) / std::max(elapsed.count(), 1e-9);
+    RecordProperty("tag_and_check_mb_per_s", std::format("{:.0f}", mb_per_s));
+    EXPECT_GT(mb_per_s, MIN_TAG_MB_PER_S);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file ThinDiscardAlgorithmTest.cpp
+ * @brief Unit tests for ThinDiscardAlgorithm and provisioning detection
+ */
+
+#include "algorithms/ThinDiscardAlgorithm.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t TEST_SIZE = 4ULL << 20;  // 4 MiB
+
+}  // namespace
+
+class ThinDiscardAlgorithmTest : public AlgorithmTestFixture {
+protected:
+    ThinDiscardAlgorithm algorithm;
+    TempTestDir temp_dir;
+    fs::path dir{temp_dir.path()};
+
+    // Disk image filled with non-zero data, fully allocated
+    auto make_image() -> std::string {
+        auto path = (dir / "disk.img").string();
+        std::ofstream{path, std::ios::binary} << std::string(TEST_SIZE, 'D');
+        return path;
+    }
+};
+
+TEST_F(ThinDiscardAlgorithmTest, Metadata) {
+    EXPECT_EQ(algorithm.get_name(), "Thin Discard");
+    EXPECT_FALSE(algorithm.get_description().empty());
+    EXPECT_EQ(algorithm.get_pass_count(), 2);
+    EXPECT_TRUE(algorithm.is_ssd_compatible());
+    EXPECT_TRUE(algorithm.supports_verification());
+    EXPECT_FALSE(algorithm.requires_device_access());
+}
+
+TEST_F(ThinDiscardAlgorithmTest, ReadProvisioningInfo_VirtioDiskWithDiscardIsThin) {
+    write_value(dir / "vda" / "queue" / "discard_max_bytes", "2147483136");
+    write_value(dir / "vda" / "queue" / "write_zeroes_max_bytes", "2147483136");
+    write_value(dir / "vda" / "queue" / "discard_zeroes_data", "0");
+
+    auto info = ThinDiscardAlgorithm::read_provisioning_info(dir / "vda");
+
+    EXPECT_TRUE(info.virtual_disk);
+    EXPECT_TRUE(info.supports_discard());
+    EXPECT_TRUE(info.supports_write_zeroes());
+    EXPECT_TRUE(info.is_thin());
+}
+
+TEST_F(ThinDiscardAlgorithmTest, ReadProvisioningInfo_ScsiUnmapModeIsThin) {
+    write_value(dir / "sdb" / "queue" / "discard_max_bytes", "4294966784");
+    write_value(dir / "sdb" / "device" / "scsi_disk" / "2:0:0:0" / "provisioning_mode", "unmap");
+
+    auto info = ThinDiscardAlgorithm::read_provisioning_info(dir / "sdb");
+
+    EXPECT_FALSE(info.virtual_disk);
+    EXPECT_EQ(info.provisioning_mode, "unmap");
+    EXPECT_TRUE(info.is_thin());
+}
+
+TEST_F(ThinDiscardAlgorithmTest, ReadProvisioningInfo_PhysicalSsdIsNotThin) {
+    write_value(dir / "nvme0n1" / "queue" / "discard_max_bytes", "2199023255040");
+    write_value(dir / "nvme0n1" / "queue" / "write_zeroes_max_bytes", "131072");
+    write_value(dir / "sda" / "device" / "scsi_disk" / "0:0:0:0" / "provisioning_mode", "full");
+
+    EXPECT_FALSE(ThinDiscardAlgorithm::read_provisioning_info(dir / "nvme0n1").is_thin());
+    EXPECT_FALSE(ThinDiscardAlgorithm::read_provisioning_info(dir / "sda").is_thin());
+}
+
+TEST_F(ThinDiscardAlgorithmTest, ReadProvisioningInfo_PartitionUsesParentQueue) {
+    write_value(dir / "vdb" / "queue" / "discard_max_bytes", "1073741824");
+    write_value(dir / "vdb" / "vdb1" / "partition", "1");
+
+    auto info = ThinDiscardAlgorithm::read_provisioning_info(dir / "vdb" / "vdb1");
+
+    EXPECT_EQ(info.discard_max_bytes, 1073741824U);
+    EXPECT_TRUE(info.is_thin());
+}
+
+TEST_F(ThinDiscardAlgorithmTest, ReadProvisioningInfo_MissingAttributesReadAsUnsupported) {
+    auto info = ThinDiscardAlgorithm::read_provisioning_info(dir / "vdz");
+
+    EXPECT_EQ(info, (ProvisioningInfo{.discard_max_bytes = 0,
+                                      .write_zeroes_max_bytes = 0,
+                                      .discard_zeroes_data = false,
+                                      .provisioning_mode = {},
+                                      .virtual_disk = true}));
+    EXPECT_FALSE(info.is_thin());
+}
+
+TEST_F(ThinDiscardAlgorithmTest, GetProvisioningInfo_NotABlockDevice) {
+    auto path = make_image();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    EXPECT_FALSE(ThinDiscardAlgorithm::get_provisioning_info(fd).has_value());
+    ::close(fd);
+}
+
+TEST_F(ThinDiscardAlgorithmTest, Execute_ImageReadsZeroAndIsDeallocated) {
+    auto path = make_image();
+    int fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    struct stat before{};
+    ASSERT_EQ(::fstat(fd, &before), 0);
+
+    bool result = algorithm.execute(fd, TEST_SIZE, CreateCapturingCallback(), cancel_flag);
+    if (!result) {
+        ::close(fd);
+        GTEST_SKIP() << "Filesystem cannot punch holes";
+    }
+
+    struct stat after{};
+    ASSERT_EQ(::fstat(fd, &after), 0);
+    EXPECT_EQ(after.st_size, before.st_size);
+    EXPECT_LT(after.st_blocks, before.st_blocks);
+    EXPECT_TRUE(algorithm.verify(fd, TEST_SIZE, nullptr, cancel_flag));
+    ::close(fd);
+
+    ASSERT_FALSE(captured_progress.empty());
+    EXPECT_EQ(captured_progress.front().current_pass, 1);
+    EXPECT_EQ(captured_progress.back().current_pass, 2);
+    EXPECT_EQ(captured_progress.back().total_passes, 2);
+    EXPECT_DOUBLE_EQ(captured_progress.back().percentage, 100.0);
+}
+
+TEST_F(ThinDiscardAlgorithmTest, Execute_CancelledLeavesDataInPlace) {
+    auto path = make_image();
+    int fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    cancel_flag.store(true);
+
+    EXPECT_FALSE(algorithm.execute(fd, TEST_SIZE, nullptr, cancel_flag));
+    cancel_flag.store(false);
+    EXPECT_FALSE(algorithm.verify(fd, TEST_SIZE, nullptr, cancel_flag));
+    ::close(fd);
+}
+
+TEST_F(ThinDiscardAlgorithmTest, Execute_ZeroSize_ReturnsTrue) {
+    EXPECT_TRUE(algorithm.execute(-1, 0, nullptr, cancel_flag));
+}
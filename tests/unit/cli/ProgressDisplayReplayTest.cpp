@@ -0,0 +1,185 @@
+/**
+ * @file ProgressDisplayReplayTest.cpp
+ * @brief Progress trace generation and CLI progress display replay benchmarks
+ *
+ * Replays update storms far above what a helper sends into cli::ProgressDisplay
+ * and gates the process CPU cost and the amount of terminal output. Scenario
+ * knobs are documented in fixtures/ProgressReplay.hpp.
+ */
+
+#include "cli/ProgressDisplay.hpp"
+
+#include "fixtures/ProgressReplay.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <sstream>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Regression gates, generous enough for loaded CI machines
+constexpr double MAX_CPU_LOAD = 0.5;  // Cores busy while replaying
+
+/**
+ * @brief Captures std::cout for the lifetime of the object
+ */
+class CaptureStdout {
+public:
+    CaptureStdout() : previous_(std::cout.rdbuf(captured_.rdbuf())) {}
+    ~CaptureStdout() { std::cout.rdbuf(previous_); }
+
+    CaptureStdout(const CaptureStdout&) = delete;
+    CaptureStdout& operator=(const CaptureStdout&) = delete;
+    CaptureStdout(CaptureStdout&&) = delete;
+    CaptureStdout& operator=(CaptureStdout&&) = delete;
+
+    [[nodiscard]] auto text() const -> std::string { return captured_.str(); }
+
+private:
+    std::ostringstream captured_;
+    std::streambuf* previous_;
+};
+
+auto job_count(const std::vector<TraceEvent>& trace) -> std::size_t {
+    std::size_t jobs = 0;
+    for (const auto& event : trace) {
+        jobs = std::max(jobs, event.job + 1);
+    }
+    return jobs;
+}
+
+auto make_displays(std::size_t jobs, bool multi_device)
+    -> std::vector<std::unique_ptr<cli::ProgressDisplay>> {
+    std::vector<std::unique_ptr<cli::ProgressDisplay>> displays;
+    for (std::size_t job = 0; job < jobs; ++job) {
+        auto display = std::make_unique<cli::ProgressDisplay>(
+            std::format("/dev/sd{}", static_cast<char>('a' + job % 26)), "Replay Disk",
+            1'000'000'000'000, "Replay", 3);
+        display->set_color_enabled(false);
+        display->set_multi_device(multi_device);
+        displays.push_back(std::move(display));
+    }
+    return displays;
+}
+
+void record(const ReplayReport& report) {
+    ::testing::Test::RecordProperty("updates", std::format("{}", report.delivered));
+    ::testing::Test::RecordProperty("cpu_load", std::format("{:.3f}", report.cpu_load()));
+}
+
+}  // namespace
+
+// ========== Trace generation ==========
+
+TEST(ProgressReplayTest, SyntheticTrace_HasRateJobsAndCompletion) {
+    auto trace = make_synthetic_trace({.rate_hz = 100.0,
+                                       .jobs = 3,
+                                       .duration = 1s,
+                                       .jitter = 0.5,
+                                       .seed = 7,
+                                       .total_bytes = 1'000,
+                                       .passes = 2});
+
+    EXPECT_TRUE(std::ranges::is_sorted(trace, {}, &TraceEvent::at));
+    for (std::size_t job = 0; job < 3; ++job) {
+        auto events = std::ranges::count(trace, job, &TraceEvent::job);
+        EXPECT_GT(events, 50) << job;
+        EXPECT_LT(events, 200) << job;
+
+        // Each job ends exactly once, at 100 % of the last pass
+        auto reversed = trace | std::views::reverse;
+        auto last = std::ranges::find(reversed, job, &TraceEvent::job);
+        ASSERT_NE(last, reversed.end());
+        EXPECT_TRUE(last->progress.is_complete);
+        EXPECT_EQ(last->progress.current_pass, 2);
+        EXPECT_EQ(last->progress.bytes_written, 2'000U);
+        EXPECT_EQ(std::ranges::count_if(trace,
+                                        [job](const TraceEvent& e) {
+                                            return e.job == job && e.progress.is_complete;
+                                        }),
+                  1);
+    }
+}
+
+TEST(ProgressReplayTest, RecordedTrace_RoundTripsThroughText) {
+    auto trace = make_synthetic_trace({.rate_hz = 50.0,
+                                       .jobs = 2,
+                                       .duration = 200ms,
+                                       .jitter = 0.2,
+                                       .seed = 1,
+                                       .total_bytes = 4'096,
+                                       .passes = 1});
+    std::stringstream file;
+    file << "# recorded by hand\n\n";
+    write_progress_trace(file, trace);
+
+    auto loaded = read_progress_trace(file);
+
+    ASSERT_EQ(loaded.size(), trace.size());
+    for (std::size_t i = 0; i < trace.size(); ++i) {
+        EXPECT_EQ(loaded[i].at, trace[i].at);
+        EXPECT_EQ(loaded[i].job, trace[i].job);
+        EXPECT_EQ(loaded[i].progress.bytes_written, trace[i].progress.bytes_written);
+        EXPECT_EQ(loaded[i].progress.status, trace[i].progress.status);
+        EXPECT_EQ(loaded[i].progress.is_complete, trace[i].progress.is_complete);
+    }
+}
+
+// ========== Replay benchmarks ==========
+
+TEST(ProgressDisplayReplayTest, Benchmark_SingleDeviceStorm) {
+    const auto trace = trace_from_environment({.rate_hz = 2'000.0, .jobs = 1, .duration = 1s});
+    auto displays = make_displays(job_count(trace), false);
+
+    ReplayReport report;
+    {
+        CaptureStdout capture;
+        report = ProgressReplayer::replay(
+            trace,
+            [&displays](const TraceEvent& event) { displays[event.job]->update(event.progress); },
+            [] { std::this_thread::sleep_for(1ms); });
+    }
+    record(report);
+
+    EXPECT_EQ(report.delivered, trace.size());
+    EXPECT_LT(report.cpu_load(), MAX_CPU_LOAD);
+}
+
+TEST(ProgressDisplayReplayTest, Benchmark_MultiDeviceStormIsThrottled) {
+    const auto trace =
+        trace_from_environment({.rate_hz = 1'000.0, .jobs = 8, .duration = 1s, .jitter = 0.3});
+    const auto jobs = job_count(trace);
+    auto displays = make_displays(jobs, true);
+    std::mutex output_mutex;  // Callers serialize output across displays
+
+    ReplayReport report;
+    std::string output;
+    {
+        CaptureStdout capture;
+        report = ProgressReplayer::replay(
+            trace,
+            [&](const TraceEvent& event) {
+                std::lock_guard lock(output_mutex);
+                displays[event.job]->update(event.progress);
+            },
+            [] { std::this_thread::sleep_for(1ms); });
+        output = capture.text();
+    }
+    record(report);
+
+    EXPECT_EQ(report.delivered, trace.size());
+    EXPECT_LT(report.cpu_load(), MAX_CPU_LOAD);
+
+    // One status line per device per interval, however fast updates arrive
+    const auto intervals = static_cast<std::size_t>(report.wall / 5s) + 1;
+    const auto status_lines = static_cast<std::size_t>(std::ranges::count(output, '\n'));
+    EXPECT_LE(status_lines, jobs * (intervals + 3));  // Plus a three-line header each
+}
@@ -0,0 +1,138 @@
+/**
+ * @file SnapshotObservableTest.cpp
+ * @brief Unit tests for the copy-on-write snapshot observable
+ */
+
+#include "core/Observable.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Names = std::vector<std::string>;
+
+/**
+ * @brief Value that counts how often it is copied
+ */
+struct CopyCounter {
+    static inline int copies = 0;
+
+    int value = 0;
+
+    CopyCounter() = default;
+    explicit CopyCounter(int v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&&) noexcept = default;
+    CopyCounter& operator=(const CopyCounter& other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    CopyCounter& operator=(CopyCounter&&) noexcept = default;
+    ~CopyCounter() = default;
+
+    auto operator==(const CopyCounter&) const -> bool = default;
+};
+
+}  // namespace
+
+TEST(SnapshotObservableTest, SetPublishesNewSnapshotAndKeepsOldOneValid) {
+    mvvm::SnapshotObservable<Names> names{{"sda"}};
+    auto before = names.get();
+
+    EXPECT_TRUE(names.set({"sda", "sdb"}));
+
+    EXPECT_EQ(*before, Names{"sda"});
+    EXPECT_EQ(names.get()->size(), 2U);
+}
+
+TEST(SnapshotObservableTest, EqualValueDoesNotNotify) {
+    mvvm::SnapshotObservable<Names> names{{"sda"}};
+    int calls = 0;
+    names.subscribe([&calls](const auto&) { ++calls; });
+
+    EXPECT_FALSE(names.set({"sda"}));
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(SnapshotObservableTest, SubscribersShareTheStoredSnapshot) {
+    mvvm::SnapshotObservable<std::vector<CopyCounter>> values;
+    std::vector<mvvm::SnapshotObservable<std::vector<CopyCounter>>::Snapshot> seen;
+    for (int i = 0; i < 3; ++i) {
+        values.subscribe([&seen](const auto& snapshot) { seen.push_back(snapshot); });
+    }
+    std::vector<CopyCounter> update;
+    update.emplace_back(1);
+    update.emplace_back(2);
+    CopyCounter::copies = 0;
+
+    values.set(std::move(update));
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+    ASSERT_EQ(seen.size(), 3U);
+    for (const auto& snapshot : seen) {
+        EXPECT_EQ(snapshot, values.get());
+    }
+}
+
+TEST(SnapshotObservableTest, UnsubscribeStopsNotifications) {
+    mvvm::SnapshotObservable<Names> names;
+    int first = 0;
+    int second = 0;
+    auto id = names.subscribe([&first](const auto&) { ++first; });
+    names.subscribe([&second](const auto&) { ++second; });
+
+    names.set({"sda"});
+    names.unsubscribe(id);
+    names.set({"sdb"});
+
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 2);
+}
+
+TEST(SnapshotObservableTest, SubscribeFromCallbackDoesNotDeadlock) {
+    mvvm::SnapshotObservable<Names> names;
+    int late_calls = 0;
+    names.subscribe([&](const auto&) {
+        names.subscribe([&late_calls](const auto&) { ++late_calls; });
+    });
+
+    names.set({"sda"});
+    EXPECT_EQ(late_calls, 0);  // Added after this notification started
+    names.set({"sdb"});
+    EXPECT_EQ(late_calls, 1);
+}
+
+TEST(SnapshotObservableTest, ConcurrentReadersSeeCompleteSnapshots) {
+    mvvm::SnapshotObservable<Names> names{{"a"}};
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            auto snapshot = names.get();
+            // Every published value is a non-empty run of one repeated name
+            if (snapshot->empty()) {
+                torn = true;
+                continue;
+            }
+            for (const auto& name : *snapshot) {
+                if (name != snapshot->front()) {
+                    torn = true;
+                }
+            }
+        }
+    });
+    for (int i = 1; i <= 500; ++i) {
+        names.set(Names(static_cast<std::size_t>(i % 7) + 1, std::to_string(i)));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_FALSE(torn.load());
+}
@@ -0,0 +1,180 @@
+/**
+ * @file DiskInventoryTest.cpp
+ * @brief Unit tests and footprint benchmark for the compact disk inventory
+ */
+
+#include "models/DiskInventory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t LARGE_INVENTORY = 2'000;
+
+// Inventory bytes may be at most this fraction of the equivalent DiskInfo vector
+constexpr double MAX_FOOTPRINT_RATIO = 0.5;
+
+auto make_disk(std::size_t index) -> DiskInfo {
+    // Realistic fleet: few distinct models, most disks unmounted
+    DiskInfo disk{.path = std::format("/dev/sd{}", index),
+                  .model = std::format("Vendor Enterprise SAS Model {}", index % 4),
+                  .serial = std::format("SN{:08}", index),
+                  .size_bytes = 4'000'000'000'000,
+                  .is_removable = false,
+                  .is_ssd = index % 2 == 0,
+                  .filesystem = "",
+                  .is_mounted = false,
+                  .mount_point = "",
+                  .is_lvm_pv = index % 5 == 0,
+                  .smart = {},
+                  .is_thin_provisioned = false};
+    if (index % 10 == 0) {
+        disk.filesystem = "xfs";
+        disk.is_mounted = true;
+        disk.mount_point = std::format("/srv/data/volume-{}", index);
+    }
+    if (index % 3 == 0) {
+        disk.smart.available = true;
+        disk.smart.temperature_celsius = 35;
+        disk.smart.status = SmartData::HealthStatus::GOOD;
+    }
+    return disk;
+}
+
+auto make_inventory(const std::vector<DiskInfo>& disks) -> DiskInventory {
+    DiskInventory::Builder builder{disks.size()};
+    for (std::size_t i = 0; i < disks.size(); ++i) {
+        builder.add(static_cast<DiskInventory::DeviceId>(100 + i), disks[i]);
+    }
+    return std::move(builder).build();
+}
+
+// Inline plus heap bytes of a DiskInfo vector (strings past the SSO buffer allocate)
+auto footprint(const std::vector<DiskInfo>& disks) -> std::size_t {
+    auto heap = [](const std::string& s) {
+        return s.capacity() > std::string{}.capacity() ? s.capacity() + 1 : 0;
+    };
+    std::size_t bytes = disks.capacity() * sizeof(DiskInfo);
+    for (const auto& disk : disks) {
+        bytes += heap(disk.path) + heap(disk.model) + heap(disk.serial) + heap(disk.filesystem) +
+                 heap(disk.mount_point);
+    }
+    return bytes;
+}
+
+}  // namespace
+
+TEST(DiskInventoryTest, Empty_HasOnlyTheEmptyString) {
+    const DiskInventory inventory;
+
+    EXPECT_TRUE(inventory.empty());
+    EXPECT_EQ(inventory.string_count(), 1U);
+    EXPECT_EQ(inventory.string(DiskInventory::EMPTY_STRING), "");
+    EXPECT_FALSE(inventory.find(1).has_value());
+    EXPECT_TRUE(inventory.to_disk_infos().empty());
+}
+
+TEST(DiskInventoryTest, RoundTrip_PreservesEveryField) {
+    std::vector<DiskInfo> disks;
+    for (std::size_t i = 0; i < 20; ++i) {
+        disks.push_back(make_disk(i));
+    }
+    disks[7].is_removable = true;
+    disks[8].is_thin_provisioned = true;
+
+    const auto inventory = make_inventory(disks);
+
+    ASSERT_EQ(inventory.size(), disks.size());
+    EXPECT_EQ(inventory.to_disk_infos(), disks);
+    EXPECT_TRUE(inventory[7].is_removable());
+    EXPECT_TRUE(inventory[8].is_thin_provisioned());
+    EXPECT_EQ(inventory[3].smart_status(), SmartData::HealthStatus::GOOD);
+    EXPECT_EQ(inventory[4].smart(), nullptr);
+}
+
+TEST(DiskInventoryTest, Intern_StoresRepeatedStringsOnce) {
+    std::vector<DiskInfo> disks;
+    for (std::size_t i = 0; i < 100; ++i) {
+        disks.push_back(make_disk(i));
+    }
+
+    const auto inventory = make_inventory(disks);
+
+    // "" + "xfs" + 4 models + 100 paths + 100 serials + 10 mount points
+    EXPECT_EQ(inventory.string_count(), 216U);
+    EXPECT_EQ(inventory.row(1).model, inventory.row(5).model);
+    EXPECT_EQ(inventory.row(1).filesystem, DiskInventory::EMPTY_STRING);
+}
+
+TEST(DiskInventoryTest, Find_ByStableIdAndPath) {
+    const auto inventory = make_inventory({make_disk(0), make_disk(1), make_disk(2)});
+
+    auto by_id = inventory.find(101);
+    ASSERT_TRUE(by_id.has_value());
+    EXPECT_EQ(by_id->path(), "/dev/sd1");
+
+    auto by_path = inventory.find_path("/dev/sd2");
+    ASSERT_TRUE(by_path.has_value());
+    EXPECT_EQ(by_path->id(), 102U);
+
+    EXPECT_FALSE(inventory.find(7).has_value());
+    EXPECT_FALSE(inventory.find_path("/dev/sdz").has_value());
+    EXPECT_FALSE(inventory.find_path("").has_value());
+}
+
+TEST(DiskInventoryTest, Rows_IterateViewsInOrder) {
+    const auto inventory = make_inventory({make_disk(0), make_disk(1), make_disk(2)});
+
+    std::vector<DiskInventory::DeviceId> ids;
+    for (const auto disk : inventory.rows()) {
+        ids.push_back(disk.id());
+    }
+    EXPECT_EQ(ids, (std::vector<DiskInventory::DeviceId>{100, 101, 102}));
+}
+
+TEST(DiskInventoryTest, Builder_AcceptsPreInternedRows) {
+    // As the D-Bus decoder does: intern the string table, then add rows by id
+    DiskInventory::Builder builder;
+    const auto path = builder.intern("/dev/nvme0n1");
+    const auto model = builder.intern("Fast NVMe");
+    EXPECT_EQ(builder.intern("Fast NVMe"), model);
+    builder.add(DiskInventory::Row{.id = 9,
+                                   .path = path,
+                                   .model = model,
+                                   .serial = DiskInventory::EMPTY_STRING,
+                                   .filesystem = DiskInventory::EMPTY_STRING,
+                                   .mount_point = DiskInventory::EMPTY_STRING,
+                                   .size_bytes = 512,
+                                   .flags = DiskInventory::SSD | DiskInventory::MOUNTED,
+                                   .smart = {}});
+    const auto inventory = std::move(builder).build();
+
+    const auto disk = inventory[0].to_disk_info();
+    EXPECT_EQ(disk.path, "/dev/nvme0n1");
+    EXPECT_EQ(disk.model, "Fast NVMe");
+    EXPECT_TRUE(disk.is_ssd);
+    EXPECT_TRUE(disk.is_mounted);
+    EXPECT_FALSE(disk.is_removable);
+}
+
+TEST(DiskInventoryTest, LargeInventoryFootprintStaysCompact) {
+    std::vector<DiskInfo> disks;
+    disks.reserve(LARGE_INVENTORY);
+    for (std::size_t i = 0; i < LARGE_INVENTORY; ++i) {
+        disks.push_back(make_disk(i));
+    }
+
+    const auto inventory = make_inventory(disks);
+    const auto compact = inventory.memory_bytes();
+    const auto expanded = footprint(disks);
+
+    RecordProperty("disk_info_bytes_per_disk", std::format("{}", expanded / LARGE_INVENTORY));
+    RecordProperty("inventory_bytes_per_disk", std::format("{}", compact / LARGE_INVENTORY));
+
+    EXPECT_LT(static_cast<double>(compact), static_cast<double>(expanded) * MAX_FOOTPRINT_RATIO);
+}
@@ -0,0 +1,302 @@
+/**
+ * @file DiskServiceScalingTest.cpp
+ * @brief Enumeration correctness and scaling benchmarks against synthetic sysfs trees
+ *
+ * DiskService is pointed at generated /sys/block, /proc/mounts and /dev roots so the
+ * enumeration path can be checked at hundreds of disks without hardware. The timing
+ * tests assert that per-disk cost stays flat as the topology grows and that a large
+ * inventory fits a fixed latency budget.
+ */
+
+#include "helper/services/DiskService.hpp"
+
+#include "fixtures/SyntheticSysfs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+
+// Per-disk cost at the large size may be at most this multiple of the small size.
+// Linear per-disk growth (quadratic total) would blow well past it.
+constexpr double MAX_PER_DISK_GROWTH = 3.0;
+
+// Whole-inventory budget for the large topology, SMART excluded
+constexpr auto LARGE_ENUMERATION_BUDGET = std::chrono::milliseconds{2'000};
+
+constexpr std::size_t SMALL_DISKS = 32;
+constexpr std::size_t LARGE_DISKS = 512;
+constexpr int TIMING_RUNS = 3;
+
+auto make_service(const SyntheticSysfs& tree) -> SyntheticDiskService {
+    return SyntheticDiskService{tree.paths(), nullptr};
+}
+
+// Best-of-N wall time for a cold (uncached) enumeration
+auto time_enumeration(const SyntheticSysfs& tree) -> std::chrono::nanoseconds {
+    auto best = std::chrono::nanoseconds::max();
+    for (int run = 0; run < TIMING_RUNS; ++run) {
+        SyntheticDiskService service{tree.paths(), nullptr};
+        const auto start = std::chrono::steady_clock::now();
+        const auto disks = service.get_available_disks_sync();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(disks.size(), tree.disks().size());
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+    }
+    return best;
+}
+
+auto topology_with(std::size_t disks) -> SyntheticTopology {
+    // Mount table noise scales with the disk count, as it does on real hosts
+    auto topology = SyntheticTopology{};
+    topology.disk_count = disks;
+    topology.noise_mounts = disks;
+    return topology;
+}
+
+}  // namespace
+
+// ========== Correctness ==========
+
+TEST(DiskServiceScalingTest, Enumerate_SyntheticTopology_MatchesExpected) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 30}};
+    SyntheticDiskService service{tree.paths(), nullptr};
+
+    const auto disks = service.get_available_disks_sync();
+    ASSERT_EQ(disks.size(), tree.disks().size());
+
+    std::unordered_map<std::string, const DiskInfo*> by_path;
+    for (const auto& disk : disks) {
+        by_path[disk.path] = &disk;
+    }
+
+    for (const auto& expected : tree.disks()) {
+        const auto path = std::format("/dev/{}", expected.name);
+        ASSERT_TRUE(by_path.contains(path)) << path;
+        const auto& info = *by_path[path];
+
+        EXPECT_EQ(info.is_mounted, expected.mounted) << path;
+        EXPECT_EQ(info.mount_point, expected.mount_point) << path;
+        EXPECT_EQ(info.is_lvm_pv, expected.lvm_pv) << path;
+        EXPECT_EQ(info.is_ssd, expected.ssd) << path;
+        EXPECT_EQ(info.is_thin_provisioned, expected.thin) << path;
+        EXPECT_EQ(info.size_bytes, SyntheticTopology{}.sectors * 512) << path;
+        EXPECT_TRUE(info.model.starts_with("Synthetic ")) << path;
+        EXPECT_FALSE(info.model.ends_with(" ")) << path;
+        EXPECT_FALSE(info.smart.available) << path;
+    }
+}
+
+TEST(DiskServiceScalingTest, Enumerate_SkipsVirtualAndDmDevices) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 6, .dm_every = 1}};
+    auto service = make_service(tree);
+
+    for (const auto& disk : service.get_available_disks_sync()) {
+        EXPECT_FALSE(disk.path.contains("loop")) << disk.path;
+        EXPECT_FALSE(disk.path.contains("dm-")) << disk.path;
+    }
+}
+
+TEST(DiskServiceScalingTest, Enumerate_MapperMountResolvedThroughDevRoot) {
+    // No direct mounts: every mount must be found via the dm holder and /dev/mapper symlink
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 4, .mount_every = 0, .dm_every = 2}};
+    auto service = make_service(tree);
+
+    const auto disks = service.get_available_disks_sync();
+    ASSERT_EQ(disks.size(), 4U);
+    for (const auto& disk : disks) {
+        const bool expect_mounted = disk.path == "/dev/sda" || disk.path == "/dev/sdc";
+        EXPECT_EQ(disk.is_mounted, expect_mounted) << disk.path;
+        if (expect_mounted) {
+            EXPECT_EQ(disk.filesystem, "xfs");
+        }
+    }
+}
+
+TEST(DiskServiceScalingTest, Enumerate_MissingSysBlock_ReturnsEmpty) {
+    auto paths = SystemPaths{.sys_block = "/nonexistent/sys/block",
+                             .proc_mounts = "/nonexistent/proc/mounts",
+                             .dev = "/nonexistent/dev"};
+    DiskService service{paths, nullptr};
+    EXPECT_TRUE(service.get_available_disks_sync().empty());
+}
+
+TEST(DiskServiceScalingTest, Inventory_IdsStableAcrossRefreshes) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 8}};
+    auto service = make_service(tree);
+
+    const auto first = service.get_inventory();
+    ASSERT_EQ(first->size(), 8U);
+    EXPECT_EQ(service.get_inventory(), first);  // Served from cache without copying
+
+    service.invalidate_cache();
+    const auto second = service.get_inventory();
+    ASSERT_NE(second, first);
+    ASSERT_EQ(second->size(), first->size());
+
+    for (const auto disk : first->rows()) {
+        auto again = second->find(disk.id());
+        ASSERT_TRUE(again.has_value()) << disk.path();
+        EXPECT_EQ(again->path(), disk.path());
+    }
+    EXPECT_EQ(service.get_available_disks_sync(), second->to_disk_infos());
+}
+
+TEST(DiskServiceScalingTest, Enumerate_ReadsSerialFromSysfs) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 2}};
+    auto service = make_service(tree);
+
+    const auto inventory = service.get_inventory();
+    ASSERT_TRUE(inventory->find_path("/dev/sdb").has_value());
+    EXPECT_EQ(inventory->find_path("/dev/sdb")->serial(), "SYN000001");
+}
+
+TEST(DiskServiceScalingTest, WarmCache_RestoresDeviceIds) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 3}};
+    const auto cache = tree.root() / "inventory.cache";
+    std::ofstream{cache} << "storage-wiper-inventory 1\n"
+                            "next-id\t50\n"
+                            "device\t40\t/dev/sda\tSYN000000\n"
+                            "device\t41\t/dev/sdb\tSYN000001\n"
+                            "device\t42\t/dev/sdb\tSWAPPED\n";
+
+    auto service = make_service(tree);
+    ASSERT_TRUE(service.load_warm_cache(cache).has_value());
+    const auto inventory = service.get_inventory();
+
+    EXPECT_EQ(inventory->find_path("/dev/sda")->id(), 40U);
+    EXPECT_EQ(inventory->find_path("/dev/sdb")->id(), 41U);
+    EXPECT_EQ(inventory->find_path("/dev/sdc")->id(), 50U);  // New devices continue after
+}
+
+TEST(DiskServiceScalingTest, WarmCache_SaveLoadRoundTrip) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 4}};
+    const auto seed = tree.root() / "seed.cache";
+    const auto cache = tree.root() / "cache" / "inventory.cache";  // Directory is created
+    std::ofstream{seed} << "storage-wiper-inventory 1\n"
+                           "next-id\t90\n"
+                           "device\t70\t/dev/sdc\tSYN000002\n";
+
+    // Ids that differ from what a fresh enumeration would assign
+    auto first = make_service(tree);
+    ASSERT_TRUE(first.load_warm_cache(seed).has_value());
+    const auto before = first.get_inventory();
+    ASSERT_EQ(before->find_path("/dev/sdc")->id(), 70U);
+    ASSERT_TRUE(first.save_warm_cache(cache).has_value());
+    EXPECT_EQ(std::filesystem::status(cache).permissions() & std::filesystem::perms::all,
+              std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+
+    // Saving without a cached listing keeps the earlier file
+    first.invalidate_cache();
+    ASSERT_TRUE(first.save_warm_cache(cache).has_value());
+
+    auto restored = SyntheticDiskService{tree.paths(), nullptr};
+    ASSERT_TRUE(restored.load_warm_cache(cache).has_value());
+    const auto after = restored.get_inventory();
+    for (const auto disk : before->rows()) {
+        ASSERT_TRUE(after->find_path(disk.path()).has_value()) << disk.path();
+        EXPECT_EQ(after->find_path(disk.path())->id(), disk.id()) << disk.path();
+    }
+}
+
+TEST(DiskServiceScalingTest, WarmCache_SmartUsedOnceForMatchingSerial) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 1}};
+    const auto cache = tree.root() / "inventory.cache";
+    const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+    std::ofstream{cache} << "storage-wiper-inventory 1\n"
+                         << std::format("smart\t/dev/sda\tSYN000000\t{}\t1\t1200\t0\t0\t41\t0\t1\n",
+                                        now);
+
+    SyntheticDiskService service{tree.paths(), std::make_unique<SmartService>()};
+    ASSERT_TRUE(service.load_warm_cache(cache).has_value());
+
+    const auto disks = service.get_available_disks_sync();
+    ASSERT_EQ(disks.size(), 1U);
+    EXPECT_TRUE(disks[0].smart.available);
+    EXPECT_EQ(disks[0].smart.temperature_celsius, 41);
+    EXPECT_EQ(disks[0].smart.power_on_hours, 1200);
+    EXPECT_EQ(disks[0].smart.status, SmartData::HealthStatus::GOOD);
+}
+
+TEST(DiskServiceScalingTest, WarmCache_RejectsUnknownFormat) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 1}};
+    const auto cache = tree.root() / "inventory.cache";
+    std::ofstream{cache} << "something else\n";
+
+    auto service = make_service(tree);
+    EXPECT_FALSE(service.load_warm_cache(cache).has_value());
+    EXPECT_FALSE(service.load_warm_cache(tree.root() / "missing").has_value());
+}
+
+TEST(DiskServiceScalingTest, ValidateDevicePath_UsesDevRoot) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 2}};
+    auto service = make_service(tree);
+
+    EXPECT_TRUE(service.validate_device_path("/dev/sda").has_value());
+    EXPECT_FALSE(service.validate_device_path("/dev/sdz").has_value());
+    EXPECT_FALSE(service.validate_device_path("/dev/loop0").has_value());
+}
+
+TEST(DiskServiceScalingTest, ValidateDevicePath_RejectsRegularFiles) {
+    const SyntheticSysfs tree{SyntheticTopology{.disk_count = 1}};
+    DiskService service{tree.paths(), nullptr};
+
+    // Production code accepts block devices only; /dev/sda here is a plain file
+    EXPECT_FALSE(service.validate_device_path("/dev/sda").has_value());
+}
+
+TEST(DiskServiceScalingTest, DiskName_FollowsKernelScheme) {
+    EXPECT_EQ(SyntheticSysfs::disk_name(0), "sda");
+    EXPECT_EQ(SyntheticSysfs::disk_name(25), "sdz");
+    EXPECT_EQ(SyntheticSysfs::disk_name(26), "sdaa");
+    EXPECT_EQ(SyntheticSysfs::disk_name(701), "sdzz");
+    EXPECT_EQ(SyntheticSysfs::disk_name(702), "sdaaa");
+}
+
+// ========== Scaling benchmarks ==========
+
+TEST(DiskServiceScalingTest, Benchmark_PerDiskCostStaysFlat) {
+    const SyntheticSysfs small{topology_with(SMALL_DISKS)};
+    const SyntheticSysfs large{topology_with(LARGE_DISKS)};
+
+    // Warm the page cache for both trees before timing
+    static_cast<void>(make_service(small).get_available_disks_sync());
+    static_cast<void>(make_service(large).get_available_disks_sync());
+
+    const auto small_time = time_enumeration(small);
+    const auto large_time = time_enumeration(large);
+
+    const auto small_per_disk =
+        static_cast<double>(small_time.count()) / static_cast<double>(SMALL_DISKS);
+    const auto large_per_disk =
+        static_cast<double>(large_time.count()) / static_cast<double>(LARGE_DISKS);
+
+    RecordProperty("small_per_disk_us", std::format("{:.1f}", small_per_disk / 1'000.0));
+    RecordProperty("large_per_disk_us", std::format("{:.1f}", large_per_disk / 1'000.0));
+
+    EXPECT_LT(large_per_disk, small_per_disk * MAX_PER_DISK_GROWTH)
+        << std::format("per-disk cost grew from {:.1f}us ({} disks) to {:.1f}us ({} disks)",
+                       small_per_disk / 1'000.0, SMALL_DISKS, large_per_disk / 1'000.0,
+                       LARGE_DISKS);
+}
+
+TEST(DiskServiceScalingTest, Benchmark_LargeInventoryWithinBudget) {
+    const SyntheticSysfs tree{topology_with(LARGE_DISKS)};
+    static_cast<void>(make_service(tree).get_available_disks_sync());
+
+    const auto elapsed = time_enumeration(tree);
+    RecordProperty("enumeration_ms",
+                   std::format("{}", std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         elapsed)
+                                         .count()));
+
+    EXPECT_LT(elapsed, LARGE_ENUMERATION_BUDGET);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file FileShredServiceTest.cpp
+ * @brief Unit tests for in-place file shredding
+ */
+
+#include "helper/services/FileShredService.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class FileShredServiceTest : public ::testing::Test {
+protected:
+    TempTestDir temp_dir;
+    fs::path dir{temp_dir.path()};
+    util::Executor executor{{.compute_threads = 1, .io_threads = 4}};
+    FileShredService service{executor};
+    std::atomic<bool> cancel{false};
+
+    auto make_file(const std::string& name, std::size_t size, char fill = 'S') -> std::string {
+        auto path = (dir / name).string();
+        std::ofstream out{path, std::ios::binary};
+        out << std::string(size, fill);
+        return path;
+    }
+
+    static auto read_file(const std::string& path) -> std::string {
+        std::ifstream in{path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+};
+
+}  // namespace
+
+TEST_F(FileShredServiceTest, Shred_OverwritesTruncatesAndUnlinks) {
+    auto path = make_file("secret.txt", 10'000);
+    std::vector<ShredProgress> updates;
+
+    auto result = service.shred(
+        path, ShredOptions{}, [&](const ShredProgress& p) { updates.push_back(p); }, cancel);
+
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_FALSE(fs::exists(path));
+    ASSERT_FALSE(updates.empty());
+    EXPECT_TRUE(updates.back().progress.is_complete);
+    EXPECT_FALSE(updates.back().progress.has_error);
+    EXPECT_EQ(updates.back().path, path);
+}
+
+TEST_F(FileShredServiceTest, Shred_KeepsFileRenamedOverTheNameMidway) {
+    auto path = make_file("swapped.txt", 10'000);
+    auto replacement = make_file("replacement.txt", 100, 'R');
+    bool swapped = false;
+
+    auto result = service.shred(
+        path, ShredOptions{},
+        [&](const ShredProgress& update) {
+            if (!swapped && !update.progress.is_complete) {
+                swapped = ::rename(replacement.c_str(), path.c_str()) == 0;
+            }
+        },
+        cancel);
+
+    ASSERT_TRUE(swapped);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(read_file(path), std::string(100, 'R'));
+}
+
+TEST_F(FileShredServiceTest, Shred_CoversWholeLastBlock) {
+    auto path = make_file("tail.bin", 100);
+    struct stat st{};
+    ASSERT_EQ(::stat(path.c_str(), &st), 0);
+
+    auto result = service.shred(path, ShredOptions{}, {}, cancel);
+
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_EQ(result.bytes_overwritten, static_cast<uint64_t>(st.st_blksize));
+}
+
+TEST_F(FileShredServiceTest, Shred_KeepRestoresSizeWithOverwrittenContent) {
+    auto path = make_file("keep.bin", 5'000, 'K');
+    ShredOptions options;
+    options.remove = false;
+
+    auto result = service.shred(path, options, {}, cancel);
+
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_EQ(read_file(path), std::string(5'000, '\0'));
+}
+
+TEST_F(FileShredServiceTest, Shred_WarnsAboutHardLinks) {
+    auto path = make_file("linked.bin", 4'096);
+    auto alias = (dir / "alias.bin").string();
+    ASSERT_EQ(::link(path.c_str(), alias.c_str()), 0);
+
+    auto result = service.shred(path, ShredOptions{}, {}, cancel);
+
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_TRUE(std::ranges::any_of(result.warnings, [](const std::string& w) {
+        return w.find("hard links") != std::string::npos;
+    }));
+    EXPECT_EQ(fs::file_size(alias), 0U);  // Truncated through the shared inode
+}
+
+TEST_F(FileShredServiceTest, Shred_RejectsSymlinksAndDirectories) {
+    auto target = make_file("target.bin", 128);
+    auto link = (dir / "link").string();
+    ASSERT_EQ(::symlink(target.c_str(), link.c_str()), 0);
+
+    EXPECT_FALSE(service.shred(link, ShredOptions{}, {}, cancel).success);
+    EXPECT_FALSE(service.shred(dir.string(), ShredOptions{}, {}, cancel).success);
+    EXPECT_EQ(read_file(target), std::string(128, 'S'));
+}
+
+TEST_F(FileShredServiceTest, Shred_RejectsDeviceLevelAlgorithmAndForeignOwner) {
+    auto path = make_file("owned.bin", 64);
+
+    ShredOptions ata;
+    ata.algorithm = WipeAlgorithm::ATA_SECURE_ERASE;
+    EXPECT_FALSE(service.shred(path, ata, {}, cancel).success);
+
+    ShredOptions foreign;
+    foreign.required_owner = ::geteuid() + 1;
+    EXPECT_FALSE(service.shred(path, foreign, {}, cancel).success);
+    EXPECT_TRUE(fs::exists(path));
+}
+
+TEST_F(FileShredServiceTest, MapExtents_CoversFileWhenSupported) {
+    auto path = make_file("mapped.bin", 64 * 1'024);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    auto extents = FileShredService::map_extents(fd);
+    ::close(fd);
+    if (!extents) {
+        GTEST_SKIP() << "FIEMAP unavailable here: " << extents.error().message;
+    }
+
+    uint64_t mapped = 0;
+    for (const auto& extent : *extents) {
+        mapped += extent.length;
+    }
+    EXPECT_GE(mapped, 64U * 1'024U);
+}
+
+TEST_F(FileShredServiceTest, ShredAll_ProcessesFilesInParallel) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 6; ++i) {
+        paths.push_back(make_file("f" + std::to_string(i), 8'192));
+    }
+    std::mutex mutex;
+    int completions = 0;
+
+    auto results = service.shred_all(
+        paths, ShredOptions{},
+        [&](const ShredProgress& p) {
+            if (p.progress.is_complete) {
+                std::lock_guard lock(mutex);
+                ++completions;
+            }
+        },
+        cancel);
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        EXPECT_EQ(results[i].path, paths[i]);
+        EXPECT_TRUE(results[i].success) << results[i].message;
+        EXPECT_FALSE(fs::exists(paths[i]));
+    }
+    EXPECT_EQ(completions, 6);
+}
+
+TEST_F(FileShredServiceTest, Shred_CancelledBeforeStartKeepsFile) {
+    auto path = make_file("cancel.bin", 4'096);
+    cancel = true;
+
+    auto result = service.shred(path, ShredOptions{}, {}, cancel);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(fs::exists(path));
+}
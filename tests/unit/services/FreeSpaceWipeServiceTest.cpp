@@ -0,0 +1,205 @@
+/**
+ * @file FreeSpaceWipeServiceTest.cpp
+ * @brief Unit tests for free-space wiping against a simulated filesystem budget
+ */
+
+#include "helper/services/FreeSpaceWipeService.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t MIB = 1ULL << 20;
+
+/**
+ * @brief Test directory whose "free space" is a fixed budget minus what lives in it
+ *
+ * Lets the tests fill a few MiB instead of the real filesystem, and simulate
+ * other users consuming space via external_usage.
+ */
+class FreeSpaceWipeServiceTest : public ::testing::Test {
+protected:
+    TempTestDir temp_dir;
+    fs::path dir{temp_dir.path()};
+    uint64_t budget = 0;
+    std::atomic<uint64_t> external_usage{0};
+    util::Executor executor{{.compute_threads = 1, .io_threads = 4}};
+    std::atomic<bool> cancel{false};
+
+    auto used_bytes() const -> uint64_t {
+        uint64_t used = 0;
+        std::error_code ec;
+        for (const auto& entry : fs::recursive_directory_iterator(dir, ec)) {
+            if (entry.is_regular_file(ec)) {
+                used += entry.file_size(ec);
+            }
+        }
+        return used;
+    }
+
+    auto make_service() -> FreeSpaceWipeService {
+        return FreeSpaceWipeService{
+            executor, [this](const std::string&) -> std::expected<uint64_t, util::Error> {
+                const uint64_t used = used_bytes() + external_usage.load();
+                return used < budget ? budget - used : 0;
+            }};
+    }
+
+    auto directory_is_empty() const -> bool { return fs::is_empty(dir); }
+};
+
+auto small_options() -> FreeSpaceOptions {
+    FreeSpaceOptions options;
+    options.reserve_bytes = 4 * MIB;
+    options.file_size = 2 * MIB;
+    options.writers = 2;
+    return options;
+}
+
+}  // namespace
+
+TEST_F(FreeSpaceWipeServiceTest, Overwrite_FillsDownToReserveAndCleansUp) {
+    budget = 4 * MIB + 4 * MIB + MIB / 2;  // The last half MiB is below the filler minimum
+    auto service = make_service();
+    std::vector<WipeProgress> updates;
+
+    auto result = service.wipe(
+        dir.string(), small_options(), [&](const WipeProgress& p) { updates.push_back(p); },
+        cancel);
+
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_FALSE(result.backed_off);
+    EXPECT_EQ(result.bytes_filled, 4 * MIB);
+    EXPECT_TRUE(directory_is_empty());
+    ASSERT_FALSE(updates.empty());
+    EXPECT_TRUE(updates.back().is_complete);
+    EXPECT_FALSE(updates.back().has_error);
+    EXPECT_DOUBLE_EQ(updates.back().percentage, 100.0);
+}
+
+TEST_F(FreeSpaceWipeServiceTest, Overwrite_NothingToDoWhenWithinReserve) {
+    budget = 3 * MIB;
+    auto service = make_service();
+
+    auto result = service.wipe(dir.string(), small_options(), {}, cancel);
+
+    EXPECT_TRUE(result.success) << result.message;
+    EXPECT_EQ(result.bytes_filled, 0U);
+    EXPECT_TRUE(directory_is_empty());
+}
+
+TEST_F(FreeSpaceWipeServiceTest, Overwrite_BacksOffWhenOthersConsumeReserve) {
+    budget = 4 * MIB + 16 * MIB;
+    auto service = make_service();
+    auto options = small_options();
+    options.writers = 1;
+
+    // Another user writes 14 MiB part way through, leaving less than half the reserve
+    auto result = service.wipe(
+        dir.string(), options,
+        [&](const WipeProgress& p) {
+            if (p.bytes_written >= 6 * MIB) {
+                external_usage = 14 * MIB;
+            }
+        },
+        cancel);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.backed_off);
+    EXPECT_LT(result.bytes_filled, 16 * MIB);
+    EXPECT_TRUE(directory_is_empty());
+}
+
+TEST_F(FreeSpaceWipeServiceTest, Overwrite_CancelRemovesFillerFiles) {
+    budget = 4 * MIB + 16 * MIB;
+    auto service = make_service();
+
+    auto result = service.wipe(
+        dir.string(), small_options(), [&](const WipeProgress&) { cancel = true; }, cancel);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.message, "Operation was cancelled by user");
+    EXPECT_TRUE(directory_is_empty());
+}
+
+TEST_F(FreeSpaceWipeServiceTest, Overwrite_MultiPassAlgorithm) {
+    budget = 4 * MIB + 2 * MIB;
+    auto service = make_service();
+    auto options = small_options();
+    options.algorithm = WipeAlgorithm::DOD_5220_22_M;
+
+    auto result = service.wipe(dir.string(), options, {}, cancel);
+
+    ASSERT_TRUE(result.success) << result.message;
+    EXPECT_EQ(result.bytes_filled, 2 * MIB);
+}
+
+TEST_F(FreeSpaceWipeServiceTest, RejectsMissingDirectory) {
+    budget = 100 * MIB;
+    auto service = make_service();
+
+    auto result = service.wipe((dir / "missing").string(), small_options(), {}, cancel);
+
+    EXPECT_FALSE(result.success);
+}
+
+TEST_F(FreeSpaceWipeServiceTest, Trim_ReportsFilesystemError) {
+    auto service = make_service();
+    auto options = small_options();
+    options.method = FreeSpaceMethod::TRIM;
+
+    auto result = service.wipe(dir.string(), options, {}, cancel);
+
+    // tmpfs and unprivileged runs cannot FITRIM; a real failure must say why
+    if (!result.success) {
+        EXPECT_NE(result.message.find("FITRIM"), std::string::npos) << result.message;
+    }
+    EXPECT_TRUE(directory_is_empty());
+}
+
+TEST_F(FreeSpaceWipeServiceTest, CheckDirectory_RefusesPseudoFilesystems) {
+    if (!fs::is_directory("/proc/self")) {
+        GTEST_SKIP() << "procfs is not mounted";
+    }
+    EXPECT_FALSE(FreeSpaceWipeService::check_directory("/proc", std::nullopt).has_value());
+}
+
+TEST_F(FreeSpaceWipeServiceTest, CheckDirectory_RequiresOwnerOrWriteAccess) {
+    // Owned by whoever runs the tests; nobody else may write to it
+    fs::permissions(dir, fs::perms::owner_all | fs::perms::group_read | fs::perms::group_exec |
+                             fs::perms::others_read | fs::perms::others_exec);
+    const uid_t owner = geteuid();
+    const uid_t stranger = owner == 65534 ? 65533 : 65534;
+
+    EXPECT_TRUE(FreeSpaceWipeService::check_directory(dir.string(), owner).has_value());
+    EXPECT_TRUE(FreeSpaceWipeService::check_directory(dir.string(), std::nullopt).has_value());
+    EXPECT_FALSE(FreeSpaceWipeService::check_directory(dir.string(), stranger).has_value());
+
+    fs::permissions(dir, fs::perms::others_write, fs::perm_options::add);
+    EXPECT_TRUE(FreeSpaceWipeService::check_directory(dir.string(), stranger).has_value());
+}
+
+TEST_F(FreeSpaceWipeServiceTest, Overwrite_RefusesDirectoryOfAnotherUser) {
+    budget = 16 * MIB;
+    fs::permissions(dir, fs::perms::owner_all);
+    auto service = make_service();
+    auto options = small_options();
+    options.required_owner = geteuid() == 65534 ? 65533 : 65534;
+
+    auto result = service.wipe(dir.string(), options, {}, cancel);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(directory_is_empty());
+}
@@ -0,0 +1,92 @@
+/**
+ * @file IdlePolicyTest.cpp
+ * @brief Unit tests for the helper's idle trim and exit decisions
+ */
+
+#include "helper/services/IdlePolicy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string_view>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+const IdlePolicy::Clock::time_point T0{};
+
+constexpr IdleSettings SETTINGS{.trim_after = 30s, .exit_after = 300s};
+
+constexpr IdlePolicy::Activity IDLE{.busy = false, .clients = 0, .may_exit = true};
+
+}  // namespace
+
+TEST(IdlePolicyTest, Idle_TrimsOnceThenExits) {
+    IdlePolicy policy{SETTINGS, T0};
+
+    EXPECT_EQ(policy.poll(T0 + 29s, IDLE), IdleAction::NONE);
+    EXPECT_EQ(policy.poll(T0 + 30s, IDLE), IdleAction::TRIM);
+    EXPECT_EQ(policy.poll(T0 + 35s, IDLE), IdleAction::NONE);
+    EXPECT_EQ(policy.poll(T0 + 299s, IDLE), IdleAction::NONE);
+    EXPECT_EQ(policy.poll(T0 + 300s, IDLE), IdleAction::EXIT);
+}
+
+TEST(IdlePolicyTest, Busy_RestartsIdlePeriod) {
+    IdlePolicy policy{SETTINGS, T0};
+    auto busy = IDLE;
+    busy.busy = true;
+
+    EXPECT_EQ(policy.poll(T0 + 400s, busy), IdleAction::NONE);
+    EXPECT_EQ(policy.poll(T0 + 420s, IDLE), IdleAction::NONE);
+    EXPECT_EQ(policy.poll(T0 + 430s, IDLE), IdleAction::TRIM);
+    EXPECT_EQ(policy.idle_for(T0 + 430s), 30s);
+}
+
+TEST(IdlePolicyTest, ConnectedClient_TrimsButDoesNotExit) {
+    IdlePolicy policy{SETTINGS, T0};
+    auto connected = IDLE;
+    connected.clients = 1;
+
+    EXPECT_EQ(policy.poll(T0 + 30s, connected), IdleAction::TRIM);
+    EXPECT_EQ(policy.poll(T0 + 1h, connected), IdleAction::NONE);
+
+    // The exit period runs from the client leaving
+    policy.note_activity(T0 + 1h);
+    EXPECT_EQ(policy.poll(T0 + 1h + 299s, IDLE), IdleAction::TRIM);
+    EXPECT_EQ(policy.poll(T0 + 1h + 300s, IDLE), IdleAction::EXIT);
+}
+
+TEST(IdlePolicyTest, StationMode_NeverExits) {
+    IdlePolicy policy{SETTINGS, T0};
+    auto station = IDLE;
+    station.may_exit = false;
+
+    EXPECT_EQ(policy.poll(T0 + 1h, station), IdleAction::TRIM);
+    EXPECT_EQ(policy.poll(T0 + 2h, station), IdleAction::NONE);
+}
+
+TEST(IdlePolicyTest, ZeroThresholds_DisableActions) {
+    IdlePolicy policy{IdleSettings{.trim_after = 0s, .exit_after = 0s}, T0};
+
+    EXPECT_EQ(policy.poll(T0 + 24h, IDLE), IdleAction::NONE);
+}
+
+TEST(IdlePolicyTest, ParseArguments_ReadsDurations) {
+    constexpr std::array<std::string_view, 2> args{"--idle-timeout=10m", "--trim-after=45"};
+
+    auto settings = IdleSettings::parse_arguments(args);
+
+    ASSERT_TRUE(settings.has_value()) << settings.error().message;
+    EXPECT_EQ(settings->exit_after, 600s);
+    EXPECT_EQ(settings->trim_after, 45s);
+    EXPECT_EQ(IdleSettings::parse_arguments({})->exit_after, IdleSettings{}.exit_after);
+}
+
+TEST(IdlePolicyTest, ParseArguments_RejectsBadInput) {
+    constexpr std::array<std::string_view, 1> bad_value{"--idle-timeout=soon"};
+    constexpr std::array<std::string_view, 1> unknown{"--verbose"};
+
+    EXPECT_FALSE(IdleSettings::parse_arguments(bad_value).has_value());
+    EXPECT_FALSE(IdleSettings::parse_arguments(unknown).has_value());
+}
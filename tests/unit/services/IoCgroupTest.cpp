@@ -0,0 +1,136 @@
+/**
+ * @file IoCgroupTest.cpp
+ * @brief Unit tests for the wipe I/O cgroup against a fake cgroupfs tree
+ */
+
+#include "helper/services/IoCgroup.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr DeviceNumber DISK{.major = 8, .minor = 16};
+
+}  // namespace
+
+class IoCgroupTest : public ::testing::Test {
+protected:
+    TempTestDir temp_dir;
+    fs::path dir{temp_dir.path()};
+    fs::path service{dir / "system.slice" / "helper.service"};
+
+    void SetUp() override {
+        write_value(dir / "self", "0::/system.slice/helper.service");
+        write_value(service / "cgroup.controllers", "cpu io memory pids");
+        write_value(service / "cgroup.subtree_control", "");
+    }
+
+    // open() on the fake tree; the kernel would create the child's interface files
+    auto open_cgroup(IoCgroup& cgroup) -> bool {
+        const auto worker = service / IoCgroup::WORKER_GROUP;
+        fs::create_directory(worker);
+        write_value(worker / "cgroup.procs", "");
+        write_value(worker / "io.max", "");
+        auto opened = cgroup.open();
+        EXPECT_TRUE(opened.has_value()) << opened.error().message;
+        return opened.has_value();
+    }
+};
+
+TEST(IoCgroupFormatTest, ParseOwnCgroup_FindsUnifiedHierarchy) {
+    EXPECT_EQ(parse_own_cgroup("12:pids:/x\n0::/system.slice/a.service\n"),
+              "/system.slice/a.service");
+    EXPECT_FALSE(parse_own_cgroup("1:name=systemd:/init.scope\n").has_value());
+}
+
+TEST(IoCgroupFormatTest, FormatIoMax_UsesMaxForUnlimited) {
+    const IoLimits limits{.write_bps = 104'857'600, .read_iops = 500};
+    EXPECT_EQ(format_io_max(DISK, limits), "8:16 rbps=max wbps=104857600 riops=500 wiops=max");
+}
+
+TEST(IoCgroupFormatTest, ParseIoStat_PicksTheDeviceLine) {
+    constexpr auto text = "259:0 rbytes=1 wbytes=2 rios=3 wios=4 dbytes=5 dios=6\n"
+                          "8:16 rbytes=4096 wbytes=1048576 rios=1 wios=8 dbytes=0 dios=0\n";
+    const auto stat = parse_io_stat(text, DISK);
+    ASSERT_TRUE(stat.has_value());
+    EXPECT_EQ(stat->read_bytes, 4096U);
+    EXPECT_EQ(stat->write_bytes, 1'048'576U);
+    EXPECT_EQ(stat->write_ios, 8U);
+    EXPECT_FALSE(parse_io_stat(text, DeviceNumber{.major = 8, .minor = 0}).has_value());
+}
+
+TEST(IoCgroupFormatTest, IoStat_DifferenceIsTheJobsShare) {
+    const IoStat before{.write_bytes = 1'000, .write_ios = 2};
+    const IoStat after{.write_bytes = 5'000, .write_ios = 7, .discard_ios = 1};
+    EXPECT_EQ(after - before, (IoStat{.write_bytes = 4'000, .write_ios = 5, .discard_ios = 1}));
+}
+
+TEST_F(IoCgroupTest, Open_MovesHelperAndEnablesIo) {
+    IoCgroup cgroup{dir, dir / "self"};
+    ASSERT_TRUE(open_cgroup(cgroup));
+
+    EXPECT_EQ(cgroup.path(), service / IoCgroup::WORKER_GROUP);
+    EXPECT_EQ(read_value(cgroup.path() / "cgroup.procs"), std::to_string(::getpid()));
+    EXPECT_EQ(read_value(service / "cgroup.subtree_control"), "+io");
+}
+
+TEST_F(IoCgroupTest, Open_FailsWithoutDelegatedIo) {
+    write_value(service / "cgroup.controllers", "cpu memory");
+    IoCgroup cgroup{dir, dir / "self"};
+    EXPECT_FALSE(cgroup.open().has_value());
+    EXPECT_TRUE(cgroup.path().empty());
+    EXPECT_FALSE(cgroup.set_limits(DISK, IoLimits{.write_bps = 1}).has_value());
+    EXPECT_FALSE(cgroup.stat(DISK).has_value());
+}
+
+TEST_F(IoCgroupTest, SetLimits_WritesEveryController) {
+    IoCgroup cgroup{dir, dir / "self"};
+    ASSERT_TRUE(open_cgroup(cgroup));
+    write_value(service / "io.weight", "default 100");
+    write_value(service / "io.latency", "");
+
+    const IoLimits limits{.write_bps = 52'428'800, .weight = 50, .latency_target_us = 20'000};
+    ASSERT_TRUE(cgroup.set_limits(DISK, limits).has_value());
+    EXPECT_EQ(read_value(cgroup.path() / "io.max"),
+              "8:16 rbps=max wbps=52428800 riops=max wiops=max");
+    EXPECT_EQ(read_value(service / "io.weight"), "8:16 50");
+    EXPECT_EQ(read_value(service / "io.latency"), "8:16 target=20000");
+    EXPECT_EQ(cgroup.limits(DISK), limits);
+
+    // Clearing the limits later, e.g. during the wipe, puts the defaults back
+    ASSERT_TRUE(cgroup.set_limits(DISK, IoLimits{}).has_value());
+    EXPECT_EQ(read_value(service / "io.weight"), "8:16 default");
+    EXPECT_EQ(read_value(service / "io.latency"), "8:16 target=max");
+    EXPECT_EQ(cgroup.limits(DISK), IoLimits{});
+
+    EXPECT_FALSE(cgroup.set_limits(DISK, IoLimits{.weight = 20'000}).has_value());
+}
+
+TEST_F(IoCgroupTest, Stat_ReadsTheWorkerGroup) {
+    IoCgroup cgroup{dir, dir / "self"};
+    ASSERT_TRUE(open_cgroup(cgroup));
+
+    // No io.stat line yet: nothing written to the disk so far
+    write_value(cgroup.path() / "io.stat", "");
+    EXPECT_EQ(cgroup.stat(DISK), IoStat{});
+
+    write_value(cgroup.path() / "io.stat",
+                "8:16 rbytes=0 wbytes=8192 rios=0 wios=2 dbytes=0 dios=0");
+    EXPECT_EQ(cgroup.stat(DISK)->write_bytes, 8'192U);
+}
+
+TEST_F(IoCgroupTest, DiskNumber_RejectsRegularFile) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    EXPECT_FALSE(disk_number(file.path()).has_value());
+}
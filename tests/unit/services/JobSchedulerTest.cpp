@@ -0,0 +1,266 @@
+/**
+ * @file JobSchedulerTest.cpp
+ * @brief Unit tests for throughput estimates and deadline-aware job ordering
+ */
+
+#include "helper/services/JobScheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using TimePoint = JobScheduler::TimePoint;
+
+const TimePoint T0{};
+
+// One hour of writing at the HDD default rate
+constexpr uint64_t HDD_HOUR = 540'000'000'000;
+
+auto make_spec(const std::string& key, uint64_t size = HDD_HOUR,
+               WipeAlgorithm algorithm = WipeAlgorithm::ZERO_FILL) -> JobSpec {
+    return JobSpec{.device_path = "/dev/" + key,
+                   .device_key = key,
+                   .size_bytes = size,
+                   .algorithm = algorithm,
+                   .verify = false,
+                   .is_ssd = false,
+                   .priority = JobPriority::NORMAL,
+                   .deadline = std::nullopt};
+}
+
+auto with_deadline(JobSpec spec, std::chrono::milliseconds from_start) -> JobSpec {
+    spec.deadline = T0 + from_start;
+    return spec;
+}
+
+auto submit(JobScheduler& scheduler, JobSpec spec) -> uint64_t {
+    auto admission = scheduler.submit(std::move(spec), T0);
+    EXPECT_TRUE(admission.has_value()) << admission.error().message;
+    return admission ? admission->id : 0;
+}
+
+auto ids(const std::vector<PlannedJob>& plan) -> std::vector<uint64_t> {
+    std::vector<uint64_t> result;
+    std::ranges::transform(plan, std::back_inserter(result), &PlannedJob::id);
+    return result;
+}
+
+}  // namespace
+
+// ========== ThroughputEstimator ==========
+
+TEST(ThroughputEstimatorTest, Estimate_UsesPassCountAndMediaDefault) {
+    ThroughputEstimator estimator;
+    auto spec = make_spec("sda");
+
+    EXPECT_EQ(estimator.estimate(spec), 1h);
+
+    spec.algorithm = WipeAlgorithm::DOD_5220_22_M;
+    EXPECT_EQ(estimator.estimate(spec), 3h);
+
+    spec.verify = true;
+    EXPECT_EQ(estimator.estimate(spec), 4h);
+    EXPECT_EQ(ThroughputEstimator::bytes_to_process(spec), 4 * HDD_HOUR);
+
+    spec = make_spec("nvme0n1");
+    spec.is_ssd = true;
+    EXPECT_EQ(estimator.estimate(spec), 1'350s);
+}
+
+TEST(ThroughputEstimatorTest, Estimate_ThinDiscardIsOffloaded) {
+    ThroughputEstimator estimator;
+    auto spec = make_spec("vda", HDD_HOUR, WipeAlgorithm::THIN_DISCARD);
+
+    EXPECT_EQ(estimator.estimate(spec), 27s);
+}
+
+TEST(ThroughputEstimatorTest, Record_LearnsPerDevice) {
+    ThroughputEstimator estimator;
+    estimator.record("SER1", HDD_HOUR, 30min);
+
+    EXPECT_EQ(estimator.estimate(make_spec("SER1")), 30min);
+    EXPECT_EQ(estimator.estimate(make_spec("SER2")), 1h);
+
+    // Later runs are blended in rather than replacing the history
+    estimator.record("SER1", HDD_HOUR, 1h);
+    EXPECT_GT(estimator.estimate(make_spec("SER1")), 30min);
+    EXPECT_LT(estimator.estimate(make_spec("SER1")), 1h);
+}
+
+// ========== Admission ==========
+
+TEST(JobSchedulerTest, Submit_RejectsInfeasibleDeadline) {
+    JobScheduler scheduler{{.max_active = 0, .bandwidth_limit = 0, .reject_infeasible = true}};
+    auto spec = with_deadline(make_spec("sdb", 18'000'000'000'000, WipeAlgorithm::GUTMANN), 24h);
+
+    auto admission = scheduler.submit(spec, T0);
+
+    ASSERT_FALSE(admission.has_value());
+    EXPECT_NE(admission.error().message.find("Deadline cannot be met"), std::string::npos);
+    EXPECT_NE(admission.error().message.find("Gutmann"), std::string::npos);
+    EXPECT_EQ(scheduler.queued_count(), 0U);
+}
+
+TEST(JobSchedulerTest, Submit_WarnsOnInfeasibleDeadlineWhenNotRejecting) {
+    JobScheduler scheduler;
+    auto spec = with_deadline(make_spec("sdb", 18'000'000'000'000, WipeAlgorithm::GUTMANN), 24h);
+
+    auto admission = scheduler.submit(spec, T0);
+
+    ASSERT_TRUE(admission.has_value());
+    EXPECT_TRUE(admission->deadline_at_risk);
+    EXPECT_NE(admission->warning.find("Deadline cannot be met"), std::string::npos);
+    EXPECT_EQ(scheduler.queued_count(), 1U);
+}
+
+TEST(JobSchedulerTest, Submit_RejectsUnknownSize) {
+    JobScheduler scheduler;
+
+    EXPECT_FALSE(scheduler.submit(make_spec("sdb", 0), T0).has_value());
+}
+
+TEST(JobSchedulerTest, Submit_WarnsWhenQueueMakesDeadlineLate) {
+    JobScheduler scheduler{{.max_active = 1, .bandwidth_limit = 0, .reject_infeasible = true}};
+    submit(scheduler, make_spec("sda", 3 * HDD_HOUR));
+    ASSERT_EQ(scheduler.start_ready(T0).size(), 1U);
+
+    // Feasible alone, but the only bay is busy for three hours
+    auto admission = scheduler.submit(with_deadline(make_spec("sdb"), 2h), T0);
+
+    ASSERT_TRUE(admission.has_value());
+    EXPECT_TRUE(admission->deadline_at_risk);
+    EXPECT_NE(admission->warning.find("Deadline at risk"), std::string::npos);
+    EXPECT_EQ(admission->estimated_finish, T0 + 4h);
+}
+
+// ========== Planning ==========
+
+TEST(JobSchedulerTest, Plan_OrdersDeadlinesEarliestFirst) {
+    JobScheduler scheduler{{.max_active = 1, .bandwidth_limit = 0, .reject_infeasible = false}};
+    auto late = submit(scheduler, with_deadline(make_spec("sda"), 10h));
+    auto soon = submit(scheduler, with_deadline(make_spec("sdb"), 2h));
+
+    auto plan = scheduler.plan(T0);
+
+    EXPECT_EQ(ids(plan), (std::vector{soon, late}));
+    EXPECT_TRUE(std::ranges::all_of(plan, &PlannedJob::on_time));
+}
+
+TEST(JobSchedulerTest, Plan_PostponesJobThatWouldMakeOthersLate) {
+    JobScheduler scheduler{{.max_active = 1, .bandwidth_limit = 0, .reject_infeasible = false}};
+    auto a = submit(scheduler, with_deadline(make_spec("sda"), 2h));
+    auto b = submit(scheduler, with_deadline(make_spec("sdb", 5 * HDD_HOUR), 330min));
+    auto c = submit(scheduler, with_deadline(make_spec("sdc"), 6h));
+
+    auto plan = scheduler.plan(T0);
+
+    // EDF would run B second and make both B and C late
+    EXPECT_EQ(ids(plan), (std::vector{a, c, b}));
+    EXPECT_TRUE(plan[0].on_time);
+    EXPECT_TRUE(plan[1].on_time);
+    EXPECT_FALSE(plan[2].on_time);
+}
+
+TEST(JobSchedulerTest, Plan_KeepsHigherPriorityDeadline) {
+    JobScheduler scheduler{{.max_active = 1, .bandwidth_limit = 0, .reject_infeasible = false}};
+    auto normal = submit(scheduler, with_deadline(make_spec("sda"), 1h));
+    auto high_spec = with_deadline(make_spec("sdb"), 1h);
+    high_spec.priority = JobPriority::HIGH;
+    auto high = submit(scheduler, high_spec);
+
+    auto plan = scheduler.plan(T0);
+
+    EXPECT_EQ(ids(plan), (std::vector{high, normal}));
+    EXPECT_TRUE(plan[0].on_time);
+}
+
+TEST(JobSchedulerTest, Plan_FillsSlackByPriority) {
+    JobScheduler scheduler{{.max_active = 1, .bandwidth_limit = 0, .reject_infeasible = false}};
+    auto low_spec = make_spec("sda");
+    low_spec.priority = JobPriority::LOW;
+    auto low = submit(scheduler, low_spec);
+    auto urgent_spec = make_spec("sdb");
+    urgent_spec.priority = JobPriority::URGENT;
+    auto urgent = submit(scheduler, urgent_spec);
+    auto due = submit(scheduler, with_deadline(make_spec("sdc"), 2h));
+
+    auto plan = scheduler.plan(T0);
+
+    // The urgent job fits before the deadline job; the low one does not
+    EXPECT_EQ(ids(plan), (std::vector{urgent, due, low}));
+    EXPECT_TRUE(std::ranges::all_of(plan, &PlannedJob::on_time));
+}
+
+// ========== Dispatch ==========
+
+TEST(JobSchedulerTest, StartReady_RespectsBays) {
+    JobScheduler scheduler{{.max_active = 2, .bandwidth_limit = 0, .reject_infeasible = false}};
+    auto first = submit(scheduler, make_spec("sda"));
+    auto second = submit(scheduler, make_spec("sdb"));
+    auto third = submit(scheduler, make_spec("sdc"));
+
+    EXPECT_EQ(scheduler.start_ready(T0), (std::vector{first, second}));
+    EXPECT_TRUE(scheduler.start_ready(T0).empty());
+    EXPECT_EQ(scheduler.running_count(), 2U);
+
+    scheduler.complete(first, true, T0 + 1h);
+    EXPECT_EQ(scheduler.start_ready(T0 + 1h), (std::vector{third}));
+}
+
+TEST(JobSchedulerTest, StartReady_RespectsBandwidthLimit) {
+    JobScheduler scheduler{
+        {.max_active = 0, .bandwidth_limit = 200'000'000, .reject_infeasible = false}};
+    auto discard = submit(scheduler, make_spec("vda", HDD_HOUR, WipeAlgorithm::THIN_DISCARD));
+    auto first = submit(scheduler, make_spec("sda"));
+    auto second = submit(scheduler, make_spec("sdb"));
+
+    // The offloaded discard uses none of the cap; two HDDs at 150 MB/s exceed it
+    EXPECT_EQ(scheduler.start_ready(T0), (std::vector{discard, first}));
+    EXPECT_EQ(scheduler.queued_count(), 1U);
+
+    scheduler.complete(first, true, T0 + 1h);
+    EXPECT_EQ(scheduler.start_ready(T0 + 1h), (std::vector{second}));
+}
+
+TEST(JobSchedulerTest, UpdateProgress_RefinesQueuedStartTimes) {
+    JobScheduler scheduler{{.max_active = 1, .bandwidth_limit = 0, .reject_infeasible = false}};
+    auto running = submit(scheduler, make_spec("sda"));
+    auto waiting = submit(scheduler, make_spec("sdb"));
+    ASSERT_EQ(scheduler.start_ready(T0), (std::vector{running}));
+
+    // A quarter done after 30 minutes: the running job needs two hours in total
+    scheduler.update_progress(running, 0.25, T0 + 30min);
+    auto plan = scheduler.plan(T0 + 30min);
+
+    ASSERT_EQ(ids(plan), (std::vector{waiting}));
+    EXPECT_EQ(plan.front().start, T0 + 2h);
+}
+
+TEST(JobSchedulerTest, Complete_FeedsThroughputHistory) {
+    JobScheduler scheduler;
+    auto id = submit(scheduler, make_spec("SER1"));
+    ASSERT_EQ(scheduler.start_ready(T0).size(), 1U);
+
+    scheduler.complete(id, true, T0 + 2h);
+
+    EXPECT_DOUBLE_EQ(scheduler.estimator().rate(make_spec("SER1")), 75'000'000.0);
+    EXPECT_EQ(scheduler.running_count(), 0U);
+}
+
+TEST(JobSchedulerTest, Cancel_DropsWithoutHistory) {
+    JobScheduler scheduler;
+    auto id = submit(scheduler, make_spec("SER1"));
+    ASSERT_EQ(scheduler.start_ready(T0).size(), 1U);
+
+    EXPECT_TRUE(scheduler.cancel(id));
+    EXPECT_FALSE(scheduler.cancel(id));
+    EXPECT_EQ(scheduler.spec(id), nullptr);
+    EXPECT_DOUBLE_EQ(scheduler.estimator().rate(make_spec("SER1")),
+                     ThroughputEstimator::DEFAULT_HDD_RATE);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file PressureMonitorTest.cpp
+ * @brief Unit tests for PSI parsing, the pressure backoff and the write pacer
+ */
+
+#include "helper/services/PressureMonitor.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+#include "util/WritePacer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+namespace {
+
+void write_pressure(const fs::path& path, double some, double full = 0.0) {
+    std::ofstream{path} << std::format("some avg10={:.2f} avg60=0.00 avg300=0.00 total=1\n"
+                                       "full avg10={:.2f} avg60=0.00 avg300=0.00 total=1\n",
+                                       some, full);
+}
+
+}  // namespace
+
+TEST(PressureParseTest, ReadsSomeAndFullAvg10) {
+    const auto stall = parse_pressure("some avg10=12.50 avg60=3.00 avg300=1.00 total=123\n"
+                                      "full avg10=4.25 avg60=1.00 avg300=0.50 total=45\n");
+    ASSERT_TRUE(stall.has_value());
+    EXPECT_DOUBLE_EQ(stall->some, 12.5);
+    EXPECT_DOUBLE_EQ(stall->full, 4.25);
+
+    // Older kernels have no "full" line for cpu; io and memory always do
+    EXPECT_EQ(parse_pressure("some avg10=1.00 avg60=0.00 avg300=0.00 total=0\n"),
+              (PressureStall{.some = 1.0}));
+    EXPECT_FALSE(parse_pressure("").has_value());
+    EXPECT_FALSE(parse_pressure("some avg10=x").has_value());
+}
+
+TEST(PressureBackoffTest, HalvesUnderPressureAndRecoversStepwise) {
+    PressureBackoff backoff;
+    const PressureBackoff::Clock::time_point start{};
+
+    EXPECT_TRUE(backoff.update(25.0, start));
+    EXPECT_DOUBLE_EQ(backoff.multiplier(), 0.5);
+    // avg10 still high right after the cut: hold
+    EXPECT_FALSE(backoff.update(25.0, start + 1s));
+    EXPECT_TRUE(backoff.update(25.0, start + 2s));
+    EXPECT_DOUBLE_EQ(backoff.multiplier(), 0.25);
+
+    // Between the thresholds nothing moves
+    EXPECT_FALSE(backoff.update(5.0, start + 20s));
+
+    EXPECT_FALSE(backoff.update(0.0, start + 4s));
+    EXPECT_TRUE(backoff.update(0.0, start + 7s));
+    EXPECT_DOUBLE_EQ(backoff.multiplier(), 0.35);
+}
+
+TEST(PressureBackoffTest, StaysWithinBounds) {
+    PressureBackoff backoff;
+    auto now = PressureBackoff::Clock::time_point{};
+    for (int i = 0; i < 20; ++i, now += PressureBackoff::DECREASE_HOLD) {
+        backoff.update(100.0, now);
+    }
+    EXPECT_DOUBLE_EQ(backoff.multiplier(), PressureBackoff::MIN_MULTIPLIER);
+
+    for (int i = 0; i < 20; ++i, now += PressureBackoff::INCREASE_HOLD) {
+        backoff.update(0.0, now);
+    }
+    EXPECT_DOUBLE_EQ(backoff.multiplier(), 1.0);
+    EXPECT_FALSE(backoff.update(0.0, now));
+}
+
+class PressureMonitorTest : public ::testing::Test {
+protected:
+    TempTestDir temp_dir;
+    fs::path dir{temp_dir.path()};
+    fs::path proc{dir / "pressure"};
+    fs::path root{dir / "cgroup"};
+    fs::path slice{root / "system.slice"};
+    fs::path own{slice / "helper.service"};
+    fs::path neighbour{slice / "database.service"};
+    fs::path users{root / "user.slice"};
+
+    void SetUp() override {
+        fs::create_directories(proc);
+        for (const auto& cgroup : {slice, own, own / "wipe-io", neighbour, users}) {
+            fs::create_directories(cgroup);
+            write_pressure(cgroup / "io.pressure", 0.0);
+            write_pressure(cgroup / "memory.pressure", 0.0);
+        }
+        write_pressure(proc / "io", 0.0);
+        write_pressure(proc / "memory", 0.0);
+    }
+
+    auto make_monitor() const -> PressureMonitor { return PressureMonitor{own, root, proc}; }
+};
+
+TEST_F(PressureMonitorTest, Open_InstallsTriggers) {
+    auto monitor = make_monitor();
+    ASSERT_TRUE(monitor.open().has_value());
+    EXPECT_EQ(monitor.fds().size(), 2U);
+
+    std::ifstream file{proc / "io"};
+    std::string trigger;
+    std::getline(file, trigger, '\0');
+    EXPECT_EQ(trigger, PressureMonitor::TRIGGER);
+}
+
+TEST_F(PressureMonitorTest, Open_FailsWithoutPsi) {
+    fs::remove(proc / "memory");
+    auto monitor = make_monitor();
+    EXPECT_FALSE(monitor.open().has_value());
+}
+
+TEST_F(PressureMonitorTest, Open_FailsWithoutOwnCgroup) {
+    PressureMonitor outside{dir / "elsewhere", root, proc};
+    EXPECT_FALSE(outside.open().has_value());
+    PressureMonitor at_root{root, root, proc};
+    EXPECT_FALSE(at_root.open().has_value());
+}
+
+TEST_F(PressureMonitorTest, Sample_IgnoresTheHelpersOwnStalls) {
+    auto monitor = make_monitor();
+
+    // The wipe stalls 40% of the time, inside the helper's cgroup and on the host
+    write_pressure(proc / "io", 40.0);
+    write_pressure(own / "io.pressure", 40.0);
+    write_pressure(own / "wipe-io" / "io.pressure", 40.0);
+    EXPECT_DOUBLE_EQ(monitor.sample(PressureBackoff::Clock::time_point{}), 1.0);
+    EXPECT_DOUBLE_EQ(monitor.stall_percent(), 0.0);
+}
+
+TEST_F(PressureMonitorTest, Sample_BacksOffWhenANeighbourStallsBehindTheWipe) {
+    auto monitor = make_monitor();
+
+    // Host "some" barely moves: the neighbour stalls mostly while the wipe does too
+    write_pressure(proc / "io", 42.0);
+    write_pressure(own / "io.pressure", 40.0);
+    write_pressure(neighbour / "io.pressure", 30.0);
+    EXPECT_DOUBLE_EQ(monitor.sample(PressureBackoff::Clock::time_point{}), 0.5);
+    EXPECT_DOUBLE_EQ(monitor.stall_percent(), 30.0);
+}
+
+TEST_F(PressureMonitorTest, Sample_CountsOtherSlices) {
+    auto monitor = make_monitor();
+    write_pressure(users / "memory.pressure", 15.0);
+    EXPECT_DOUBLE_EQ(monitor.sample(PressureBackoff::Clock::time_point{}), 0.5);
+    EXPECT_DOUBLE_EQ(monitor.stall_percent(), 15.0);
+}
+
+TEST(WritePacerTest, ClampsTheMultiplier) {
+    util::WritePacer::set_multiplier(0.0);
+    EXPECT_DOUBLE_EQ(util::WritePacer::multiplier(), util::WritePacer::MIN_MULTIPLIER);
+    util::WritePacer::set_multiplier(3.0);
+    EXPECT_DOUBLE_EQ(util::WritePacer::multiplier(), 1.0);
+}
+
+TEST(WritePacerTest, PausesInProportionToTheWrite) {
+    util::WritePacer::set_multiplier(0.5);
+    const auto start = std::chrono::steady_clock::now();
+    util::WritePacer::pace(20ms);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    util::WritePacer::set_multiplier(1.0);
+}
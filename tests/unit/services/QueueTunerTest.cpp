@@ -0,0 +1,140 @@
+/**
+ * @file QueueTunerTest.cpp
+ * @brief Unit tests for block queue retuning and its restore paths
+ */
+
+#include "helper/services/QueueTuner.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+class QueueTunerTest : public ::testing::Test {
+protected:
+    TempTestDir temp_dir;
+    fs::path dir{temp_dir.path()};
+    fs::path state_path{dir / "state" / "queue-tuning.state"};
+
+    // A queue/ directory as a default-configured kernel shows it
+    auto make_queue(const std::string& disk) -> fs::path {
+        auto queue = dir / disk / "queue";
+        fs::create_directories(queue);
+        write_value(queue / "scheduler", "[mq-deadline] kyber bfq none");
+        write_value(queue / "max_sectors_kb", "1280");
+        write_value(queue / "max_hw_sectors_kb", "2048");
+        write_value(queue / "nr_requests", "64");
+        write_value(queue / "wbt_lat_usec", "2000");
+        fs::permissions(queue / "max_hw_sectors_kb", fs::perms::owner_read);
+        return queue;
+    }
+};
+
+TEST_F(QueueTunerTest, Plan_NvmeDropsSchedulerAndThrottling) {
+    const auto queue = make_queue("nvme0n1");
+    const auto plan = plan_queue_tuning(queue);
+
+    ASSERT_EQ(plan.size(), 4U);
+    EXPECT_EQ(plan[0].attribute, "scheduler");
+    EXPECT_EQ(plan[0].value, "none");
+    EXPECT_EQ(plan[1].attribute, "max_sectors_kb");
+    EXPECT_EQ(plan[1].value, "2048");
+    EXPECT_EQ(plan[2].attribute, "nr_requests");
+    EXPECT_EQ(plan[2].value, std::to_string(QueueTuner::TARGET_NR_REQUESTS));
+    EXPECT_EQ(plan[3].attribute, "wbt_lat_usec");
+    EXPECT_EQ(plan[3].value, "0");
+}
+
+TEST_F(QueueTunerTest, Plan_KeepsSchedulerOfOtherDisks) {
+    const auto plan = plan_queue_tuning(make_queue("sdb"));
+    ASSERT_EQ(plan.size(), 3U);
+    EXPECT_EQ(plan[0].attribute, "max_sectors_kb");
+}
+
+TEST_F(QueueTunerTest, Plan_SkipsTunedAndMissingAttributes) {
+    const auto queue = make_queue("nvme1n1");
+    write_value(queue / "scheduler", "[none] mq-deadline");
+    write_value(queue / "max_sectors_kb", "2048");
+    write_value(queue / "nr_requests", "2048");
+    fs::remove(queue / "wbt_lat_usec");
+
+    EXPECT_TRUE(plan_queue_tuning(queue).empty());
+}
+
+TEST_F(QueueTunerTest, Lease_RestoresOriginalsWhenReleased) {
+    const auto queue = make_queue("nvme0n1");
+    QueueTuner tuner{state_path};
+    {
+        auto lease = tuner.tune_queue(queue);
+        ASSERT_TRUE(lease.has_value()) << lease.error().message;
+        EXPECT_EQ(lease->applied().size(), 4U);
+
+        EXPECT_EQ(read_value(queue / "scheduler"), "none");
+        EXPECT_EQ(read_value(queue / "max_sectors_kb"), "2048");
+        EXPECT_EQ(read_value(queue / "wbt_lat_usec"), "0");
+        // The originals are on disk while the wipe runs
+        EXPECT_TRUE(fs::exists(state_path));
+    }
+
+    EXPECT_EQ(read_value(queue / "scheduler"), "mq-deadline");
+    EXPECT_EQ(read_value(queue / "max_sectors_kb"), "1280");
+    EXPECT_EQ(read_value(queue / "nr_requests"), "64");
+    EXPECT_EQ(read_value(queue / "wbt_lat_usec"), "2000");
+    EXPECT_FALSE(fs::exists(state_path));
+}
+
+TEST_F(QueueTunerTest, Lease_SharedByWipesOfOneDisk) {
+    const auto queue = make_queue("sdc");
+    QueueTuner tuner{state_path};
+
+    auto first = tuner.tune_queue(queue);
+    auto second = tuner.tune_queue(queue);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_FALSE(first->applied().empty());
+    EXPECT_TRUE(second->applied().empty());
+
+    std::optional<QueueTuner::Lease> running{std::move(*second)};
+    {
+        const auto finished = std::move(*first);
+    }
+    EXPECT_EQ(read_value(queue / "nr_requests"), "1024");  // The second wipe still runs
+
+    running.reset();
+    EXPECT_EQ(read_value(queue / "nr_requests"), "64");
+}
+
+TEST_F(QueueTunerTest, RestorePending_UndoesAnInterruptedWipe) {
+    const auto queue = make_queue("nvme2n1");
+    write_value(queue / "scheduler", "[none] mq-deadline");
+    write_value(queue / "nr_requests", "1024");
+    fs::create_directories(state_path.parent_path());
+    std::ofstream{state_path} << "storage-wiper-queue-tuning 1\n"
+                              << queue.string() << "\tscheduler\tmq-deadline\n"
+                              << queue.string() << "\tnr_requests\t64\n";
+
+    QueueTuner tuner{state_path};
+    EXPECT_EQ(tuner.restore_pending(), 1U);
+
+    EXPECT_EQ(read_value(queue / "scheduler"), "mq-deadline");
+    EXPECT_EQ(read_value(queue / "nr_requests"), "64");
+    EXPECT_FALSE(fs::exists(state_path));
+    EXPECT_EQ(tuner.restore_pending(), 0U);
+}
+
+TEST_F(QueueTunerTest, Tune_RejectsRegularFile) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    EXPECT_FALSE(queue_dir_for_device(file.path()).has_value());
+
+    QueueTuner tuner{state_path};
+    EXPECT_FALSE(tuner.tune(file.path()).has_value());
+}
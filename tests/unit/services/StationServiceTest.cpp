@@ -0,0 +1,396 @@
+/**
+ * @file StationServiceTest.cpp
+ * @brief Unit tests for hotplug station mode: uevent parsing, rules and job lifecycle
+ */
+
+#include "helper/services/StationService.hpp"
+
+#include "fixtures/ManualScheduler.hpp"
+#include "mocks/MockDiskService.hpp"
+#include "mocks/MockWipeService.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+using ::testing::_;
+using ::testing::Return;
+
+namespace {
+
+constexpr auto BAY_DEVPATH =
+    "/devices/pci0000:00/0000:00:17.0/ata3/host2/target2:0:0/2:0:0:0/block/sdb";
+constexpr auto BAY_PORT = "/devices/pci0000:00/0000:00:17.0/ata3/host2/target2:0:0/2:0:0:0";
+constexpr uint64_t GIB = 1ULL << 30;
+
+auto make_datagram(const std::string& action, const std::string& devpath,
+                   const std::string& devtype, const std::string& devname) -> std::string {
+    std::string datagram = action + "@" + devpath;
+    for (const auto& field :
+         {"ACTION=" + action, "DEVPATH=" + devpath, std::string{"SUBSYSTEM=block"},
+          "DEVNAME=" + devname, "DEVTYPE=" + devtype, std::string{"SEQNUM=4242"}}) {
+        datagram.push_back('\0');
+        datagram += field;
+    }
+    return datagram;
+}
+
+auto make_event(const std::string& action) -> UeventMessage {
+    return UeventMessage{.action = action,
+                         .subsystem = "block",
+                         .devtype = "disk",
+                         .devname = "sdb",
+                         .devpath = BAY_DEVPATH};
+}
+
+auto make_disk(uint64_t size = 500 * GIB) -> DiskInfo {
+    DiskInfo disk;
+    disk.path = "/dev/sdb";
+    disk.model = "ACME HDD 500";
+    disk.size_bytes = size;
+    return disk;
+}
+
+auto parse_config(const std::string& text) -> std::expected<StationConfig, util::Error> {
+    std::istringstream input{text};
+    return StationConfig::parse(input);
+}
+
+const std::string BASIC_CONFIG = R"(
+# Front bays on the onboard SATA controller
+[station]
+enabled = true
+settle_delay_ms = 500
+
+[rule front]
+port = /devices/pci0000:00/0000:00:17.0/ata*
+model = ACME*
+min_size = 100G
+max_size = 2T
+algorithm = dod
+verify = yes
+)";
+
+}  // namespace
+
+// ========== Uevent parsing ==========
+
+TEST(UeventTest, Parse_ExtractsBlockFields) {
+    auto message = parse_uevent(make_datagram("add", BAY_DEVPATH, "disk", "sdb"));
+
+    ASSERT_TRUE(message.has_value());
+    EXPECT_EQ(message->action, "add");
+    EXPECT_EQ(message->subsystem, "block");
+    EXPECT_EQ(message->devtype, "disk");
+    EXPECT_EQ(message->device_path(), "/dev/sdb");
+    EXPECT_EQ(message->port_path(), BAY_PORT);
+    EXPECT_TRUE(HotplugMonitor::is_disk_hotplug(*message));
+}
+
+TEST(UeventTest, Parse_RejectsUdevRebroadcastAndGarbage) {
+    std::string udev = "libudev";
+    udev.push_back('\0');
+    udev += "ACTION=add";
+
+    EXPECT_FALSE(parse_uevent(udev).has_value());
+    EXPECT_FALSE(parse_uevent("").has_value());
+}
+
+TEST(UeventTest, PartitionsAreNotDiskHotplug) {
+    auto message = parse_uevent(make_datagram("add", std::string{BAY_DEVPATH} + "/sdb1",
+                                              "partition", "sdb1"));
+
+    ASSERT_TRUE(message.has_value());
+    EXPECT_FALSE(HotplugMonitor::is_disk_hotplug(*message));
+}
+
+// ========== StationConfig ==========
+
+TEST(StationConfigTest, Parse_ReadsStationAndRules) {
+    auto config = parse_config(BASIC_CONFIG);
+
+    ASSERT_TRUE(config.has_value()) << config.error().message;
+    EXPECT_TRUE(config->enabled);
+    EXPECT_EQ(config->settle_delay, 500ms);
+    ASSERT_EQ(config->rules.size(), 1U);
+    const auto& rule = config->rules.front();
+    EXPECT_EQ(rule.name, "front");
+    EXPECT_EQ(rule.min_size_bytes, 100 * GIB);
+    EXPECT_EQ(rule.max_size_bytes, 2'048 * GIB);
+    EXPECT_EQ(rule.algorithm, WipeAlgorithm::DOD_5220_22_M);
+    EXPECT_TRUE(rule.verify);
+}
+
+TEST(StationConfigTest, Parse_ReadsSchedulingKeys) {
+    auto config = parse_config(BASIC_CONFIG +
+                               "priority = urgent\ndeadline = 90m\n"
+                               "[station]\nmax_active_jobs = 4\nbandwidth_limit = 1G\n"
+                               "reject_infeasible = yes\n");
+
+    ASSERT_TRUE(config.has_value()) << config.error().message;
+    EXPECT_EQ(config->limits.max_active, 4U);
+    EXPECT_EQ(config->limits.bandwidth_limit, GIB);
+    EXPECT_TRUE(config->limits.reject_infeasible);
+    EXPECT_EQ(config->rules.front().priority, JobPriority::URGENT);
+    EXPECT_EQ(config->rules.front().deadline, 5'400s);
+
+    EXPECT_FALSE(parse_config(BASIC_CONFIG + "deadline = soon\n").has_value());
+    EXPECT_FALSE(parse_config(BASIC_CONFIG + "priority = critical\n").has_value());
+}
+
+TEST(StationConfigTest, Parse_ReportsOffendingLine) {
+    auto config = parse_config("[station]\nenabled = true\n[rule a]\nalgorithm = shred\n");
+
+    ASSERT_FALSE(config.has_value());
+    EXPECT_NE(config.error().message.find("line 4"), std::string::npos);
+}
+
+TEST(StationConfigTest, Parse_EnabledWithoutRulesIsAnError) {
+    EXPECT_FALSE(parse_config("[station]\nenabled = true\n").has_value());
+}
+
+TEST(StationConfigTest, Load_MissingFileDisablesStation) {
+    auto config = StationConfig::load("/nonexistent/station.conf");
+
+    ASSERT_TRUE(config.has_value());
+    EXPECT_FALSE(config->enabled);
+}
+
+TEST(StationConfigTest, Match_AppliesPortModelAndSizeRules) {
+    auto config = parse_config(BASIC_CONFIG);
+    ASSERT_TRUE(config.has_value());
+
+    EXPECT_TRUE(config->match(make_disk(), BAY_PORT).has_value());
+    EXPECT_FALSE(config->match(make_disk(), "/devices/pci0000:00/0000:00:14.0/usb2").has_value());
+    EXPECT_FALSE(config->match(make_disk(50 * GIB), BAY_PORT).has_value());
+    EXPECT_FALSE(config->match(make_disk(4'096 * GIB), BAY_PORT).has_value());
+
+    auto other_model = make_disk();
+    other_model.model = "Other SSD";
+    EXPECT_FALSE(config->match(other_model, BAY_PORT).has_value());
+}
+
+TEST(StationConfigTest, Match_NeverSelectsDisksInUse) {
+    auto config = parse_config(BASIC_CONFIG);
+    ASSERT_TRUE(config.has_value());
+
+    auto mounted = make_disk();
+    mounted.is_mounted = true;
+    mounted.mount_point = "/";
+    auto lvm = make_disk();
+    lvm.is_lvm_pv = true;
+
+    EXPECT_FALSE(config->match(mounted, BAY_PORT).has_value());
+    EXPECT_FALSE(config->match(lvm, BAY_PORT).has_value());
+}
+
+// ========== StationService ==========
+
+class StationServiceTest : public ::testing::Test {
+protected:
+    ManualScheduler scheduler;
+    std::shared_ptr<MockDiskService> disk_service = MockDiskService::CreateNiceMock();
+    std::shared_ptr<MockWipeService> wipe_service = MockWipeService::CreateNiceMock();
+    std::vector<StationEvent> events;
+    ProgressCallback captured_callback;
+    std::unique_ptr<StationService> station;
+
+    void SetUp() override {
+        auto config = parse_config(BASIC_CONFIG);
+        ASSERT_TRUE(config.has_value());
+
+        ON_CALL(*disk_service, get_available_disks_blocking())
+            .WillByDefault(Return(std::vector<DiskInfo>{make_disk()}));
+        ON_CALL(*wipe_service, wipe_disk(_, _, _))
+            .WillByDefault([this](const std::string&, WipeAlgorithm, ProgressCallback callback) {
+                captured_callback = std::move(callback);
+                return true;
+            });
+
+        station = std::make_unique<StationService>(
+            *config, disk_service, [this] { return wipe_service; }, scheduler,
+            [this](const StationEvent& event) { events.push_back(event); });
+    }
+
+    auto has_event(StationEvent::Kind kind) const -> bool {
+        return std::any_of(events.begin(), events.end(),
+                           [kind](const StationEvent& e) { return e.kind == kind; });
+    }
+};
+
+TEST_F(StationServiceTest, MatchingInsertStartsWipeAfterSettleDelay) {
+    EXPECT_CALL(*wipe_service, wipe_disk("/dev/sdb", WipeAlgorithm::DOD_5220_22_M, _)).Times(1);
+
+    station->on_uevent(make_event("add"));
+    EXPECT_TRUE(station->is_busy("/dev/sdb"));
+    EXPECT_TRUE(events.empty());  // Nothing happens before the settle delay
+
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::STARTED); }));
+    EXPECT_GE(scheduler.now(), 500ms);
+    EXPECT_EQ(station->active_jobs(), 1U);
+    EXPECT_EQ(events.back().rule, "front");
+    EXPECT_EQ(events.back().port_path, BAY_PORT);
+}
+
+TEST_F(StationServiceTest, CompletionEmitsFinishedAndFreesBay) {
+    station->on_uevent(make_event("add"));
+    ASSERT_TRUE(scheduler.run_until([&] { return static_cast<bool>(captured_callback); }));
+
+    MockWipeService::SimulateSuccessfulWipe(captured_callback, 1, 0ms);
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::FINISHED); }));
+
+    EXPECT_TRUE(events.back().success);
+    EXPECT_EQ(station->active_jobs(), 0U);
+    EXPECT_FALSE(station->is_busy("/dev/sdb"));
+}
+
+TEST_F(StationServiceTest, NonMatchingDiskIsIgnored) {
+    auto small = make_disk(10 * GIB);
+    ON_CALL(*disk_service, get_available_disks_blocking())
+        .WillByDefault(Return(std::vector<DiskInfo>{small}));
+    EXPECT_CALL(*wipe_service, wipe_disk(_, _, _)).Times(0);
+
+    station->on_uevent(make_event("add"));
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::IGNORED); }));
+    EXPECT_EQ(station->active_jobs(), 0U);
+}
+
+TEST_F(StationServiceTest, RemovalBeforeSettleAbandonsInsert) {
+    EXPECT_CALL(*wipe_service, wipe_disk(_, _, _)).Times(0);
+
+    station->on_uevent(make_event("add"));
+    station->on_uevent(make_event("remove"));
+
+    // Let the settle timer fire; the abandoned attempt must do nothing
+    scheduler.run_until([] { return false; }, 200ms);
+    EXPECT_TRUE(events.empty());
+    EXPECT_FALSE(station->is_busy("/dev/sdb"));
+}
+
+TEST_F(StationServiceTest, AliasOfQueuedDiskIsBusy) {
+    // Stands in for same_disk(): the by-id link and the partition lead to /dev/sdb
+    auto same_disk = [](const std::string& a, const std::string& b) {
+        auto disk = [](const std::string& path) -> std::string {
+            if (path == "/dev/disk/by-id/ata-ACME_HDD_500" || path == "/dev/sdb1") {
+                return "/dev/sdb";
+            }
+            return path;
+        };
+        return disk(a) == disk(b);
+    };
+    auto config = parse_config(BASIC_CONFIG);
+    ASSERT_TRUE(config.has_value());
+    station = std::make_unique<StationService>(
+        *config, disk_service, [this] { return wipe_service; }, scheduler,
+        [this](const StationEvent& event) { events.push_back(event); },
+        std::chrono::steady_clock::now, same_disk);
+
+    station->on_uevent(make_event("add"));
+    EXPECT_TRUE(station->is_busy("/dev/disk/by-id/ata-ACME_HDD_500"));
+    EXPECT_TRUE(station->is_busy("/dev/sdb1"));
+    EXPECT_FALSE(station->is_busy("/dev/sdc"));
+
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::STARTED); }));
+    EXPECT_TRUE(station->is_busy("/dev/disk/by-id/ata-ACME_HDD_500"));
+}
+
+TEST_F(StationServiceTest, DiskInUseElsewhereIsIgnored) {
+    auto config = parse_config(BASIC_CONFIG);
+    ASSERT_TRUE(config.has_value());
+    station = std::make_unique<StationService>(
+        *config, disk_service, [this] { return wipe_service; }, scheduler,
+        [this](const StationEvent& event) { events.push_back(event); },
+        std::chrono::steady_clock::now, std::equal_to<>{},
+        [](const std::string& device) -> std::optional<std::string> {
+            if (device == "/dev/sdb") {
+                return "device is being surface scanned";
+            }
+            return std::nullopt;
+        });
+    EXPECT_CALL(*wipe_service, wipe_disk(_, _, _)).Times(0);
+
+    station->on_uevent(make_event("add"));
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::IGNORED); }));
+    EXPECT_EQ(events.back().message, "device is being surface scanned");
+    EXPECT_EQ(station->active_jobs(), 0U);
+    EXPECT_EQ(station->queued_jobs(), 0U);
+    EXPECT_FALSE(station->is_busy("/dev/sdb"));
+}
+
+TEST_F(StationServiceTest, RemovalDuringWipeCancelsJob) {
+    station->on_uevent(make_event("add"));
+    ASSERT_TRUE(scheduler.run_until([&] { return static_cast<bool>(captured_callback); }));
+
+    EXPECT_CALL(*wipe_service, cancel_current_operation()).Times(1);
+    station->on_uevent(make_event("remove"));
+    ::testing::Mock::VerifyAndClearExpectations(wipe_service.get());
+}
+
+TEST_F(StationServiceTest, WaitsForDeviceNodeToAppear) {
+    int calls = 0;
+    ON_CALL(*disk_service, validate_device_path(_))
+        .WillByDefault([&calls](const std::string&) -> std::expected<void, util::Error> {
+            if (++calls < 3) {
+                return std::unexpected(util::Error{"No such device"});
+            }
+            return {};
+        });
+
+    station->on_uevent(make_event("add"));
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::STARTED); }));
+    EXPECT_EQ(calls, 3);
+    EXPECT_GE(scheduler.now(), 1'500ms);
+}
+
+TEST_F(StationServiceTest, InfeasibleDeadlineIsRefused) {
+    auto config =
+        parse_config(BASIC_CONFIG + "deadline = 1h\n[station]\nreject_infeasible = true\n");
+    ASSERT_TRUE(config.has_value());
+    station = std::make_unique<StationService>(
+        *config, disk_service, [this] { return wipe_service; }, scheduler,
+        [this](const StationEvent& event) { events.push_back(event); });
+    EXPECT_CALL(*wipe_service, wipe_disk(_, _, _)).Times(0);
+
+    // DoD plus verification on 500 GiB at the HDD default takes about 4 hours
+    station->on_uevent(make_event("add"));
+    ASSERT_TRUE(scheduler.run_until([&] { return has_event(StationEvent::Kind::IGNORED); }));
+    EXPECT_NE(events.back().message.find("Deadline cannot be met"), std::string::npos);
+    EXPECT_FALSE(station->is_busy("/dev/sdb"));
+}
+
+TEST_F(StationServiceTest, SecondDiskWaitsForFreeBay) {
+    auto config = parse_config(BASIC_CONFIG + "[station]\nmax_active_jobs = 1\n");
+    ASSERT_TRUE(config.has_value());
+    station = std::make_unique<StationService>(
+        *config, disk_service, [this] { return wipe_service; }, scheduler,
+        [this](const StationEvent& event) { events.push_back(event); });
+
+    auto second = make_disk();
+    second.path = "/dev/sdc";
+    ON_CALL(*disk_service, get_available_disks_blocking())
+        .WillByDefault(Return(std::vector<DiskInfo>{make_disk(), second}));
+    auto second_event = make_event("add");
+    second_event.devname = "sdc";
+    second_event.devpath = std::string{BAY_PORT} + "/block/sdc";
+
+    station->on_uevent(make_event("add"));
+    station->on_uevent(second_event);
+    auto queued = [&] {
+        return std::ranges::count(events, StationEvent::Kind::QUEUED, &StationEvent::kind) == 2;
+    };
+    ASSERT_TRUE(scheduler.run_until(queued));
+    EXPECT_EQ(station->active_jobs(), 1U);
+    EXPECT_EQ(station->queued_jobs(), 1U);
+
+    EXPECT_CALL(*wipe_service, wipe_disk("/dev/sdc", _, _)).Times(1);
+    MockWipeService::SimulateSuccessfulWipe(captured_callback, 1, 0ms);
+    ASSERT_TRUE(scheduler.run_until([&] { return station->queued_jobs() == 0; }));
+    EXPECT_EQ(station->active_jobs(), 1U);
+}
@@ -0,0 +1,262 @@
+/**
+ * @file SurfaceScanServiceTest.cpp
+ * @brief Unit tests for the read-only surface scan and its grading
+ */
+
+#include "helper/services/SurfaceScanService.hpp"
+
+#include "fixtures/TestFixtures.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr uint64_t MIB = 1ULL << 20;
+constexpr uint64_t SCAN_SIZE = 8 * MIB;
+constexpr uint32_t SECTOR = 512;
+
+// Striped reads should keep up with a plain sequential pread loop over the page cache
+constexpr double MIN_SCAN_VS_PREAD = 0.25;
+
+/**
+ * @brief Reader over a virtual device whose bytes are all zero
+ */
+auto zero_reader(uint64_t size) -> SurfaceReader {
+    return [size](void* buffer, std::size_t length, uint64_t offset) -> ssize_t {
+        if (offset >= size) {
+            return 0;
+        }
+        const auto count = static_cast<std::size_t>(std::min<uint64_t>(length, size - offset));
+        std::memset(buffer, 0, count);
+        return static_cast<ssize_t>(count);
+    };
+}
+
+/**
+ * @brief Reader that fails every read touching [bad_begin, bad_end)
+ */
+auto failing_reader(uint64_t size, uint64_t bad_begin, uint64_t bad_end) -> SurfaceReader {
+    return [inner = zero_reader(size), bad_begin, bad_end](void* buffer, std::size_t length,
+                                                           uint64_t offset) -> ssize_t {
+        if (offset < bad_end && offset + length > bad_begin) {
+            errno = EIO;
+            return -1;
+        }
+        return inner(buffer, length, offset);
+    };
+}
+
+auto scan(const SurfaceReader& reader, uint64_t size, SurfaceScanOptions options = {})
+    -> SurfaceScanReport {
+    const std::atomic<bool> cancel{false};
+    return scan_surface(reader, size, SECTOR, options, nullptr, cancel);
+}
+
+auto report_with(std::array<uint64_t, LATENCY_BUCKETS> histogram, uint64_t failed = 0)
+    -> SurfaceScanReport {
+    SurfaceScanReport report{};
+    report.complete = true;
+    report.histogram = histogram;
+    report.failed_sector_count = failed;
+    grade_surface(report);
+    return report;
+}
+
+}  // namespace
+
+TEST(SurfaceScanTest, LatencyBucket_Boundaries) {
+    using std::chrono::milliseconds;
+    EXPECT_EQ(latency_bucket(milliseconds{0}), LatencyBucket::UNDER_10MS);
+    EXPECT_EQ(latency_bucket(milliseconds{10}), LatencyBucket::UNDER_50MS);
+    EXPECT_EQ(latency_bucket(milliseconds{149}), LatencyBucket::UNDER_150MS);
+    EXPECT_EQ(latency_bucket(SLOW_READ), LatencyBucket::UNDER_500MS);
+    EXPECT_EQ(latency_bucket(VERY_SLOW_READ), LatencyBucket::OVER_500MS);
+}
+
+TEST(SurfaceScanTest, Grade_FollowsThresholds) {
+    EXPECT_EQ(report_with({10'000, 0, 0, 0, 0}).grade, 'A');
+    EXPECT_EQ(report_with({9'000, 0, 1'000, 0, 0}).grade, 'B');  // 10% over 50 ms
+    EXPECT_EQ(report_with({9'999, 0, 0, 1, 0}).grade, 'B');      // One slow read
+    EXPECT_EQ(report_with({9'900, 0, 0, 100, 0}).grade, 'C');    // 1% slow
+    EXPECT_EQ(report_with({9'999, 0, 0, 0, 1}).grade, 'C');      // One very slow read
+    EXPECT_EQ(report_with({9'900, 0, 0, 0, 100}).grade, 'D');    // 1% very slow
+    EXPECT_EQ(report_with({10'000, 0, 0, 0, 0}, 1).grade, 'D');
+    EXPECT_EQ(report_with({10'000, 0, 0, 0, 0}, 17).grade, 'F');
+
+    const auto graded = report_with({10'000, 0, 0, 0, 0});
+    EXPECT_TRUE(graded.summary.starts_with("Grade A")) << graded.summary;
+}
+
+TEST(SurfaceScanTest, Scan_HealthyDeviceGradesA) {
+    const auto report = scan(zero_reader(SCAN_SIZE), SCAN_SIZE);
+
+    EXPECT_TRUE(report.complete);
+    EXPECT_EQ(report.bytes_read, SCAN_SIZE);
+    EXPECT_EQ(report.grade, 'A') << report.summary;
+    EXPECT_EQ(report.regions.size(), SurfaceScanOptions::DEFAULT_REGIONS);
+
+    uint64_t reads = 0;
+    for (const auto count : report.histogram) {
+        reads += count;
+    }
+    EXPECT_EQ(reads, SCAN_SIZE / SurfaceScanOptions::DEFAULT_READ_SIZE);
+}
+
+TEST(SurfaceScanTest, Scan_ListsExactlyTheUnreadableSectors) {
+    constexpr uint64_t BAD_BEGIN = (3 * MIB) + (7 * SECTOR);
+    constexpr uint64_t BAD_END = BAD_BEGIN + (4 * SECTOR);
+
+    const auto report = scan(failing_reader(SCAN_SIZE, BAD_BEGIN, BAD_END), SCAN_SIZE);
+
+    EXPECT_TRUE(report.complete);
+    EXPECT_EQ(report.failed_sector_count, 4U);
+    EXPECT_EQ(report.failed_sectors, (std::vector<uint64_t>{BAD_BEGIN, BAD_BEGIN + SECTOR,
+                                                            BAD_BEGIN + (2 * SECTOR),
+                                                            BAD_BEGIN + (3 * SECTOR)}));
+    EXPECT_EQ(report.grade, 'D') << report.summary;
+
+    // The heatmap shows where they are
+    const auto region = static_cast<std::size_t>(BAD_BEGIN * report.regions.size() / SCAN_SIZE);
+    EXPECT_EQ(report.regions[region].failed_sectors, 4U);
+}
+
+TEST(SurfaceScanTest, Scan_ManyUnreadableSectorsGradeF) {
+    const auto report = scan(failing_reader(SCAN_SIZE, MIB, MIB + (64 * SECTOR)), SCAN_SIZE);
+    EXPECT_EQ(report.failed_sector_count, 64U);
+    EXPECT_EQ(report.grade, 'F');
+}
+
+TEST(SurfaceScanTest, Scan_RecordsSlowRead) {
+    constexpr uint64_t SLOW_OFFSET = 5 * MIB;
+    const auto inner = zero_reader(SCAN_SIZE);
+    const SurfaceReader reader = [&inner](void* buffer, std::size_t length, uint64_t offset) {
+        if (offset == SLOW_OFFSET) {
+            std::this_thread::sleep_for(SLOW_READ + std::chrono::milliseconds{100});
+        }
+        return inner(buffer, length, offset);
+    };
+
+    // Enough reads that one slow one stays under 0.1%
+    const auto report = scan(reader, SCAN_SIZE, {.read_size = 4'096, .queue_depth = 1});
+
+    ASSERT_EQ(report.slow_read_count, 1U);
+    EXPECT_EQ(report.slow_reads.front().offset, SLOW_OFFSET);
+    EXPECT_GE(report.slow_reads.front().latency_us, 150'000U);
+    EXPECT_EQ(report.grade, 'B') << report.summary;
+}
+
+TEST(SurfaceScanTest, Scan_StopsWhenCancelled) {
+    std::atomic<bool> cancel{false};
+    const auto inner = zero_reader(SCAN_SIZE);
+    const SurfaceReader reader = [&](void* buffer, std::size_t length, uint64_t offset) {
+        if (offset >= 2 * MIB) {
+            cancel.store(true);
+        }
+        return inner(buffer, length, offset);
+    };
+
+    const auto report =
+        scan_surface(reader, SCAN_SIZE, SECTOR, {.queue_depth = 1}, nullptr, cancel);
+    EXPECT_FALSE(report.complete);
+    EXPECT_LT(report.bytes_read, SCAN_SIZE);
+    EXPECT_EQ(report.grade, '?');
+}
+
+TEST(SurfaceScanServiceTest, Start_ScansFileAndKeepsReport) {
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    ASSERT_TRUE(file.resize(SCAN_SIZE));
+
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    std::optional<WipeProgress> final_progress;
+    std::atomic<bool> release{false};
+    SurfaceScanService service;
+
+    const auto started = service.start(file.path(), [&](const WipeProgress& progress) {
+        if (!progress.is_complete) {
+            // Hold the scan open until the duplicate start has been tried
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+            return;
+        }
+        std::lock_guard lock{mutex};
+        final_progress = progress;
+        done_cv.notify_all();
+    });
+    ASSERT_TRUE(started.has_value()) << started.error().message;
+
+    // A second scan of the same device is refused while the first runs
+    EXPECT_TRUE(service.is_scanning(file.path()));
+    EXPECT_FALSE(service.start(file.path(), nullptr).has_value());
+    EXPECT_EQ(service.active_count(), 1U);
+    EXPECT_EQ(service.active_devices(), std::vector<std::string>{file.path()});
+    release.store(true);
+
+    {
+        std::unique_lock lock{mutex};
+        ASSERT_TRUE(done_cv.wait_for(lock, std::chrono::seconds{30},
+                                     [&] { return final_progress.has_value(); }));
+    }
+    EXPECT_FALSE(final_progress->has_error);
+    EXPECT_TRUE(final_progress->status.starts_with("Grade A")) << final_progress->status;
+
+    const auto report = service.report(file.path());
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->bytes_read, SCAN_SIZE);
+    EXPECT_EQ(report->grade, 'A');
+}
+
+TEST(SurfaceScanServiceTest, Start_RejectsMissingDevice) {
+    SurfaceScanService service;
+    EXPECT_FALSE(service.start("/nonexistent/storage-wiper-device", nullptr).has_value());
+    EXPECT_EQ(service.active_count(), 0U);
+    EXPECT_TRUE(service.active_devices().empty());
+}
+
+TEST(SurfaceScanTest, Benchmark_ScanAgainstPlainReads) {
+    constexpr uint64_t SIZE = 64 * MIB;
+    TempTestFile file;
+    ASSERT_TRUE(file.valid());
+    std::vector<uint8_t> chunk(MIB, 0x5A);
+    for (uint64_t offset = 0; offset < SIZE; offset += MIB) {
+        ASSERT_EQ(pwrite(file.fd(), chunk.data(), chunk.size(), static_cast<off_t>(offset)),
+                  static_cast<ssize_t>(chunk.size()));
+    }
+
+    const auto plain_start = std::chrono::steady_clock::now();
+    for (uint64_t offset = 0; offset < SIZE; offset += MIB) {
+        ASSERT_EQ(pread(file.fd(), chunk.data(), chunk.size(), static_cast<off_t>(offset)),
+                  static_cast<ssize_t>(chunk.size()));
+    }
+    const std::chrono::duration<double> plain = std::chrono::steady_clock::now() - plain_start;
+
+    const SurfaceReader reader = [fd = file.fd()](void* buffer, std::size_t length,
+                                                  uint64_t offset) {
+        return pread(fd, buffer, length, static_cast<off_t>(offset));
+    };
+    const auto report = scan(reader, SIZE);
+    ASSERT_TRUE(report.complete);
+
+    const double scan_seconds = std::max(std::chrono::duration<double>(report.elapsed).count(),
+                                         1e-3);
+    const double ratio = plain.count() / scan_seconds;
+    RecordProperty("scan_mb_per_s", std::format("{:.0f}", (SIZE / MIB) / scan_seconds));
+    RecordProperty("scan_vs_pread", std::format("{:.2f}", ratio));
+    EXPECT_GT(ratio, MIN_SCAN_VS_PREAD);
+}
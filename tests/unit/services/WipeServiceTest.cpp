@@ -125,14 +125,21 @@ TEST_F(WipeServiceTest, GetPassCount_AllAlgorithms) {
     };
 
     std::vector<TestCase> test_cases = {
-        {       WipeAlgorithm::ZERO_FILL,  1},
-        {     WipeAlgorithm::RANDOM_FILL,  1},
-        {   WipeAlgorithm::DOD_5220_22_M,  3},
-        {        WipeAlgorithm::SCHNEIER,  7},
-        {           WipeAlgorithm::VSITR,  7},
-        { WipeAlgorithm::GOST_R_50739_95,  2},
-        {         WipeAlgorithm::GUTMANN, 35},
-        {WipeAlgorithm::ATA_SECURE_ERASE,  1},
+        {                  WipeAlgorithm::ZERO_FILL,  1},
+        {                WipeAlgorithm::RANDOM_FILL,  1},
+        {              WipeAlgorithm::DOD_5220_22_M,  3},
+        {                   WipeAlgorithm::SCHNEIER,  7},
+        {                      WipeAlgorithm::VSITR,  7},
+        {            WipeAlgorithm::GOST_R_50739_95,  2},
+        {                    WipeAlgorithm::GUTMANN, 35},
+        {           WipeAlgorithm::ATA_SECURE_ERASE,  1},
+        {               WipeAlgorithm::THIN_DISCARD,  2},
+        {          WipeAlgorithm::DOD_5220_22_M_ECE,  7},
+        {          WipeAlgorithm::RCMP_TSSIT_OPS_II,  7},
+        {                 WipeAlgorithm::LBA_TAGGED,  1},
+        {            WipeAlgorithm::LBA_TAGGED_ZERO,  2},
+        {          WipeAlgorithm::LUKS_CRYPTO_SHRED,  1},
+        {WipeAlgorithm::LUKS_CRYPTO_SHRED_OVERWRITE,  2},
     };
 
     for (const auto& tc : test_cases) {
@@ -145,7 +152,7 @@ TEST_F(WipeServiceTest, GetPassCount_AllAlgorithms) {
 TEST_F(WipeServiceTest, AlgorithmNames_AreUnique) {
     std::set<std::string> names;
 
-    for (int i = 0; i <= static_cast<int>(WipeAlgorithm::ATA_SECURE_ERASE); ++i) {
+    for (int i = 0; i <= static_cast<int>(WipeAlgorithm::LUKS_CRYPTO_SHRED_OVERWRITE); ++i) {
         auto algo = static_cast<WipeAlgorithm>(i);
         auto name = wipe_service->get_algorithm_name(algo);
 
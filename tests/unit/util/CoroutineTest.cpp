@@ -0,0 +1,204 @@
+/**
+ * @file CoroutineTest.cpp
+ * @brief Unit tests for util::Task, spawn() and the scheduler awaitables
+ */
+
+#include "util/Coroutine.hpp"
+
+#include "fixtures/ManualScheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+auto add(int a, int b) -> util::Task<int> {
+    co_return a + b;
+}
+
+auto add_twice(int a, int b) -> util::Task<int> {
+    const int first = co_await add(a, b);
+    const int second = co_await add(first, b);
+    co_return second;
+}
+
+auto fail_after_sleep(ManualScheduler& scheduler) -> util::Task<int> {
+    co_await util::sleep_for(scheduler, 10ms);
+    throw std::runtime_error{"device gone"};
+}
+
+}  // namespace
+
+TEST(CoroutineTest, Task_IsLazyUntilAwaited) {
+    bool started = false;
+    auto make = [&]() -> util::Task<> {
+        started = true;
+        co_return;
+    };
+
+    auto task = make();
+    EXPECT_FALSE(started);
+
+    util::spawn(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(CoroutineTest, Task_NestedAwaitReturnsValue) {
+    int result = 0;
+    auto outer = [&]() -> util::Task<> { result = co_await add_twice(2, 3); };
+
+    util::spawn(outer());
+    EXPECT_EQ(result, 8);
+}
+
+TEST(CoroutineTest, SleepFor_SuspendsWithoutBlockingAndResumesInOrder) {
+    ManualScheduler scheduler;
+    std::vector<std::string> events;
+
+    auto sleeper = [&](std::string name, std::chrono::milliseconds delay) -> util::Task<> {
+        co_await util::sleep_for(scheduler, delay);
+        events.push_back(name);
+    };
+
+    util::spawn(sleeper("slow", 300ms));
+    util::spawn(sleeper("fast", 100ms));
+    EXPECT_TRUE(events.empty());  // Both suspended, caller not blocked
+
+    ASSERT_TRUE(scheduler.run_until([&] { return events.size() == 2; }));
+    EXPECT_EQ(events, (std::vector<std::string>{"fast", "slow"}));
+    EXPECT_EQ(scheduler.now(), 300ms);
+}
+
+TEST(CoroutineTest, Exception_PropagatesToAwaiter) {
+    ManualScheduler scheduler;
+    std::string caught;
+
+    auto outer = [&]() -> util::Task<> {
+        try {
+            static_cast<void>(co_await fail_after_sleep(scheduler));
+        } catch (const std::runtime_error& e) {
+            caught = e.what();
+        }
+    };
+
+    util::spawn(outer());
+    ASSERT_TRUE(scheduler.run_until([&] { return !caught.empty(); }));
+    EXPECT_EQ(caught, "device gone");
+}
+
+TEST(CoroutineTest, RunBlocking_RunsOffThreadAndResumesOnScheduler) {
+    ManualScheduler scheduler;
+    util::Executor executor{{.compute_threads = 1, .io_threads = 2}};
+    const auto test_thread = std::this_thread::get_id();
+    std::thread::id worker_thread;
+    std::thread::id resumed_thread;
+    int value = 0;
+
+    auto task = [&]() -> util::Task<> {
+        value = co_await util::run_blocking(
+            scheduler,
+            [&] {
+                worker_thread = std::this_thread::get_id();
+                return 7;
+            },
+            util::TaskLane::BLOCKING_IO, executor);
+        resumed_thread = std::this_thread::get_id();
+    };
+
+    util::spawn(task());
+    ASSERT_TRUE(scheduler.run_until([&] { return value != 0; }));
+    EXPECT_EQ(value, 7);
+    EXPECT_NE(worker_thread, test_thread);
+    EXPECT_EQ(resumed_thread, test_thread);
+}
+
+TEST(CoroutineTest, RunBlocking_RethrowsException) {
+    ManualScheduler scheduler;
+    util::Executor executor{{.compute_threads = 1, .io_threads = 1}};
+    bool caught = false;
+
+    auto task = [&]() -> util::Task<> {
+        try {
+            co_await util::run_blocking(
+                scheduler, []() { throw std::runtime_error{"ioctl failed"}; },
+                util::TaskLane::BLOCKING_IO, executor);
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+    };
+
+    util::spawn(task());
+    ASSERT_TRUE(scheduler.run_until([&] { return caught; }));
+}
+
+TEST(CoroutineTest, RunBlocking_BulkPriorityQueuesBehindNormalWork) {
+    ManualScheduler scheduler;
+    util::Executor executor{{.compute_threads = 1, .io_threads = 1}};
+    std::atomic<bool> release{false};
+    std::vector<std::string> order;
+    std::mutex order_mutex;
+    auto record = [&](std::string name) {
+        std::lock_guard lock{order_mutex};
+        order.push_back(std::move(name));
+    };
+
+    // Occupy the only I/O worker so both tasks below are queued together
+    executor.post(
+        [&] {
+            while (!release.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        },
+        util::TaskPriority::NORMAL, util::TaskLane::BLOCKING_IO);
+
+    bool done = false;
+    auto task = [&]() -> util::Task<> {
+        co_await util::run_blocking(
+            scheduler, [&] { record("bulk"); }, util::TaskLane::BLOCKING_IO, executor,
+            util::TaskPriority::BULK);
+        done = true;
+    };
+    util::spawn(task());
+    executor.post([&] { record("normal"); }, util::TaskPriority::NORMAL,
+                  util::TaskLane::BLOCKING_IO);
+    release.store(true);
+
+    ASSERT_TRUE(scheduler.run_until([&] { return done; }));
+    std::lock_guard lock{order_mutex};
+    EXPECT_EQ(order, (std::vector<std::string>{"normal", "bulk"}));
+}
+
+TEST(CoroutineTest, ManyPollingOperations_ShareFewThreads) {
+    // Hundreds of "issue, then poll" operations in flight at once with a tiny pool
+    ManualScheduler scheduler;
+    util::Executor executor{{.compute_threads = 1, .io_threads = 2}};
+    constexpr int OPERATIONS = 300;
+    constexpr int POLLS = 5;
+    std::atomic<int> completed{0};
+
+    auto operation = [&](int id) -> util::Task<> {
+        for (int poll = 0; poll < POLLS; ++poll) {
+            const int status = co_await util::run_blocking(
+                scheduler, [id] { return id; }, util::TaskLane::BLOCKING_IO, executor);
+            static_cast<void>(status);
+            co_await util::sleep_for(scheduler, 1'000ms);
+        }
+        completed.fetch_add(1);
+    };
+
+    for (int i = 0; i < OPERATIONS; ++i) {
+        util::spawn(operation(i));
+    }
+
+    ASSERT_TRUE(scheduler.run_until([&] { return completed.load() == OPERATIONS; }, 30'000ms));
+    EXPECT_EQ(executor.io_threads(), 2U);
+}
@@ -0,0 +1,206 @@
+/**
+ * @file ExecutorTest.cpp
+ * @brief Unit tests for the work-stealing executor and RandomStream
+ */
+
+#include "util/Executor.hpp"
+#include "util/RandomStream.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto WAIT_LIMIT = 5s;
+
+/**
+ * @brief Manually released gate for holding workers busy
+ */
+class Gate {
+public:
+    void open() { promise_.set_value(); }
+    void wait() const { future_.wait(); }
+
+private:
+    std::promise<void> promise_;
+    std::shared_future<void> future_{promise_.get_future().share()};
+};
+
+}  // namespace
+
+TEST(ExecutorTest, Submit_ReturnsResult) {
+    util::Executor executor{{.compute_threads = 2, .io_threads = 1}};
+
+    auto compute = executor.submit([] { return 21 * 2; });
+    auto io = executor.submit([] { return std::string{"io"}; }, util::TaskPriority::NORMAL,
+                              util::TaskLane::BLOCKING_IO);
+
+    EXPECT_EQ(compute.get(), 42);
+    EXPECT_EQ(io.get(), "io");
+}
+
+TEST(ExecutorTest, Submit_PropagatesException) {
+    util::Executor executor{{.compute_threads = 1, .io_threads = 1}};
+
+    auto future = executor.submit([]() -> int { throw std::runtime_error{"boom"}; });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ExecutorTest, Destructor_DrainsQueuedTasks) {
+    std::atomic<int> ran{0};
+    {
+        util::Executor executor{{.compute_threads = 2, .io_threads = 2}};
+        for (int i = 0; i < 200; ++i) {
+            executor.post([&ran] { ran.fetch_add(1); });
+            executor.post([&ran] { ran.fetch_add(1); }, util::TaskPriority::BULK,
+                          util::TaskLane::BLOCKING_IO);
+        }
+    }
+    EXPECT_EQ(ran.load(), 400);
+}
+
+TEST(ExecutorTest, ParallelFor_VisitsEachIndexOnce) {
+    util::Executor executor{{.compute_threads = 4, .io_threads = 1}};
+    std::vector<std::atomic<int>> hits(1'000);
+
+    executor.parallel_for(hits.size(), [&hits](std::size_t i) { hits[i].fetch_add(1); });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ExecutorTest, ParallelFor_NestedInsideWorkerDoesNotDeadlock) {
+    util::Executor executor{{.compute_threads = 2, .io_threads = 1}};
+    std::atomic<int> total{0};
+
+    auto outer = executor.submit([&] {
+        executor.parallel_for(64, [&](std::size_t) { total.fetch_add(1); });
+    });
+
+    ASSERT_EQ(outer.wait_for(WAIT_LIMIT), std::future_status::ready);
+    EXPECT_EQ(total.load(), 64);
+}
+
+TEST(ExecutorTest, ParallelFor_RethrowsFirstException) {
+    util::Executor executor{{.compute_threads = 2, .io_threads = 1}};
+    std::atomic<int> visited{0};
+
+    EXPECT_THROW(executor.parallel_for(32,
+                                       [&](std::size_t i) {
+                                           visited.fetch_add(1);
+                                           if (i == 7) {
+                                               throw std::runtime_error{"index 7"};
+                                           }
+                                       }),
+                 std::runtime_error);
+    // Remaining indices still run so callers never observe a half-finished loop
+    EXPECT_EQ(visited.load(), 32);
+}
+
+TEST(ExecutorTest, ControlTask_RunsWhileOtherLanesSaturated) {
+    util::Executor executor{{.compute_threads = 2, .io_threads = 2}};
+    Gate gate;
+
+    // Occupy every compute and I/O worker, then queue more bulk work behind them
+    for (int i = 0; i < 8; ++i) {
+        executor.post([&gate] { gate.wait(); }, util::TaskPriority::BULK);
+        executor.post([&gate] { gate.wait(); }, util::TaskPriority::BULK,
+                      util::TaskLane::BLOCKING_IO);
+    }
+
+    auto control = executor.submit([] { return true; }, util::TaskPriority::CONTROL);
+    const auto status = control.wait_for(WAIT_LIMIT);
+    gate.open();
+
+    ASSERT_EQ(status, std::future_status::ready);
+    EXPECT_TRUE(control.get());
+}
+
+TEST(ExecutorTest, IoLane_NormalRunsBeforeQueuedBulk) {
+    util::Executor executor{{.compute_threads = 1, .io_threads = 1}};
+    Gate gate;
+    std::mutex order_mutex;
+    std::vector<char> order;
+
+    auto record = [&](char tag) {
+        std::lock_guard lock{order_mutex};
+        order.push_back(tag);
+    };
+
+    auto blocker = executor.submit([&gate] { gate.wait(); }, util::TaskPriority::NORMAL,
+                                   util::TaskLane::BLOCKING_IO);
+    executor.post([&] { record('b'); }, util::TaskPriority::BULK, util::TaskLane::BLOCKING_IO);
+    auto normal = executor.submit([&] { record('n'); }, util::TaskPriority::NORMAL,
+                                  util::TaskLane::BLOCKING_IO);
+    gate.open();
+
+    ASSERT_EQ(normal.wait_for(WAIT_LIMIT), std::future_status::ready);
+    blocker.get();
+    // Flush: a task queued after both runs only once they have
+    executor.submit([] {}, util::TaskPriority::BULK, util::TaskLane::BLOCKING_IO).get();
+
+    std::lock_guard lock{order_mutex};
+    ASSERT_EQ(order.size(), 2U);
+    EXPECT_EQ(order[0], 'n');
+    EXPECT_EQ(order[1], 'b');
+}
+
+TEST(ExecutorTest, IdleWorkerStealsFromBusyWorker) {
+    util::Executor executor{{.compute_threads = 2, .io_threads = 1}};
+    std::atomic<int> children_done{0};
+
+    // The parent queues children on its own deque and then blocks; only a steal by
+    // the other worker can run them.
+    auto parent = executor.submit([&] {
+        std::vector<std::future<void>> children;
+        for (int i = 0; i < 4; ++i) {
+            children.push_back(executor.submit([&] { children_done.fetch_add(1); }));
+        }
+        for (auto& child : children) {
+            if (child.wait_for(WAIT_LIMIT) != std::future_status::ready) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    ASSERT_EQ(parent.wait_for(2 * WAIT_LIMIT), std::future_status::ready);
+    EXPECT_TRUE(parent.get());
+    EXPECT_EQ(children_done.load(), 4);
+}
+
+TEST(ExecutorTest, OnComputeWorker_IdentifiesWorkerThreads) {
+    util::Executor executor{{.compute_threads = 1, .io_threads = 1}};
+
+    EXPECT_FALSE(executor.on_compute_worker());
+    EXPECT_TRUE(executor.submit([&] { return executor.on_compute_worker(); }).get());
+    EXPECT_FALSE(executor
+                     .submit([&] { return executor.on_compute_worker(); },
+                             util::TaskPriority::NORMAL, util::TaskLane::BLOCKING_IO)
+                     .get());
+}
+
+// ========== RandomStream ==========
+
+TEST(RandomStreamTest, Next_YieldsFreshBuffers) {
+    util::Executor executor{{.compute_threads = 2, .io_threads = 1}};
+    util::RandomStream stream{4'096, executor};
+
+    std::set<std::vector<uint8_t>> seen;
+    for (int i = 0; i < 8; ++i) {
+        const auto& buffer = stream.next();
+        ASSERT_EQ(buffer.size(), 4'096U);
+        seen.insert(buffer);
+    }
+    EXPECT_EQ(seen.size(), 8U);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file StartupTraceTest.cpp
+ * @brief Unit tests for startup phase timing
+ */
+
+#include "util/StartupTrace.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+const util::StartupTrace::Clock::time_point ORIGIN{};
+
+}  // namespace
+
+TEST(StartupTraceTest, Mark_RecordsOffsetFromOrigin) {
+    util::StartupTrace trace{ORIGIN, false};
+
+    trace.mark(util::StartupTrace::WINDOW_PRESENTED, ORIGIN + 40ms);
+    trace.mark(util::StartupTrace::FIRST_FRAME, ORIGIN + 85ms);
+
+    EXPECT_EQ(trace.offset_of(util::StartupTrace::FIRST_FRAME), 85ms);
+    EXPECT_FALSE(trace.offset_of(util::StartupTrace::DISKS_SHOWN).has_value());
+    ASSERT_EQ(trace.phases().size(), 2U);
+    EXPECT_EQ(trace.phases().front().name, "window presented");
+}
+
+TEST(StartupTraceTest, Mark_KeepsFirstOccurrence) {
+    util::StartupTrace trace{ORIGIN, false};
+
+    trace.mark(util::StartupTrace::HELPER_CONNECTED, ORIGIN + 120ms);
+    // A later reconnect must not replace the cold-start number
+    trace.mark(util::StartupTrace::HELPER_CONNECTED, ORIGIN + 30s);
+
+    EXPECT_EQ(trace.offset_of(util::StartupTrace::HELPER_CONNECTED), 120ms);
+    EXPECT_EQ(trace.phases().size(), 1U);
+}
+
+TEST(StartupTraceTest, Report_ListsPhasesInOrder) {
+    util::StartupTrace trace{ORIGIN, false};
+
+    trace.mark(util::StartupTrace::FIRST_FRAME, ORIGIN + 83ms);
+    trace.mark(util::StartupTrace::DISKS_SHOWN, ORIGIN + 1500us);
+
+    EXPECT_EQ(trace.report(), "first frame +83.0 ms, disks shown +1.5 ms");
+}
+
+TEST(StartupTraceTest, Finish_IsIdempotent) {
+    util::StartupTrace trace{ORIGIN, false};
+    trace.mark(util::StartupTrace::FIRST_FRAME, ORIGIN + 200ms);
+
+    trace.finish();
+    trace.finish();
+
+    EXPECT_EQ(trace.phases().size(), 1U);
+}
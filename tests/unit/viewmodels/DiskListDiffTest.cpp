@@ -0,0 +1,96 @@
+/**
+ * @file DiskListDiffTest.cpp
+ * @brief Unit tests for the keyed disk list diff
+ */
+
+#include "viewmodels/DiskListDiff.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+auto make_disk(const std::string& path, const std::string& model = "ACME") -> DiskInfo {
+    DiskInfo disk;
+    disk.path = path;
+    disk.model = model;
+    disk.size_bytes = 1ULL << 40;
+    return disk;
+}
+
+// Apply edits the way a list store would and return the result
+auto apply(std::vector<DiskInfo> rows, const std::vector<DiskInfo>& after,
+           const std::vector<DiskListEdit>& edits) -> std::vector<DiskInfo> {
+    for (const auto& edit : edits) {
+        const auto at = rows.begin() + static_cast<std::ptrdiff_t>(edit.position);
+        switch (edit.kind) {
+            case DiskListEdit::Kind::INSERT:
+                rows.insert(at, after[edit.source]);
+                break;
+            case DiskListEdit::Kind::REMOVE:
+                rows.erase(at);
+                break;
+            case DiskListEdit::Kind::UPDATE:
+                *at = after[edit.source];
+                break;
+        }
+    }
+    return rows;
+}
+
+}  // namespace
+
+TEST(DiskListDiffTest, UnchangedListProducesNoEdits) {
+    std::vector<DiskInfo> disks = {make_disk("/dev/sda"), make_disk("/dev/sdb")};
+
+    EXPECT_TRUE(diff_disk_lists(disks, disks).empty());
+}
+
+TEST(DiskListDiffTest, InsertRemoveAndChangeTouchOnlyAffectedRows) {
+    std::vector<DiskInfo> before = {make_disk("/dev/sda"), make_disk("/dev/sdb"),
+                                    make_disk("/dev/sdc")};
+    std::vector<DiskInfo> after = {make_disk("/dev/sda"), make_disk("/dev/sdc", "Renamed"),
+                                   make_disk("/dev/sdd")};
+
+    auto edits = diff_disk_lists(before, after);
+
+    EXPECT_EQ(edits, (std::vector<DiskListEdit>{
+                         {.kind = DiskListEdit::Kind::REMOVE, .position = 1, .source = 0},
+                         {.kind = DiskListEdit::Kind::UPDATE, .position = 1, .source = 1},
+                         {.kind = DiskListEdit::Kind::INSERT, .position = 2, .source = 2},
+                     }));
+    EXPECT_EQ(apply(before, after, edits), after);
+}
+
+TEST(DiskListDiffTest, ReorderIsExpressedAsMoves) {
+    std::vector<DiskInfo> before = {make_disk("/dev/sda"), make_disk("/dev/sdb"),
+                                    make_disk("/dev/sdc")};
+    std::vector<DiskInfo> after = {make_disk("/dev/sdc"), make_disk("/dev/sda"),
+                                   make_disk("/dev/sdb")};
+
+    EXPECT_EQ(apply(before, after, diff_disk_lists(before, after)), after);
+}
+
+TEST(DiskListDiffTest, LargeRefreshWithOneChangeIsOneEdit) {
+    std::vector<DiskInfo> before;
+    for (int i = 0; i < 500; ++i) {
+        before.push_back(make_disk("/dev/disk" + std::to_string(i)));
+    }
+    auto after = before;
+    after[250].is_mounted = true;
+
+    auto edits = diff_disk_lists(before, after);
+
+    ASSERT_EQ(edits.size(), 1U);
+    EXPECT_EQ(edits.front().kind, DiskListEdit::Kind::UPDATE);
+    EXPECT_EQ(edits.front().position, 250U);
+}
+
+TEST(DiskListDiffTest, EmptyToFullAndBack) {
+    std::vector<DiskInfo> disks = {make_disk("/dev/sda"), make_disk("/dev/sdb")};
+
+    EXPECT_EQ(apply({}, disks, diff_disk_lists({}, disks)), disks);
+    EXPECT_TRUE(apply(disks, {}, diff_disk_lists(disks, {})).empty());
+}
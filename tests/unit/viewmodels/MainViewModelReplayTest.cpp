@@ -0,0 +1,122 @@
+/**
+ * @file MainViewModelReplayTest.cpp
+ * @brief Progress storm replay through MainViewModel with main-loop measurements
+ *
+ * Updates are delivered to the default main context the way GDBus delivers the
+ * helper's WipeProgress signals, while MainLoopProbe samples frame pacing and
+ * dispatch latency. Scenario knobs are documented in fixtures/ProgressReplay.hpp.
+ */
+
+#include "viewmodels/MainViewModel.hpp"
+
+#include "fixtures/MainLoopProbe.hpp"
+#include "fixtures/ProgressReplay.hpp"
+#include "fixtures/TestFixtures.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <format>
+
+using ::testing::_;
+using ::testing::Invoke;
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Regression gates, generous enough for loaded CI machines
+constexpr auto MAX_LOOP_LATENCY_P99 = std::chrono::milliseconds{50};
+constexpr auto MAX_FRAME_INTERVAL_P99 = std::chrono::milliseconds{50};  // About 3 frames
+constexpr double MAX_CPU_LOAD = 1.0;                                     // Cores
+
+auto format_ms(std::chrono::microseconds value) -> std::string {
+    return std::format("{:.2f}", static_cast<double>(value.count()) / 1'000.0);
+}
+
+}  // namespace
+
+class MainViewModelReplayTest : public ViewModelTestFixture {
+protected:
+    std::shared_ptr<MainViewModel> view_model;
+    ProgressCallback progress_callback;
+
+    void SetUp() override {
+        ViewModelTestFixture::SetUp();
+        view_model = std::make_shared<MainViewModel>(mock_disk_service, mock_wipe_service);
+    }
+
+    void TearDown() override {
+        view_model.reset();
+        ViewModelTestFixture::TearDown();
+    }
+
+    // Runs the real start-wipe flow and keeps the callback the helper's signals feed
+    void StartWipe() {
+        ON_CALL(*mock_disk_service, get_available_disks(_))
+            .WillByDefault(Invoke([](auto callback) {
+                callback(std::vector<DiskInfo>{MockDiskService::CreateTestDisk("/dev/sda")});
+            }));
+        EXPECT_CALL(*mock_wipe_service, wipe_disk("/dev/sda", _, _))
+            .WillOnce(Invoke([this](const std::string&, WipeAlgorithm, ProgressCallback callback) {
+                progress_callback = std::move(callback);
+                return true;
+            }));
+
+        view_model->initialize();
+        view_model->set_connection_state(true, "");
+        PumpMainLoop();
+        view_model->select_disk("/dev/sda");
+        view_model->wipe_command->execute();
+
+        auto confirm = view_model->current_message.get().confirmation_callback;
+        ASSERT_TRUE(confirm);
+        confirm(true);
+        ASSERT_TRUE(progress_callback);
+    }
+};
+
+TEST_F(MainViewModelReplayTest, Benchmark_ProgressStormKeepsMainLoopResponsive) {
+    ASSERT_NO_FATAL_FAILURE(StartWipe());
+    const auto trace = trace_from_environment(
+        {.rate_hz = 1'000.0, .jobs = 4, .duration = 1s, .jitter = 0.3});
+
+    std::size_t notifications = 0;
+    auto subscription =
+        view_model->wipe_progress.subscribe([&notifications](const WipeProgress&) {
+            ++notifications;
+        });
+
+    auto context = Glib::MainContext::get_default();
+    MainLoopProbe probe;
+    auto report = ProgressReplayer::replay(
+        trace,
+        [this, &context](const TraceEvent& event) {
+            context->invoke([this, progress = event.progress]() {
+                progress_callback(progress);
+                return false;
+            });
+        },
+        [&context] { context->iteration(true); });
+    PumpMainLoop();
+    probe.stop();
+    view_model->wipe_progress.unsubscribe(subscription);
+
+    const auto latency = probe.loop_latency();
+    const auto frames = probe.frame_intervals();
+    RecordProperty("updates", std::format("{}", report.delivered));
+    RecordProperty("loop_latency_p99_ms", format_ms(latency.p99));
+    RecordProperty("loop_latency_max_ms", format_ms(latency.max));
+    RecordProperty("frame_interval_p99_ms", format_ms(frames.p99));
+    RecordProperty("frame_interval_max_ms", format_ms(frames.max));
+    RecordProperty("cpu_load", std::format("{:.3f}", report.cpu_load()));
+
+    EXPECT_EQ(report.delivered, trace.size());
+    EXPECT_GT(notifications, 0U);
+    EXPECT_TRUE(view_model->wipe_progress.get().is_complete);
+    EXPECT_FALSE(view_model->is_wipe_in_progress.get());
+
+    EXPECT_LT(latency.p99, MAX_LOOP_LATENCY_P99);
+    EXPECT_LT(frames.p99, MAX_FRAME_INTERVAL_P99);
+    EXPECT_LT(report.cpu_load(), MAX_CPU_LOAD);
+}
@@ -53,7 +53,7 @@ TEST_F(MainViewModelTest, Initialize_LoadsDisks) {
     view_model->initialize();  // Won't load disks since not connected
     SimulateConnected();       // This triggers load_disks()
 
-    EXPECT_EQ(view_model->disks.get().size(), 2u);
+    EXPECT_EQ(view_model->disks.get()->size(), 2u);
 }
 
 // Test: initialize with empty disk list when connected
@@ -64,7 +64,20 @@ TEST_F(MainViewModelTest, Initialize_HandlesEmptyDiskList) {
     view_model->initialize();
     SimulateConnected();
 
-    EXPECT_TRUE(view_model->disks.get().empty());
+    EXPECT_TRUE(view_model->disks.get()->empty());
+}
+
+// Test: disks_loaded stays false until the helper answers
+TEST_F(MainViewModelTest, DisksLoaded_SetAfterFirstResponse) {
+    EXPECT_CALL(*mock_disk_service, get_available_disks(testing::_))
+        .WillOnce(Invoke([](auto callback) { callback(std::vector<DiskInfo>{}); }));
+
+    view_model->initialize();
+    EXPECT_FALSE(view_model->disks_loaded.get());  // Not connected yet
+
+    SimulateConnected();
+
+    EXPECT_TRUE(view_model->disks_loaded.get());
 }
 
 // Test: select_disk updates selected_disk_path
@@ -201,7 +214,7 @@ TEST_F(MainViewModelTest, Algorithms_ArePopulated) {
     SimulateConnected();
 
     // Should have multiple algorithms available
-    EXPECT_FALSE(view_model->algorithms.get().empty());
+    EXPECT_FALSE(view_model->algorithms.get()->empty());
 }
 
 // Test: disk selection cleared when disk no longer available